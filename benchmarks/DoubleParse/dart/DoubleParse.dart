@@ -0,0 +1,84 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure the throughput of parsing doubles, both with double.parse and when
+// decoding UTF-8 encoded JSON.
+
+import 'dart:convert';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+const int count = 1000;
+
+List<double> generateDoubles(int seed, double Function(Random) next) {
+  final random = Random(seed);
+  return List<double>.generate(count, (_) => next(random));
+}
+
+// Doubles with full 17 digit representations, like measurements or
+// coordinates.
+final List<double> fullPrecision =
+    generateDoubles(1, (r) => (r.nextDouble() - 0.5) * 1000);
+
+// Doubles with a few digits, like prices.
+final List<double> shortDigits =
+    generateDoubles(2, (r) => r.nextInt(1000000) / 100);
+
+// Doubles across the whole exponent range.
+final List<double> wideExponents = generateDoubles(
+    3, (r) => r.nextDouble() * pow(10, r.nextInt(600) - 300).toDouble());
+
+class DoubleParse extends BenchmarkBase {
+  final List<String> strings;
+  double sum = 0;
+
+  DoubleParse(String name, List<double> values)
+      : strings = values.map((d) => d.toString()).toList(),
+        super('DoubleParse.$name');
+
+  @override
+  void run() {
+    double sum = 0;
+    for (final s in strings) {
+      sum += double.parse(s);
+    }
+    this.sum = sum;
+  }
+}
+
+class JsonDecodeDoubles extends BenchmarkBase {
+  final Uint8List bytes;
+  static final Converter<List<int>, Object?> decoder =
+      json.fuse(utf8).decoder;
+  double sum = 0;
+
+  JsonDecodeDoubles(String name, List<double> values)
+      : bytes = utf8.encode(jsonEncode(values)),
+        super('DoubleParse.JsonUtf8.$name');
+
+  @override
+  void run() {
+    double sum = 0;
+    for (final d in decoder.convert(bytes) as List) {
+      sum += d as double;
+    }
+    this.sum = sum;
+  }
+}
+
+void main() {
+  final benchmarks = [
+    DoubleParse('FullPrecision', fullPrecision),
+    DoubleParse('ShortDigits', shortDigits),
+    DoubleParse('WideExponents', wideExponents),
+    JsonDecodeDoubles('FullPrecision', fullPrecision),
+    JsonDecodeDoubles('ShortDigits', shortDigits),
+    JsonDecodeDoubles('WideExponents', wideExponents),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the latency of short `Isolate.run` jobs with cold isolate creation
+// and with isolates taken from the VM's pool of pre-initialized isolates
+// (--isolate-pool-size).
+//
+// Since the pool is configured by a VM flag, each variant is measured in a
+// separate VM process started with the same executable and VM arguments.
+
+import 'dart:io';
+import 'dart:isolate';
+
+const int warmupCount = 100;
+const int count = 2000;
+const int poolSize = 4;
+
+Future<void> main(List<String> args) async {
+  if (args.isNotEmpty) {
+    await measure(args.single);
+    return;
+  }
+  await runVariant('Cold', 0);
+  await runVariant('Pooled', poolSize);
+}
+
+Future<void> runVariant(String name, int isolatePoolSize) async {
+  final result = await Process.run(Platform.executable, [
+    ...Platform.executableArguments,
+    '--isolate-pool-size=$isolatePoolSize',
+    Platform.script.toFilePath(),
+    name,
+  ]);
+  if (result.exitCode != 0) {
+    throw 'IsolateRunLatency.$name failed:\n${result.stdout}\n${result.stderr}';
+  }
+  stdout.write(result.stdout);
+}
+
+Future<void> measure(String name) async {
+  for (int i = 0; i < warmupCount; ++i) {
+    await Isolate.run(job);
+  }
+
+  final latencies = List<int>.filled(count, 0);
+  final sw = Stopwatch()..start();
+  for (int i = 0; i < count; ++i) {
+    final start = sw.elapsedMicroseconds;
+    if (await Isolate.run(job) != 42) throw 'Unexpected result';
+    latencies[i] = sw.elapsedMicroseconds - start;
+  }
+  latencies.sort();
+
+  final average = latencies.reduce((a, b) => a + b) / count;
+  final p50 = latencies[count ~/ 2];
+  final p99 = latencies[count * 99 ~/ 100];
+  print('IsolateRunLatency.$name(Latency): $average us.');
+  print('IsolateRunLatency.${name}P50(Latency): $p50 us.');
+  print('IsolateRunLatency.${name}P99(Latency): $p99 us.');
+}
+
+int job() => 42;
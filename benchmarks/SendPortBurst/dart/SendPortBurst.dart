@@ -0,0 +1,68 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures throughput of a producer isolate sending many tiny messages to a
+// consumer in the same isolate group, with and without coalescing of
+// messages to the same port (--port-message-batch-size).
+//
+// Since coalescing is configured by a VM flag, each variant is measured in a
+// separate VM process started with the same executable and VM arguments.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+
+const int messageCount = 1000000;
+const int batchSize = 64;
+
+Future<void> main(List<String> args) async {
+  if (args.isNotEmpty) {
+    await measure(args.single);
+    return;
+  }
+  await runVariant('Unbatched', 0);
+  await runVariant('Batched', batchSize);
+}
+
+Future<void> runVariant(String name, int portMessageBatchSize) async {
+  final result = await Process.run(Platform.executable, [
+    ...Platform.executableArguments,
+    '--port-message-batch-size=$portMessageBatchSize',
+    Platform.script.toFilePath(),
+    name,
+  ]);
+  if (result.exitCode != 0) {
+    throw 'SendPortBurst.$name failed:\n${result.stdout}\n${result.stderr}';
+  }
+  stdout.write(result.stdout);
+}
+
+Future<void> measure(String name) async {
+  // Warm up.
+  await run(messageCount ~/ 10);
+
+  final sw = Stopwatch()..start();
+  await run(messageCount);
+  final us = sw.elapsedMicroseconds;
+  print('SendPortBurst.$name(RunTimeRaw): ${us / messageCount} us.');
+}
+
+Future<void> run(int count) async {
+  final port = ReceivePort();
+  final done = Completer<void>();
+  int received = 0;
+  port.listen((_) {
+    if (++received == count) done.complete();
+  });
+  await Isolate.spawn(produce, [port.sendPort, count]);
+  await done.future;
+  port.close();
+}
+
+void produce(List<Object> args) {
+  final [SendPort sendPort, int count] = args;
+  for (int i = 0; i < count; ++i) {
+    sendPort.send(i);
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the memory footprint of a read-only lookup table used by a number
+// of worker isolates when the table is copied into every worker and when it is
+// frozen with `deepFreeze` and passed by reference.
+//
+// dart:concurrent is experimental, so this has to be run with
+// --experimental-shared-data. Each variant is measured in a separate VM
+// process started with the same executable and VM arguments.
+
+import 'dart:concurrent';
+import 'dart:io';
+import 'dart:isolate';
+
+const int workerCount = 32;
+const int tableSize = 20000;
+
+Future<void> main(List<String> args) async {
+  if (args.isNotEmpty) {
+    await measure(args.single);
+    return;
+  }
+  await runVariant('Copied');
+  await runVariant('Frozen');
+}
+
+Future<void> runVariant(String name) async {
+  final result = await Process.run(Platform.executable, [
+    ...Platform.executableArguments,
+    Platform.script.toFilePath(),
+    name,
+  ]);
+  if (result.exitCode != 0) {
+    throw 'SharedLookupTableMemory.$name failed:\n'
+        '${result.stdout}\n${result.stderr}';
+  }
+  stdout.write(result.stdout);
+}
+
+Map<String, List<(int, String)>> buildTable() => {
+      for (int i = 0; i < tableSize; i++)
+        'key$i': [for (int j = 0; j < 4; j++) (i * j, 'value$i.$j')],
+    };
+
+Future<void> measure(String name) async {
+  var table = buildTable();
+  if (name == 'Frozen') {
+    // Records referring to strings are frozen in place, the lists and the map
+    // are copied into unmodifiable versions.
+    table = deepFreeze(table);
+  }
+
+  final startRss = ProcessInfo.currentRss;
+  final sw = Stopwatch()..start();
+
+  final ready = ReceivePort();
+  final exits = <ReceivePort>[];
+  final releases = <SendPort>[];
+  for (int i = 0; i < workerCount; i++) {
+    final onExit = ReceivePort();
+    exits.add(onExit);
+    await Isolate.spawn(worker, (table, ready.sendPort),
+        onExit: onExit.sendPort);
+  }
+  await for (final release in ready) {
+    releases.add(release as SendPort);
+    if (releases.length == workerCount) break;
+  }
+  final elapsedUs = sw.elapsedMicroseconds;
+  final rss = ProcessInfo.currentRss;
+
+  for (final release in releases) {
+    release.send(null);
+  }
+  for (final onExit in exits) {
+    await onExit.first;
+  }
+
+  final perWorkerKB = (rss - startRss) / workerCount / 1024;
+  print('SharedLookupTableMemory.${name}Rss(MemoryUse): $perWorkerKB');
+  print('SharedLookupTableMemory.${name}SetupLatency(Latency): '
+      '${elapsedUs / workerCount} us.');
+}
+
+Future<void> worker(
+    (Map<String, List<(int, String)>>, SendPort) message) async {
+  final (table, ready) = message;
+  if (table['key${tableSize - 1}']!.length != 4) throw 'Unexpected table';
+  // Keep the table alive until all workers are up and RSS has been measured.
+  final release = ReceivePort();
+  ready.send(release.sendPort);
+  await release.first;
+  if (table.length != tableSize) throw 'Unexpected table';
+}
@@ -4,6 +4,9 @@
 
 #include "include/dart_api.h"
 #include "vm/bootstrap_natives.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+#include "vm/object_graph_copy.h"
 #include "vm/os_thread.h"
 
 namespace dart {
@@ -98,4 +101,9 @@ DEFINE_FFI_NATIVE_ENTRY(ConditionVariable_Notify,
   condvar->Notify();
 }
 
+DEFINE_NATIVE_ENTRY(Concurrent_deepFreeze, 0, 1) {
+  const auto& object = Object::Handle(zone, arguments->NativeArgAt(0));
+  return DeepFreezeObjectGraph(object);
+}
+
 }  // namespace dart
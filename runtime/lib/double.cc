@@ -127,6 +127,43 @@ DEFINE_NATIVE_ENTRY(Double_parse, 0, 3) {
   return Object::null();
 }
 
+// Parses the ASCII numeral in bytes [start, end) of a Uint8List without
+// creating a string for it. Returns null if the bytes are not a valid numeral
+// or not backed by VM typed data.
+DEFINE_NATIVE_ENTRY(Double_parseBytes, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, bytes, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, startValue, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, endValue, arguments->NativeArgAt(2));
+
+  if (!bytes.IsTypedDataBase()) {
+    return Object::null();
+  }
+  const TypedDataBase& array = TypedDataBase::Cast(bytes);
+  if (array.ElementSizeInBytes() != 1) {
+    return Object::null();
+  }
+
+  const intptr_t start = startValue.Value();
+  const intptr_t end = endValue.Value();
+  const intptr_t len = array.LengthInBytes();
+
+  // Indices should be inside the list, and 0 <= start < end <= len.
+  if (0 <= start && start < end && end <= len) {
+    double double_value;
+    bool is_valid;
+    {
+      NoSafepointScope no_safepoint;
+      is_valid = CStringToDouble(
+          reinterpret_cast<const char*>(array.DataAddr(start)), end - start,
+          &double_value);
+    }
+    if (is_valid) {
+      return Double::New(double_value);
+    }
+  }
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(Double_toString, 0, 1) {
   const Number& number = Number::CheckedHandle(zone, arguments->NativeArgAt(0));
   return number.ToString(Heap::kNew);
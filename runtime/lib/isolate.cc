@@ -16,6 +16,7 @@
 #include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/hash_table.h"
+#include "vm/isolate_pool.h"
 #include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/message_handler.h"
@@ -123,6 +124,12 @@ DEFINE_NATIVE_ENTRY(SendPort_sendInternal_, 0, 2) {
   }
 #endif
 
+  if (same_group && FLAG_port_message_batch_size > 1) {
+    isolate->AddToMessageBatch(destination_port_id, obj);
+    return Object::null();
+  }
+  isolate->FlushMessageBatch();
+
   // TODO(turnidge): Throw an exception when the return value is false?
   PortMap::PostMessage(WriteMessage(same_group, obj, destination_port_id,
                                     Message::kNormalPriority));
@@ -847,12 +854,42 @@ class SpawnIsolateTask : public ThreadPool::Task {
       return;
     }
 
-    char* error = nullptr;
-
     auto group = state_->isolate_group();
-    Isolate* isolate = CreateWithinExistingIsolateGroup(group, name, &error);
+    auto pool = group->isolate_pool();
+    StartLightweight(name, group, pool, initialize_callback);
+    if (pool == nullptr) {
+      return;
+    }
+
+    // The child is running now, or failed to start: top up the pool for the
+    // next spawn. The spawner cannot shut down before we release its spawn
+    // count, which keeps the group alive meanwhile.
+    pool->Refill();
     parent_isolate_->DecrementSpawnCount();
     parent_isolate_ = nullptr;
+  }
+
+ private:
+  // Without a pool the spawn count of the parent is released as soon as the
+  // child has been created. With a pool the caller releases it after this
+  // returns, on every path.
+  void StartLightweight(const char* name,
+                        IsolateGroup* group,
+                        IsolatePool* pool,
+                        Dart_InitializeIsolateCallback initialize_callback) {
+    char* error = nullptr;
+
+    // Pooled isolates have already been created and initialized by the
+    // embedder.
+    Isolate* isolate = pool != nullptr ? pool->TryTake(name) : nullptr;
+    const bool is_pooled = isolate != nullptr;
+    if (!is_pooled) {
+      isolate = CreateWithinExistingIsolateGroup(group, name, &error);
+    }
+    if (pool == nullptr) {
+      parent_isolate_->DecrementSpawnCount();
+      parent_isolate_ = nullptr;
+    }
 
     if (isolate == nullptr) {
       FailedSpawn(error, /*has_current_isolate=*/false);
@@ -860,20 +897,20 @@ class SpawnIsolateTask : public ThreadPool::Task {
       return;
     }
 
-    void* child_isolate_data = nullptr;
-    const bool success = initialize_callback(&child_isolate_data, &error);
-    if (!success) {
-      FailedSpawn(error);
-      Dart_ShutdownIsolate();
-      free(error);
-      return;
+    if (!is_pooled) {
+      void* child_isolate_data = nullptr;
+      const bool success = initialize_callback(&child_isolate_data, &error);
+      if (!success) {
+        FailedSpawn(error);
+        Dart_ShutdownIsolate();
+        free(error);
+        return;
+      }
+      isolate->set_init_callback_data(child_isolate_data);
     }
-
-    isolate->set_init_callback_data(child_isolate_data);
     Run(isolate);
   }
 
- private:
   void Run(Isolate* child) {
     if (!EnsureIsRunnable(child)) {
       Dart_ShutdownIsolate();
@@ -161,7 +161,9 @@ static ObjectPtr ExecuteMatch(Zone* zone,
   }
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp &&
+      RegExpEngine::TierUpIfHot(Thread::Current(), regexp,
+                                subject.GetClassId(), sticky)) {
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
                                            /*sticky=*/sticky, zone);
   }
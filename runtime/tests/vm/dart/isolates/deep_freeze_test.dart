@@ -0,0 +1,38 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// OtherResources=deep_freeze_test_body.dart
+//
+// This launches deep_freeze_test_body.dart with dart:concurrent enabled if the
+// test runs on the appropriate channel.
+
+import 'dart:io';
+
+import 'package:expect/expect.dart';
+
+import '../use_flag_test_helper.dart';
+
+main() async {
+  if (isAOTRuntime) {
+    return; // dart:concurrent has to be enabled when compiling the snapshot.
+  }
+
+  final testeeScriptPath =
+      Platform.script.resolve('deep_freeze_test_body.dart').toFilePath();
+  final result = await Process.run(Platform.executable, <String>[
+    ...Platform.executableArguments,
+    '--experimental_shared_data',
+    testeeScriptPath,
+  ]);
+  if (Platform.version.contains('(main)') ||
+      Platform.version.contains('(dev)')) {
+    if (result.exitCode != 0) {
+      print('stdout: ${result.stdout}');
+      print('stderr: ${result.stderr}');
+    }
+    Expect.equals(0, result.exitCode);
+  } else {
+    Expect.notEquals(0, result.exitCode);
+  }
+}
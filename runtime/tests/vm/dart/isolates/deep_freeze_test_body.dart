@@ -0,0 +1,161 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// This exercises deepFreeze from dart:concurrent: frozen object graphs are
+// passed by reference to isolates of the same group and cannot be modified.
+
+import 'dart:async';
+import 'dart:concurrent';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+class Point {
+  final int x;
+  final int y;
+  const Point(this.x, this.y);
+}
+
+class Labelled {
+  final String label;
+  final Object? value;
+  Labelled(this.label, this.value);
+}
+
+class Counter {
+  int count = 0;
+}
+
+class LateInit {
+  late final int value;
+}
+
+Future<Object?> roundTrip(Object? object) async {
+  final port = ReceivePort();
+  await Isolate.spawn((SendPort sendPort) {
+    final inner = ReceivePort();
+    sendPort.send(inner.sendPort);
+    inner.listen((message) {
+      sendPort.send(message);
+      inner.close();
+    });
+  }, port.sendPort);
+  final iterator = StreamIterator(port);
+  await iterator.moveNext();
+  (iterator.current as SendPort).send(object);
+  await iterator.moveNext();
+  final result = iterator.current;
+  port.close();
+  return result;
+}
+
+void testCollections() {
+  final list = <Object?>[
+    1,
+    'two',
+    [3.0],
+    {'four': 4},
+    {5},
+    Uint8List.fromList([6]),
+  ];
+  final frozen = deepFreeze(list);
+  Expect.listEquals([1, 'two'], frozen.sublist(0, 2));
+  Expect.listEquals([3.0], frozen[2] as List);
+  Expect.mapEquals({'four': 4}, frozen[3] as Map);
+  Expect.setEquals({5}, frozen[4] as Set);
+  Expect.listEquals([6], frozen[5] as Uint8List);
+
+  Expect.throwsUnsupportedError(() => frozen.add(7));
+  Expect.throwsUnsupportedError(() => frozen[0] = 0);
+  Expect.throwsUnsupportedError(() => (frozen[2] as List)[0] = 0.0);
+  Expect.throwsUnsupportedError(() => (frozen[3] as Map)['five'] = 5);
+  Expect.throwsUnsupportedError(() => (frozen[4] as Set).add(6));
+  Expect.throwsUnsupportedError(() => (frozen[5] as Uint8List)[0] = 0);
+
+  // The original is left untouched.
+  list.add(7);
+  (list[2] as List).add(8.0);
+  Expect.equals(6, frozen.length);
+  Expect.equals(1, (frozen[2] as List).length);
+}
+
+void testMapOrderAndDeletions() {
+  final map = <String, int>{};
+  for (int i = 0; i < 100; i++) {
+    map['$i'] = i;
+  }
+  for (int i = 0; i < 100; i += 3) {
+    map.remove('$i');
+  }
+  final frozen = deepFreeze(map);
+  Expect.listEquals(map.keys.toList(), frozen.keys.toList());
+  Expect.listEquals(map.values.toList(), frozen.values.toList());
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(map['$i'], frozen['$i']);
+  }
+}
+
+void testSharingAndCycles() {
+  final shared = [1, 2, 3];
+  final cyclic = <Object?>[shared, shared];
+  cyclic.add(cyclic);
+  final frozen = deepFreeze(cyclic);
+  Expect.identical(frozen[0], frozen[1]);
+  Expect.identical(frozen, frozen[2]);
+
+  // Freezing a frozen graph is a no-op.
+  Expect.identical(frozen, deepFreeze(frozen));
+}
+
+void testInPlace() {
+  final point = Point(1, 2);
+  Expect.identical(point, deepFreeze(point));
+
+  final record = (1, name: 'record', point: point);
+  Expect.identical(record, deepFreeze(record));
+
+  final frozenList = deepFreeze([1, 2]);
+  final labelled = Labelled('list', frozenList);
+  Expect.identical(labelled, deepFreeze(labelled));
+}
+
+void testUnsupported() {
+  int captured = 0;
+  Expect.throwsArgumentError(() => deepFreeze([() => captured++]));
+  Expect.throwsArgumentError(() => deepFreeze(Counter()));
+  Expect.throwsArgumentError(() => deepFreeze(LateInit()));
+  // Records and instances must only refer to already frozen objects.
+  Expect.throwsArgumentError(() => deepFreeze((1, [2])));
+  Expect.throwsArgumentError(() => deepFreeze(Labelled('list', [1])));
+
+  // Failures deep inside the graph are reported as well.
+  Expect.throwsArgumentError(
+      () => deepFreeze({
+            'nested': [Labelled('counter', Counter())]
+          }));
+}
+
+Future<void> testPassedByReference() async {
+  final table = deepFreeze({
+    for (int i = 0; i < 1000; i++) 'key$i': [i, i + 1],
+  });
+  Expect.identical(table, await roundTrip(table));
+
+  final record = deepFreeze((table, Point(1, 2)));
+  Expect.identical(record, await roundTrip(record));
+
+  // Unfrozen objects are still copied.
+  final list = [1, 2, 3];
+  Expect.notIdentical(list, await roundTrip(list));
+}
+
+main() async {
+  testCollections();
+  testMapOrderAndDeletions();
+  testSharingAndCycles();
+  testInPlace();
+  testUnsupported();
+  await testPassedByReference();
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--isolate-pool-size=2
+// VMOptions=--isolate-pool-size=2 --isolate-pool-idle-timeout-ms=0
+
+// Spawns isolates out of the pool of pre-initialized isolates and ensures
+// pooled isolates don't leak state between spawns and don't keep the group
+// alive once the main isolate exits.
+
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+int counter = 0;
+
+int incrementCounter() => ++counter;
+
+main() async {
+  for (int i = 0; i < 20; ++i) {
+    // Every isolate starts with fresh static state.
+    Expect.equals(1, await Isolate.run(incrementCounter));
+  }
+
+  final results = await Future.wait([
+    for (int i = 0; i < 10; ++i) Isolate.run(() => i * i),
+  ]);
+  Expect.listEquals([for (int i = 0; i < 10; ++i) i * i], results);
+
+  final onExit = ReceivePort();
+  final isolate = await Isolate.spawn((String name) {
+    Expect.equals('named', name);
+  }, 'named', onExit: onExit.sendPort, debugName: 'named');
+  Expect.equals('named', isolate.debugName);
+  await onExit.first;
+
+  Expect.equals(0, counter);
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--port-message-batch-size=16
+// VMOptions=--port-message-batch-size=16 --port-message-batch-window-us=0
+
+// Ensures coalesced SendPort messages are delivered in order, as individual
+// events, with the state they had when they were sent.
+
+import 'dart:async';
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+const int messageCount = 1000;
+
+void producer(List<SendPort> ports) {
+  final [SendPort a, SendPort b] = ports;
+  final list = <int>[];
+  for (int i = 0; i < messageCount; ++i) {
+    list.add(i);
+    a.send(list.sublist(list.length < 3 ? 0 : list.length - 3));
+    a.send(i);
+    // Interleaving another port forces the pending batch out.
+    if (i % 100 == 99) b.send(i);
+  }
+  final mutable = [1, 2, 3];
+  a.send(mutable);
+  mutable[0] = 42;
+  Isolate.exit(a, 'done');
+}
+
+main() async {
+  final a = ReceivePort();
+  final b = ReceivePort();
+  final events = <Object?>[];
+  final done = Completer<void>();
+  int microtasks = 0;
+  a.listen((message) {
+    events.add(message);
+    // Every message is its own event: microtasks scheduled by one handler
+    // run before the next message is delivered.
+    Expect.equals(events.length - 1, microtasks);
+    scheduleMicrotask(() => microtasks++);
+    if (message == 'done') done.complete();
+  });
+  final bEvents = <int>[];
+  b.listen((message) => bEvents.add(message as int));
+
+  await Isolate.spawn(producer, [a.sendPort, b.sendPort]);
+  await done.future;
+
+  Expect.equals(2 * messageCount + 2, events.length);
+  Expect.equals(events.length, microtasks);
+  for (int i = 0; i < messageCount; ++i) {
+    final window = events[2 * i] as List;
+    Expect.equals(i, window.last);
+    Expect.equals(i, events[2 * i + 1]);
+  }
+  Expect.listEquals([1, 2, 3], events[2 * messageCount] as List);
+  Expect.equals('done', events.last);
+  Expect.listEquals(
+      [for (int i = 99; i < messageCount; i += 100) i], bEvents);
+
+  a.close();
+  b.close();
+}
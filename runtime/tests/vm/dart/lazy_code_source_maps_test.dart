@@ -0,0 +1,113 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that AOT snapshots written with --lazy-code-source-maps give the
+// same stack traces, including line numbers and inlined frames, as snapshots
+// with eagerly loaded code source maps.
+
+import 'dart:io';
+
+import 'package:expect/config.dart';
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+@pragma('vm:prefer-inline')
+void throwIfNegative(int x) {
+  if (x < 0) {
+    throw ArgumentError.value(x); // throwIfNegative line
+  }
+}
+
+@pragma('vm:prefer-inline')
+int checkedSquare(int x) {
+  throwIfNegative(x); // checkedSquare line
+  return x * x;
+}
+
+@pragma('vm:never-inline')
+int sumOfSquares(List<int> values) {
+  int sum = 0;
+  for (final value in values) {
+    sum += checkedSquare(value); // sumOfSquares line
+  }
+  return sum;
+}
+
+void child() {
+  print(sumOfSquares([1, 2, 3]));
+  try {
+    sumOfSquares([1, -2]);
+  } catch (e, st) {
+    print(e);
+    print(st);
+  }
+}
+
+Future<void> main(List<String> args) async {
+  if (args.contains('--child')) {
+    child();
+    return;
+  }
+
+  if (!isVmAotConfiguration) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  final script = Platform.script.toFilePath();
+  final source = File(script).readAsLinesSync();
+  int lineOf(String marker) =>
+      source.indexWhere((line) => line.endsWith('// $marker line')) + 1;
+
+  await withTempDir('lazy-code-source-maps', (String tempDir) async {
+    final scriptDill = path.join(tempDir, 'test.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--packages=$sdkDir/.dart_tool/package_config.json',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      script,
+    ]);
+
+    Future<List<String>> compileAndRun(bool lazy) async {
+      final snapshot = path.join(tempDir, lazy ? 'lazy.so' : 'eager.so');
+      await run(genSnapshot, <String>[
+        '--snapshot-kind=app-aot-elf',
+        '--elf=$snapshot',
+        '--${lazy ? '' : 'no-'}lazy-code-source-maps',
+        scriptDill,
+      ]);
+      return await runOutput(dartPrecompiledRuntime, <String>[
+        snapshot,
+        '--child',
+      ]);
+    }
+
+    final eager = await compileAndRun(false);
+    final lazy = await compileAndRun(true);
+    Expect.listEquals(eager, lazy);
+
+    Expect.equals('14', lazy[0]);
+    final fileName = path.basename(script);
+    // The inlined functions have frames of their own.
+    for (final function in [
+      'throwIfNegative',
+      'checkedSquare',
+      'sumOfSquares',
+    ]) {
+      final location = '$fileName:${lineOf(function)}:';
+      Expect.isTrue(
+        lazy.any((line) =>
+            line.contains(' $function (') && line.contains(location)),
+        'Missing frame of $function at $location in:\n${lazy.join('\n')}',
+      );
+    }
+  });
+}
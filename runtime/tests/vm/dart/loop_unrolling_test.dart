@@ -0,0 +1,103 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation --no-loop-unrolling
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation --loop-unrolling-factor=3
+
+// Checks that fully and partially unrolled loops compute the same results as
+// the original loops, including when deoptimizing in the middle of them.
+
+import 'package:expect/expect.dart';
+
+// Constant trip count: fully unrolled.
+@pragma('vm:never-inline')
+int constantTripCount(List<int> list) {
+  int sum = 0;
+  for (int i = 0; i < 10; i++) {
+    sum += list[i] * i;
+  }
+  return sum;
+}
+
+// Unknown trip count: partially unrolled.
+@pragma('vm:never-inline')
+int sumRange(int start, int end) {
+  int sum = 0;
+  for (int i = start; i < end; i++) {
+    sum += i;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int sumDownwards(int start, int step) {
+  int sum = 0;
+  for (int i = start; i > 0; i -= step) {
+    sum += i;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+void fill(List<int> list, int n, int value) {
+  for (int i = 0; i < n; i++) {
+    list[i] = value + i;
+  }
+}
+
+// Deoptimizes when [list] contains something other than an int.
+@pragma('vm:never-inline')
+num sumNums(List<num> list, int n) {
+  num sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += list[i];
+  }
+  return sum;
+}
+
+void test() {
+  final list = List<int>.generate(10, (i) => i + 1);
+  Expect.equals(330, constantTripCount(list));
+
+  for (int start = -3; start < 3; start++) {
+    for (int end = -3; end < 20; end++) {
+      final int n = end > start ? end - start : 0;
+      Expect.equals(n * (start + end - 1) ~/ 2, sumRange(start, end));
+    }
+  }
+  // Loops whose bounds are close to the int64 limits (the sum wraps around).
+  const int max = 0x7FFFFFFFFFFFFFFF;
+  Expect.equals(5 * max - 15, sumRange(max - 5, max));
+
+  Expect.equals(55, sumDownwards(10, 1));
+  Expect.equals(30, sumDownwards(10, 2));
+  Expect.equals(22, sumDownwards(10, 3));
+  Expect.equals(0, sumDownwards(0, 1));
+
+  for (int n = 0; n <= 10; n++) {
+    final filled = List<int>.filled(10, -1);
+    fill(filled, n, 100);
+    for (int i = 0; i < 10; i++) {
+      Expect.equals(i < n ? 100 + i : -1, filled[i]);
+    }
+  }
+  Expect.throws<RangeError>(() => fill(List<int>.filled(5, 0), 6, 0));
+}
+
+void main() {
+  for (int i = 0; i < 50; i++) {
+    test();
+  }
+
+  final nums = List<num>.generate(9, (i) => i);
+  for (int i = 0; i < 50; i++) {
+    Expect.equals(36, sumNums(nums, 9));
+  }
+  // Deoptimize in the middle of the loop: the double is added in the sixth
+  // iteration, after five ints have been summed.
+  nums[5] = 0.5;
+  Expect.equals(31.5, sumNums(nums, 9));
+  Expect.equals(10.5, sumNums(nums, 6));
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation --no-loop-vectorization
+
+// Checks that vectorized typed data loops compute the same results as the
+// scalar loops over regular lists they are compared against, for trip counts
+// smaller than the vector width, with remainder iterations, when arrays alias
+// and when the loop goes out of bounds.
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+@pragma('vm:never-inline')
+void daxpy(double a, Float64List x, Float64List y, int n) {
+  for (int i = 0; i < n; i++) {
+    y[i] = a * x[i] + y[i];
+  }
+}
+
+@pragma('vm:never-inline')
+void negate(Float64List x, Float64List y, int n) {
+  for (int i = 0; i < n; i++) {
+    y[i] = -x[i];
+  }
+}
+
+@pragma('vm:never-inline')
+void add32(Float32List x, Float32List y, Float32List z, int n) {
+  for (int i = 0; i < n; i++) {
+    z[i] = x[i] + y[i];
+  }
+}
+
+@pragma('vm:never-inline')
+void fill32(Float32List x, int n) {
+  for (int i = 0; i < n; i++) {
+    x[i] = 1.5;
+  }
+}
+
+@pragma('vm:never-inline')
+void copyBytes(Uint8List src, Uint8List dst, int n) {
+  for (int i = 0; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+@pragma('vm:never-inline')
+void xorBytes(Uint8List x, Uint8List y, int n) {
+  for (int i = 0; i < n; i++) {
+    y[i] = x[i] ^ 0x5A;
+  }
+}
+
+@pragma('vm:never-inline')
+void addInt32(Int32List x, Int32List y, Int32List z, int n) {
+  for (int i = 0; i < n; i++) {
+    z[i] = x[i] + y[i];
+  }
+}
+
+final Float32List _float32 = Float32List(1);
+
+double toFloat32(double value) {
+  _float32[0] = value;
+  return _float32[0];
+}
+
+// Runs [kernel] on typed data and [reference] on regular lists and checks
+// that both either complete or throw a RangeError.
+void expectSame(void Function() kernel, void Function() reference) {
+  bool kernelThrew = false;
+  bool referenceThrew = false;
+  try {
+    kernel();
+  } on RangeError {
+    kernelThrew = true;
+  }
+  try {
+    reference();
+  } on RangeError {
+    referenceThrew = true;
+  }
+  Expect.equals(referenceThrew, kernelThrew);
+}
+
+Float64List float64s(int length, double seed) =>
+    Float64List.fromList([for (int i = 0; i < length; i++) seed * i - 3.75]);
+
+Float32List float32s(int length, double seed) => Float32List.fromList(
+    [for (int i = 0; i < length; i++) toFloat32(seed * i - 3.75)]);
+
+Uint8List bytes(int length, int seed) =>
+    Uint8List.fromList([for (int i = 0; i < length; i++) (seed * i) & 0xFF]);
+
+Int32List int32s(int length, int seed) => Int32List.fromList(
+    [for (int i = 0; i < length; i++) (0x7FFFFFF0 + seed * i).toSigned(32)]);
+
+void testFloat64(int length, int n) {
+  final x = float64s(length, 0.75);
+  final y = float64s(length, -1.25);
+  final ex = x.toList(), ey = y.toList();
+  expectSame(() => daxpy(2.5, x, y, n), () {
+    for (int i = 0; i < n; i++) {
+      ey[i] = 2.5 * ex[i] + ey[i];
+    }
+  });
+  Expect.listEquals(ey, y);
+
+  final z = Float64List(length);
+  final ez = z.toList();
+  expectSame(() => negate(x, z, n), () {
+    for (int i = 0; i < n; i++) {
+      ez[i] = -ex[i];
+    }
+  });
+  Expect.listEquals(ez, z);
+
+  // Views of the same buffer, shifted by one element.
+  final buffer = float64s(length + 1, 0.5);
+  final eb = buffer.toList();
+  expectSame(
+      () => daxpy(2.0, Float64List.sublistView(buffer, 0, length),
+          Float64List.sublistView(buffer, 1), n), () {
+    for (int i = 0; i < n; i++) {
+      eb[i + 1] = 2.0 * eb[i] + eb[i + 1];
+    }
+  });
+  Expect.listEquals(eb, buffer);
+}
+
+void testFloat32(int length, int n) {
+  final x = float32s(length, 0.75);
+  final y = float32s(length, -1.25);
+  final z = Float32List(length);
+  final ex = x.toList(), ey = y.toList(), ez = z.toList();
+  expectSame(() => add32(x, y, z, n), () {
+    for (int i = 0; i < n; i++) {
+      ez[i] = toFloat32(ex[i] + ey[i]);
+    }
+  });
+  Expect.listEquals(ez, z);
+
+  // The output is also an input.
+  expectSame(() => add32(x, y, x, n), () {
+    for (int i = 0; i < n; i++) {
+      ex[i] = toFloat32(ex[i] + ey[i]);
+    }
+  });
+  Expect.listEquals(ex, x);
+
+  expectSame(() => fill32(y, n), () {
+    for (int i = 0; i < n; i++) {
+      ey[i] = 1.5;
+    }
+  });
+  Expect.listEquals(ey, y);
+}
+
+void testIntegers(int length, int n) {
+  final src = bytes(length, 37);
+  final dst = Uint8List(length);
+  final esrc = src.toList(), edst = dst.toList();
+  expectSame(() => copyBytes(src, dst, n), () {
+    for (int i = 0; i < n; i++) {
+      edst[i] = esrc[i];
+    }
+  });
+  Expect.listEquals(edst, dst);
+
+  expectSame(() => xorBytes(src, dst, n), () {
+    for (int i = 0; i < n; i++) {
+      edst[i] = esrc[i] ^ 0x5A;
+    }
+  });
+  Expect.listEquals(edst, dst);
+
+  // Overlapping views: every element is copied from the previous one.
+  final buffer = bytes(length + 1, 11);
+  final eb = buffer.toList();
+  expectSame(
+      () => copyBytes(Uint8List.sublistView(buffer, 0, length),
+          Uint8List.sublistView(buffer, 1), n), () {
+    for (int i = 0; i < n; i++) {
+      eb[i + 1] = eb[i];
+    }
+  });
+  Expect.listEquals(eb, buffer);
+
+  // Sums overflow and wrap around.
+  final x = int32s(length, 3);
+  final y = int32s(length, -7);
+  final z = Int32List(length);
+  final ex = x.toList(), ey = y.toList(), ez = z.toList();
+  expectSame(() => addInt32(x, y, z, n), () {
+    for (int i = 0; i < n; i++) {
+      ez[i] = (ex[i] + ey[i]).toSigned(32);
+    }
+  });
+  Expect.listEquals(ez, z);
+}
+
+void main() {
+  for (int iteration = 0; iteration < 20; iteration++) {
+    // Trip counts below, at and above the vector widths, with and without
+    // remainder iterations, and beyond the end of the arrays.
+    for (int length = 0; length <= 19; length++) {
+      for (int n = 0; n <= length + 2; n++) {
+        testFloat64(length, n);
+        testFloat32(length, n);
+        testIntegers(length, n);
+      }
+    }
+  }
+}
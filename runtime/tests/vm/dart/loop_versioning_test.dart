@@ -0,0 +1,105 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation --no-loop-versioning
+
+// Checks that loops versioned to hoist bounds checks behave like the original
+// loops both when the guards pass and when they fail: out of bounds accesses
+// throw at the same iteration, after the same side effects.
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+@pragma('vm:never-inline')
+void copyRange(List<int> src, List<int> dst, int start, int end) {
+  for (int i = start; i < end; i++) {
+    dst[i] = src[i] + 1;
+  }
+}
+
+// The index computed in the loop is used after it.
+@pragma('vm:never-inline')
+int sumRange(Uint8List bytes, int start, int end) {
+  int sum = 0;
+  int i = start;
+  for (; i < end; i++) {
+    sum += bytes[i];
+  }
+  return sum * 1000 + i;
+}
+
+@pragma('vm:never-inline')
+void shiftLeft(Int32List list, int end) {
+  for (int i = 0; i < end; i++) {
+    list[i] = list[i + 1];
+  }
+}
+
+void testCopyRange(int srcLength, int dstLength, int start, int end) {
+  final src = List<int>.generate(srcLength, (i) => i * 3);
+  final dst = List<int>.filled(dstLength, -1);
+  final expected = List<int>.filled(dstLength, -1);
+  bool expectThrows = false;
+  for (int i = start; i < end; i++) {
+    if (i < 0 || i >= srcLength || i >= dstLength) {
+      expectThrows = true;
+      break;
+    }
+    expected[i] = src[i] + 1;
+  }
+  if (expectThrows) {
+    Expect.throws<RangeError>(() => copyRange(src, dst, start, end));
+  } else {
+    copyRange(src, dst, start, end);
+  }
+  Expect.listEquals(expected, dst);
+}
+
+void testSumRange(int length, int start, int end) {
+  final bytes = Uint8List.fromList([for (int i = 0; i < length; i++) i + 1]);
+  int sum = 0;
+  int i = start;
+  for (; i < end; i++) {
+    if (i < 0 || i >= length) {
+      Expect.throws<RangeError>(() => sumRange(bytes, start, end));
+      return;
+    }
+    sum += i + 1;
+  }
+  Expect.equals(sum * 1000 + i, sumRange(bytes, start, end));
+}
+
+void testShiftLeft(int length, int end) {
+  final list = Int32List.fromList([for (int i = 0; i < length; i++) i * 7]);
+  final expected = list.toList();
+  for (int i = 0; i < end; i++) {
+    if (i + 1 >= length) {
+      Expect.throws<RangeError>(() => shiftLeft(list, end));
+      Expect.listEquals(expected, list);
+      return;
+    }
+    expected[i] = expected[i + 1];
+  }
+  shiftLeft(list, end);
+  Expect.listEquals(expected, list);
+}
+
+void main() {
+  for (int iteration = 0; iteration < 20; iteration++) {
+    for (int start = -2; start <= 4; start++) {
+      for (int end = -1; end <= 12; end++) {
+        testCopyRange(10, 10, start, end);
+        // The guard on the shorter list fails first.
+        testCopyRange(10, 6, start, end);
+        testCopyRange(6, 10, start, end);
+        testSumRange(10, start, end);
+      }
+    }
+    for (int end = -1; end <= 12; end++) {
+      testShiftLeft(10, end);
+    }
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that the AOT snapshot compiled with --precompiler-threads does not
+// depend on the number of helper threads or their timing, e.g. because
+// inlining heuristics are updated while functions are compiled in parallel.
+
+import 'dart:io';
+
+import 'package:expect/config.dart';
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'gc/splay_test.dart';
+import 'use_flag_test_helper.dart';
+
+Future<void> main(List<String> args) async {
+  if (args.contains('--child')) {
+    final splay = StrongSplay();
+    splay.setup();
+    splay.exercise();
+    splay.tearDown();
+    return;
+  }
+
+  if (!isVmAotConfiguration) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('precompiler-threads-determinism', (String tempDir) async {
+    final scriptDill = path.join(tempDir, 'test.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--packages=$sdkDir/.dart_tool/package_config.json',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      Platform.script.toFilePath(),
+    ]);
+
+    int count = 0;
+    Future<List<int>> compile(int threads) async {
+      final snapshot = path.join(tempDir, 'snapshot${count++}.so');
+      await run(genSnapshot, <String>[
+        '--snapshot-kind=app-aot-elf',
+        '--elf=$snapshot',
+        '--precompiler-threads=$threads',
+        scriptDill,
+      ]);
+      return File(snapshot).readAsBytesSync();
+    }
+
+    final oneThread = await compile(1);
+    Expect.listEquals(oneThread, await compile(4));
+    Expect.listEquals(oneThread, await compile(4));
+  });
+}
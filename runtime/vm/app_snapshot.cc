@@ -22,6 +22,7 @@
 #include "vm/growable_array.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/json_writer.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
@@ -29,6 +30,7 @@
 #include "vm/raw_object_fields.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/v8_snapshot_writer.h"
 #include "vm/version.h"
@@ -59,11 +61,30 @@ DEFINE_FLAG(bool,
             false,
             "Print information about how many array are candidates for Smi and "
             "ROData optimizations.");
+DEFINE_FLAG(bool,
+            lazy_code_source_maps,
+            false,
+            "Leave the code source maps of AOT snapshots in read-only data and "
+            "only copy them into the heap when they are first used. Has no "
+            "effect without compressed pointers, where they are always read-"
+            "only heap objects.");
 #endif  // defined(DART_PRECOMPILER)
 
+DEFINE_FLAG(int,
+            snapshot_fill_tasks,
+            4,
+            "Maximum number of helper threads initializing the objects of a "
+            "snapshot while it is read. 0 reads snapshots on one thread.");
+DEFINE_FLAG(charp,
+            snapshot_load_profile,
+            nullptr,
+            "Write the size, object count and load time of each cluster of "
+            "the snapshots read by the VM as JSON to the given file.");
+
 // Forward declarations.
 class Serializer;
 class Deserializer;
+class SnapshotLoadProfile;
 
 namespace {
 
@@ -233,6 +254,12 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill may run on a helper thread, concurrently with the fills
+  // of other clusters. It then must only use Deserializer::Local and the
+  // static Deserializer::InitializeHeader: the deserializer passed to it has
+  // no thread, zone or image reader.
+  virtual bool CanFillConcurrently() const { return false; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(Deserializer* deserializer, const Array& refs) {
@@ -523,6 +550,13 @@ class Serializer : public ThreadStackResource {
   void TraceDataOffset(uint32_t offset);
   intptr_t GetDataSize() const;
 
+  // Whether code source maps are written to the read-only data image rather
+  // than as heap objects. See Code::code_source_map.
+  bool LazyCodeSourceMaps() const;
+  // Writes the contents of [map] to the data image, once, and returns their
+  // offset in it.
+  uint32_t GetLazyCodeSourceMapOffset(CodeSourceMapPtr map);
+
   void WriteDispatchTable(const Array& entries);
 
   Heap* heap() const { return heap_; }
@@ -637,6 +671,7 @@ class Serializer : public ThreadStackResource {
 #if defined(DART_PRECOMPILER)
   IntMap<intptr_t> deduped_instructions_sources_;
   IntMap<intptr_t> code_index_;
+  IntMap<intptr_t> lazy_code_source_map_offsets_;
 #endif
 
   intptr_t current_loading_unit_id_ = 0;
@@ -854,6 +889,15 @@ class Deserializer : public ThreadStackResource {
   };
 
  private:
+  // Creates a deserializer for the fill section of [parent]'s snapshot at
+  // [position], to be used by a helper thread. See FillConcurrently.
+  Deserializer(const Deserializer& parent, intptr_t position);
+
+  // Fills the clusters which can be filled concurrently on helper threads,
+  // and the others in order on this thread. The fill section of cluster i
+  // starts at [fill_positions][i]; the last entry is the end of the fills.
+  void FillConcurrently(const intptr_t* fill_positions);
+
   Heap* heap_;
   PageSpace* old_space_;
   FreeList* freelist_;
@@ -872,6 +916,10 @@ class Deserializer : public ThreadStackResource {
   DeserializationCluster** clusters_;
   const bool is_non_root_unit_;
   InstructionsTable& instructions_table_;
+  // Only set while a snapshot is read with a load profile.
+  SnapshotLoadProfile* load_profile_ = nullptr;
+
+  friend class ConcurrentFillQueue;
 };
 
 DART_FORCE_INLINE
@@ -1481,6 +1529,8 @@ class TypeParametersDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, TypeParameters::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -1577,6 +1627,8 @@ class TypeArgumentsDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -1665,6 +1717,8 @@ class PatchClassDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, PatchClass::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2045,6 +2099,8 @@ class ClosureDataDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, ClosureData::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2116,6 +2172,8 @@ class FfiTrampolineDataDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, FfiTrampolineData::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2227,6 +2285,8 @@ class FieldDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, Field::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2368,6 +2428,8 @@ class ScriptDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, Script::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2440,6 +2502,8 @@ class LibraryDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, Library::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2511,6 +2575,8 @@ class NamespaceDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, Namespace::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2575,6 +2641,8 @@ class KernelProgramInfoDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, KernelProgramInfo::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -2682,7 +2750,8 @@ class CodeSerializationCluster : public SerializationCluster {
     s->Push(code->untag()->catch_entry_);
     if (!FLAG_precompiled_mode || !FLAG_dwarf_stack_traces_mode) {
       s->Push(code->untag()->inlined_id_to_function_);
-      if (s->InCurrentLoadingUnitOrRoot(code->untag()->code_source_map_)) {
+      if (s->InCurrentLoadingUnitOrRoot(code->untag()->code_source_map_) &&
+          !s->LazyCodeSourceMaps()) {
         s->Push(code->untag()->code_source_map_);
       }
     }
@@ -2724,6 +2793,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t is_cold;        // 1 if this code is cold and 0 otherwise.
     intptr_t instructions_id;
   };
 
@@ -2733,6 +2803,9 @@ class CodeSerializationCluster : public SerializationCluster {
   // the code section. InstructionsTable encoding assumes that all
   // instructions with non-discarded Code objects are grouped at the end.
   //
+  // Within each of these groups cold code comes last, so that code which is
+  // unlikely to run does not share cache lines and pages with hot code.
+  //
   // Note that in AOT mode we expect that all Code objects pointing to
   // the same instructions are deduplicated, as in bare instructions mode
   // there is no way to identify which specific Code object (out of those
@@ -2742,6 +2815,8 @@ class CodeSerializationCluster : public SerializationCluster {
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->is_cold < b->is_cold) return -1;
+    if (a->is_cold > b->is_cold) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2768,6 +2843,7 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.is_cold = Code::IsCold(code) ? 1 : 0;
     order_list->Add(info);
   }
 
@@ -2813,6 +2889,7 @@ class CodeSerializationCluster : public SerializationCluster {
     ASSERT(count == non_discarded_count || (s->kind() == Snapshot::kFullAOT));
 
     first_ref_ = s->next_ref_index();
+    s->Write<bool>(s->LazyCodeSourceMaps());
     s->WriteUnsigned(non_discarded_count);
     for (auto code : objects_) {
       if (!Code::IsDiscarded(code)) {
@@ -2953,13 +3030,13 @@ class CodeSerializationCluster : public SerializationCluster {
     }
     if (FLAG_precompiled_mode && FLAG_dwarf_stack_traces_mode) {
       WriteFieldValue(inlined_id_to_function_, Array::null());
-      WriteFieldValue(code_source_map_, CodeSourceMap::null());
+      WriteCodeSourceMap(s, CodeSourceMap::null());
     } else {
       WriteField(code, inlined_id_to_function_);
       if (s->InCurrentLoadingUnitOrRoot(code->untag()->code_source_map_)) {
-        WriteField(code, code_source_map_);
+        WriteCodeSourceMap(s, code->untag()->code_source_map_);
       } else {
-        WriteFieldValue(code_source_map_, CodeSourceMap::null());
+        WriteCodeSourceMap(s, CodeSourceMap::null());
       }
     }
     if (kind == Snapshot::kFullJIT) {
@@ -2975,6 +3052,19 @@ class CodeSerializationCluster : public SerializationCluster {
 #endif
   }
 
+  // Lazy code source maps are written as their offset in the data image in
+  // units of the object alignment, or 0 for null.
+  void WriteCodeSourceMap(Serializer* s, CodeSourceMapPtr map) {
+    if (!s->LazyCodeSourceMaps()) {
+      WriteFieldValue(code_source_map_, map);
+    } else if (map == CodeSourceMap::null()) {
+      s->WriteUnsigned(0);
+    } else {
+      s->WriteUnsigned(s->GetLazyCodeSourceMapOffset(map) >>
+                       compiler::target::ObjectAlignment::kObjectAlignmentLog2);
+    }
+  }
+
   GrowableArray<CodePtr>* objects() { return &objects_; }
   GrowableArray<CodePtr>* deferred_objects() { return &deferred_objects_; }
 
@@ -3013,6 +3103,7 @@ class CodeDeserializationCluster : public DeserializationCluster {
   void ReadAlloc(Deserializer* d) override {
     start_index_ = d->next_index();
     d->set_code_start_index(start_index_);
+    lazy_code_source_maps_ = d->Read<bool>();
     const intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
       ReadAllocOneCode(d);
@@ -3083,8 +3174,17 @@ class CodeDeserializationCluster : public DeserializationCluster {
 #endif
       code->untag()->inlined_id_to_function_ =
           static_cast<ArrayPtr>(d->ReadRef());
-      code->untag()->code_source_map_ =
-          static_cast<CodeSourceMapPtr>(d->ReadRef());
+      if (lazy_code_source_maps_) {
+        // Loaded on first use, see Code::code_source_map.
+        const intptr_t offset = d->ReadUnsigned();
+        code->untag()->code_source_map_ =
+            (offset == 0) ? CodeSourceMap::null()
+                          : static_cast<CodeSourceMapPtr>(
+                                static_cast<ObjectPtr>(Smi::New(offset)));
+      } else {
+        code->untag()->code_source_map_ =
+            static_cast<CodeSourceMapPtr>(d->ReadRef());
+      }
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
       ASSERT(d->kind() == Snapshot::kFullJIT);
@@ -3140,6 +3240,7 @@ class CodeDeserializationCluster : public DeserializationCluster {
  private:
   intptr_t deferred_start_index_;
   intptr_t deferred_stop_index_;
+  bool lazy_code_source_maps_ = false;
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -3435,6 +3536,8 @@ class PcDescriptorsDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3510,6 +3613,8 @@ class CodeSourceMapDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3588,6 +3693,8 @@ class CompressedStackMapsDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3803,6 +3910,8 @@ class ExceptionHandlersDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3895,6 +4004,8 @@ class ContextDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3975,6 +4086,8 @@ class ContextScopeDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4040,6 +4153,8 @@ class UnlinkedCallDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, UnlinkedCall::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4106,6 +4221,8 @@ class ICDataDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, ICData::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4170,6 +4287,8 @@ class MegamorphicCacheDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, MegamorphicCache::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4235,6 +4354,8 @@ class SubtypeTestCacheDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, SubtypeTestCache::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4299,6 +4420,8 @@ class LoadingUnitDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, LoadingUnit::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4369,6 +4492,8 @@ class LanguageErrorDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, LanguageError::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4434,6 +4559,8 @@ class UnhandledExceptionDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, UnhandledException::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4608,6 +4735,8 @@ class InstanceDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4705,6 +4834,8 @@ class LibraryPrefixDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, LibraryPrefix::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4818,6 +4949,8 @@ class TypeDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4932,6 +5065,8 @@ class FunctionTypeDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5045,6 +5180,8 @@ class RecordTypeDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5159,6 +5296,8 @@ class TypeParameterDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5260,6 +5399,8 @@ class ClosureDeserializationCluster
     ReadAllocFixedSize(d, Closure::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5424,6 +5565,8 @@ class DoubleDeserializationCluster
     ReadAllocFixedSize(d, Double::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
     const bool mark_canonical = is_root_unit_ && is_canonical();
@@ -5497,6 +5640,8 @@ class Simd128DeserializationCluster
     ReadAllocFixedSize(d, Int32x4::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
     const intptr_t cid = cid_;
@@ -5564,6 +5709,8 @@ class GrowableObjectArrayDeserializationCluster
     ReadAllocFixedSize(d, GrowableObjectArray::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5645,6 +5792,8 @@ class RecordDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5726,6 +5875,8 @@ class TypedDataDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5799,6 +5950,8 @@ class TypedDataViewDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, TypedDataView::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5876,6 +6029,8 @@ class ExternalTypedDataDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, ExternalTypedData::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6059,6 +6214,8 @@ class StackTraceDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, StackTrace::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6122,6 +6279,8 @@ class RegExpDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, RegExp::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6134,6 +6293,7 @@ class RegExpDeserializationCluster : public DeserializationCluster {
       regexp->untag()->num_one_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->num_two_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->type_flags_ = d.Read<int8_t>();
+      regexp->untag()->num_executions_ = 0;
     }
   }
 };
@@ -6203,6 +6363,8 @@ class WeakPropertyDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, WeakProperty::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6275,6 +6437,8 @@ class MapDeserializationCluster
     ReadAllocFixedSize(d, Map::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6350,6 +6514,8 @@ class SetDeserializationCluster
     ReadAllocFixedSize(d, Set::InstanceSize());
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6496,6 +6662,8 @@ class ArrayDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6589,6 +6757,8 @@ class WeakArrayDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6709,6 +6879,8 @@ class StringDeserializationCluster
     BuildCanonicalSetFromLayout(d);
   }
 
+  bool CanFillConcurrently() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6743,12 +6915,10 @@ class StringDeserializationCluster
 #endif
       str->untag()->length_ = Smi::New(length);
 
-      StringHasher hasher;
       if (cid == kOneByteStringCid) {
         for (intptr_t j = 0; j < length; j++) {
           uint8_t code_unit = d.Read<uint8_t>();
           static_cast<OneByteStringPtr>(str)->untag()->data()[j] = code_unit;
-          hasher.Add(code_unit);
         }
 
       } else {
@@ -6756,10 +6926,10 @@ class StringDeserializationCluster
           uint16_t code_unit = d.Read<uint8_t>();
           code_unit = code_unit | (d.Read<uint8_t>() << 8);
           static_cast<TwoByteStringPtr>(str)->untag()->data()[j] = code_unit;
-          hasher.Add(code_unit);
         }
       }
-      String::SetCachedHash(str, hasher.Finalize());
+      // Hash the copied code units in blocks rather than one at a time.
+      String::SetCachedHash(str, String::Hash(str));
     }
   }
 
@@ -8386,6 +8556,39 @@ intptr_t Serializer::GetDataSize() const {
   }
   return image_writer_->data_size();
 }
+
+bool Serializer::LazyCodeSourceMaps() const {
+#if defined(DART_PRECOMPILER) && defined(DART_COMPRESSED_POINTERS)
+  return FLAG_lazy_code_source_maps && (kind_ == Snapshot::kFullAOT) && !vm_ &&
+         (current_loading_unit_id_ <= LoadingUnit::kRootId);
+#else
+  return false;
+#endif
+}
+
+uint32_t Serializer::GetLazyCodeSourceMapOffset(CodeSourceMapPtr map) {
+#if defined(DART_PRECOMPILER)
+  ASSERT(LazyCodeSourceMaps());
+  const intptr_t key = static_cast<intptr_t>(map);
+  intptr_t offset = lazy_code_source_map_offsets_.Lookup(key);
+  if (offset == 0) {
+    // The length followed by the contents, see Code::LoadCodeSourceMap.
+    const uint32_t length = map->untag()->length_;
+    const intptr_t size = sizeof(length) + length;
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(malloc(size));
+    memcpy(bytes, &length, sizeof(length));
+    memcpy(bytes + sizeof(length), map->untag()->data(), length);
+    offset = image_writer_->AddBytesToData(bytes, size);
+    ASSERT(offset != 0);
+    lazy_code_source_map_offsets_.Insert(key, offset);
+  }
+  TraceDataOffset(offset);
+  return offset;
+#else
+  UNREACHABLE();
+  return 0;
+#endif
+}
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
 void Serializer::Push(ObjectPtr object, intptr_t cid_override) {
@@ -8708,13 +8911,35 @@ ZoneGrowableArray<Object*>* Serializer::Serialize(SerializationRoots* roots) {
   }
 #endif
 
+  // Record where the fill section of each cluster starts, so the
+  // deserializer can fill clusters concurrently. The offsets are relative to
+  // the start of the first fill section and written once they are known.
+  const intptr_t fill_offsets_position = bytes_written();
+  for (intptr_t i = 0; i <= clusters.length(); i++) {
+    stream_->WriteFixed<uint32_t>(0);
+  }
+  const intptr_t fill_start = bytes_written();
+  GrowableArray<intptr_t> fill_offsets(clusters.length() + 1);
+
   for (SerializationCluster* cluster : clusters) {
+    fill_offsets.Add(bytes_written() - fill_start);
     cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
     Write<int32_t>(kSectionMarker);
 #endif
   }
 
+  const intptr_t fill_end = bytes_written();
+  fill_offsets.Add(fill_end - fill_start);
+  if (!Utils::IsUint(32, fill_end - fill_start)) {
+    FATAL("Snapshot fill sections too large");
+  }
+  stream_->SetPosition(fill_offsets_position);
+  for (intptr_t offset : fill_offsets) {
+    stream_->WriteFixed<uint32_t>(offset);
+  }
+  stream_->SetPosition(fill_end);
+
   roots->WriteRoots(this);
 
 #if defined(DEBUG)
@@ -8976,6 +9201,27 @@ Deserializer::Deserializer(Thread* thread,
   stream_.SetPosition(offset);
 }
 
+Deserializer::Deserializer(const Deserializer& parent, intptr_t position)
+    : ThreadStackResource(nullptr),
+      heap_(parent.heap_),
+      old_space_(parent.old_space_),
+      freelist_(parent.freelist_),
+      zone_(nullptr),
+      kind_(parent.kind_),
+      stream_(parent.stream_.buffer_,
+              parent.stream_.end_ - parent.stream_.buffer_),
+      image_reader_(nullptr),
+      num_base_objects_(parent.num_base_objects_),
+      num_objects_(parent.num_objects_),
+      num_clusters_(parent.num_clusters_),
+      refs_(parent.refs_),
+      next_ref_index_(parent.next_ref_index_),
+      clusters_(nullptr),
+      is_non_root_unit_(parent.is_non_root_unit_),
+      instructions_table_(parent.instructions_table_) {
+  stream_.SetPosition(position);
+}
+
 Deserializer::~Deserializer() {
   delete[] clusters_;
 }
@@ -9513,6 +9759,427 @@ class HeapLocker : public StackResource {
   FreeList* freelist_;
 };
 
+// The sizes and load times of the clusters of a snapshot. Recorded when
+// --snapshot-load-profile is given or the isolate timeline stream is
+// enabled, and reported as one timeline event per cluster and phase and as
+// an entry of the JSON report once the snapshot is loaded.
+class SnapshotLoadProfile : public ZoneAllocated {
+ public:
+  SnapshotLoadProfile(Zone* zone, intptr_t num_clusters)
+      : num_clusters_(num_clusters),
+        entries_(zone->Alloc<Entry>(num_clusters)),
+        start_micros_(OS::GetCurrentMonotonicMicros()) {
+    for (intptr_t i = 0; i < num_clusters; i++) {
+      entries_[i] = Entry();
+    }
+  }
+
+  static void Init();
+  static void Cleanup();
+
+  static bool IsEnabled() {
+    if (FLAG_snapshot_load_profile != nullptr) {
+      return true;
+    }
+#if defined(SUPPORT_TIMELINE)
+    return Timeline::GetIsolateStream()->enabled();
+#else
+    return false;
+#endif
+  }
+
+  void BeginAlloc(intptr_t i, const Deserializer* d) {
+    Entry* entry = &entries_[i];
+    entry->start_index = d->next_index();
+    entry->alloc_size = d->position();
+    entry->alloc_start = OS::GetCurrentMonotonicMicros();
+  }
+
+  void EndAlloc(intptr_t i,
+                const Deserializer* d,
+                const DeserializationCluster* cluster) {
+    Entry* entry = &entries_[i];
+    entry->alloc_end = OS::GetCurrentMonotonicMicros();
+    entry->name = cluster->name();
+    entry->is_canonical = cluster->is_canonical();
+    entry->num_objects = d->next_index() - entry->start_index;
+    entry->alloc_size = d->position() - entry->alloc_size;
+  }
+
+  // May be called from the helper threads filling clusters concurrently.
+  void RecordFill(intptr_t i,
+                  intptr_t size,
+                  int64_t start,
+                  int64_t end,
+                  bool concurrent) {
+    Entry* entry = &entries_[i];
+    entry->fill_size = size;
+    entry->fill_start = start;
+    entry->fill_end = end;
+    entry->filled_concurrently = concurrent;
+  }
+
+  // Runs the PostLoad of cluster [i], counting the objects it replaces with
+  // existing canonical objects.
+  void PostLoad(intptr_t i,
+                DeserializationCluster* cluster,
+                Deserializer* d,
+                const Array& refs) {
+    Entry* entry = &entries_[i];
+    Array& before = Array::Handle(d->zone());
+    if (entry->is_canonical) {
+      Object& object = Object::Handle(d->zone());
+      before = Array::New(entry->num_objects);
+      for (intptr_t j = 0; j < entry->num_objects; j++) {
+        object = refs.At(entry->start_index + j);
+        before.SetAt(j, object);
+      }
+    }
+    entry->post_load_start = OS::GetCurrentMonotonicMicros();
+    cluster->PostLoad(d, refs);
+    entry->post_load_end = OS::GetCurrentMonotonicMicros();
+    if (entry->is_canonical) {
+      for (intptr_t j = 0; j < entry->num_objects; j++) {
+        if (before.At(j) != refs.At(entry->start_index + j)) {
+          entry->canonicalized++;
+        }
+      }
+    }
+  }
+
+  // Reports the profile of the snapshot [name] of [isolate_group].
+  void Report(IsolateGroup* isolate_group, const char* name);
+
+ private:
+  struct Entry {
+    const char* name = nullptr;
+    bool is_canonical = false;
+    bool filled_concurrently = false;
+    intptr_t start_index = 0;
+    intptr_t num_objects = 0;
+    intptr_t alloc_size = 0;
+    intptr_t fill_size = 0;
+    int64_t alloc_start = 0;
+    int64_t alloc_end = 0;
+    int64_t fill_start = 0;
+    int64_t fill_end = 0;
+    int64_t post_load_start = 0;
+    int64_t post_load_end = 0;
+    intptr_t canonicalized = 0;
+  };
+
+  void AddTimelineEvents();
+  void WriteReport(IsolateGroup* isolate_group,
+                   const char* name,
+                   int64_t end_micros);
+
+  const intptr_t num_clusters_;
+  Entry* const entries_;
+  const int64_t start_micros_;
+
+  // Guards report_, the comma separated JSON objects of all snapshots
+  // profiled so far, which are rewritten to the report file each time.
+  static Mutex* report_mutex_;
+  static char* report_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotLoadProfile);
+};
+
+Mutex* SnapshotLoadProfile::report_mutex_ = nullptr;
+char* SnapshotLoadProfile::report_ = nullptr;
+
+void SnapshotLoadProfile::Init() {
+  ASSERT(report_mutex_ == nullptr);
+  report_mutex_ = new Mutex();
+}
+
+void SnapshotLoadProfile::Cleanup() {
+  delete report_mutex_;
+  report_mutex_ = nullptr;
+  free(report_);
+  report_ = nullptr;
+}
+
+void SnapshotLoadProfile::Report(IsolateGroup* isolate_group,
+                                 const char* name) {
+  const int64_t end_micros = OS::GetCurrentMonotonicMicros();
+  AddTimelineEvents();
+  if (FLAG_snapshot_load_profile != nullptr) {
+    WriteReport(isolate_group, name, end_micros);
+  }
+}
+
+void SnapshotLoadProfile::AddTimelineEvents() {
+#if defined(SUPPORT_TIMELINE)
+  TimelineStream* stream = Timeline::GetIsolateStream();
+  if (!stream->enabled()) {
+    return;
+  }
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    const Entry& entry = entries_[i];
+    const struct {
+      const char* phase;
+      int64_t start;
+      int64_t end;
+      intptr_t size;
+      bool concurrent;
+      intptr_t canonicalized;
+    } phases[] = {
+        {"ReadAlloc", entry.alloc_start, entry.alloc_end, entry.alloc_size,
+         false, 0},
+        {"ReadFill", entry.fill_start, entry.fill_end, entry.fill_size,
+         entry.filled_concurrently, 0},
+        {"PostLoad", entry.post_load_start, entry.post_load_end, 0, false,
+         entry.canonicalized},
+    };
+    for (const auto& phase : phases) {
+      TimelineEvent* event = stream->StartEvent();
+      if (event == nullptr) {
+        return;
+      }
+      event->Duration(entry.name, phase.start, phase.end);
+      event->SetNumArguments(5);
+      event->CopyArgument(0, "phase", phase.phase);
+      event->FormatArgument(1, "objects", "%" Pd, entry.num_objects);
+      event->FormatArgument(2, "bytes", "%" Pd, phase.size);
+      event->CopyArgument(3, "concurrent",
+                          phase.concurrent ? "true" : "false");
+      // The number of objects replaced by existing canonical objects.
+      event->FormatArgument(4, "canonicalized", "%" Pd, phase.canonicalized);
+      event->Complete();
+    }
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+void SnapshotLoadProfile::WriteReport(IsolateGroup* isolate_group,
+                                      const char* name,
+                                      int64_t end_micros) {
+  JSONWriter json;
+  json.OpenObject();
+  json.PrintProperty("snapshot", name);
+  json.PrintProperty("isolateGroup", isolate_group->source()->name);
+  json.PrintProperty64("loadMicros", end_micros - start_micros_);
+  json.OpenArray("clusters");
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    const Entry& entry = entries_[i];
+    json.OpenObject();
+    json.PrintProperty("name", entry.name);
+    json.PrintPropertyBool("canonical", entry.is_canonical);
+    json.PrintProperty("objects", entry.num_objects);
+    json.PrintProperty("allocBytes", entry.alloc_size);
+    json.PrintProperty("fillBytes", entry.fill_size);
+    json.PrintProperty64("allocMicros", entry.alloc_end - entry.alloc_start);
+    json.PrintProperty64("fillMicros", entry.fill_end - entry.fill_start);
+    json.PrintPropertyBool("filledConcurrently", entry.filled_concurrently);
+    json.PrintProperty64("postLoadMicros",
+                         entry.post_load_end - entry.post_load_start);
+    json.PrintProperty("canonicalized", entry.canonicalized);
+    json.CloseObject();
+  }
+  json.CloseArray();
+  json.CloseObject();
+
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+
+  MutexLocker ml(report_mutex_);
+  if (report_ == nullptr) {
+    report_ = Utils::StrDup(json.ToCString());
+  } else {
+    char* previous = report_;
+    report_ = Utils::SCreate("%s,\n%s", previous, json.ToCString());
+    free(previous);
+  }
+  auto file = file_open(FLAG_snapshot_load_profile, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write snapshot load profile: %s\n",
+                 FLAG_snapshot_load_profile);
+    return;
+  }
+  file_write("[\n", 2, file);
+  file_write(report_, strlen(report_), file);
+  file_write("\n]\n", 3, file);
+  file_close(file);
+}
+
+// Fill sections smaller than this in total are not worth the helper threads.
+static constexpr intptr_t kMinConcurrentFillSize = 64 * KB;
+
+#if defined(TESTING)
+static RelaxedAtomic<intptr_t> concurrent_fills = 0;
+
+intptr_t FullSnapshotReader::concurrent_fills_for_testing() {
+  return concurrent_fills.load();
+}
+#endif  // defined(TESTING)
+
+// The clusters a deserializer lets helper threads fill, largest first. The
+// queue is shared by the deserializer and its helper tasks, and deleted by
+// whichever releases it last, as helper tasks may only start running after
+// the deserializer is done.
+class ConcurrentFillQueue {
+ public:
+  explicit ConcurrentFillQueue(const Deserializer* parent) : parent_(parent) {}
+
+  void Add(intptr_t index,
+           DeserializationCluster* cluster,
+           intptr_t position,
+           intptr_t size) {
+    entries_.Add({index, cluster, position, size});
+    total_size_ += size;
+  }
+
+  intptr_t length() const { return entries_.length(); }
+  intptr_t total_size() const { return total_size_; }
+
+  // Must be called before the queue is shared with [num_tasks] helpers.
+  void Start(intptr_t num_tasks) {
+    entries_.Sort(CompareSizes);
+    remaining_ = entries_.length();
+    ref_count_.fetch_add(num_tasks);
+  }
+
+  // Fills clusters until there are none left to take.
+  void Drain() {
+    for (intptr_t i = next_.fetch_add(1); i < entries_.length();
+         i = next_.fetch_add(1)) {
+      const Entry& entry = entries_[i];
+      SnapshotLoadProfile* profile = parent_->load_profile_;
+      const int64_t start =
+          (profile != nullptr) ? OS::GetCurrentMonotonicMicros() : 0;
+      Deserializer d(*parent_, entry.position);
+      entry.cluster->ReadFill(&d);
+#if defined(DEBUG)
+      int32_t section_marker = d.Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+      if (profile != nullptr) {
+        profile->RecordFill(entry.index, entry.size, start,
+                            OS::GetCurrentMonotonicMicros(),
+                            /*concurrent=*/true);
+      }
+#if defined(TESTING)
+      concurrent_fills.fetch_add(1);
+#endif  // defined(TESTING)
+      MonitorLocker ml(&monitor_);
+      if (--remaining_ == 0) {
+        ml.NotifyAll();
+      }
+    }
+  }
+
+  void WaitUntilFilled() {
+    MonitorLocker ml(&monitor_);
+    while (remaining_ > 0) {
+      ml.Wait();
+    }
+  }
+
+  void Release() {
+    if (ref_count_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  struct Entry {
+    intptr_t index;
+    DeserializationCluster* cluster;
+    intptr_t position;
+    intptr_t size;
+  };
+
+  static int CompareSizes(const Entry* a, const Entry* b) {
+    return (a->size > b->size) ? -1 : ((a->size < b->size) ? 1 : 0);
+  }
+
+  const Deserializer* const parent_;
+  MallocGrowableArray<Entry> entries_;
+  intptr_t total_size_ = 0;
+  RelaxedAtomic<intptr_t> next_ = 0;
+  std::atomic<intptr_t> ref_count_ = {1};
+  Monitor monitor_;
+  intptr_t remaining_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentFillQueue);
+};
+
+class ConcurrentFillTask : public ThreadPool::Task {
+ public:
+  explicit ConcurrentFillTask(ConcurrentFillQueue* queue) : queue_(queue) {}
+  ~ConcurrentFillTask() { queue_->Release(); }
+
+  void Run() override { queue_->Drain(); }
+
+ private:
+  ConcurrentFillQueue* const queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentFillTask);
+};
+
+void Deserializer::FillConcurrently(const intptr_t* fill_positions) {
+  ConcurrentFillQueue* queue = nullptr;
+  const intptr_t max_tasks = Utils::Minimum<intptr_t>(
+      FLAG_snapshot_fill_tasks, OS::NumberOfAvailableProcessors() - 1);
+  if ((max_tasks > 0) && (Dart::thread_pool() != nullptr)) {
+    queue = new ConcurrentFillQueue(this);
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      if (clusters_[i]->CanFillConcurrently()) {
+        queue->Add(i, clusters_[i], fill_positions[i],
+                   fill_positions[i + 1] - fill_positions[i]);
+      }
+    }
+    if (queue->total_size() < kMinConcurrentFillSize) {
+      queue->Release();
+      queue = nullptr;
+    }
+  }
+
+  if (queue != nullptr) {
+    // This thread fills the other clusters first and then helps draining the
+    // queue, so fewer helpers than clusters in the queue are needed.
+    const intptr_t num_tasks =
+        Utils::Minimum<intptr_t>(max_tasks, queue->length() - 1);
+    queue->Start(num_tasks);
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      Dart::thread_pool()->Run<ConcurrentFillTask>(queue);
+    }
+  }
+
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if ((queue != nullptr) && clusters_[i]->CanFillConcurrently()) {
+      continue;
+    }
+    const int64_t start =
+        (load_profile_ != nullptr) ? OS::GetCurrentMonotonicMicros() : 0;
+    set_position(fill_positions[i]);
+    clusters_[i]->ReadFill(this);
+#if defined(DEBUG)
+    int32_t section_marker = Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+    if (load_profile_ != nullptr) {
+      load_profile_->RecordFill(i, fill_positions[i + 1] - fill_positions[i],
+                                start, OS::GetCurrentMonotonicMicros(),
+                                /*concurrent=*/false);
+    }
+  }
+
+  if (queue != nullptr) {
+    queue->Drain();
+    queue->WaitUntilFilled();
+    queue->Release();
+  }
+  set_position(fill_positions[num_clusters_]);
+}
+
 void Deserializer::Deserialize(DeserializationRoots* roots) {
   const void* clustered_start = AddressOfCurrentPosition();
 
@@ -9526,6 +10193,9 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
 
   clusters_ = new DeserializationCluster*[num_clusters_];
   refs = Array::New(num_objects_ + kFirstReference, Heap::kOld);
+  if (SnapshotLoadProfile::IsEnabled()) {
+    load_profile_ = new (zone_) SnapshotLoadProfile(zone_, num_clusters_);
+  }
 
 #if defined(DART_PRECOMPILED_RUNTIME)
   if (instructions_table_len > 0) {
@@ -9577,8 +10247,14 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
       for (intptr_t i = 0; i < num_clusters_; i++) {
+        if (load_profile_ != nullptr) {
+          load_profile_->BeginAlloc(i, this);
+        }
         clusters_[i] = ReadCluster();
         clusters_[i]->ReadAlloc(this);
+        if (load_profile_ != nullptr) {
+          load_profile_->EndAlloc(i, this, clusters_[i]);
+        }
 #if defined(DEBUG)
         intptr_t serializers_next_ref_index_ = Read<int32_t>();
         ASSERT_EQUAL(serializers_next_ref_index_, next_ref_index_);
@@ -9589,15 +10265,22 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     // We should have completely filled the ref array.
     ASSERT_EQUAL(next_ref_index_ - kFirstReference, num_objects_);
 
+    // The fill sections are preceded by their offsets from the start of the
+    // first one, and the end of the last one.
+    intptr_t* fill_positions = zone_->Alloc<intptr_t>(num_clusters_ + 1);
+    for (intptr_t i = 0; i <= num_clusters_; i++) {
+      uint32_t offset;
+      ReadBytes(reinterpret_cast<uint8_t*>(&offset), sizeof(offset));
+      fill_positions[i] = offset;
+    }
+    const intptr_t fill_start = position();
+    for (intptr_t i = 0; i <= num_clusters_; i++) {
+      fill_positions[i] += fill_start;
+    }
+
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadFill");
-      for (intptr_t i = 0; i < num_clusters_; i++) {
-        clusters_[i]->ReadFill(this);
-#if defined(DEBUG)
-        int32_t section_marker = Read<int32_t>();
-        ASSERT(section_marker == kSectionMarker);
-#endif
-      }
+      FillConcurrently(fill_positions);
     }
 
     roots->ReadRoots(this);
@@ -9623,8 +10306,23 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
   {
     TIMELINE_DURATION(thread(), Isolate, "PostLoad");
     for (intptr_t i = 0; i < num_clusters_; i++) {
-      clusters_[i]->PostLoad(this, refs);
+      if (load_profile_ != nullptr) {
+        load_profile_->PostLoad(i, clusters_[i], this, refs);
+      } else {
+        clusters_[i]->PostLoad(this, refs);
+      }
+    }
+  }
+
+  if (load_profile_ != nullptr) {
+    const char* name = "isolate";
+    if (is_non_root_unit_) {
+      name = "deferred";
+    } else if (isolate_group == Dart::vm_isolate_group()) {
+      name = "vm";
     }
+    load_profile_->Report(isolate_group, name);
+    load_profile_ = nullptr;
   }
 
   if (isolate_group->snapshot_is_dontneed_safe()) {
@@ -9821,6 +10519,14 @@ void FullSnapshotWriter::WriteFullSnapshot(
 }
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 
+void FullSnapshotReader::Init() {
+  SnapshotLoadProfile::Init();
+}
+
+void FullSnapshotReader::Cleanup() {
+  SnapshotLoadProfile::Cleanup();
+}
+
 FullSnapshotReader::FullSnapshotReader(const Snapshot* snapshot,
                                        const uint8_t* instructions_buffer,
                                        Thread* thread)
@@ -162,6 +162,10 @@ class FullSnapshotWriter {
 
 class FullSnapshotReader {
  public:
+  // Sets up and tears down the state shared by all snapshot loads.
+  static void Init();
+  static void Cleanup();
+
   FullSnapshotReader(const Snapshot* snapshot,
                      const uint8_t* instructions_buffer,
                      Thread* thread);
@@ -171,6 +175,12 @@ class FullSnapshotReader {
   ApiErrorPtr ReadProgramSnapshot();
   ApiErrorPtr ReadUnitSnapshot(const LoadingUnit& unit);
 
+#if defined(TESTING)
+  // The number of clusters filled by all snapshot reads so far while other
+  // threads could fill clusters at the same time.
+  static intptr_t concurrent_fills_for_testing();
+#endif  // defined(TESTING)
+
  private:
   IsolateGroup* isolate_group() const { return thread_->isolate_group(); }
 
@@ -20,6 +20,7 @@
 #include "vm/datastream.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/symbols.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -564,6 +565,59 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+// Measure hashing of strings of the lengths typical for map keys.
+BENCHMARK(StringHash) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  const intptr_t kMaxLength = 64;
+  char one_byte[2 * kMaxLength];
+  uint16_t two_byte[2 * kMaxLength];
+  for (intptr_t i = 0; i < 2 * kMaxLength; i++) {
+    one_byte[i] = 'a' + (i % 26);
+    two_byte[i] = 0x3b1 + (i % 24);
+  }
+  const intptr_t kLoopCount = 1000000;
+  uword hash = 0;
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    const intptr_t start = i % kMaxLength;
+    const intptr_t length = 1 + (i % kMaxLength);
+    hash ^= String::Hash(&one_byte[start], length);
+    hash ^= String::Hash(&two_byte[start], length);
+  }
+  timer.Stop();
+  EXPECT(hash != 0);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+// Measure adding new symbols to the symbol table and looking them up again.
+BENCHMARK(SymbolInterning) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  const intptr_t kNumSymbols = 100000;
+  char** names = new char*[kNumSymbols];
+  for (intptr_t i = 0; i < kNumSymbols; i++) {
+    names[i] = Utils::SCreate("benchmarkSymbolInterning_%" Pd, i);
+  }
+  String& symbol = String::Handle();
+  Timer timer;
+  timer.Start();
+  for (intptr_t pass = 0; pass < 2; pass++) {
+    for (intptr_t i = 0; i < kNumSymbols; i++) {
+      symbol = Symbols::New(thread, names[i]);
+    }
+  }
+  timer.Stop();
+  for (intptr_t i = 0; i < kNumSymbols; i++) {
+    free(names[i]);
+  }
+  delete[] names;
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
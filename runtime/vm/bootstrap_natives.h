@@ -96,6 +96,7 @@ namespace dart {
   V(Double_equal, 2)                                                           \
   V(Double_doubleFromInteger, 2)                                               \
   V(Double_parse, 3)                                                           \
+  V(Double_parseBytes, 3)                                                      \
   V(Double_toString, 1)                                                        \
   V(Double_toStringAsFixed, 2)                                                 \
   V(Double_toStringAsExponential, 2)                                           \
@@ -245,6 +246,7 @@ namespace dart {
   V(Int32x4_setFlagZ, 2)                                                       \
   V(Int32x4_setFlagW, 2)                                                       \
   V(Int32x4_select, 3)                                                         \
+  V(Concurrent_deepFreeze, 1)                                                  \
   V(Isolate_exit_, 2)                                                          \
   V(Isolate_getCurrentRootUriStr, 0)                                           \
   V(Isolate_getDebugName, 1)                                                   \
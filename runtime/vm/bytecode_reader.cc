@@ -20,6 +20,7 @@
 #include "vm/flags.h"
 #include "vm/hash.h"
 #include "vm/hash_table.h"
+#include "vm/interpreter.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
@@ -34,6 +35,13 @@
 namespace dart {
 
 DEFINE_FLAG(bool, dump_kernel_bytecode, false, "Dump kernel bytecode");
+#if defined(DART_PRECOMPILED_RUNTIME)
+DEFINE_FLAG(bool,
+            interpreter_dispatch_table_calls,
+            true,
+            "Make interface calls from bytecode to functions of the AOT "
+            "program through its dispatch table.");
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
 
 namespace bytecode {
 
@@ -60,6 +68,20 @@ class BytecodeOffsetsMapTraits {
 };
 using BytecodeOffsetsMap = UnorderedHashMap<BytecodeOffsetsMapTraits>;
 
+class DispatchTableSelectorMapTraits {
+ public:
+  static const char* Name() { return "DispatchTableSelectorMapTraits"; }
+  static bool ReportStats() { return false; }
+
+  static bool IsMatch(const Object& a, const Object& b) {
+    return (a.ptr() == b.ptr());
+  }
+
+  static uword Hash(const Object& key) { return Function::Cast(key).Hash(); }
+};
+using DispatchTableSelectorMap =
+    UnorderedHashMap<DispatchTableSelectorMapTraits>;
+
 BytecodeLoader::BytecodeLoader(Thread* thread, const TypedDataBase& binary)
     : thread_(thread),
       binary_(binary),
@@ -551,6 +573,7 @@ intptr_t BytecodeReaderHelper::ReadConstantPool(const Function& function,
       case ConstantPoolTag::kInterfaceCall: {
         elem = ReadObject();
         ASSERT(elem.IsFunction());
+        elem = ResolveInterfaceTarget(Function::Cast(elem));
         // InterfaceCall constant occupies 2 entries.
         // The first entry is used for interface target.
         pool.SetTypeAt(i, ObjectPool::EntryType::kTaggedObject,
@@ -565,6 +588,7 @@ intptr_t BytecodeReaderHelper::ReadConstantPool(const Function& function,
       case ConstantPoolTag::kInstantiatedInterfaceCall: {
         elem = ReadObject();
         ASSERT(elem.IsFunction());
+        elem = ResolveInterfaceTarget(Function::Cast(elem));
         // InstantiatedInterfaceCall constant occupies 3 entries:
         // 1) Interface target.
         pool.SetTypeAt(i, ObjectPool::EntryType::kTaggedObject,
@@ -618,6 +642,59 @@ intptr_t BytecodeReaderHelper::ReadConstantPool(const Function& function,
   return obj_count - 1;
 }
 
+ObjectPtr BytecodeReaderHelper::ResolveInterfaceTarget(
+    const Function& target) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  if (FLAG_interpreter_dispatch_table_calls && !target.HasBytecode()) {
+    const auto& entry =
+        Object::Handle(Z, LookupDispatchTableTarget(thread_, target));
+    if (!entry.IsNull()) {
+      return entry.ptr();
+    }
+  }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+  return target.ptr();
+}
+
+ObjectPtr BytecodeReaderHelper::LookupDispatchTableTarget(
+    Thread* thread,
+    const Function& target) {
+  Zone* zone = thread->zone();
+  ObjectStore* object_store = thread->isolate_group()->object_store();
+  Array& data = Array::Handle(
+      zone, object_store->dispatch_table_interface_selector_map());
+  if (data.IsNull()) {
+    // See Precompiler::FinalizeDispatchTableInterfaceSelectors.
+    const auto& selectors = Array::Handle(
+        zone, object_store->dispatch_table_interface_selectors());
+    if (selectors.IsNull()) {
+      return Object::null();
+    }
+    const auto& num_cids = Smi::Handle(zone, Smi::RawCast(selectors.At(0)));
+    data = HashTables::New<DispatchTableSelectorMap>(selectors.Length() / 2,
+                                                     Heap::kOld);
+    DispatchTableSelectorMap map(zone, data.ptr());
+    auto& function = Function::Handle(zone);
+    auto& offset = Smi::Handle(zone);
+    auto& entry = Array::Handle(zone);
+    for (intptr_t i = 1; i < selectors.Length(); i += 2) {
+      function ^= selectors.At(i);
+      offset ^= selectors.At(i + 1);
+      entry = Array::New(Interpreter::kDispatchTableTargetLength, Heap::kOld);
+      entry.SetAt(Interpreter::kDispatchTableTargetFunction, function);
+      entry.SetAt(Interpreter::kDispatchTableTargetOffset, offset);
+      entry.SetAt(Interpreter::kDispatchTableTargetNumCids, num_cids);
+      map.UpdateOrInsert(function, entry);
+    }
+    data = map.Release().ptr();
+    object_store->set_dispatch_table_interface_selector_map(data);
+  }
+  DispatchTableSelectorMap map(zone, data.ptr());
+  const auto& entry = Object::Handle(zone, map.GetOrNull(target));
+  map.Release();
+  return entry.ptr();
+}
+
 BytecodePtr BytecodeReaderHelper::ReadBytecode(const ObjectPool& pool) {
   const intptr_t size = reader_.ReadUInt();
   const intptr_t offset = reader_.offset();
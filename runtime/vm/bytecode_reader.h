@@ -192,6 +192,12 @@ class BytecodeReaderHelper : public ValueObject {
 
   Reader& reader() { return reader_; }
 
+  // Returns the dispatch table target for interface calls to [target] (see
+  // Interpreter::kDispatchTableTargetFunction), or null if [target] has no
+  // selector in the dispatch table of the AOT program.
+  static ObjectPtr LookupDispatchTableTarget(Thread* thread,
+                                             const Function& target);
+
   void ReadCode(const Function& function, intptr_t code_offset);
 
   void ReadMembers(const Class& cls, bool discard_fields);
@@ -330,6 +336,11 @@ class BytecodeReaderHelper : public ValueObject {
                             const ObjectPool& pool,
                             intptr_t start_index);
 
+  // Returns the pool entry of an interface call to [target]: [target] itself,
+  // or its dispatch table target if the call can go through the dispatch
+  // table of the AOT program (see Interpreter::DispatchTableCall).
+  ObjectPtr ResolveInterfaceTarget(const Function& target);
+
   BytecodePtr ReadBytecode(const ObjectPool& pool);
   void ReadExceptionsTable(const Function& function,
                            const Bytecode& bytecode,
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -994,6 +995,56 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     instr->ReplaceWith(call, current_iterator());
     return;
   }
+
+  if (TryDevirtualizeUsingProfile(instr)) {
+    return;
+  }
+}
+
+bool AotCallSpecializer::TryDevirtualizeUsingProfile(InstanceCallInstr* call) {
+  AotProfile* profile = AotProfile::Current();
+  // Calls which were inlined into this graph belong to other functions.
+  if ((profile == nullptr) || (call->inlining_id() > 0)) {
+    return false;
+  }
+  const Function& function = flow_graph()->function();
+  const AotProfile::CallSite* site =
+      profile->LookupCall(function, call->token_pos(), call->function_name());
+  // Checking for some of the classes of a megamorphic call site would mostly
+  // add overhead.
+  if ((site == nullptr) || site->receivers.is_empty() ||
+      (site->receivers.length() > FLAG_max_polymorphic_checks)) {
+    return false;
+  }
+
+  const Array& args_desc_array =
+      Array::Handle(Z, call->GetArgumentsDescriptor());
+  const ICData& ic_data = ICData::Handle(
+      Z, ICData::New(function, call->function_name(), args_desc_array,
+                     DeoptId::kNone, /* args_tested = */ 1,
+                     ICData::kOptimized));
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (const auto& receiver : site->receivers) {
+    cls = isolate_group()->class_table()->At(receiver.cid);
+    target = call->ResolveForReceiverClass(cls);
+    if (target.IsNull() || target.IsInvokeFieldDispatcher() ||
+        target.IsNoSuchMethodDispatcher()) {
+      continue;
+    }
+    ic_data.AddReceiverCheck(receiver.cid, target, receiver.count);
+  }
+  if (ic_data.NumberOfChecksIs(0)) {
+    return false;
+  }
+
+  const CallTargets* targets = CallTargets::Create(Z, ic_data);
+  ASSERT(!targets->is_empty());
+  PolymorphicInstanceCallInstr* poly_call =
+      PolymorphicInstanceCallInstr::FromCall(Z, call, *targets,
+                                             /* complete = */ false);
+  call->ReplaceWith(poly_call, current_iterator());
+  return true;
 }
 
 void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
@@ -80,6 +80,11 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryExpandCallThroughGetter(const Class& receiver_class,
                                   InstanceCallInstr* call);
 
+  // Replaces [call] with a polymorphic call which checks for the receiver
+  // classes seen at this call site in a training run (see AotProfile) and
+  // falls back to a generic call for other receivers.
+  bool TryDevirtualizeUsingProfile(InstanceCallInstr* call);
+
   Definition* TryOptimizeDivisionOperation(TemplateDartCall<0>* instr,
                                            Token::Kind op_kind,
                                            Value* left_value,
@@ -0,0 +1,435 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include <stdlib.h>
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/function_key.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write type feedback collected by the JIT into the given file when "
+            "the isolate exits, to be used by --read-aot-profile-from.");
+
+// Identifies [cls] across runs of the same program: the url of its library
+// and its name.
+static const char* ClassKey(Zone* zone, const Class& cls) {
+  const auto& library = Library::Handle(zone, cls.library());
+  const char* url =
+      library.IsNull() ? "" : String::Handle(zone, library.url()).ToCString();
+  return OS::SCreate(zone, "%s\t%s", url, cls.ScrubbedNameCString());
+}
+
+class AotProfileWriterVisitor : public FunctionVisitor {
+ public:
+  AotProfileWriterVisitor(Zone* zone, BaseTextBuffer* buffer)
+      : zone_(zone),
+        buffer_(buffer),
+        class_table_(IsolateGroup::Current()->class_table()),
+        ic_data_array_(Array::Handle(zone)),
+        edge_counters_(Array::Handle(zone)),
+        ic_data_(ICData::Handle(zone)),
+        code_(Code::Handle(zone)),
+        descriptors_(PcDescriptors::Handle(zone)),
+        cls_(Class::Handle(zone)),
+        selector_(String::Handle(zone)),
+        token_positions_(zone, 64) {}
+
+  void VisitFunction(const Function& function) {
+    if (!function.WasExecuted()) {
+      return;
+    }
+    buffer_->Printf("function\t%" Pd "\t%s\n",
+                    static_cast<intptr_t>(function.usage_counter()),
+                    FunctionKey(zone_, function));
+    ic_data_array_ = function.ic_data_array();
+    if (ic_data_array_.IsNull()) {
+      return;
+    }
+
+    edge_counters_ ^=
+        ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounters);
+    if (!edge_counters_.IsNull() && edge_counters_.Length() > 0) {
+      buffer_->AddString("edges\t");
+      for (intptr_t i = 0; i < edge_counters_.Length(); ++i) {
+        buffer_->Printf("%s%" Pd, (i > 0) ? "," : "",
+                        Smi::Value(Smi::RawCast(edge_counters_.At(i))));
+      }
+      buffer_->AddString("\n");
+    }
+
+    code_ = function.unoptimized_code();
+    if (code_.IsNull()) {
+      return;
+    }
+    CollectTokenPositions();
+
+    for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+         i < ic_data_array_.Length(); ++i) {
+      ic_data_ ^= ic_data_array_.At(i);
+      const intptr_t count = ic_data_.AggregateCount();
+      const intptr_t deopt_id = ic_data_.deopt_id();
+      if ((count == 0) || (deopt_id >= token_positions_.length()) ||
+          (token_positions_[deopt_id] == kNoTokenPos)) {
+        continue;
+      }
+      selector_ = ic_data_.target_name();
+      buffer_->Printf("call\t%" Pd32 "\t%" Pd "\t%s\n",
+                      token_positions_[deopt_id], count,
+                      selector_.ToCString());
+      if (ic_data_.rebind_rule() != ICData::kInstance) {
+        continue;
+      }
+      for (intptr_t j = 0; j < ic_data_.NumberOfChecks(); ++j) {
+        const intptr_t receiver_count = ic_data_.GetCountAt(j);
+        const intptr_t cid = ic_data_.GetReceiverClassIdAt(j);
+        if ((receiver_count == 0) || !class_table_->HasValidClassAt(cid)) {
+          continue;
+        }
+        cls_ = class_table_->At(cid);
+        buffer_->Printf("receiver\t%" Pd "\t%s\n", receiver_count,
+                        ClassKey(zone_, cls_));
+      }
+    }
+  }
+
+ private:
+  static constexpr int32_t kNoTokenPos = kMinInt32;
+
+  // Maps deopt ids of calls in the unoptimized code to token positions.
+  void CollectTokenPositions() {
+    token_positions_.Clear();
+    descriptors_ = code_.pc_descriptors();
+    PcDescriptors::Iterator iter(descriptors_,
+                                 UntaggedPcDescriptors::kIcCall |
+                                     UntaggedPcDescriptors::kUnoptStaticCall);
+    while (iter.MoveNext()) {
+      const intptr_t deopt_id = iter.DeoptId();
+      if (deopt_id < 0) {
+        continue;
+      }
+      while (token_positions_.length() <= deopt_id) {
+        token_positions_.Add(kNoTokenPos);
+      }
+      token_positions_[deopt_id] = iter.TokenPos().Serialize();
+    }
+  }
+
+  Zone* const zone_;
+  BaseTextBuffer* const buffer_;
+  ClassTable* const class_table_;
+  Array& ic_data_array_;
+  Array& edge_counters_;
+  ICData& ic_data_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  Class& cls_;
+  String& selector_;
+  GrowableArray<int32_t> token_positions_;
+};
+
+AcqRelAtomic<bool> AotProfileWriter::file_claimed_ = {false};
+
+AotProfileWriter* AotProfileWriter::New(IsolateGroup* isolate_group) {
+  if ((FLAG_write_aot_profile_to == nullptr) ||
+      IsolateGroup::IsSystemIsolateGroup(isolate_group)) {
+    return nullptr;
+  }
+  bool expected = false;
+  if (!file_claimed_.compare_exchange_strong(expected, true)) {
+    return nullptr;
+  }
+  return new AotProfileWriter();
+}
+
+AotProfileWriter::~AotProfileWriter() {
+  file_claimed_.store(false);
+}
+
+void AotProfileWriter::WriteTo(Thread* thread, BaseTextBuffer* buffer) {
+  buffer->AddString("# Dart AOT profile\n");
+  AotProfileWriterVisitor visitor(thread->zone(), buffer);
+  ProgramVisitor::WalkProgram(thread->zone(), thread->isolate_group(),
+                              &visitor);
+}
+
+void AotProfileWriter::Write(Thread* thread) {
+  const char* filename = FLAG_write_aot_profile_to;
+  if ((Dart::file_write_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+
+  TextBuffer buffer(64 * KB);
+  WriteTo(thread, &buffer);
+
+  MutexLocker ml(&mutex_);
+  void* file = Dart::file_open_callback()(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", filename);
+    return;
+  }
+  const intptr_t output_length = buffer.length();
+  char* output = buffer.Steal();
+  Dart::file_write_callback()(output, output_length, file);
+  free(output);
+  Dart::file_close_callback()(file);
+}
+
+#if defined(TESTING)
+AotProfile* AotProfile::current_for_testing_ = nullptr;
+#endif
+
+AotProfile* AotProfile::Current() {
+#if defined(TESTING)
+  if (current_for_testing_ != nullptr) {
+    return current_for_testing_;
+  }
+#endif
+  Precompiler* precompiler = Precompiler::Instance();
+  return (precompiler != nullptr) ? precompiler->profile() : nullptr;
+}
+
+const AotProfile::FunctionProfile* AotProfile::Lookup(
+    const Function& function) const {
+  Zone* zone = Thread::Current()->zone();
+  const intptr_t index = functions_.LookupValue(FunctionKey(zone, function));
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+  return profiles_[index];
+}
+
+const AotProfile::CallSite* AotProfile::LookupCall(
+    const Function& function,
+    TokenPosition token_pos,
+    const String& selector) const {
+  const FunctionProfile* profile = Lookup(function);
+  if (profile == nullptr) {
+    return nullptr;
+  }
+  const int32_t pos = token_pos.Serialize();
+  for (auto call : profile->calls) {
+    if ((call->token_pos == pos) && selector.Equals(call->selector)) {
+      return call;
+    }
+  }
+  return nullptr;
+}
+
+bool AotProfile::LookupCallCount(const Function& function,
+                                 TokenPosition token_pos,
+                                 intptr_t* count) const {
+  const FunctionProfile* profile = Lookup(function);
+  if (profile == nullptr) {
+    return false;
+  }
+  const int32_t pos = token_pos.Serialize();
+  *count = 0;
+  for (auto call : profile->calls) {
+    if (call->token_pos == pos) {
+      *count += call->count;
+    }
+  }
+  return true;
+}
+
+ArrayPtr AotProfile::EdgeCounters(const Function& function) const {
+  const FunctionProfile* profile = Lookup(function);
+  if ((profile == nullptr) || profile->edge_counters.is_empty()) {
+    return Array::null();
+  }
+  Zone* zone = Thread::Current()->zone();
+  const intptr_t length = profile->edge_counters.length();
+  const auto& counters = Array::Handle(zone, Array::New(length));
+  auto& count = Smi::Handle(zone);
+  for (intptr_t i = 0; i < length; ++i) {
+    count = Smi::New(profile->edge_counters[i]);
+    counters.SetAt(i, count);
+  }
+  return counters.ptr();
+}
+
+#if defined(DART_PRECOMPILER)
+
+DEFINE_FLAG(charp,
+            read_aot_profile_from,
+            nullptr,
+            "Guide AOT compilation by the type feedback in the given file, "
+            "written by --write-aot-profile-to.");
+
+AotProfile* AotProfile::ReadIfRequested(Thread* thread) {
+  const char* filename = FLAG_read_aot_profile_from;
+  if (filename == nullptr) {
+    return nullptr;
+  }
+  if ((Dart::file_read_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return nullptr;
+  }
+  void* file = Dart::file_open_callback()(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = 0;
+  Dart::file_read_callback()(&data, &length, file);
+  Dart::file_close_callback()(file);
+  if ((data == nullptr) || (length < 0)) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+
+  Zone* zone = thread->zone();
+  char* text = zone->Alloc<char>(length + 1);
+  memmove(text, data, length);
+  text[length] = '\0';
+  free(data);
+
+  AotProfile* profile = new (zone) AotProfile(zone);
+  if (!profile->Parse(thread, text)) {
+    OS::PrintErr("warning: Malformed AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  return profile;
+}
+
+// Splits [line] in place into at most [max_fields] tab separated fields.
+// The last field extends to the end of the line.
+static intptr_t SplitFields(char* line, char** fields, intptr_t max_fields) {
+  intptr_t count = 0;
+  fields[count++] = line;
+  while (count < max_fields) {
+    char* tab = strchr(fields[count - 1], '\t');
+    if (tab == nullptr) {
+      break;
+    }
+    *tab = '\0';
+    fields[count++] = tab + 1;
+  }
+  return count;
+}
+
+static bool ParseInt(const char* str, int64_t* value) {
+  char* end = nullptr;
+  *value = strtoll(str, &end, 10);
+  return (end != str) && ((*end == '\0') || (*end == ','));
+}
+
+static int ReceiverComparator(const AotProfile::Receiver* a,
+                              const AotProfile::Receiver* b) {
+  if (a->count != b->count) {
+    return (a->count > b->count) ? -1 : 1;
+  }
+  return (a->cid < b->cid) ? -1 : ((a->cid > b->cid) ? 1 : 0);
+}
+
+bool AotProfile::Parse(Thread* thread, char* data) {
+  // Class ids differ between the training run and the AOT compilation.
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  auto& cls = Class::Handle(zone_);
+  for (intptr_t cid = kIllegalCid + 1; cid < class_table->NumCids(); ++cid) {
+    if (class_table->HasValidClassAt(cid)) {
+      cls = class_table->At(cid);
+      classes_.Insert({ClassKey(zone_, cls), cid});
+    }
+  }
+
+  FunctionProfile* function = nullptr;
+  CallSite* call = nullptr;
+  char* fields[3];
+  int64_t value = 0;
+  char* next = data;
+  while (next != nullptr) {
+    char* line = next;
+    next = strchr(line, '\n');
+    if (next != nullptr) {
+      *next++ = '\0';
+    }
+    if ((line[0] == '\0') || (line[0] == '#')) {
+      continue;
+    }
+
+    char* record = line;
+    char* rest = strchr(line, '\t');
+    if (rest == nullptr) {
+      return false;
+    }
+    *rest++ = '\0';
+    if (strcmp(record, "function") == 0) {
+      // function <usage count> <function key>
+      if ((SplitFields(rest, fields, 2) != 2) ||
+          !ParseInt(fields[0], &value)) {
+        return false;
+      }
+      function = new (zone_) FunctionProfile();
+      function->usage_count = value;
+      call = nullptr;
+      functions_.Insert({fields[1], profiles_.length()});
+      profiles_.Add(function);
+    } else if (strcmp(record, "edges") == 0) {
+      // edges <count>,<count>,...
+      if (function == nullptr) {
+        return false;
+      }
+      for (const char* str = rest; str != nullptr;) {
+        if (!ParseInt(str, &value)) {
+          return false;
+        }
+        function->edge_counters.Add(value);
+        str = strchr(str, ',');
+        if (str != nullptr) {
+          str++;
+        }
+      }
+    } else if (strcmp(record, "call") == 0) {
+      // call <token pos> <count> <selector>
+      int64_t token_pos = 0;
+      if ((function == nullptr) || (SplitFields(rest, fields, 3) != 3) ||
+          !ParseInt(fields[0], &token_pos) || !ParseInt(fields[1], &value)) {
+        return false;
+      }
+      call = new (zone_)
+          CallSite(static_cast<int32_t>(token_pos), value, fields[2]);
+      function->calls.Add(call);
+    } else if (strcmp(record, "receiver") == 0) {
+      // receiver <count> <class key>
+      if ((call == nullptr) || (SplitFields(rest, fields, 2) != 2) ||
+          !ParseInt(fields[0], &value)) {
+        return false;
+      }
+      const intptr_t cid = classes_.LookupValue(fields[1]);
+      if (cid != CStringIntMapKeyValueTrait::kNoValue) {
+        call->receivers.Add({cid, static_cast<intptr_t>(value)});
+      }
+    } else {
+      return false;
+    }
+  }
+
+  for (auto profile : profiles_) {
+    for (auto site : profile->calls) {
+      site->receivers.Sort(ReceiverComparator);
+    }
+  }
+  return true;
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
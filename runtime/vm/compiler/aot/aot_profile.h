@@ -0,0 +1,172 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/object.h"
+#include "vm/os_thread.h"
+#include "vm/token_position.h"
+
+namespace dart {
+
+class BaseTextBuffer;
+
+// Type feedback recorded by a JIT training run and used to guide AOT
+// compilation.
+//
+// Running the JIT with --write-aot-profile-to=<file> dumps, when the isolate
+// shuts down, the information which unoptimized code has collected for each
+// executed function: its usage counter, the edge counters of its blocks and
+// for each call site the number of calls and the classes of the receivers.
+// Only the first isolate group of the process which runs user code writes
+// the profile: groups created by Isolate.spawnUri run other programs.
+//
+// When gen_snapshot is given the same file with --read-aot-profile-from the
+// profile is used to
+//
+//   * devirtualize instance calls which CHA cannot resolve by checking the
+//     class id of the receiver against the classes seen in training, with a
+//     fallback to a generic call (see AotCallSpecializer),
+//   * prioritize inlining of call sites which were hot in training (see
+//     FlowGraphInliner),
+//   * move blocks which were never reached in training out of the way of
+//     the hot path (see BlockScheduler),
+//   * place functions which were never executed in training after all
+//     other code (see Code::is_cold).
+//
+// Unlike in the JIT, feedback only changes how fast the code runs and never
+// what it computes, so a stale profile is harmless.
+//
+// The profile is a text file with one tab separated record per line:
+//
+//   function <usage count> <script url> <token pos> <qualified name>
+//   edges <count>,<count>,...
+//   call <token pos> <count> <selector>
+//   receiver <count> <library url> <class name>
+//
+// Edges, calls and receivers belong to the last function and call before
+// them. Call sites are identified by their token position and selector
+// rather than deopt id, as AOT flow graphs are built with different deopt
+// ids. Edge counters are indexed by the preorder number of blocks in the
+// unoptimized flow graph and are only used if the AOT flow graph has the
+// same number of blocks.
+class AotProfileWriter {
+ public:
+  // Returns nullptr unless --write-aot-profile-to is given and no other
+  // isolate group of the process which runs user code writes the profile.
+  static AotProfileWriter* New(IsolateGroup* isolate_group);
+
+  ~AotProfileWriter();
+
+  // Writes the profile of the current isolate group to the file given by
+  // --write-aot-profile-to. Isolates of the group shutting down at the same
+  // time write the file one after another.
+  void Write(Thread* thread);
+
+ private:
+  friend class AotProfileTestHelper;
+
+  AotProfileWriter() {}
+
+  // Appends the profile of the current isolate group to [buffer].
+  static void WriteTo(Thread* thread, BaseTextBuffer* buffer);
+
+  // Whether an isolate group of this process owns the profile file.
+  static AcqRelAtomic<bool> file_claimed_;
+
+  Mutex mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfileWriter);
+};
+
+class AotProfile : public ZoneAllocated {
+ public:
+  struct Receiver {
+    intptr_t cid;
+    intptr_t count;
+  };
+
+  class CallSite : public ZoneAllocated {
+   public:
+    CallSite(int32_t token_pos, intptr_t count, const char* selector)
+        : token_pos(token_pos), count(count), selector(selector) {}
+
+    const int32_t token_pos;
+    const intptr_t count;
+    const char* const selector;
+    // Receiver classes which exist in this program, most frequent first.
+    GrowableArray<Receiver> receivers;
+  };
+
+  // Reads the profile given by --read-aot-profile-from. Returns nullptr if
+  // there is no profile or it cannot be read.
+  static AotProfile* ReadIfRequested(Thread* thread);
+
+  // Returns the profile used by the current AOT compilation, if any.
+  static AotProfile* Current();
+
+  // Returns true if [function] was executed in training.
+  bool WasExecuted(const Function& function) const {
+    return Lookup(function) != nullptr;
+  }
+
+  // Returns the call site of [function] at [token_pos] invoking [selector],
+  // or nullptr if it was not executed in training.
+  const CallSite* LookupCall(const Function& function,
+                             TokenPosition token_pos,
+                             const String& selector) const;
+
+  // Returns false if [function] was not executed in training. Otherwise
+  // sets [count] to the number of calls made at [token_pos].
+  bool LookupCallCount(const Function& function,
+                       TokenPosition token_pos,
+                       intptr_t* count) const;
+
+  // Returns the edge counters of [function] as an array of Smis indexed by
+  // block preorder number, or null if there are none.
+  ArrayPtr EdgeCounters(const Function& function) const;
+
+ private:
+  class FunctionProfile : public ZoneAllocated {
+   public:
+    intptr_t usage_count = 0;
+    GrowableArray<intptr_t> edge_counters;
+    GrowableArray<CallSite*> calls;
+  };
+
+  explicit AotProfile(Zone* zone)
+      : zone_(zone), functions_(zone), classes_(zone) {}
+
+  bool Parse(Thread* thread, char* data);
+  const FunctionProfile* Lookup(const Function& function) const;
+
+#if defined(TESTING)
+  // Returned by [Current] when set (see AotProfileTestHelper).
+  static AotProfile* current_for_testing_;
+#endif
+
+  Zone* const zone_;
+  // Maps function keys to indices in profiles_.
+  CStringIntMap functions_;
+  GrowableArray<FunctionProfile*> profiles_;
+  // Maps class keys to class ids.
+  CStringIntMap classes_;
+
+  friend class AotProfileTestHelper;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfile);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
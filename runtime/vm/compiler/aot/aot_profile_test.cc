@@ -0,0 +1,271 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "platform/text_buffer.h"
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#endif  // defined(DART_PRECOMPILER)
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/function_key.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+DECLARE_FLAG(bool, cold_code_section);
+#endif  // defined(DART_PRECOMPILER)
+
+class AotProfileTestHelper : public AllStatic {
+ public:
+  static const char* Write(Thread* thread) {
+    TextBuffer buffer(KB);
+    AotProfileWriter::WriteTo(thread, &buffer);
+    return thread->zone()->MakeCopyOfString(buffer.buffer());
+  }
+
+#if defined(DART_PRECOMPILER)
+  static AotProfile* Parse(Thread* thread, const char* text) {
+    Zone* zone = thread->zone();
+    AotProfile* profile = new (zone) AotProfile(zone);
+    if (!profile->Parse(thread, zone->MakeCopyOfString(text))) {
+      return nullptr;
+    }
+    return profile;
+  }
+
+  // Returns the only call site recorded for [function].
+  static const AotProfile::CallSite* OnlyCall(const AotProfile* profile,
+                                              const Function& function) {
+    const AotProfile::FunctionProfile* function_profile =
+        profile->Lookup(function);
+    if ((function_profile == nullptr) ||
+        (function_profile->calls.length() != 1)) {
+      return nullptr;
+    }
+    return function_profile->calls[0];
+  }
+
+  static void SetCurrent(AotProfile* profile) {
+    AotProfile::current_for_testing_ = profile;
+  }
+#endif  // defined(DART_PRECOMPILER)
+};
+
+static const char* kCallFooScript = R"(
+  class A {
+    int foo() => 1;
+  }
+  class B extends A {
+    int foo() => 2;
+  }
+  class C extends A {
+    int foo() => 3;
+  }
+
+  @pragma('vm:never-inline')
+  int callFoo(dynamic a) => a.foo();
+
+  final objects = <A>[A(), B(), C()];
+
+  void main() {
+    for (int i = 0; i < 3; i++) {
+      callFoo(objects[1]);
+    }
+    callFoo(objects[2]);
+  }
+)";
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_Write) {
+  const auto& root_library = Library::Handle(LoadTestScript(kCallFooScript));
+  Invoke(root_library, "main");
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "callFoo"));
+  const char* url = String::Handle(root_library.url()).ToCString();
+
+  const char* profile = AotProfileTestHelper::Write(thread);
+  EXPECT_SUBSTRING("# Dart AOT profile\n", profile);
+  EXPECT_SUBSTRING(FunctionKey(thread->zone(), function), profile);
+  EXPECT_SUBSTRING("\t4\tfoo\n", profile);
+  EXPECT_SUBSTRING(OS::SCreate(thread->zone(), "receiver\t3\t%s\tB\n", url),
+                   profile);
+  EXPECT_SUBSTRING(OS::SCreate(thread->zone(), "receiver\t1\t%s\tC\n", url),
+                   profile);
+  EXPECT_NOTSUBSTRING(OS::SCreate(thread->zone(), "\t%s\tA\n", url), profile);
+}
+
+#if defined(DART_PRECOMPILER)
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_ReadWritten) {
+  const auto& root_library = Library::Handle(LoadTestScript(kCallFooScript));
+  Invoke(root_library, "main");
+  const auto& call_foo = Function::Handle(GetFunction(root_library, "callFoo"));
+  const auto& a = Class::Handle(GetClass(root_library, "A"));
+  const auto& b = Class::Handle(GetClass(root_library, "B"));
+  const auto& c = Class::Handle(GetClass(root_library, "C"));
+
+  AotProfile* profile =
+      AotProfileTestHelper::Parse(thread, AotProfileTestHelper::Write(thread));
+  EXPECT(profile != nullptr);
+  EXPECT(profile->WasExecuted(call_foo));
+  const auto& a_foo = Function::Handle(a.LookupFunctionAllowPrivate(
+      String::Handle(String::New("foo"))));
+  EXPECT(!profile->WasExecuted(a_foo));
+
+  const AotProfile::CallSite* site =
+      AotProfileTestHelper::OnlyCall(profile, call_foo);
+  EXPECT(site != nullptr);
+  EXPECT_EQ(4, site->count);
+  EXPECT_STREQ("foo", site->selector);
+  // Most frequent receiver first.
+  EXPECT_EQ(2, site->receivers.length());
+  EXPECT_EQ(b.id(), site->receivers[0].cid);
+  EXPECT_EQ(3, site->receivers[0].count);
+  EXPECT_EQ(c.id(), site->receivers[1].cid);
+  EXPECT_EQ(1, site->receivers[1].count);
+
+  const TokenPosition token_pos = TokenPosition::Deserialize(site->token_pos);
+  EXPECT(site == profile->LookupCall(call_foo, token_pos,
+                                     String::Handle(String::New("foo"))));
+  EXPECT(nullptr == profile->LookupCall(call_foo, token_pos,
+                                        String::Handle(String::New("bar"))));
+  intptr_t count = 0;
+  EXPECT(profile->LookupCallCount(call_foo, token_pos, &count));
+  EXPECT_EQ(4, count);
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_ReadMalformed) {
+  EXPECT(AotProfileTestHelper::Parse(thread, "") != nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread, "# comment\n\n") != nullptr);
+  // Receivers of classes which don't exist in this program are skipped.
+  EXPECT(AotProfileTestHelper::Parse(thread,
+                                     "function\t1\tunknown\n"
+                                     "edges\t1,0,1\n"
+                                     "call\t5\t2\tfoo\n"
+                                     "receiver\t2\tunknown\tUnknown\n") !=
+         nullptr);
+
+  // Records which belong to a missing function or call.
+  EXPECT(AotProfileTestHelper::Parse(thread, "edges\t1,2\n") == nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread, "call\t5\t2\tfoo\n") == nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread,
+                                     "function\t1\tunknown\n"
+                                     "receiver\t2\tunknown\tUnknown\n") ==
+         nullptr);
+  // Malformed numbers and fields, unknown records.
+  EXPECT(AotProfileTestHelper::Parse(thread, "function\tx\tunknown\n") ==
+         nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread, "function\t1\n") == nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread,
+                                     "function\t1\tunknown\n"
+                                     "edges\t1,x\n") == nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread, "unknown\t1\n") == nullptr);
+  EXPECT(AotProfileTestHelper::Parse(thread, "function") == nullptr);
+}
+
+static InstanceCallInstr* FindInstanceCall(FlowGraph* flow_graph) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto call = it.Current()->AsInstanceCall()) {
+        return call;
+      }
+    }
+  }
+  return nullptr;
+}
+
+static PolymorphicInstanceCallInstr* FindPolymorphicInstanceCall(
+    FlowGraph* flow_graph) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto call = it.Current()->AsPolymorphicInstanceCall()) {
+        return call;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// The receivers seen in training turn a call which CHA cannot resolve into
+// class id checks with a fallback to the generic call.
+ISOLATE_UNIT_TEST_CASE(AotProfile_Devirtualization) {
+  const auto& root_library = Library::Handle(LoadTestScript(kCallFooScript));
+  const auto& call_foo = Function::Handle(GetFunction(root_library, "callFoo"));
+  const auto& b = Class::Handle(GetClass(root_library, "B"));
+  const char* url = String::Handle(root_library.url()).ToCString();
+
+  TestPipeline pipeline(call_foo, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({CompilerPass::kComputeSSA});
+  InstanceCallInstr* call = FindInstanceCall(flow_graph);
+  EXPECT(call != nullptr);
+
+  const char* text = OS::SCreate(
+      thread->zone(),
+      "function\t10\t%s\n"
+      "call\t%" Pd32 "\t10\tfoo\n"
+      "receiver\t10\t%s\tB\n",
+      FunctionKey(thread->zone(), call_foo),
+      call->token_pos().Serialize(), url);
+  AotProfile* profile = AotProfileTestHelper::Parse(thread, text);
+  EXPECT(profile != nullptr);
+
+  AotProfileTestHelper::SetCurrent(profile);
+  pipeline.RunAdditionalPasses({CompilerPass::kApplyICData});
+  AotProfileTestHelper::SetCurrent(nullptr);
+
+  PolymorphicInstanceCallInstr* poly_call =
+      FindPolymorphicInstanceCall(flow_graph);
+  EXPECT(poly_call != nullptr);
+  EXPECT(!poly_call->complete());
+  EXPECT(poly_call->targets().IsMonomorphic());
+  EXPECT_EQ(b.id(), poly_call->targets().MonomorphicReceiverCid());
+}
+
+// Without a profile the call stays generic.
+ISOLATE_UNIT_TEST_CASE(AotProfile_NoDevirtualizationWithoutProfile) {
+  const auto& root_library = Library::Handle(LoadTestScript(kCallFooScript));
+  const auto& call_foo = Function::Handle(GetFunction(root_library, "callFoo"));
+
+  TestPipeline pipeline(call_foo, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses(
+      {CompilerPass::kComputeSSA, CompilerPass::kApplyICData});
+  EXPECT(FindInstanceCall(flow_graph) != nullptr);
+  EXPECT(FindPolymorphicInstanceCall(flow_graph) == nullptr);
+}
+
+// Functions which were not executed in training are placed with cold code.
+ISOLATE_UNIT_TEST_CASE(AotProfile_ColdCode) {
+  SetFlagScope<bool> sfs(&FLAG_cold_code_section, true);
+  const auto& root_library = Library::Handle(LoadTestScript(kCallFooScript));
+  const auto& call_foo = Function::Handle(GetFunction(root_library, "callFoo"));
+  const auto& a = Class::Handle(GetClass(root_library, "A"));
+  const auto& a_foo = Function::Handle(
+      a.LookupFunctionAllowPrivate(String::Handle(String::New("foo"))));
+
+  AotProfile* profile = AotProfileTestHelper::Parse(
+      thread, OS::SCreate(thread->zone(), "function\t1\t%s\n",
+                          FunctionKey(thread->zone(), call_foo)));
+  EXPECT(profile != nullptr);
+
+  TestPipeline call_foo_pipeline(call_foo, CompilerPass::kAOT);
+  FlowGraph* call_foo_graph = call_foo_pipeline.RunPasses({});
+  EXPECT(!Precompiler::IsColdCode(profile, call_foo, call_foo_graph));
+
+  TestPipeline a_foo_pipeline(a_foo, CompilerPass::kAOT);
+  FlowGraph* a_foo_graph = a_foo_pipeline.RunPasses({});
+  EXPECT(Precompiler::IsColdCode(profile, a_foo, a_foo_graph));
+  EXPECT(!Precompiler::IsColdCode(/*profile=*/nullptr, a_foo, a_foo_graph));
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -92,6 +92,9 @@ class DispatchTableGenerator {
 
   SelectorMap* selector_map() { return &selector_map_; }
 
+  // The number of class ids covered by the table.
+  int32_t num_classes() const { return num_classes_; }
+
   // Find suitable selectors and compute offsets for them.
   void Initialize(ClassTable* table);
 
@@ -4,6 +4,7 @@
 
 #include "vm/compiler/aot/precompiler.h"
 
+#include <atomic>
 #include <memory>
 
 #include "platform/unicode.h"
@@ -13,9 +14,11 @@
 #include "vm/closure_functions_cache.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph.h"
@@ -34,6 +37,7 @@
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart.h"
 #include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/ffi/native_assets.h"
@@ -54,6 +58,7 @@
 #include "vm/stack_trace.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/timer.h"
 #include "vm/type_testing_stubs.h"
@@ -85,6 +90,15 @@ DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
             "Print reasons for retaining objects to the given file");
+DEFINE_FLAG(bool,
+            cold_code_section,
+            true,
+            "Place code which is unlikely to run after all other code");
+DEFINE_FLAG(int,
+            precompiler_threads,
+            0,
+            "Number of helper threads compiling functions in parallel with "
+            "the main thread (0 compiles them one by one)");
 
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
@@ -345,6 +359,17 @@ class PrecompileParsedFunctionHelper : public ValueObject {
 
   bool Compile(CompilationPipeline* pipeline);
 
+  // The phases of Compile(), which may run on different threads when
+  // functions are compiled in parallel (see ParallelCompilation).
+  FlowGraph* BuildFlowGraph(CompilationPipeline* pipeline,
+                            ZoneGrowableArray<const ICData*>* ic_data_array);
+  void Optimize(CompilerPassState* pass_state);
+  // Returns false if the compilation needs to be retried because the
+  // global object pool has grown during code generation.
+  bool GenerateCode(CompilerPassState* pass_state,
+                    ZoneGrowableArray<const ICData*>* ic_data_array,
+                    intptr_t far_branch_level);
+
  private:
   ParsedFunction* parsed_function() const { return parsed_function_; }
   bool optimized() const { return optimized_; }
@@ -363,6 +388,95 @@ class PrecompileParsedFunctionHelper : public ValueObject {
   DISALLOW_COPY_AND_ASSIGN(PrecompileParsedFunctionHelper);
 };
 
+// Compiles a wave of functions in parallel (see
+// Precompiler::ProcessFunctionsInParallel).
+//
+// Helper threads build and optimize the flow graphs of the functions in the
+// order of the wave, while the main thread generates and installs their
+// code one by one in the same order. Code generation adds entries to the
+// global object pool and installs code, which must not happen concurrently,
+// and doing it in a fixed order keeps the output independent of the number
+// of threads and of their timing. For the same reason the inlining
+// heuristics cached in functions are only updated at the end of the wave
+// (see DeferredInliningInfo).
+//
+// The flow graph of a function lives in the zone of the thread which built
+// it. That thread waits until the main thread has generated code before
+// moving on to the next function, so the main thread can safely use and
+// extend the graph and at most one graph per thread is alive at a time. If
+// no helper thread got to a function yet, the main thread builds it itself.
+class ParallelCompilation : public ValueObject {
+ public:
+  explicit ParallelCompilation(Precompiler* precompiler);
+  ~ParallelCompilation();
+
+  void Add(const Function& function);
+
+  intptr_t length() const { return functions_.length(); }
+  const Function& function(intptr_t i) const { return *functions_[i]; }
+
+  // Starts up to [num_threads] helper threads. Returns the number of
+  // threads started.
+  intptr_t Start(intptr_t num_threads);
+
+  // Generates code for the [i]th function, which must be called in order.
+  // Returns false if the function must be compiled again once the wave is
+  // finished, e.g. because it bailed out.
+  bool GenerateCode(intptr_t i);
+
+  // Waits for all helper threads to exit and applies the inlining
+  // heuristics computed during the wave.
+  void Finish();
+
+ private:
+  class Worker;
+
+  enum class State {
+    kPending,
+    kBuilt,
+    kDone,
+  };
+
+  struct Result {
+    State state = State::kPending;
+    ParsedFunction* parsed_function = nullptr;
+    // nullptr if building the graph failed.
+    FlowGraph* flow_graph = nullptr;
+    ZoneGrowableArray<const ICData*>* ic_data_array = nullptr;
+    ZoneGrowableArray<const Function*>* inline_id_to_function = nullptr;
+    ZoneGrowableArray<TokenPosition>* inline_id_to_token_pos = nullptr;
+    ZoneGrowableArray<intptr_t>* caller_inline_id = nullptr;
+    DeferredInliningInfo* deferred_inlining_info = nullptr;
+    SlotCache* slot_cache = nullptr;
+    intptr_t deopt_id = 0;
+  };
+
+  void RunWorker();
+
+  // Returns the index of the next function to build or -1 if there is none.
+  intptr_t ClaimNext();
+
+  // Builds and optimizes the flow graph of the [i]th function on [thread].
+  void Build(Thread* thread, intptr_t i);
+
+  // Generates code from the flow graph of the [i]th function on [thread].
+  bool Finalize(Thread* thread, intptr_t i);
+
+  Precompiler* const precompiler_;
+  Zone* const zone_;
+  GrowableArray<const Function*> functions_;
+  Result* results_ = nullptr;
+  std::atomic<intptr_t> next_ = {0};
+  DeferredInliningInfo deferred_inlining_info_;
+
+  // Protects the states of results and the fields below.
+  Monitor monitor_;
+  intptr_t running_ = 0;
+  MallocGrowableArray<CompilerTimings*> worker_timings_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCompilation);
+};
+
 static void Jump(const Error& error) {
   Thread::Current()->long_jump_base()->Jump(1, error);
 }
@@ -385,6 +499,19 @@ void Precompiler::ReportStats() {
   }
 
   thread()->compiler_timings()->Print();
+
+  if (cold_code_count_ > 0) {
+    OS::PrintErr("Placed %" Pd " cold functions (%" Pd
+                 " bytes) after all other code\n",
+                 cold_code_count_, cold_code_size_);
+  }
+  if (parallel_wave_count_ > 0) {
+    OS::PrintErr("Compiled %" Pd " functions in %" Pd
+                 " waves using up to %" Pd " helper threads (%" Pd
+                 " compiled again on the main thread)\n",
+                 function_count_, parallel_wave_count_, parallel_thread_count_,
+                 parallel_retry_count_);
+  }
 }
 
 Precompiler::Precompiler(Thread* thread)
@@ -512,6 +639,7 @@ void Precompiler::DoCompileAll() {
           /*including_nonchanging_cids=*/true);
 
       tracer_ = PrecompilerTracer::StartTracingIfRequested(this);
+      profile_ = AotProfile::ReadIfRequested(T);
 
       // All stubs have already been generated, all of them share the same pool.
       // We use that pool to initialize our global object pool, to guarantee
@@ -660,6 +788,7 @@ void Precompiler::DoCompileAll() {
       retained_reasons_writer_ = nullptr;
     }
 
+    profile_ = nullptr;
     zone_ = nullptr;
   }
 
@@ -773,8 +902,12 @@ void Precompiler::Iterate() {
     changed_ = false;
 
     while (pending_functions_.Length() > 0) {
-      function ^= pending_functions_.RemoveLast();
-      ProcessFunction(function);
+      if (FLAG_precompiler_threads > 0) {
+        ProcessFunctionsInParallel();
+      } else {
+        function ^= pending_functions_.RemoveLast();
+        ProcessFunction(function);
+      }
     }
 
     CheckForNewDynamicFunctions();
@@ -880,9 +1013,86 @@ void Precompiler::ProcessFunction(const Function& function) {
 
   // Used in the JIT to save type-feedback across compilations.
   function.ClearICDataArray();
+  CountColdCode(function);
   AddCalleesOf(function, gop_offset);
 }
 
+void Precompiler::CountColdCode(const Function& function) {
+  const Code& code = Code::Handle(Z, function.CurrentCode());
+  if (code.is_cold()) {
+    cold_code_count_++;
+    cold_code_size_ += code.Size();
+  }
+}
+
+void Precompiler::ProcessFunctionsInParallel() {
+  HANDLESCOPE(T);
+  // The wave consists of all pending functions, in the order in which they
+  // would be compiled one by one. Callees found while compiling it form the
+  // next wave.
+  ParallelCompilation compilation(this);
+  Function& pending = Function::Handle(Z);
+  while (pending_functions_.Length() > 0) {
+    pending ^= pending_functions_.RemoveLast();
+    compilation.Add(pending);
+  }
+  const intptr_t num_threads = compilation.Start(FLAG_precompiler_threads);
+  parallel_thread_count_ = Utils::Maximum(parallel_thread_count_, num_threads);
+  parallel_wave_count_++;
+
+  GrowableArray<const Function*> retry;
+  for (intptr_t i = 0; i < compilation.length(); i++) {
+    const Function& function = compilation.function(i);
+    const intptr_t gop_offset = global_object_pool_builder()->CurrentLength();
+    RELEASE_ASSERT(!function.HasCode());
+
+    TracingScope tracing_scope(this);
+    function_count_++;
+
+    if (FLAG_trace_precompiler) {
+      THR_Print("Precompiling %" Pd " %s (%s, %s)\n", function_count_,
+                function.ToLibNamePrefixedQualifiedCString(),
+                function.token_pos().ToCString(),
+                Function::KindToCString(function.kind()));
+    }
+
+    bool compiled;
+    {
+      PRECOMPILER_TIMER_SCOPE(this, CompileFunction);
+      compiled = compilation.GenerateCode(i);
+    }
+    if (!compiled) {
+      retry.Add(&function);
+      continue;
+    }
+    if (is_tracing()) {
+      tracer_->WriteCompileFunctionEvent(function);
+    }
+
+    // Used in the JIT to save type-feedback across compilations.
+    function.ClearICDataArray();
+    CountColdCode(function);
+    AddCalleesOf(function, gop_offset);
+  }
+  compilation.Finish();
+
+  // Functions which bailed out are compiled again one by one, which also
+  // reports compile-time errors.
+  parallel_retry_count_ += retry.length();
+  for (const Function* function : retry) {
+    HANDLESCOPE(T);
+    const intptr_t gop_offset = global_object_pool_builder()->CurrentLength();
+    TracingScope tracing_scope(this);
+    error_ = CompileFunction(this, thread_, zone_, *function);
+    if (!error_.IsNull()) {
+      Jump(error_);
+    }
+    function->ClearICDataArray();
+    CountColdCode(*function);
+    AddCalleesOf(*function, gop_offset);
+  }
+}
+
 void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
   PRECOMPILER_TIMER_SCOPE(this, AddCalleesOf);
   ASSERT(function.HasCode());
@@ -2035,6 +2245,9 @@ void Precompiler::FinalizeDispatchTable() {
   const auto& entries =
       Array::Handle(Z, dispatch_table_generator_->BuildCodeArray());
   IG->object_store()->set_dispatch_table_code_entries(entries);
+#if defined(DART_DYNAMIC_MODULES)
+  FinalizeDispatchTableInterfaceSelectors();
+#endif  // defined(DART_DYNAMIC_MODULES)
   // Delete the dispatch table generator to ensure there's no attempt
   // to add new entries after this point.
   delete dispatch_table_generator_;
@@ -2060,6 +2273,43 @@ void Precompiler::FinalizeDispatchTable() {
   printed.Release();
 }
 
+#if defined(DART_DYNAMIC_MODULES)
+void Precompiler::FinalizeDispatchTableInterfaceSelectors() {
+  // Bytecode of dynamic modules can only call into the program through
+  // functions with entry point pragmas. Record the table offsets of their
+  // selectors so that the interpreter can make interface calls to them
+  // through the dispatch table instead of looking up the target by name.
+  //
+  // The first element is the number of class ids covered by the table, the
+  // others are pairs of interface targets and selector offsets.
+  const auto& selectors =
+      GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  selectors.Add(Smi::Handle(
+      Z, Smi::New(dispatch_table_generator_->num_classes())));
+  auto& function = Function::Handle(Z);
+  auto& offset = Smi::Handle(Z);
+  FunctionSet::Iterator it(&functions_with_entry_point_pragmas_);
+  while (it.MoveNext()) {
+    function ^= functions_with_entry_point_pragmas_.GetKey(it.Current());
+    if (function.is_static() || !functions_to_retain_.ContainsKey(function)) {
+      continue;
+    }
+    const compiler::TableSelector* selector =
+        selector_map()->GetSelector(function);
+    if (selector == nullptr) {
+      continue;
+    }
+    offset = Smi::New(selector->offset);
+    selectors.Add(function);
+    selectors.Add(offset);
+  }
+  if (selectors.Length() > 1) {
+    IG->object_store()->set_dispatch_table_interface_selectors(
+        Array::Handle(Z, Array::MakeFixedLength(selectors)));
+  }
+}
+#endif  // defined(DART_DYNAMIC_MODULES)
+
 void Precompiler::ReplaceFunctionStaticCallEntries() {
   PRECOMPILER_TIMER_SCOPE(this, ReplaceFunctionStaticCallEntries);
   class StaticCallTableEntryFixer : public CodeVisitor {
@@ -3405,6 +3655,54 @@ void Precompiler::FinalizeAllClasses() {
   IG->set_all_classes_finalized(true);
 }
 
+bool Precompiler::IsColdCode(const AotProfile* profile,
+                             const Function& function,
+                             FlowGraph* flow_graph) {
+  if (!FLAG_cold_code_section) {
+    return false;
+  }
+
+  if (profile != nullptr) {
+    switch (function.kind()) {
+      case UntaggedFunction::kRegularFunction:
+      case UntaggedFunction::kClosureFunction:
+      case UntaggedFunction::kGetterFunction:
+      case UntaggedFunction::kSetterFunction:
+      case UntaggedFunction::kConstructor:
+        if (!profile->WasExecuted(function)) {
+          return true;
+        }
+        break;
+      default:
+        // Other functions are created on demand and may have been compiled
+        // differently in training.
+        break;
+    }
+  }
+
+  // Only code which leaves every path by throwing is cold. Returns, tail
+  // calls (e.g. into the resume stub) and any other exit keep it hot.
+  bool throws = false;
+  for (auto block : flow_graph->reverse_postorder()) {
+    Instruction* last = block->last_instruction();
+    // A function without returns may loop forever rather than throw.
+    if (auto goto_instr = last->AsGoto()) {
+      if (goto_instr->successor()->preorder_number() <=
+          block->preorder_number()) {
+        return false;
+      }
+    }
+    if (last->SuccessorCount() > 0) {
+      continue;
+    }
+    if (!last->IsThrow() && !last->IsReThrow()) {
+      return false;
+    }
+    throws = true;
+  }
+  return throws;
+}
+
 void PrecompileParsedFunctionHelper::FinalizeCompilation(
     compiler::Assembler* assembler,
     FlowGraphCompiler* graph_compiler,
@@ -3420,12 +3718,15 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
   // Allocates instruction object. Since this occurs only at safepoint,
   // there can be no concurrent access to the instruction page.
   const auto pool_attachment = Code::PoolAttachment::kNotAttachPool;
+  const bool is_cold =
+      Precompiler::IsColdCode(precompiler_->profile(), function, flow_graph);
 
   SafepointWriteRwLocker ml(T, T->isolate_group()->program_lock());
   const Code& code = Code::Handle(
       Code::FinalizeCodeAndNotify(function, graph_compiler, assembler,
                                   pool_attachment, optimized(), stats));
   code.set_is_optimized(optimized());
+  code.set_is_cold(is_cold);
   code.set_owner(function);
   if (!function.IsOptimizable()) {
     // A function with huge unoptimized code can become non-optimizable
@@ -3468,6 +3769,147 @@ static void GenerateNecessaryAllocationStubs(FlowGraph* flow_graph) {
   }
 }
 
+FlowGraph* PrecompileParsedFunctionHelper::BuildFlowGraph(
+    CompilationPipeline* pipeline,
+    ZoneGrowableArray<const ICData*>* ic_data_array) {
+  const Function& function = parsed_function()->function();
+  FlowGraph* flow_graph = nullptr;
+  {
+    TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
+    COMPILER_TIMINGS_TIMER_SCOPE(thread(), BuildGraph);
+    flow_graph =
+        pipeline->BuildFlowGraph(thread()->zone(), parsed_function(),
+                                 ic_data_array, Compiler::kNoOSRDeoptId,
+                                 optimized());
+  }
+
+  if (optimized()) {
+    flow_graph->PopulateWithICData(function);
+  }
+
+  if (optimized() && flow_graph->should_reorder_blocks()) {
+    TIMELINE_DURATION(thread(), CompilerVerbose,
+                      "BlockScheduler::AssignEdgeWeights");
+    BlockScheduler::AssignEdgeWeights(flow_graph);
+  }
+
+  const bool print_flow_graph =
+      (FLAG_print_flow_graph ||
+       (optimized() && FLAG_print_flow_graph_optimized)) &&
+      FlowGraphPrinter::ShouldPrint(function);
+
+  if (print_flow_graph && !optimized()) {
+    FlowGraphPrinter::PrintGraph("Unoptimized Compilation", flow_graph);
+  }
+
+  return flow_graph;
+}
+
+void PrecompileParsedFunctionHelper::Optimize(CompilerPassState* pass_state) {
+  if (optimized()) {
+    TIMELINE_DURATION(thread(), CompilerVerbose, "OptimizationPasses");
+
+    AotCallSpecializer call_specializer(precompiler_, pass_state->flow_graph(),
+                                        pass_state->speculative_policy);
+    pass_state->call_specializer = &call_specializer;
+
+    CompilerPass::RunPipeline(CompilerPass::kAOT, pass_state);
+  }
+}
+
+bool PrecompileParsedFunctionHelper::GenerateCode(
+    CompilerPassState* pass_state,
+    ZoneGrowableArray<const ICData*>* ic_data_array,
+    intptr_t far_branch_level) {
+  FlowGraph* flow_graph = pass_state->flow_graph();
+  ASSERT(pass_state->inline_id_to_function.length() ==
+         pass_state->caller_inline_id.length());
+
+  ASSERT(precompiler_ != nullptr);
+
+  // When generating code in bare instruction mode all code objects
+  // share the same global object pool. To reduce interleaving of
+  // unrelated object pool entries from different code objects
+  // we attempt to pregenerate stubs referenced by the code
+  // we are going to generate.
+  //
+  // Reducing interleaving means reducing recompilations triggered by
+  // failure to commit object pool into the global object pool.
+  GenerateNecessaryAllocationStubs(flow_graph);
+
+  // Even in bare instructions mode we don't directly add objects into
+  // the global object pool because code generation can bail out
+  // (e.g. due to speculative optimization or branch offsets being
+  // too big). If we were adding objects into the global pool directly
+  // these recompilations would leave dead entries behind.
+  // Instead we add objects into an intermediary pool which gets
+  // committed into the global object pool at the end of the compilation.
+  // This makes an assumption that global object pool itself does not
+  // grow during code generation - unfortunately this is not the case
+  // because we might have nested code generation (i.e. we might generate
+  // some stubs). If this indeed happens we retry the compilation.
+  // (See TryCommitToParent invocation below).
+  compiler::ObjectPoolBuilder object_pool_builder(
+      precompiler_->global_object_pool_builder());
+  compiler::Assembler assembler(&object_pool_builder, far_branch_level);
+
+  CodeStatistics* function_stats = nullptr;
+  if (FLAG_print_instruction_stats) {
+    // At the moment we are leaking CodeStatistics objects for
+    // simplicity because this is just a development mode flag.
+    function_stats = new CodeStatistics(&assembler);
+  }
+
+  FlowGraphCompiler graph_compiler(
+      &assembler, flow_graph, *parsed_function(), optimized(),
+      pass_state->speculative_policy, pass_state->inline_id_to_function,
+      pass_state->inline_id_to_token_pos, pass_state->caller_inline_id,
+      ic_data_array, function_stats);
+  pass_state->graph_compiler = &graph_compiler;
+  CompilerPass::GenerateCode(pass_state);
+  {
+    COMPILER_TIMINGS_TIMER_SCOPE(thread(), FinalizeCode);
+    TIMELINE_DURATION(thread(), CompilerVerbose, "FinalizeCompilation");
+    ASSERT(thread()->IsDartMutatorThread());
+    FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
+                        function_stats);
+  }
+
+  if (precompiler_->phase() == Precompiler::Phase::kFixpointCodeGeneration) {
+    for (intptr_t i = 0; i < graph_compiler.used_static_fields().length();
+         i++) {
+      precompiler_->AddField(*graph_compiler.used_static_fields().At(i));
+    }
+
+    const GrowableArray<const compiler::TableSelector*>& call_selectors =
+        graph_compiler.dispatch_table_call_targets();
+    for (intptr_t i = 0; i < call_selectors.length(); i++) {
+      precompiler_->AddTableSelector(call_selectors[i]);
+    }
+  } else {
+    // We should not be generating code outside of these two specific
+    // precompilation phases.
+    RELEASE_ASSERT(
+        precompiler_->phase() ==
+        Precompiler::Phase::kCompilingConstructorsForInstructionCounts);
+  }
+
+  // In bare instructions mode try adding all entries from the object
+  // pool into the global object pool. This might fail if we have
+  // nested code generation (i.e. we generated some stubs) which means
+  // that some of the object indices we used are already occupied in the
+  // global object pool.
+  //
+  // In this case we simply retry compilation assuming that we are not
+  // going to hit this problem on the second attempt.
+  //
+  // Note: currently we can't assume that two compilations of the same
+  // method will lead to the same IR due to instability of inlining
+  // heuristics (under some conditions we might end up inlining
+  // more aggressively on the second attempt).
+  return object_pool_builder.TryCommitToParent();
+}
+
 // Return false if bailed out.
 bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   ASSERT(CompilerState::Current().is_aot());
@@ -3495,137 +3937,21 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
     LongJumpScope jump;
     const intptr_t val = setjmp(*jump.Set());
     if (val == 0) {
-      FlowGraph* flow_graph = nullptr;
-      ZoneGrowableArray<const ICData*>* ic_data_array = nullptr;
       const Function& function = parsed_function()->function();
 
       CompilerState compiler_state(thread(), /*is_aot=*/true, optimized(),
                                    CompilerState::ShouldTrace(function));
       compiler_state.set_function(function);
 
-      {
-        ic_data_array = new (zone) ZoneGrowableArray<const ICData*>();
-
-        TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
-        COMPILER_TIMINGS_TIMER_SCOPE(thread(), BuildGraph);
-        flow_graph =
-            pipeline->BuildFlowGraph(zone, parsed_function(), ic_data_array,
-                                     Compiler::kNoOSRDeoptId, optimized());
-      }
-
-      if (optimized()) {
-        flow_graph->PopulateWithICData(function);
-      }
-
-      const bool print_flow_graph =
-          (FLAG_print_flow_graph ||
-           (optimized() && FLAG_print_flow_graph_optimized)) &&
-          FlowGraphPrinter::ShouldPrint(function);
-
-      if (print_flow_graph && !optimized()) {
-        FlowGraphPrinter::PrintGraph("Unoptimized Compilation", flow_graph);
-      }
+      ZoneGrowableArray<const ICData*>* ic_data_array =
+          new (zone) ZoneGrowableArray<const ICData*>();
+      FlowGraph* flow_graph = BuildFlowGraph(pipeline, ic_data_array);
 
       CompilerPassState pass_state(thread(), flow_graph, &speculative_policy,
                                    precompiler_);
+      Optimize(&pass_state);
 
-      if (optimized()) {
-        TIMELINE_DURATION(thread(), CompilerVerbose, "OptimizationPasses");
-
-        AotCallSpecializer call_specializer(precompiler_, flow_graph,
-                                            &speculative_policy);
-        pass_state.call_specializer = &call_specializer;
-
-        flow_graph = CompilerPass::RunPipeline(CompilerPass::kAOT, &pass_state);
-      }
-
-      ASSERT(pass_state.inline_id_to_function.length() ==
-             pass_state.caller_inline_id.length());
-
-      ASSERT(precompiler_ != nullptr);
-
-      // When generating code in bare instruction mode all code objects
-      // share the same global object pool. To reduce interleaving of
-      // unrelated object pool entries from different code objects
-      // we attempt to pregenerate stubs referenced by the code
-      // we are going to generate.
-      //
-      // Reducing interleaving means reducing recompilations triggered by
-      // failure to commit object pool into the global object pool.
-      GenerateNecessaryAllocationStubs(flow_graph);
-
-      // Even in bare instructions mode we don't directly add objects into
-      // the global object pool because code generation can bail out
-      // (e.g. due to speculative optimization or branch offsets being
-      // too big). If we were adding objects into the global pool directly
-      // these recompilations would leave dead entries behind.
-      // Instead we add objects into an intermediary pool which gets
-      // committed into the global object pool at the end of the compilation.
-      // This makes an assumption that global object pool itself does not
-      // grow during code generation - unfortunately this is not the case
-      // because we might have nested code generation (i.e. we might generate
-      // some stubs). If this indeed happens we retry the compilation.
-      // (See TryCommitToParent invocation below).
-      compiler::ObjectPoolBuilder object_pool_builder(
-          precompiler_->global_object_pool_builder());
-      compiler::Assembler assembler(&object_pool_builder, far_branch_level);
-
-      CodeStatistics* function_stats = nullptr;
-      if (FLAG_print_instruction_stats) {
-        // At the moment we are leaking CodeStatistics objects for
-        // simplicity because this is just a development mode flag.
-        function_stats = new CodeStatistics(&assembler);
-      }
-
-      FlowGraphCompiler graph_compiler(
-          &assembler, flow_graph, *parsed_function(), optimized(),
-          &speculative_policy, pass_state.inline_id_to_function,
-          pass_state.inline_id_to_token_pos, pass_state.caller_inline_id,
-          ic_data_array, function_stats);
-      pass_state.graph_compiler = &graph_compiler;
-      CompilerPass::GenerateCode(&pass_state);
-      {
-        COMPILER_TIMINGS_TIMER_SCOPE(thread(), FinalizeCode);
-        TIMELINE_DURATION(thread(), CompilerVerbose, "FinalizeCompilation");
-        ASSERT(thread()->IsDartMutatorThread());
-        FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
-                            function_stats);
-      }
-
-      if (precompiler_->phase() ==
-          Precompiler::Phase::kFixpointCodeGeneration) {
-        for (intptr_t i = 0; i < graph_compiler.used_static_fields().length();
-             i++) {
-          precompiler_->AddField(*graph_compiler.used_static_fields().At(i));
-        }
-
-        const GrowableArray<const compiler::TableSelector*>& call_selectors =
-            graph_compiler.dispatch_table_call_targets();
-        for (intptr_t i = 0; i < call_selectors.length(); i++) {
-          precompiler_->AddTableSelector(call_selectors[i]);
-        }
-      } else {
-        // We should not be generating code outside of these two specific
-        // precompilation phases.
-        RELEASE_ASSERT(
-            precompiler_->phase() ==
-            Precompiler::Phase::kCompilingConstructorsForInstructionCounts);
-      }
-
-      // In bare instructions mode try adding all entries from the object
-      // pool into the global object pool. This might fail if we have
-      // nested code generation (i.e. we generated some stubs) which means
-      // that some of the object indices we used are already occupied in the
-      // global object pool.
-      //
-      // In this case we simply retry compilation assuming that we are not
-      // going to hit this problem on the second attempt.
-      //
-      // Note: currently we can't assume that two compilations of the same
-      // method will lead to the same IR due to instability of inlining
-      // heuristics (under some conditions we might end up inlining
-      // more aggressively on the second attempt).
-      if (!object_pool_builder.TryCommitToParent()) {
+      if (!GenerateCode(&pass_state, ic_data_array, far_branch_level)) {
         done = false;
         continue;
       }
@@ -3679,6 +4005,17 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   return is_compiled;
 }
 
+static void DisassembleIfRequested(const Function& function, bool optimized) {
+  if (FLAG_disassemble && FlowGraphPrinter::ShouldPrint(function)) {
+    Code& code = Code::Handle(function.CurrentCode());
+    Disassembler::DisassembleCode(function, code, optimized);
+  } else if (FLAG_disassemble_optimized && optimized &&
+             FlowGraphPrinter::ShouldPrint(function)) {
+    Code& code = Code::Handle(function.CurrentCode());
+    Disassembler::DisassembleCode(function, code, true);
+  }
+}
+
 static ErrorPtr PrecompileFunctionHelper(Precompiler* precompiler,
                                          CompilationPipeline* pipeline,
                                          const Function& function,
@@ -3731,14 +4068,7 @@ static ErrorPtr PrecompileFunctionHelper(Precompiler* precompiler,
                 per_compile_timer.TotalElapsedTime());
     }
 
-    if (FLAG_disassemble && FlowGraphPrinter::ShouldPrint(function)) {
-      Code& code = Code::Handle(function.CurrentCode());
-      Disassembler::DisassembleCode(function, code, optimized);
-    } else if (FLAG_disassemble_optimized && optimized &&
-               FlowGraphPrinter::ShouldPrint(function)) {
-      Code& code = Code::Handle(function.CurrentCode());
-      Disassembler::DisassembleCode(function, code, true);
-    }
+    DisassembleIfRequested(function, optimized);
     return Error::null();
   } else {
     Thread* const thread = Thread::Current();
@@ -3774,6 +4104,272 @@ ErrorPtr Precompiler::CompileFunction(Precompiler* precompiler,
   return PrecompileFunctionHelper(precompiler, &pipeline, function, optimized);
 }
 
+class ParallelCompilation::Worker : public ThreadPool::Task {
+ public:
+  explicit Worker(ParallelCompilation* compilation)
+      : compilation_(compilation) {}
+  virtual ~Worker() {}
+
+ private:
+  virtual void Run() { compilation_->RunWorker(); }
+
+  ParallelCompilation* const compilation_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+ParallelCompilation::ParallelCompilation(Precompiler* precompiler)
+    : precompiler_(precompiler),
+      zone_(precompiler->zone()),
+      functions_(precompiler->zone(), 64) {}
+
+ParallelCompilation::~ParallelCompilation() {
+  ASSERT(running_ == 0);
+  delete[] results_;
+}
+
+void ParallelCompilation::Add(const Function& function) {
+  ASSERT(results_ == nullptr);
+  functions_.Add(&Function::ZoneHandle(zone_, function.ptr()));
+}
+
+intptr_t ParallelCompilation::Start(intptr_t num_threads) {
+  results_ = new Result[length()];
+  num_threads = Utils::Minimum(num_threads, length());
+  intptr_t started = 0;
+  for (intptr_t i = 0; i < num_threads; i++) {
+    {
+      MonitorLocker ml(&monitor_);
+      running_++;
+    }
+    if (!Dart::thread_pool()->Run<Worker>(this)) {
+      MonitorLocker ml(&monitor_);
+      running_--;
+      break;
+    }
+    started++;
+  }
+  return started;
+}
+
+intptr_t ParallelCompilation::ClaimNext() {
+  const intptr_t i = next_.fetch_add(1);
+  return i < length() ? i : -1;
+}
+
+void ParallelCompilation::RunWorker() {
+  IsolateGroup* isolate_group = precompiler_->thread()->isolate_group();
+  if (Thread::EnterIsolateGroupAsHelper(isolate_group, Thread::kCompilerTask,
+                                        /*bypass_safepoint=*/false)) {
+    Thread* thread = Thread::Current();
+    CompilerTimings* timings = nullptr;
+    if (FLAG_print_precompiler_timings) {
+      timings = new CompilerTimings();
+      thread->set_compiler_timings(timings);
+    }
+    for (intptr_t i = ClaimNext(); i >= 0; i = ClaimNext()) {
+      StackZone stack_zone(thread);
+      HANDLESCOPE(thread);
+      Build(thread, i);
+
+      // Keep the flow graph alive until the main thread is done with it.
+      MonitorLocker ml(&monitor_);
+      results_[i].state = State::kBuilt;
+      ml.NotifyAll();
+      while (results_[i].state != State::kDone) {
+        ml.WaitWithSafepointCheck(thread);
+      }
+    }
+    if (timings != nullptr) {
+      thread->set_compiler_timings(nullptr);
+      MonitorLocker ml(&monitor_);
+      worker_timings_.Add(timings);
+    }
+    Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/false);
+  }
+
+  // This notification must happen after the thread left the isolate group
+  // to avoid a shutdown race with the thread registry.
+  MonitorLocker ml(&monitor_);
+  running_--;
+  ml.NotifyAll();
+}
+
+void ParallelCompilation::Build(Thread* thread, intptr_t i) {
+  Result* const result = &results_[i];
+  Zone* const zone = thread->zone();
+  const Function& function = Function::ZoneHandle(zone, functions_[i]->ptr());
+  const bool optimized = function.IsOptimizable();
+
+  LongJumpScope jump;
+  if (setjmp(*jump.Set()) == 0) {
+    CompilerState compiler_state(thread, /*is_aot=*/true, optimized,
+                                 CompilerState::ShouldTrace(function));
+    compiler_state.set_function(function);
+    DeferredInliningInfo* deferred = new (zone) DeferredInliningInfo();
+    compiler_state.set_deferred_inlining_info(deferred);
+
+    DartCompilationPipeline pipeline;
+    ParsedFunction* parsed_function =
+        new (zone) ParsedFunction(thread, function);
+    {
+      HANDLESCOPE(thread);
+      pipeline.ParseFunction(parsed_function);
+    }
+
+    // Speculative inlining is only restricted after a bailout, in which
+    // case the function is compiled again by the main thread.
+    SpeculativeInliningPolicy speculative_policy(
+        true, FLAG_max_speculative_inlining_attempts);
+    PrecompileParsedFunctionHelper helper(precompiler_, parsed_function,
+                                          optimized);
+    auto ic_data_array = new (zone) ZoneGrowableArray<const ICData*>();
+    FlowGraph* flow_graph = helper.BuildFlowGraph(&pipeline, ic_data_array);
+    CompilerPassState pass_state(thread, flow_graph, &speculative_policy,
+                                 precompiler_);
+    helper.Optimize(&pass_state);
+
+    result->parsed_function = parsed_function;
+    result->flow_graph = pass_state.flow_graph();
+    result->ic_data_array = ic_data_array;
+    result->inline_id_to_function =
+        new (zone) ZoneGrowableArray<const Function*>();
+    for (auto inlined : pass_state.inline_id_to_function) {
+      result->inline_id_to_function->Add(inlined);
+    }
+    result->inline_id_to_token_pos =
+        new (zone) ZoneGrowableArray<TokenPosition>();
+    for (auto token_pos : pass_state.inline_id_to_token_pos) {
+      result->inline_id_to_token_pos->Add(token_pos);
+    }
+    result->caller_inline_id = new (zone) ZoneGrowableArray<intptr_t>();
+    for (auto caller_id : pass_state.caller_inline_id) {
+      result->caller_inline_id->Add(caller_id);
+    }
+    result->deferred_inlining_info = deferred;
+    result->slot_cache = compiler_state.slot_cache();
+    result->deopt_id = compiler_state.deopt_id();
+  } else {
+    // Bailouts and errors are reported when the function is compiled again.
+    thread->ClearStickyError();
+    result->flow_graph = nullptr;
+  }
+}
+
+bool ParallelCompilation::Finalize(Thread* thread, intptr_t i) {
+  Result* const result = &results_[i];
+  if (result->flow_graph == nullptr) {
+    return false;
+  }
+  deferred_inlining_info_.AddAll(zone_, *result->deferred_inlining_info);
+
+  ParsedFunction* parsed_function = result->parsed_function;
+  const Function& function = parsed_function->function();
+  const bool optimized = function.IsOptimizable();
+
+  LongJumpScope jump;
+  if (setjmp(*jump.Set()) == 0) {
+    FlowGraph* flow_graph = result->flow_graph;
+    flow_graph->set_thread(thread);
+    parsed_function->set_thread(thread);
+
+    CompilerState compiler_state(thread, /*is_aot=*/true, optimized,
+                                 CompilerState::ShouldTrace(function));
+    compiler_state.set_function(function);
+    compiler_state.set_slot_cache(result->slot_cache);
+    compiler_state.set_deopt_id(result->deopt_id);
+
+    SpeculativeInliningPolicy speculative_policy(
+        true, FLAG_max_speculative_inlining_attempts);
+    CompilerPassState pass_state(thread, flow_graph, &speculative_policy,
+                                 precompiler_);
+    pass_state.inline_id_to_function.Clear();
+    for (auto inlined : *result->inline_id_to_function) {
+      pass_state.inline_id_to_function.Add(inlined);
+    }
+    for (auto token_pos : *result->inline_id_to_token_pos) {
+      pass_state.inline_id_to_token_pos.Add(token_pos);
+    }
+    pass_state.caller_inline_id.Clear();
+    for (auto caller_id : *result->caller_inline_id) {
+      pass_state.caller_inline_id.Add(caller_id);
+    }
+
+    PrecompileParsedFunctionHelper helper(precompiler_, parsed_function,
+                                          optimized);
+    if (!helper.GenerateCode(&pass_state, result->ic_data_array,
+                             /*far_branch_level=*/0)) {
+      // The global object pool grew during code generation, so the code
+      // installed for the function cannot be used.
+      SafepointWriteRwLocker ml(thread,
+                                thread->isolate_group()->program_lock());
+      function.ClearCode();
+      return false;
+    }
+    DisassembleIfRequested(function, optimized);
+    return true;
+  } else {
+    // The function is compiled again, which reports errors.
+    thread->ClearStickyError();
+    return false;
+  }
+}
+
+bool ParallelCompilation::GenerateCode(intptr_t i) {
+  Thread* const thread = Thread::Current();
+  NoActiveIsolateScope no_isolate_scope;
+  VMTagScope tag_scope(thread, VMTag::kCompileUnoptimizedTagId);
+  TIMELINE_FUNCTION_COMPILATION_DURATION(thread, "CompileFunction",
+                                         function(i));
+
+  intptr_t expected = i;
+  if (next_.compare_exchange_strong(expected, i + 1)) {
+    // No helper thread got to this function yet.
+    StackZone stack_zone(thread);
+    HANDLESCOPE(thread);
+    Build(thread, i);
+    const bool success = Finalize(thread, i);
+    results_[i].state = State::kDone;
+    return success;
+  }
+
+  {
+    MonitorLocker ml(&monitor_);
+    while (results_[i].state != State::kBuilt) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+  bool success;
+  {
+    StackZone stack_zone(thread);
+    HANDLESCOPE(thread);
+    success = Finalize(thread, i);
+  }
+  MonitorLocker ml(&monitor_);
+  results_[i].state = State::kDone;
+  ml.NotifyAll();
+  return success;
+}
+
+void ParallelCompilation::Finish() {
+  Thread* const thread = Thread::Current();
+  {
+    MonitorLocker ml(&monitor_);
+    while (running_ > 0) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+  deferred_inlining_info_.Apply();
+  CompilerTimings* timings = thread->compiler_timings();
+  for (CompilerTimings* worker_timings : worker_timings_) {
+    if (timings != nullptr) {
+      timings->MergeNested(*worker_timings);
+    }
+    delete worker_timings;
+  }
+  worker_timings_.Clear();
+}
+
 Obfuscator::Obfuscator(Thread* thread, const String& private_key)
     : state_(nullptr) {
   auto isolate_group = thread->isolate_group();
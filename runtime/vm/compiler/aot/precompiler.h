@@ -21,6 +21,7 @@
 namespace dart {
 
 // Forward declarations.
+class AotProfile;
 class Class;
 class Error;
 class Field;
@@ -248,6 +249,14 @@ class Precompiler : public ValueObject {
                                   Zone* zone,
                                   const Function& function);
 
+  // Returns true if the code of [function] compiled from [flow_graph] is
+  // unlikely to run and belongs in the cold code section: [function] was not
+  // executed in training (see [profile], may be null) or every path through
+  // it ends in a throw.
+  static bool IsColdCode(const AotProfile* profile,
+                         const Function& function,
+                         FlowGraph* flow_graph);
+
   // Returns true if get:runtimeType is not overloaded by any class.
   bool get_runtime_type_is_unique() const {
     return get_runtime_type_is_unique_;
@@ -280,6 +289,9 @@ class Precompiler : public ValueObject {
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
+  // Type feedback from a training run, if any (see AotProfile).
+  AotProfile* profile() const { return profile_; }
+
  private:
   static Precompiler* singleton_;
 
@@ -333,6 +345,11 @@ class Precompiler : public ValueObject {
   bool HasApiUse(const Object& obj);
 
   void ProcessFunction(const Function& function);
+  // Compiles all pending functions using FLAG_precompiler_threads helper
+  // threads (see ParallelCompilation).
+  void ProcessFunctionsInParallel();
+  // Updates the statistics of code placed after all other code.
+  void CountColdCode(const Function& function);
   void CheckForNewDynamicFunctions();
   void CollectCallbackFields();
 
@@ -340,6 +357,9 @@ class Precompiler : public ValueObject {
 
   void TraceForRetainedFunctions();
   void FinalizeDispatchTable();
+#if defined(DART_DYNAMIC_MODULES)
+  void FinalizeDispatchTableInterfaceSelectors();
+#endif  // defined(DART_DYNAMIC_MODULES)
   void ReplaceFunctionStaticCallEntries();
   void DropFunctions();
   void DropFields();
@@ -385,6 +405,11 @@ class Precompiler : public ValueObject {
   intptr_t dropped_typeparam_count_;
   intptr_t dropped_library_count_;
   intptr_t dropped_constants_arrays_entries_count_;
+  intptr_t parallel_wave_count_ = 0;
+  intptr_t parallel_thread_count_ = 0;
+  intptr_t parallel_retry_count_ = 0;
+  intptr_t cold_code_count_ = 0;
+  intptr_t cold_code_size_ = 0;
 
   compiler::ObjectPoolBuilder global_object_pool_builder_;
   GrowableObjectArray& libraries_;
@@ -412,6 +437,7 @@ class Precompiler : public ValueObject {
 
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
+  AotProfile* profile_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
   bool is_tracing_ = false;
 };
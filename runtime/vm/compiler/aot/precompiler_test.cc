@@ -0,0 +1,80 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#endif  // defined(DART_PRECOMPILER)
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+DECLARE_FLAG(bool, cold_code_section);
+
+static const char* kColdCodeScript = R"(
+  @pragma('vm:never-inline')
+  void alwaysThrows(int x) {
+    if (x > 0) {
+      throw StateError('positive');
+    }
+    throw ArgumentError(x);
+  }
+
+  @pragma('vm:never-inline')
+  int mayThrow(int x) {
+    if (x > 0) {
+      throw StateError('positive');
+    }
+    return x;
+  }
+
+  @pragma('vm:never-inline')
+  void loopsForever(List<int> list) {
+    while (true) {
+      list.add(list.length);
+    }
+  }
+
+  @pragma('vm:never-inline')
+  void loopsThenThrows(List<int> list) {
+    for (int i = 0; i < list.length; i++) {
+      list[i] = i;
+    }
+    throw StateError('done');
+  }
+)";
+
+static bool IsColdCode(const Library& root_library, const char* name) {
+  const auto& function = Function::Handle(GetFunction(root_library, name));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  return Precompiler::IsColdCode(/*profile=*/nullptr, function, flow_graph);
+}
+
+ISOLATE_UNIT_TEST_CASE(Precompiler_ColdCode) {
+  SetFlagScope<bool> sfs(&FLAG_cold_code_section, true);
+  const auto& root_library = Library::Handle(LoadTestScript(kColdCodeScript));
+
+  EXPECT(IsColdCode(root_library, "alwaysThrows"));
+  EXPECT(!IsColdCode(root_library, "mayThrow"));
+  // Functions without returns are only cold if they can't loop forever.
+  EXPECT(!IsColdCode(root_library, "loopsForever"));
+  EXPECT(!IsColdCode(root_library, "loopsThenThrows"));
+}
+
+ISOLATE_UNIT_TEST_CASE(Precompiler_ColdCodeDisabled) {
+  SetFlagScope<bool> sfs(&FLAG_cold_code_section, false);
+  const auto& root_library = Library::Handle(LoadTestScript(kColdCodeScript));
+
+  EXPECT(!IsColdCode(root_library, "alwaysThrows"));
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -14,6 +14,13 @@ void AsmIntrinsifier::String_identityHash(Assembler* assembler,
   String_getHashCode(assembler, normal_ir_body);
 }
 
+// The hash is only computed once per string, so the runtime's block-wise
+// StringHasher computes it rather than a per-architecture copy of it.
+void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
+                                                Label* normal_ir_body) {
+  String_getHashCode(assembler, normal_ir_body);
+}
+
 void AsmIntrinsifier::RegExp_ExecuteMatch(Assembler* assembler,
                                           Label* normal_ir_body) {
   AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(assembler, normal_ir_body,
@@ -1444,45 +1444,6 @@ void AsmIntrinsifier::StringBaseIsEmpty(Assembler* assembler,
   __ Ret();
 }
 
-void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
-                                                Label* normal_ir_body) {
-  __ ldr(R1, Address(SP, 0 * target::kWordSize));
-  __ ldr(R0, FieldAddress(R1, target::String::hash_offset()));
-  __ cmp(R0, Operand(0));
-  READS_RETURN_ADDRESS_FROM_LR(__ bx(LR, NE));  // Return if already computed.
-  __ ldr(R2, FieldAddress(R1, target::String::length_offset()));
-  __ SmiUntag(R2);
-  __ mov(R3, Operand(0));
-  __ AddImmediate(R8, R1,
-                  target::OneByteString::data_offset() - kHeapObjectTag);
-
-  // R1: Instance of OneByteString.
-  // R2: String length, untagged integer.
-  // R3: Loop counter, untagged integer.
-  // R8: String data.
-  // R0: Hash code, untagged integer.
-
-  Label loop, done;
-  __ Bind(&loop);
-  __ cmp(R3, Operand(R2));
-  __ b(&done, EQ);
-  // Add to hash code: (hash_ is uint32)
-  // Get one characters (ch).
-  __ ldrb(TMP, Address(R8, 0));
-  // TMP: ch.
-  __ add(R3, R3, Operand(1));
-  __ add(R8, R8, Operand(1));
-  __ CombineHashes(R0, TMP);
-  __ b(&loop);
-
-  __ Bind(&done);
-  // Finalize. Allow a zero result to combine checks from empty string branch.
-  __ FinalizeHashForSize(target::String::kHashBits, R0);
-  __ SmiTag(R0);
-  __ StoreIntoSmiField(FieldAddress(R1, target::String::hash_offset()), R0);
-  __ Ret();
-}
-
 // Allocates a _OneByteString or _TwoByteString. The content is not initialized.
 // 'length-reg' (R2) contains the desired length as a _Smi or _Mint.
 // Returns new string as tagged pointer in R0.
@@ -1728,6 +1689,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2));
   __ ldr(FUNCTION_REG, FieldAddress(R1, target::RegExp::function_offset(
                                             kOneByteStringCid, sticky)));
+  // Patterns which have not tiered up to compiled code yet hold bytecode.
+  __ LoadClassId(R1, FUNCTION_REG);
+  __ CompareImmediate(R1, kFunctionCid);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R9.
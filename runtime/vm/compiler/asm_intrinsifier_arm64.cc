@@ -1647,61 +1647,6 @@ void AsmIntrinsifier::StringBaseIsEmpty(Assembler* assembler,
   __ ret();
 }
 
-void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
-                                                Label* normal_ir_body) {
-  Label compute_hash;
-  __ ldr(R1, Address(SP, 0 * target::kWordSize));  // OneByteString object.
-  __ ldr(R0, FieldAddress(R1, target::String::hash_offset()),
-         kUnsignedFourBytes);
-  __ adds(R0, R0, Operand(R0));  // Smi tag the hash code, setting Z flag.
-  __ b(&compute_hash, EQ);
-  __ ret();  // Return if already computed.
-
-  __ Bind(&compute_hash);
-  __ LoadCompressedSmi(R2, FieldAddress(R1, target::String::length_offset()));
-  __ SmiUntag(R2);
-
-  __ mov(R3, ZR);
-  __ AddImmediate(R6, R1,
-                  target::OneByteString::data_offset() - kHeapObjectTag);
-  // R1: Instance of OneByteString.
-  // R2: String length, untagged integer.
-  // R3: Loop counter, untagged integer.
-  // R6: String data.
-  // R0: Hash code, untagged integer.
-
-  Label loop, done;
-  __ Bind(&loop);
-  __ cmp(R3, Operand(R2));
-  __ b(&done, EQ);
-  // Add to hash code: (hash_ is uint32)
-  // Get one characters (ch).
-  __ ldr(R7, Address(R6, R3), kUnsignedByte);
-  // R7: ch.
-  __ add(R3, R3, Operand(1));
-  __ CombineHashes(R0, R7);
-  __ cmp(R3, Operand(R2));
-  __ b(&loop);
-
-  __ Bind(&done);
-  // Finalize. Allow a zero result to combine checks from empty string branch.
-  __ FinalizeHashForSize(target::String::kHashBits, R0);
-
-  // R1: Untagged address of header word (ldxr/stxr do not support offsets).
-  __ sub(R1, R1, Operand(kHeapObjectTag));
-  __ LslImmediate(R0, R0, target::UntaggedObject::kHashTagPos);
-  Label retry;
-  __ Bind(&retry);
-  __ ldxr(R2, R1, kEightBytes);
-  __ orr(R2, R2, Operand(R0));
-  __ stxr(R4, R2, R1, kEightBytes);
-  __ cbnz(&retry, R4);
-
-  __ LsrImmediate(R0, R0, target::UntaggedObject::kHashTagPos);
-  __ SmiTag(R0);
-  __ ret();
-}
-
 // Allocates a _OneByteString or _TwoByteString. The content is not initialized.
 // 'length-reg' (R2) contains the desired length as a _Smi or _Mint.
 // Returns new string as tagged pointer in R0.
@@ -1966,6 +1911,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ LoadCompressed(FUNCTION_REG,
                     FieldAddress(R1, target::RegExp::function_offset(
                                          kOneByteStringCid, sticky)));
+  // Patterns which have not tiered up to compiled code yet hold bytecode.
+  __ LoadClassId(R1, FUNCTION_REG);
+  __ CompareImmediate(R1, kFunctionCid);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R5.
@@ -1481,47 +1481,6 @@ void AsmIntrinsifier::StringBaseIsEmpty(Assembler* assembler,
   __ ret();
 }
 
-void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
-                                                Label* normal_ir_body) {
-  Label compute_hash;
-  __ movl(EBX, Address(ESP, +1 * target::kWordSize));  // OneByteString object.
-  __ movl(EAX, FieldAddress(EBX, target::String::hash_offset()));
-  __ cmpl(EAX, Immediate(0));
-  __ j(EQUAL, &compute_hash, Assembler::kNearJump);
-  __ ret();
-
-  __ Bind(&compute_hash);
-  // Hash not yet computed, use algorithm of class StringHasher.
-  __ movl(ECX, FieldAddress(EBX, target::String::length_offset()));
-  __ SmiUntag(ECX);
-  __ xorl(EAX, EAX);
-  __ xorl(EDI, EDI);
-  // EBX: Instance of OneByteString.
-  // ECX: String length, untagged integer.
-  // EDI: Loop counter, untagged integer.
-  // EAX: Hash code, untagged integer.
-  Label loop, done;
-  __ Bind(&loop);
-  __ cmpl(EDI, ECX);
-  __ j(EQUAL, &done, Assembler::kNearJump);
-  // Add to hash code: (hash_ is uint32)
-  // Get one characters (ch).
-  __ movzxb(EDX, FieldAddress(EBX, EDI, TIMES_1,
-                              target::OneByteString::data_offset()));
-  // EDX: ch and temporary.
-  __ CombineHashes(EAX, EDX);
-
-  __ incl(EDI);
-  __ jmp(&loop, Assembler::kNearJump);
-
-  __ Bind(&done);
-  // Finalize and fit to size kHashBits. Ensures hash is non-zero.
-  __ FinalizeHashForSize(target::String::kHashBits, EAX, EDX);
-  __ SmiTag(EAX);
-  __ StoreIntoSmiField(FieldAddress(EBX, target::String::hash_offset()), EAX);
-  __ ret();
-}
-
 // Allocates a _OneByteString or _TwoByteString. The content is not initialized.
 // 'length_reg' contains the desired length as a _Smi or _Mint.
 // Returns new string as tagged pointer in EAX.
@@ -1766,6 +1725,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movl(FUNCTION_REG, FieldAddress(EBX, EDI, TIMES_4,
                                      target::RegExp::function_offset(
                                          kOneByteStringCid, sticky)));
+  // Patterns which have not tiered up to compiled code yet hold bytecode.
+  __ LoadClassId(EDI, FUNCTION_REG);
+  __ cmpl(EDI, Immediate(kFunctionCid));
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in EAX, the argument descriptor in EDX, and IC-Data in ECX.
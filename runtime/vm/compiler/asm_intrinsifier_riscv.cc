@@ -1675,69 +1675,6 @@ void AsmIntrinsifier::StringBaseIsEmpty(Assembler* assembler,
   __ ret();
 }
 
-void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
-                                                Label* normal_ir_body) {
-  Label compute_hash;
-  __ lx(A1, Address(SP, 0 * target::kWordSize));  // OneByteString object.
-#if defined(HASH_IN_OBJECT_HEADER)
-  // uint32_t field in header.
-  __ lwu(A0, FieldAddress(A1, target::String::hash_offset()));
-  __ SmiTag(A0);
-#else
-  // Smi field.
-  __ lx(A0, FieldAddress(A1, target::String::hash_offset()));
-#endif
-  __ beqz(A0, &compute_hash);
-  __ ret();  // Return if already computed.
-
-  __ Bind(&compute_hash);
-  __ lx(T0, FieldAddress(A1, target::String::length_offset()));
-  __ SmiUntag(T0);
-
-  __ mv(T1, ZR);
-  __ addi(T2, A1, target::OneByteString::data_offset() - kHeapObjectTag);
-
-  // A1: Instance of OneByteString.
-  // T0: String length, untagged integer.
-  // T1: Loop counter, untagged integer.
-  // T2: String data.
-  // A0: Hash code, untagged integer.
-
-  Label loop, done;
-  __ Bind(&loop);
-  __ beq(T1, T0, &done);
-  // Add to hash code: (hash_ is uint32)
-  // Get one characters (ch).
-  __ lbu(T3, Address(T2, 0));
-  __ addi(T2, T2, 1);
-  // T3: ch.
-  __ addi(T1, T1, 1);
-  __ CombineHashes(A0, T3);
-  __ j(&loop);
-
-  __ Bind(&done);
-  // Finalize. Allow a zero result to combine checks from empty string branch.
-  __ FinalizeHashForSize(target::String::kHashBits, A0);
-#if defined(HASH_IN_OBJECT_HEADER)
-  // A1: Untagged address of header word (lr/sc do not support offsets).
-  __ subi(A1, A1, kHeapObjectTag);
-  __ slli(A0, A0, target::UntaggedObject::kHashTagPos);
-  Label retry;
-  __ Bind(&retry);
-  __ lr(T0, Address(A1, 0));
-  __ or_(T0, T0, A0);
-  __ sc(TMP, T0, Address(A1, 0));
-  __ bnez(TMP, &retry);
-
-  __ srli(A0, A0, target::UntaggedObject::kHashTagPos);
-  __ SmiTag(A0);
-#else
-  __ SmiTag(A0);
-  __ sx(A0, FieldAddress(A1, target::String::hash_offset()));
-#endif
-  __ ret();
-}
-
 // Allocates a _OneByteString or _TwoByteString. The content is not initialized.
 // 'length-reg' (A1) contains the desired length as a _Smi or _Mint.
 // Returns new string as tagged pointer in A0.
@@ -1984,6 +1921,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(T1, T1, T2);
   __ lx(FUNCTION_REG, FieldAddress(T1, target::RegExp::function_offset(
                                            kOneByteStringCid, sticky)));
+  // Patterns which have not tiered up to compiled code yet hold bytecode.
+  __ LoadClassId(T1, FUNCTION_REG);
+  __ CompareImmediate(T1, kFunctionCid);
+  __ BranchIf(NE, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in T0, the argument descriptor in S4, and IC-Data in S5.
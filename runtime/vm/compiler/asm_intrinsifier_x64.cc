@@ -1547,54 +1547,6 @@ void AsmIntrinsifier::StringBaseIsEmpty(Assembler* assembler,
   __ ret();
 }
 
-void AsmIntrinsifier::OneByteString_getHashCode(Assembler* assembler,
-                                                Label* normal_ir_body) {
-  Label compute_hash;
-  __ movq(
-      RBX,
-      Address(RSP, +1 * target::kWordSize));  // target::OneByteString object.
-  __ movl(RAX, FieldAddress(RBX, target::String::hash_offset()));
-  __ cmpq(RAX, Immediate(0));
-  __ j(EQUAL, &compute_hash, Assembler::kNearJump);
-  __ SmiTag(RAX);
-  __ ret();
-
-  __ Bind(&compute_hash);
-  // Hash not yet computed, use algorithm of class StringHasher.
-  __ LoadCompressedSmi(RCX, FieldAddress(RBX, target::String::length_offset()));
-  __ SmiUntag(RCX);
-  __ xorq(RAX, RAX);
-  __ xorq(RDI, RDI);
-  // RBX: Instance of target::OneByteString.
-  // RCX: String length, untagged integer.
-  // RDI: Loop counter, untagged integer.
-  // RAX: Hash code, untagged integer.
-  Label loop, done;
-  __ Bind(&loop);
-  __ cmpq(RDI, RCX);
-  __ j(EQUAL, &done, Assembler::kNearJump);
-  // Add to hash code: (hash_ is uint32)
-  // Get one characters (ch).
-  __ movzxb(RDX, FieldAddress(RBX, RDI, TIMES_1,
-                              target::OneByteString::data_offset()));
-  // RDX: ch and temporary.
-  __ CombineHashes(RAX, RDX);
-
-  __ incq(RDI);
-  __ jmp(&loop, Assembler::kNearJump);
-
-  __ Bind(&done);
-  // Finalize and fit to size kHashBits. Ensures hash is non-zero.
-  __ FinalizeHashForSize(target::String::kHashBits, RAX);
-  __ shlq(RAX, Immediate(target::UntaggedObject::kHashTagPos));
-  // lock+orq is an atomic read-modify-write.
-  __ lock();
-  __ orq(FieldAddress(RBX, target::Object::tags_offset()), RAX);
-  __ sarq(RAX, Immediate(target::UntaggedObject::kHashTagPos));
-  __ SmiTag(RAX);
-  __ ret();
-}
-
 // Allocates a _OneByteString or _TwoByteString. The content is not initialized.
 // 'length_reg' contains the desired length as a _Smi or _Mint.
 // Returns new string as tagged pointer in RAX.
@@ -1862,6 +1814,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
                                                target::RegExp::function_offset(
                                                    kOneByteStringCid, sticky)));
 #endif
+  // Patterns which have not tiered up to compiled code yet hold bytecode.
+  __ LoadClassId(RDI, FUNCTION_REG);
+  __ cmpq(RDI, Immediate(kFunctionCid));
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in RAX, the argument descriptor in R10, and IC-Data in RCX.
@@ -10,12 +10,15 @@
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/backend/loop_versioning.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/object.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, loop_versioning);
+
 // Helper method to count number of bounds checks.
 static intptr_t CountBoundChecks(FlowGraph* flow_graph) {
   intptr_t count = 0;
@@ -294,4 +297,143 @@ ISOLATE_UNIT_TEST_CASE(BCEListNamedAndPlainLength) {
   TestScriptJIT(kScriptChars, 2, 0);
 }
 
+//
+// Loop versioning tests.
+//
+
+struct VersioningResult {
+  bool changed;
+  intptr_t loops;
+  intptr_t checks_before;
+  intptr_t checks_after;
+};
+
+// Helper method to build CFG, run loop versioning on function foo, and
+// report the number of loops and before/after bounds checks.
+static VersioningResult ApplyVersioning(const char* script_chars) {
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  std::initializer_list<CompilerPass::Id> passes = {
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kCSE,
+      CompilerPass::kLICM,
+  };
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  EXPECT_EQ(1, flow_graph->GetLoopHierarchy().num_loops());
+
+  VersioningResult result;
+  result.checks_before = CountBoundChecks(flow_graph);
+  LoopVersioner versioner(flow_graph);
+  result.changed = versioner.Optimize();
+  result.loops = flow_graph->GetLoopHierarchy().num_loops();
+  result.checks_after = CountBoundChecks(flow_graph);
+  return result;
+}
+
+ISOLATE_UNIT_TEST_CASE(BCELoopVersioning) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a, int start, int end) {
+        int sum = 0;
+        for (int i = start; i < end; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+      main() {
+        final a = Uint8List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a, i, 100);
+        }
+      }
+    )";
+  VersioningResult result = ApplyVersioning(kScriptChars);
+  EXPECT(result.changed);
+  // Only the slow copy of the loop keeps its bounds check.
+  EXPECT_EQ(2, result.loops);
+  EXPECT_EQ(1, result.checks_before);
+  EXPECT_EQ(1, result.checks_after);
+}
+
+ISOLATE_UNIT_TEST_CASE(BCELoopVersioningTwoArrays) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List a, Float64List b, int n) {
+        for (int i = 0; i < n; i++) {
+          b[i] = a[i + 1];
+        }
+      }
+      main() {
+        final a = Float64List(101);
+        final b = Float64List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a, b, i);
+        }
+      }
+    )";
+  VersioningResult result = ApplyVersioning(kScriptChars);
+  EXPECT(result.changed);
+  EXPECT_EQ(2, result.loops);
+  EXPECT_EQ(2, result.checks_before);
+  EXPECT_EQ(2, result.checks_after);
+}
+
+ISOLATE_UNIT_TEST_CASE(BCELoopVersioningNotNeeded) {
+  // Range analysis removes the check without versioning.
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = i;
+        }
+      }
+      main() {
+        final a = Uint8List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a);
+        }
+      }
+    )";
+  VersioningResult result = ApplyVersioning(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(1, result.checks_after);
+}
+
+ISOLATE_UNIT_TEST_CASE(BCELoopVersioningDisabled) {
+  SetFlagScope<bool> sfs(&FLAG_loop_versioning, false);
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a, int start, int end) {
+        for (int i = start; i < end; i++) {
+          a[i] = 0;
+        }
+      }
+      main() {
+        final a = Uint8List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a, i, 100);
+        }
+      }
+    )";
+  VersioningResult result = ApplyVersioning(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(1, result.checks_after);
+}
+
 }  // namespace dart
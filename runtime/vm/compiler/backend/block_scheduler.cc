@@ -6,6 +6,7 @@
 
 #include "vm/allocation.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
 
@@ -50,23 +51,34 @@ void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
   if (!FLAG_reorder_basic_blocks) {
     return;
   }
-  if (CompilerState::Current().is_aot()) {
-    return;
-  }
 
   const Function& function = flow_graph->parsed_function().function();
-  const Array& ic_data_array =
-      Array::Handle(flow_graph->zone(), function.ic_data_array());
-  if (ic_data_array.IsNull()) {
-    DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
-                 function.ForceOptimize());
-    return;
-  }
   Array& edge_counters = Array::Handle();
-  edge_counters ^=
-      ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
-  if (edge_counters.IsNull()) {
-    return;
+  if (CompilerState::Current().is_aot()) {
+    // Use the edge counters of a training run, if the flow graph has the
+    // same shape as the one which was instrumented.
+    AotProfile* profile = AotProfile::Current();
+    if (profile == nullptr) {
+      return;
+    }
+    edge_counters = profile->EdgeCounters(function);
+    if (edge_counters.IsNull() ||
+        (edge_counters.Length() != flow_graph->preorder().length())) {
+      return;
+    }
+  } else {
+    const Array& ic_data_array =
+        Array::Handle(flow_graph->zone(), function.ic_data_array());
+    if (ic_data_array.IsNull()) {
+      DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
+                   function.ForceOptimize());
+      return;
+    }
+    edge_counters ^=
+        ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
+    if (edge_counters.IsNull()) {
+      return;
+    }
   }
 
   auto graph_entry = flow_graph->graph_entry();
@@ -246,6 +258,9 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
 // *cold* and moved to the end of the order.
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
+// - If edge weights are known from a training run (see AotProfile), the more
+// frequent successor of a branch follows it and a successor which was never
+// reached is considered cold.
 //
 namespace {
 class AOTBlockScheduler {
@@ -296,7 +311,9 @@ class AOTBlockScheduler {
           //
           // This is the main difference from |DiscoverBlocks| which always
           // visits successors in reverse order.
-          if (successor_count == 2 && block->loop_info() != nullptr) {
+          if (successor_count == 2 && PushByEdgeWeight(last)) {
+            // Successors were pushed according to the training run.
+          } else if (successor_count == 2 && block->loop_info() != nullptr) {
             auto succ0 = last->SuccessorAt(0);
             auto succ1 = last->SuccessorAt(1);
 
@@ -355,6 +372,30 @@ class AOTBlockScheduler {
   // The block should not move to cold section.
   static constexpr uint8_t kPinnedMark = 1 << 3;
 
+  // Pushes the successors of [branch] so that the more frequent one is
+  // visited last and thus placed right after the branch. Returns false if
+  // their weights are unknown or equal.
+  bool PushByEdgeWeight(Instruction* branch) {
+    auto succ0 = branch->SuccessorAt(0)->AsTargetEntry();
+    auto succ1 = branch->SuccessorAt(1)->AsTargetEntry();
+    if ((succ0 == nullptr) || (succ1 == nullptr) ||
+        (succ0->edge_weight() == succ1->edge_weight())) {
+      return false;
+    }
+    TargetEntryInstr* hot = succ0;
+    TargetEntryInstr* cold = succ1;
+    if (succ0->edge_weight() < succ1->edge_weight()) {
+      hot = succ1;
+      cold = succ0;
+    }
+    if (cold->edge_weight() == 0.0) {
+      MarksOf(cold) |= kColdMark;
+    }
+    PushBlock(hot);
+    PushBlock(cold);
+    return true;
+  }
+
   uint8_t& MarksOf(BlockEntryInstr* block) {
     return marks_[block->preorder_number()];
   }
@@ -12,6 +12,9 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
   object_header_bytes_ = 0;
   return_const_count_ = 0;
   return_const_with_load_field_count_ = 0;
+  spill_store_count_ = 0;
+  spill_load_count_ = 0;
+  constant_load_count_ = 0;
   intptr_t i = 0;
 
 #define DO(type, attrs)                                                        \
@@ -105,6 +108,10 @@ void CombinedCodeStatistics::DumpStatistics() {
   OS::PrintErr("% 8" Pd " return-constant-with-load-field functions\n",
                return_const_with_load_field_count_);
   OS::PrintErr("--------------------\n");
+  OS::PrintErr("% 8" Pd " spill slot stores\n", spill_store_count_);
+  OS::PrintErr("% 8" Pd " spill slot loads\n", spill_load_count_);
+  OS::PrintErr("% 8" Pd " constant loads\n", constant_load_count_);
+  OS::PrintErr("--------------------\n");
 }
 
 int CombinedCodeStatistics::CompareEntries(const void* a, const void* b) {
@@ -125,6 +132,9 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
   instruction_bytes_ = 0;
   unaccounted_bytes_ = 0;
   alignment_bytes_ = 0;
+  spill_store_count_ = 0;
+  spill_load_count_ = 0;
+  constant_load_count_ = 0;
 
   stack_index_ = -1;
   for (intptr_t i = 0; i < kStackSize; i++)
@@ -163,6 +173,19 @@ void CodeStatistics::SpecialEnd(intptr_t tag) {
   stack_index_--;
 }
 
+void CodeStatistics::RecordMove(const MoveOperands& move) {
+  const Location src = move.src();
+  const Location dst = move.dest();
+  if (src.IsConstant()) {
+    if (dst.IsMachineRegister()) {
+      constant_load_count_++;
+    }
+    return;
+  }
+  if (src.HasStackIndex()) spill_load_count_++;
+  if (dst.HasStackIndex()) spill_store_count_++;
+}
+
 void CodeStatistics::Finalize() {
   intptr_t function_size = assembler_->CodeSize();
   unaccounted_bytes_ = function_size - instruction_bytes_;
@@ -200,6 +223,9 @@ void CodeStatistics::AppendTo(CombinedCodeStatistics* stat) {
   ASSERT(stat->unaccounted_bytes_ >= 0);
   stat->alignment_bytes_ += alignment_bytes_;
   stat->object_header_bytes_ += Instructions::HeaderSize();
+  stat->spill_store_count_ += spill_store_count_;
+  stat->spill_load_count_ += spill_load_count_;
+  stat->constant_load_count_ += constant_load_count_;
 
   if (returns_constant) stat->return_const_count_++;
   if (returns_const_with_load_field_) {
@@ -67,6 +67,9 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t spill_store_count_;
+  intptr_t spill_load_count_;
+  intptr_t constant_load_count_;
 };
 
 class CodeStatistics {
@@ -79,6 +82,10 @@ class CodeStatistics {
   void SpecialBegin(intptr_t tag);
   void SpecialEnd(intptr_t tag);
 
+  // Counts stores to and loads from spill slots and rematerialized constants
+  // among the moves emitted by parallel moves.
+  void RecordMove(const MoveOperands& move);
+
   void AppendTo(CombinedCodeStatistics* stat);
 
   void Finalize();
@@ -97,6 +104,9 @@ class CodeStatistics {
   intptr_t instruction_bytes_;
   intptr_t unaccounted_bytes_;
   intptr_t alignment_bytes_;
+  intptr_t spill_store_count_;
+  intptr_t spill_load_count_;
+  intptr_t constant_load_count_;
 
   intptr_t stack_[kStackSize];
   intptr_t stack_index_;
@@ -267,6 +267,9 @@ class FlowGraph : public ZoneAllocated {
 
   Thread* thread() const { return thread_; }
   Zone* zone() const { return thread()->zone(); }
+  // Hands the graph over to [thread], which continues its compilation. The
+  // zone of the thread which built the graph must outlive the graph.
+  void set_thread(Thread* thread) { thread_ = thread; }
   IsolateGroup* isolate_group() const { return thread()->isolate_group(); }
 
   intptr_t max_block_id() const { return max_block_id_; }
@@ -475,6 +475,10 @@ class FlowGraphCompiler : public ValueObject {
     if (stats_ != nullptr) stats_->SpecialEnd(tag);
   }
 
+  void StatsRecordMove(const MoveOperands& move) {
+    if (stats_ != nullptr) stats_->RecordMove(move);
+  }
+
   GrowableArray<const Field*>& used_static_fields() {
     return used_static_fields_;
   }
@@ -1398,6 +1398,7 @@ class Instruction : public ZoneAllocated {
   // GetDeoptId and/or CopyDeoptIdFrom.
   friend class CallSiteInliner;
   friend class LICM;
+  friend class InstructionCopier;
   friend class ComparisonInstr;
   friend class Scheduler;
   friend class BlockEntryInstr;
@@ -6804,9 +6805,12 @@ class LoadIndexedInstr : public TemplateDefinition<2, NoThrow> {
 
   Value* array() const { return inputs_[kArrayPos]; }
   Value* index() const { return inputs_[kIndexPos]; }
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
+  AlignmentType alignment() const { return alignment_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
+  CompileType* result_type() const { return result_type_; }
 
   virtual intptr_t DeoptimizationTarget() const {
     // Direct access since this instruction cannot deoptimize, and the deopt-id
@@ -7087,10 +7091,13 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
   Value* index() const { return inputs_[kIndexPos]; }
   Value* value() const { return inputs_[kValuePos]; }
 
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
+  AlignmentType alignment() const { return alignment_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
 
+  StoreBarrierType emit_store_barrier() const { return emit_store_barrier_; }
   bool ShouldEmitStoreBarrier() const {
     if (value()->definition()->Type()->IsBool()) {
       return false;
@@ -9909,6 +9916,7 @@ class CheckStackOverflowInstr : public TemplateInstruction<0, NoThrow> {
   bool in_loop() const { return loop_depth_ > 0; }
   intptr_t stack_depth() const { return stack_depth_; }
   intptr_t loop_depth() const { return loop_depth_; }
+  Kind kind() const { return kind_; }
 
   DECLARE_INSTRUCTION(CheckStackOverflow)
 
@@ -11346,6 +11354,27 @@ class SimdOpInstr : public Definition {
     return new SimdOpInstr(KindForMethod(kind), left, deopt_id);
   }
 
+  // Create a unary SimdOp instr.
+  static SimdOpInstr* Create(Kind kind, Value* left, intptr_t deopt_id) {
+    return new SimdOpInstr(kind, left, deopt_id);
+  }
+
+  // Create a SimdOp instr with four inputs (e.g. Int32x4FromInts).
+  static SimdOpInstr* Create(Kind kind,
+                             Value* x,
+                             Value* y,
+                             Value* z,
+                             Value* w,
+                             intptr_t deopt_id) {
+    SimdOpInstr* op = new SimdOpInstr(kind, deopt_id);
+    ASSERT(op->InputCount() == 4);
+    op->SetInputAt(0, x);
+    op->SetInputAt(1, y);
+    op->SetInputAt(2, z);
+    op->SetInputAt(3, w);
+    return op;
+  }
+
   static Kind KindForOperator(MethodRecognizer::Kind kind);
 
   static Kind KindForMethod(MethodRecognizer::Kind method_kind);
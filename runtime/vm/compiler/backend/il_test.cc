@@ -1946,6 +1946,81 @@ ISOLATE_UNIT_TEST_CASE(IL_TestIntInstr) {
   }
 }
 
+// Checks that a constant materialized into a register inside a block is
+// rematerialized instead of being spilled to the stack when the register is
+// needed for other values.
+ISOLATE_UNIT_TEST_CASE(IL_RematerializeSpilledConstant) {
+  using compiler::BlockBuilder;
+  // More values live at the same time than there are registers.
+  const intptr_t kNumValues = kNumberOfCpuRegisters + 4;
+  const int64_t kConstant = 0x123456789;
+
+  ConstantInstr* constant = nullptr;
+  const auto& func = BuildTestFunction(/*num_parameters=*/1, [&](auto& H) {
+    H.AddVariable("x", AbstractType::ZoneHandle(Type::IntType()),
+                  new CompileType(CompileType::Int()));
+
+    BlockBuilder builder(H.flow_graph(),
+                         H.flow_graph()->graph_entry()->normal_entry());
+    Definition* x = builder.AddUnboxInstr(
+        kUnboxedInt64, builder.AddParameter(0), /*is_checked=*/false);
+    constant = builder.AddDefinition(new UnboxedConstantInstr(
+        Integer::ZoneHandle(Integer::NewCanonical(kConstant)),
+        kUnboxedInt64));
+
+    GrowableArray<Definition*> values;
+    for (intptr_t i = 0; i < kNumValues; i++) {
+      values.Add(builder.AddDefinition(new BinaryInt64OpInstr(
+          Token::kADD, new Value(x), new Value(H.IntConstant(i, kUnboxedInt64)),
+          DeoptId::kNone, Instruction::kNotSpeculative)));
+    }
+    Definition* sum = values[0];
+    for (intptr_t i = 1; i < kNumValues; i++) {
+      sum = builder.AddDefinition(new BinaryInt64OpInstr(
+          Token::kADD, new Value(sum), new Value(values[i]), DeoptId::kNone,
+          Instruction::kNotSpeculative));
+    }
+    Definition* result = builder.AddDefinition(
+        new BinaryInt64OpInstr(Token::kADD, new Value(constant),
+                               new Value(sum), DeoptId::kNone,
+                               Instruction::kNotSpeculative));
+    builder.AddReturn(
+        new Value(builder.AddDefinition(new BoxInt64Instr(new Value(result)))));
+  });
+
+  // The constant is not stored to the stack after its definition...
+  if (auto move = constant->next()->AsParallelMove()) {
+    for (intptr_t i = 0; i < move->NumMoves(); i++) {
+      EXPECT(!move->MoveOperandsAt(i)->src().Equals(constant->locs()->out(0)) ||
+             !move->MoveOperandsAt(i)->dest().HasStackIndex());
+    }
+  }
+  // ... but moved from the constant itself into a register at its use.
+  bool rematerialized = false;
+  for (Instruction* instr = constant->next(); instr != nullptr;
+       instr = instr->next()) {
+    if (auto move = instr->AsParallelMove()) {
+      for (intptr_t i = 0; i < move->NumMoves(); i++) {
+        const Location src = move->MoveOperandsAt(i)->src();
+        if (src.IsConstant() && (src.constant_instruction() == constant)) {
+          EXPECT(move->MoveOperandsAt(i)->dest().IsRegister());
+          rematerialized = true;
+        }
+      }
+    }
+  }
+  EXPECT(rematerialized);
+
+  for (int64_t x : {static_cast<int64_t>(0), static_cast<int64_t>(1),
+                    static_cast<int64_t>(-5), static_cast<int64_t>(1) << 40}) {
+    const auto& arg = Integer::Handle(Integer::New(x));
+    const auto& result =
+        Integer::CheckedHandle(thread->zone(), InvokeFunction(func, arg));
+    EXPECT_EQ(kNumValues * x + kNumValues * (kNumValues - 1) / 2 + kConstant,
+              result.Value());
+  }
+}
+
 // This is a smoke test which verifies that RecordCoverage instruction is not
 // accidentally removed by some overly eager optimization.
 ISOLATE_UNIT_TEST_CASE(IL_RecordCoverageSurvivesOptimizations) {
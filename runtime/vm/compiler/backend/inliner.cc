@@ -5,6 +5,7 @@
 #include "vm/compiler/backend/inliner.h"
 
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
@@ -279,6 +280,13 @@ class CallSites : public ValueObject {
           nesting_depth(nesting_depth) {
       if (CompilerState::Current().is_aot()) {
         call_count = AotCallCountApproximation(nesting_depth);
+        // Prefer the number of calls made in a training run. Calls which
+        // were inlined into the caller graph belong to other functions.
+        AotProfile* profile = AotProfile::Current();
+        if ((profile != nullptr) && (call->inlining_id() <= 0)) {
+          profile->LookupCallCount(caller_graph->function(), call->token_pos(),
+                                   &call_count);
+        }
       } else {
         call_count = call->CallCount();
       }
@@ -1212,7 +1220,7 @@ class CallSiteInliner : public ValueObject {
     // Abort if this function has deoptimized too much.
     if (function.deoptimization_counter() >=
         FLAG_max_deoptimization_counter_threshold) {
-      function.set_is_inlinable(false);
+      DeferredInliningInfo::MarkNotInlinable(function);
       TRACE_INLINING(THR_Print("     Bailout: deoptimization threshold\n"));
       PRINT_INLINING_TREE("Deoptimization threshold exceeded",
                           &call_data->caller, &function, call_data->call);
@@ -1384,7 +1392,7 @@ class CallSiteInliner : public ValueObject {
           if (!AdjustForOptionalParameters(
                   *parsed_function, first_actual_param_index, argument_names,
                   arguments, param_stubs, callee_graph)) {
-            function.set_is_inlinable(false);
+            DeferredInliningInfo::MarkNotInlinable(function);
             TRACE_INLINING(THR_Print("     Bailout: optional arg mismatch\n"));
             PRINT_INLINING_TREE("Optional arg mismatch", &call_data->caller,
                                 &function, call_data->call);
@@ -1497,7 +1505,7 @@ class CallSiteInliner : public ValueObject {
               // specialized based on argument types.
               if (!FlowGraphInliner::FunctionHasAlwaysConsiderInliningPragma(
                       function)) {
-                function.set_is_inlinable(false);
+                DeferredInliningInfo::MarkNotInlinable(function);
                 TRACE_INLINING(THR_Print("     Mark not inlinable\n"));
               }
             }
@@ -2441,6 +2449,17 @@ void FlowGraphInliner::CollectGraphInfo(FlowGraph* flow_graph,
   if (force || (function.optimized_instruction_count() == 0)) {
     GraphInfoCollector info;
     info.Collect(*flow_graph);
+    DeferredInliningInfo* deferred =
+        CompilerState::Current().deferred_inlining_info();
+    if (deferred != nullptr) {
+      deferred->SetGraphInfo(function, info.instruction_count(),
+                             info.call_site_count());
+      *instruction_count = Utils::Minimum<intptr_t>(
+          info.instruction_count(), Function::kMaxInstructionCount);
+      *call_site_count = Utils::Minimum<intptr_t>(
+          info.call_site_count(), Function::kMaxInstructionCount);
+      return;
+    }
     function.SetOptimizedInstructionCountClamped(info.instruction_count());
     function.SetOptimizedCallSiteCountClamped(info.call_site_count());
   }
@@ -2448,6 +2467,55 @@ void FlowGraphInliner::CollectGraphInfo(FlowGraph* flow_graph,
   *call_site_count = function.optimized_call_site_count();
 }
 
+void DeferredInliningInfo::SetGraphInfo(const Function& function,
+                                        intptr_t instruction_count,
+                                        intptr_t call_site_count) {
+  updates_.Add({&function, instruction_count, call_site_count, -1, false});
+}
+
+void DeferredInliningInfo::SetInliningDepth(const Function& function,
+                                            intptr_t inlining_depth) {
+  updates_.Add({&function, -1, -1, inlining_depth, false});
+}
+
+void DeferredInliningInfo::SetNotInlinable(const Function& function) {
+  updates_.Add({&function, -1, -1, -1, true});
+}
+
+void DeferredInliningInfo::MarkNotInlinable(const Function& function) {
+  DeferredInliningInfo* deferred =
+      CompilerState::Current().deferred_inlining_info();
+  if (deferred != nullptr) {
+    deferred->SetNotInlinable(function);
+  } else {
+    function.set_is_inlinable(false);
+  }
+}
+
+void DeferredInliningInfo::AddAll(Zone* zone,
+                                  const DeferredInliningInfo& other) {
+  for (Update update : other.updates_) {
+    update.function = &Function::ZoneHandle(zone, update.function->ptr());
+    updates_.Add(update);
+  }
+}
+
+void DeferredInliningInfo::Apply() const {
+  for (const Update& update : updates_) {
+    const Function& function = *update.function;
+    if (update.instruction_count >= 0) {
+      function.SetOptimizedInstructionCountClamped(update.instruction_count);
+      function.SetOptimizedCallSiteCountClamped(update.call_site_count);
+    }
+    if (update.inlining_depth >= 0) {
+      function.set_inlining_depth(update.inlining_depth);
+    }
+    if (update.not_inlinable) {
+      function.set_is_inlinable(false);
+    }
+  }
+}
+
 void FlowGraphInliner::SetInliningId(FlowGraph* flow_graph,
                                      intptr_t inlining_id) {
   ASSERT(flow_graph->inlining_id() < 0);
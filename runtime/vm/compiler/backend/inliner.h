@@ -89,6 +89,51 @@ class SpeculativeInliningPolicy {
   GrowableArray<intptr_t> inlining_suppressions_;
 };
 
+// Inlining heuristics computed for functions while the precompiler compiles
+// several functions in parallel (see Precompiler::Iterate).
+//
+// The inliner caches the size and inlining depth of a function in the
+// Function object, and marks functions which are never worth inlining as not
+// inlinable, and uses this information when the function is later
+// considered for inlining. Updating it in place would make inlining
+// decisions of concurrently compiled functions depend on timing, so it is
+// recorded here and applied once all functions of a wave are compiled.
+class DeferredInliningInfo : public ZoneAllocated {
+ public:
+  DeferredInliningInfo() : updates_() {}
+
+  void SetGraphInfo(const Function& function,
+                    intptr_t instruction_count,
+                    intptr_t call_site_count);
+  void SetInliningDepth(const Function& function, intptr_t inlining_depth);
+  void SetNotInlinable(const Function& function);
+
+  // Marks [function] as not inlinable, or records it if the current
+  // compilation defers its updates (see CompilerState).
+  static void MarkNotInlinable(const Function& function);
+
+  // Appends the updates recorded in [other], which may have been recorded
+  // on another thread, allocating handles in [zone].
+  void AddAll(Zone* zone, const DeferredInliningInfo& other);
+
+  // Applies the recorded updates in the order they were made.
+  void Apply() const;
+
+ private:
+  struct Update {
+    const Function* function;
+    // -1 if not updated.
+    intptr_t instruction_count;
+    intptr_t call_site_count;
+    intptr_t inlining_depth;
+    bool not_inlinable;
+  };
+
+  GrowableArray<Update> updates_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeferredInliningInfo);
+};
+
 class FlowGraphInliner : ValueObject {
  public:
   FlowGraphInliner(FlowGraph* flow_graph,
@@ -0,0 +1,195 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/instruction_copier.h"
+
+namespace dart {
+
+Instruction* InstructionCopier::CopyInstruction(Instruction* instr,
+                                                DefinitionMap* map) {
+  const intptr_t deopt_id = instr->GetDeoptId();
+  Instruction* copy = nullptr;
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    copy = BinaryIntegerOpInstr::Make(
+        op->representation(), op->op_kind(), CopyInput(instr, 0, *map),
+        CopyInput(instr, 1, *map), deopt_id, op->can_overflow(),
+        op->is_truncating(), op->range(), op->SpeculativeModeOfInputs());
+  } else if (auto op = instr->AsUnaryIntegerOp()) {
+    copy = UnaryIntegerOpInstr::Make(
+        op->representation(), op->op_kind(), CopyInput(instr, 0, *map),
+        deopt_id, op->SpeculativeModeOfInputs(), op->range());
+  } else if (auto op = instr->AsBinaryDoubleOp()) {
+    copy = new (zone()) BinaryDoubleOpInstr(
+        op->op_kind(), CopyInput(instr, 0, *map), CopyInput(instr, 1, *map),
+        deopt_id, op->source(), op->SpeculativeModeOfInputs(),
+        op->representation());
+  } else if (auto op = instr->AsUnaryDoubleOp()) {
+    copy = new (zone())
+        UnaryDoubleOpInstr(op->op_kind(), CopyInput(instr, 0, *map), deopt_id,
+                           op->SpeculativeModeOfInputs(), op->representation());
+  } else if (auto load = instr->AsLoadIndexed()) {
+    copy = new (zone()) LoadIndexedInstr(
+        CopyInput(instr, 0, *map), CopyInput(instr, 1, *map),
+        load->index_unboxed(), load->index_scale(), load->class_id(),
+        load->alignment(), deopt_id, load->source(), load->result_type());
+  } else if (auto store = instr->AsStoreIndexed()) {
+    copy = new (zone()) StoreIndexedInstr(
+        CopyInput(instr, 0, *map), CopyInput(instr, 1, *map),
+        CopyInput(instr, 2, *map), store->emit_store_barrier(),
+        store->index_unboxed(), store->index_scale(), store->class_id(),
+        store->alignment(), deopt_id, store->source(),
+        store->SpeculativeModeOfInput(StoreIndexedInstr::kValuePos));
+  } else if (auto load = instr->AsLoadField()) {
+    ASSERT(!load->calls_initializer());
+    copy = new (zone())
+        LoadFieldInstr(CopyInput(instr, 0, *map), load->slot(),
+                       load->loads_inner_pointer(), load->source(),
+                       /*calls_initializer=*/false, deopt_id);
+  } else if (instr->IsCheckArrayBound()) {
+    copy = new (zone()) CheckArrayBoundInstr(
+        CopyInput(instr, CheckBoundBaseInstr::kLengthPos, *map),
+        CopyInput(instr, CheckBoundBaseInstr::kIndexPos, *map), deopt_id);
+  } else if (instr->IsGenericCheckBound()) {
+    copy = new (zone()) GenericCheckBoundInstr(
+        CopyInput(instr, CheckBoundBaseInstr::kLengthPos, *map),
+        CopyInput(instr, CheckBoundBaseInstr::kIndexPos, *map), deopt_id);
+  } else if (auto check = instr->AsCheckClass()) {
+    copy = new (zone()) CheckClassInstr(CopyInput(instr, 0, *map), deopt_id,
+                                        check->cids(), check->source());
+  } else if (auto check = instr->AsCheckClassId()) {
+    copy = new (zone())
+        CheckClassIdInstr(CopyInput(instr, 0, *map), check->cids(), deopt_id);
+  } else if (instr->IsCheckSmi()) {
+    copy = new (zone())
+        CheckSmiInstr(CopyInput(instr, 0, *map), deopt_id, instr->source());
+  } else if (auto check = instr->AsCheckNull()) {
+    copy = new (zone())
+        CheckNullInstr(CopyInput(instr, 0, *map), check->function_name(),
+                       deopt_id, check->source(), check->exception_type());
+  } else if (auto box = instr->AsBox()) {
+    copy = BoxInstr::Create(box->from_representation(),
+                            CopyInput(instr, 0, *map));
+  } else if (auto unbox = instr->AsUnbox()) {
+    UnboxInstr* unbox_copy =
+        UnboxInstr::Create(unbox->representation(), CopyInput(instr, 0, *map),
+                           deopt_id, unbox->SpeculativeModeOfInputs());
+    if (auto unbox_integer = unbox->AsUnboxInteger()) {
+      if (unbox_integer->is_truncating()) {
+        unbox_copy->AsUnboxInteger()->mark_truncating();
+      }
+    }
+    copy = unbox_copy;
+  } else if (auto conv = instr->AsIntConverter()) {
+    IntConverterInstr* conv_copy = new (zone()) IntConverterInstr(
+        conv->from(), conv->to(), CopyInput(instr, 0, *map), deopt_id);
+    if (conv->is_truncating()) {
+      conv_copy->mark_truncating();
+    }
+    copy = conv_copy;
+  } else if (auto redefinition = instr->AsRedefinition()) {
+    RedefinitionInstr* redefinition_copy = new (zone())
+        RedefinitionInstr(CopyInput(instr, 0, *map),
+                          redefinition->inserted_by_constant_propagation());
+    redefinition_copy->set_constrained_type(
+        redefinition->constrained_type());
+    copy = redefinition_copy;
+  } else if (auto check = instr->AsCheckStackOverflow()) {
+    copy = new (zone()) CheckStackOverflowInstr(
+        check->source(), check->stack_depth(), check->loop_depth(), deopt_id,
+        check->kind());
+  }
+  ASSERT(copy != nullptr);
+  copy->set_inlining_id(instr->inlining_id());
+
+  if (instr->env() != nullptr) {
+    instr->env()->DeepCopyTo(zone(), copy);
+    RenameEnvironment(copy, *map);
+  }
+  if (Definition* def = instr->AsDefinition()) {
+    Definition* def_copy = copy->AsDefinition();
+    if (def->HasSSATemp()) {
+      flow_graph_->AllocateSSAIndex(def_copy);
+    }
+    if (def->HasType()) {
+      def_copy->UpdateType(*def->Type());
+    }
+    map->Insert({def, def_copy});
+  }
+  return copy;
+}
+
+BranchInstr* InstructionCopier::CopyBranch(BranchInstr* branch,
+                                           const DefinitionMap& map) {
+  ComparisonInstr* comparison = branch->comparison();
+  ComparisonInstr* comparison_copy = comparison->CopyWithNewOperands(
+      CopyInput(comparison, 0, map), CopyInput(comparison, 1, map));
+  comparison_copy->set_inlining_id(comparison->inlining_id());
+  BranchInstr* copy = new (zone()) BranchInstr(comparison_copy, DeoptId::kNone);
+  if (branch->env() != nullptr) {
+    copy->InheritDeoptTarget(zone(), branch);
+    RenameEnvironment(copy, map);
+  } else {
+    copy->CopyDeoptIdFrom(*branch);
+  }
+  copy->comparison()->SetDeoptId(*comparison);
+  return copy;
+}
+
+Value* InstructionCopier::CopyInput(Instruction* instr,
+                                    intptr_t index,
+                                    const DefinitionMap& map) {
+  return new (zone()) Value(Lookup(map, instr->InputAt(index)->definition()));
+}
+
+void InstructionCopier::RenameInputs(Instruction* instr,
+                                     const DefinitionMap& map) {
+  for (intptr_t i = 0; i < instr->InputCount(); ++i) {
+    Value* input = instr->InputAt(i);
+    Definition* def = Lookup(map, input->definition());
+    if (def != input->definition()) {
+      input->BindTo(def);
+    }
+  }
+}
+
+void InstructionCopier::RenameEnvironment(Instruction* instr,
+                                          const DefinitionMap& map) {
+  if (instr->env() == nullptr) {
+    return;
+  }
+  for (Environment::DeepIterator it(instr->env()); !it.Done(); it.Advance()) {
+    Value* value = it.CurrentValue();
+    Definition* def = Lookup(map, value->definition());
+    if (def != value->definition()) {
+      value->BindToEnvironment(def);
+      value->SetReachingType(nullptr);
+    }
+  }
+}
+
+bool InstructionCopier::IsCopyable(Instruction* instr) {
+  // Int32 operations and unboxing have additional constraints checked when
+  // they are created.
+  if (auto op = instr->AsBinaryIntegerOp()) {
+    return op->representation() != kUnboxedInt32;
+  }
+  if (auto op = instr->AsUnaryIntegerOp()) {
+    return op->representation() != kUnboxedInt32;
+  }
+  if (auto unbox = instr->AsUnbox()) {
+    return unbox->representation() != kUnboxedInt32;
+  }
+  if (auto load = instr->AsLoadField()) {
+    return !load->calls_initializer();
+  }
+  return instr->IsBinaryDoubleOp() || instr->IsUnaryDoubleOp() ||
+         instr->IsLoadIndexed() || instr->IsStoreIndexed() ||
+         instr->IsCheckArrayBound() || instr->IsGenericCheckBound() ||
+         instr->IsCheckClass() || instr->IsCheckClassId() ||
+         instr->IsCheckSmi() || instr->IsCheckNull() || instr->IsBox() ||
+         instr->IsIntConverter() || instr->IsRedefinition() ||
+         instr->IsCheckStackOverflow();
+}
+
+}  // namespace dart
@@ -0,0 +1,68 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_INSTRUCTION_COPIER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_INSTRUCTION_COPIER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+// Re-creates instructions of a flow graph with their inputs and environments
+// renamed, as needed by loop transformations which duplicate loop bodies
+// (see LoopUnroller and LoopVersioner).
+//
+// Only instructions that can be re-created faithfully are copied (see
+// IsCopyable). Copies keep the deopt id of the original instruction, so
+// deoptimizing in a copy resumes unoptimized code at the same place.
+class InstructionCopier : public ValueObject {
+ public:
+  // Maps definitions to their copies. Definitions that are not in the map
+  // are used as they are.
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+  typedef ZoneDirectChainedHashMap<DefinitionKV> DefinitionMap;
+
+  explicit InstructionCopier(FlowGraph* flow_graph)
+      : flow_graph_(flow_graph) {}
+
+  // Returns a copy of [instr] with inputs and environment renamed by [map].
+  // Adds the copy of a definition to the map.
+  Instruction* CopyInstruction(Instruction* instr, DefinitionMap* map);
+
+  // Returns a copy of [branch] (without successors) with the operands of its
+  // comparison and its environment renamed by [map].
+  BranchInstr* CopyBranch(BranchInstr* branch, const DefinitionMap& map);
+
+  Value* CopyInput(Instruction* instr,
+                   intptr_t index,
+                   const DefinitionMap& map);
+  void RenameInputs(Instruction* instr, const DefinitionMap& map);
+  void RenameEnvironment(Instruction* instr, const DefinitionMap& map);
+
+  static Definition* Lookup(const DefinitionMap& map, Definition* def) {
+    Definition* copy = map.LookupValue(def);
+    return copy != nullptr ? copy : def;
+  }
+
+  // Returns true if CopyInstruction can copy [instr].
+  static bool IsCopyable(Instruction* instr);
+
+ private:
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  FlowGraph* const flow_graph_;
+
+  DISALLOW_COPY_AND_ASSIGN(InstructionCopier);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_INSTRUCTION_COPIER_H_
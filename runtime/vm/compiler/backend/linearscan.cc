@@ -589,6 +589,19 @@ static bool HasOnlyUnconstrainedUses(LiveRange* range) {
   return true;
 }
 
+// Returns true if the constant [def] materialized into the [out] location
+// can be rematerialized by a move from the constant when it is spilled.
+static bool CanRematerialize(Definition* def, Location out) {
+  if (!out.IsUnallocated() ||
+      ((out.policy() != Location::kRequiresRegister) &&
+       (out.policy() != Location::kRequiresFpuRegister))) {
+    return false;
+  }
+  return (def->representation() == kTagged) ||
+         (def->representation() == kUnboxedDouble) ||
+         RepresentationUtils::IsUnboxedInteger(def->representation());
+}
+
 void FlowGraphAllocator::BuildLiveRanges() {
   const intptr_t block_count = block_order_.length();
   ASSERT(block_order_[0]->IsGraphEntry());
@@ -1410,6 +1423,14 @@ void FlowGraphAllocator::ProcessOneInstruction(BlockEntryInstr* block,
       locs->set_out(0, Location::NoLocation());
       return;
     }
+
+    // Otherwise the constant is materialized into a register at its
+    // definition. Use the constant itself as a pseudo spill slot so that
+    // when the range is spilled the value is rematerialized at its uses
+    // instead of being stored to and reloaded from the stack.
+    if (CanRematerialize(def, locs->out(0))) {
+      range->set_spill_slot(Location::Constant(def->AsConstant()));
+    }
   }
 
   const intptr_t pos = GetLifetimePosition(current);
@@ -0,0 +1,423 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_unrolling.h"
+
+#include <utility>
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/branch_optimizer.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, loop_unrolling, true, "Unroll small counted loops.");
+DEFINE_FLAG(int,
+            loop_unrolling_max_trip_count,
+            16,
+            "Fully unroll loops with at most this many iterations.");
+DEFINE_FLAG(int,
+            loop_unrolling_factor,
+            4,
+            "Maximum number of copies of the body in a partially unrolled "
+            "loop.");
+DEFINE_FLAG(int,
+            loop_unrolling_size_threshold,
+            80,
+            "Maximum number of instructions added by unrolling a loop in "
+            "JIT mode.");
+DEFINE_FLAG(int,
+            loop_unrolling_aot_size_threshold,
+            40,
+            "Maximum number of instructions added by unrolling a loop in "
+            "AOT mode (doubled with --optimization-level=3).");
+DEFINE_FLAG(bool, trace_loop_unrolling, false, "Trace loop unrolling.");
+
+DECLARE_FLAG(int, optimization_level);
+
+LoopUnroller::LoopUnroller(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph), copier_(flow_graph) {}
+
+intptr_t LoopUnroller::SizeBudget() {
+  if (!CompilerState::Current().is_aot()) {
+    return FLAG_loop_unrolling_size_threshold;
+  }
+  // Unrolling trades code size for speed, which is not wanted when
+  // optimizing for size.
+  switch (FLAG_optimization_level) {
+    case 1:
+      return 0;
+    case 3:
+      return 2 * FLAG_loop_unrolling_aot_size_threshold;
+    default:
+      return FLAG_loop_unrolling_aot_size_threshold;
+  }
+}
+
+bool LoopUnroller::Optimize() {
+  if (!FLAG_loop_unrolling || SizeBudget() <= 0) {
+    return false;
+  }
+  bool changed = false;
+  // Unrolling changes the flow graph, so the loop hierarchy is recomputed
+  // after every unrolled loop.
+  while (UnrollOneLoop()) {
+    changed = true;
+  }
+  return changed;
+}
+
+bool LoopUnroller::UnrollOneLoop() {
+  const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+  loop_hierarchy.ComputeInduction();
+  for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+    if (TryUnroll(header->loop_info())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LoopUnroller::TryUnroll(LoopInfo* loop) {
+  LoopShape shape;
+  if (!MatchLoop(loop, &shape)) {
+    return false;
+  }
+  const intptr_t budget = SizeBudget();
+
+  int64_t trip_count = 0;
+  const bool has_constant_trip_count = loop->HasConstantTripCount(&trip_count);
+  if (has_constant_trip_count &&
+      trip_count <= FLAG_loop_unrolling_max_trip_count &&
+      (trip_count + 1) * shape.size <= budget) {
+    if (FLAG_trace_loop_unrolling && flow_graph_->should_print()) {
+      THR_Print("Fully unrolling loop B%" Pd " (%" Pd64 " iterations)\n",
+                shape.header->block_id(), trip_count);
+    }
+    FullyUnroll(shape, static_cast<intptr_t>(trip_count));
+    return true;
+  }
+
+  // Partial unrolling only pays off for loops that are expected to run for
+  // a while, so it is limited to counted loops. In AOT mode it is only done
+  // when optimizing for speed, as the added code is rarely executed in
+  // most applications.
+  if (loop->control() == nullptr ||
+      (CompilerState::Current().is_aot() && FLAG_optimization_level < 3)) {
+    return false;
+  }
+  intptr_t factor = Utils::Minimum<intptr_t>(FLAG_loop_unrolling_factor,
+                                             1 + budget / (shape.size + 1));
+  if (has_constant_trip_count) {
+    factor = Utils::Minimum<intptr_t>(factor, trip_count);
+  }
+  if (factor < 2) {
+    return false;
+  }
+  GrowableArray<Definition*> live_out;
+  if (!CollectLiveOut(shape, &live_out)) {
+    return false;
+  }
+  if (FLAG_trace_loop_unrolling && flow_graph_->should_print()) {
+    THR_Print("Unrolling loop B%" Pd " by %" Pd "\n", shape.header->block_id(),
+              factor);
+  }
+  PartiallyUnroll(shape, factor, live_out);
+  return true;
+}
+
+bool LoopUnroller::MatchLoop(LoopInfo* loop, LoopShape* shape) {
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if (header == nullptr || loop->inner() != nullptr ||
+      loop->back_edges().length() != 1 || header->PredecessorCount() != 2 ||
+      header->try_index() != kInvalidTryIndex) {
+    return false;
+  }
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  if (branch == nullptr || branch->comparison()->InputCount() != 2 ||
+      branch->comparison()->IsDoubleTestOp()) {
+    return false;
+  }
+  TargetEntryInstr* body = branch->true_successor();
+  TargetEntryInstr* exit = branch->false_successor();
+  if (!loop->Contains(body)) {
+    std::swap(body, exit);
+  }
+  if (body != loop->back_edges()[0] || loop->Contains(exit) ||
+      body->env() == nullptr || exit->env() == nullptr ||
+      !body->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  shape->loop = loop;
+  shape->header = header;
+  shape->body = body;
+  shape->exit = exit;
+  shape->branch = branch;
+  shape->back_edge_index = header->IndexOfPredecessor(body);
+  shape->pre_header_index = 1 - shape->back_edge_index;
+  shape->pre_header = header->PredecessorAt(shape->pre_header_index);
+  if (shape->pre_header->try_index() != kInvalidTryIndex) {
+    return false;
+  }
+
+  intptr_t size = 0;
+  for (BlockEntryInstr* block : {static_cast<BlockEntryInstr*>(header),
+                                 static_cast<BlockEntryInstr*>(body)}) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* instr = it.Current();
+      if (instr->IsCheckStackOverflow() || instr == branch ||
+          instr->IsGoto()) {
+        continue;
+      }
+      if (!InstructionCopier::IsCopyable(instr)) {
+        return false;
+      }
+      size++;
+    }
+  }
+  shape->size = size;
+  return true;
+}
+
+bool LoopUnroller::CollectLiveOut(const LoopShape& shape,
+                                  GrowableArray<Definition*>* live_out) {
+  auto is_used_outside = [&](Definition* def) {
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      BlockEntryInstr* block = it.Current()->instruction()->GetBlock();
+      if (block != shape.header && block != shape.body) return true;
+    }
+    for (Value::Iterator it(def->env_use_list()); !it.Done(); it.Advance()) {
+      BlockEntryInstr* block = it.Current()->instruction()->GetBlock();
+      if (block != shape.header && block != shape.body) return true;
+    }
+    return false;
+  };
+  auto collect = [&](Definition* def) {
+    if (!is_used_outside(def)) return true;
+    // Untagged values cannot flow into phis.
+    if (def->representation() == kUntagged) return false;
+    live_out->Add(def);
+    return true;
+  };
+
+  for (PhiIterator it(shape.header); !it.Done(); it.Advance()) {
+    if (!collect(it.Current())) return false;
+  }
+  for (ForwardInstructionIterator it(shape.header); !it.Done(); it.Advance()) {
+    Definition* def = it.Current()->AsDefinition();
+    if (def != nullptr && !collect(def)) return false;
+  }
+  return true;
+}
+
+// Replaces the loop with copies of the header and the body for every
+// iteration, followed by a final copy of the header which computes the
+// values observed after the loop:
+//
+//   pre_header: ..., H0, B0, H1, B1, ..., Hn, goto exit
+//
+void LoopUnroller::FullyUnroll(const LoopShape& shape, intptr_t trip_count) {
+  GotoInstr* goto_header = shape.pre_header->last_instruction()->AsGoto();
+  ASSERT(goto_header != nullptr);
+  Instruction* last = goto_header->previous();
+
+  DefinitionMap* map = FirstIteration(shape);
+  for (intptr_t i = 0; i < trip_count; ++i) {
+    last = CopyBlock(shape.header, map, last);
+    last = CopyBlock(shape.body, map, last);
+    map = NextIteration(shape, *map);
+  }
+  last = CopyBlock(shape.header, map, last);
+  last->LinkTo(goto_header);
+
+  JoinEntryInstr* join = BranchSimplifier::ToJoinEntry(zone(), shape.exit);
+  goto_header->set_successor(join);
+
+  // Remove the original loop, redirecting uses of header definitions after
+  // the loop to their values in the final copy of the header.
+  for (BlockEntryInstr* block : {static_cast<BlockEntryInstr*>(shape.header),
+                                 static_cast<BlockEntryInstr*>(shape.body)}) {
+    if (auto join_entry = block->AsJoinEntry()) {
+      for (PhiIterator it(join_entry); !it.Done(); it.Advance()) {
+        it.Current()->UnuseAllInputs();
+      }
+    }
+    block->UnuseAllInputs();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      it.Current()->UnuseAllInputs();
+    }
+  }
+  for (PhiIterator it(shape.header); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    phi->ReplaceUsesWith(InstructionCopier::Lookup(*map, phi));
+  }
+  for (ForwardInstructionIterator it(shape.header); !it.Done(); it.Advance()) {
+    if (Definition* def = it.Current()->AsDefinition()) {
+      def->ReplaceUsesWith(InstructionCopier::Lookup(*map, def));
+    }
+  }
+
+  flow_graph_->DiscoverBlocks();
+  flow_graph_->MergeBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph_->ComputeDominators(&dominance_frontier);
+}
+
+// Unrolls the loop by [factor], testing the exit condition after every copy
+// of the body:
+//
+//   header:  phis, H,   branch S1 / E1
+//   S1:      B,   H',  branch S2 / E2
+//   ...
+//   body:    B'', goto header           (exited via E_factor from the last S)
+//   E_k:     goto exit                  (exit turned into a join)
+//
+// The original body block stays the back edge of the loop, so the order of
+// phi inputs in the header is unchanged. Header definitions which are used
+// after the loop are merged from all exits by new phis.
+void LoopUnroller::PartiallyUnroll(const LoopShape& shape,
+                                   intptr_t factor,
+                                   const GrowableArray<Definition*>& live_out) {
+  const bool stays_if_true = shape.branch->true_successor() == shape.body;
+  JoinEntryInstr* join = BranchSimplifier::ToJoinEntry(zone(), shape.exit);
+
+  GrowableArray<BlockEntryInstr*> loop_blocks;
+  loop_blocks.Add(shape.header);
+  loop_blocks.Add(shape.body);
+  GrowableArray<BlockEntryInstr*> exits;
+  GrowableArray<DefinitionMap*> exit_maps;
+
+  DefinitionMap* map = new (zone()) DefinitionMap();
+  BranchInstr* test = shape.branch;
+  for (intptr_t i = 1; i <= factor; ++i) {
+    TargetEntryInstr* exit = NewTarget(join, *map);
+    GotoInstr* goto_join = new (zone()) GotoInstr(join, DeoptId::kNone);
+    goto_join->InheritDeoptTarget(zone(), join);
+    copier_.RenameEnvironment(goto_join, *map);
+    exit->LinkTo(goto_join);
+    exit->set_last_instruction(goto_join);
+    loop_blocks.Add(exit);
+    exits.Add(exit);
+    exit_maps.Add(map);
+
+    TargetEntryInstr* next =
+        (i == factor) ? shape.body : NewTarget(shape.body, *map);
+    *(stays_if_true ? test->true_successor_address()
+                    : test->false_successor_address()) = next;
+    *(stays_if_true ? test->false_successor_address()
+                    : test->true_successor_address()) = exit;
+    if (i == factor) {
+      break;
+    }
+    loop_blocks.Add(next);
+
+    Instruction* last = CopyBlock(shape.body, map, next);
+    map = NextIteration(shape, *map);
+    last = CopyBlock(shape.header, map, last);
+    test = copier_.CopyBranch(shape.branch, *map);
+    last->AppendInstruction(test);
+    next->set_last_instruction(test);
+  }
+
+  // The original body is now the last copy, which continues with the values
+  // computed by the copies of the header before it.
+  copier_.RenameEnvironment(shape.body, *map);
+  for (ForwardInstructionIterator it(shape.body); !it.Done(); it.Advance()) {
+    copier_.RenameInputs(it.Current(), *map);
+    copier_.RenameEnvironment(it.Current(), *map);
+  }
+  for (PhiIterator it(shape.header); !it.Done(); it.Advance()) {
+    Value* input = it.Current()->InputAt(shape.back_edge_index);
+    Definition* def = InstructionCopier::Lookup(*map, input->definition());
+    if (def != input->definition()) {
+      input->BindTo(def);
+    }
+  }
+
+  flow_graph_->DiscoverBlocks();
+
+  // Merge values of header definitions used after the loop.
+  for (Definition* def : live_out) {
+    PhiInstr* phi = new (zone()) PhiInstr(join, join->PredecessorCount());
+    phi->set_representation(def->representation());
+    flow_graph_->AllocateSSAIndex(phi);
+    phi->mark_alive();
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      Value* use = it.Current();
+      if (!loop_blocks.Contains(use->instruction()->GetBlock())) {
+        use->BindTo(phi);
+      }
+    }
+    for (Value::Iterator it(def->env_use_list()); !it.Done(); it.Advance()) {
+      Value* use = it.Current();
+      if (!loop_blocks.Contains(use->instruction()->GetBlock())) {
+        use->BindToEnvironment(phi);
+      }
+    }
+    for (intptr_t i = 0; i < join->PredecessorCount(); ++i) {
+      BlockEntryInstr* pred = join->PredecessorAt(i);
+      intptr_t index = 0;
+      while (exits[index] != pred) {
+        index++;
+      }
+      Value* input = new (zone())
+          Value(InstructionCopier::Lookup(*exit_maps[index], def));
+      phi->SetInputAt(i, input);
+      input->definition()->AddInputUse(input);
+    }
+    join->InsertPhi(phi);
+  }
+
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph_->ComputeDominators(&dominance_frontier);
+}
+
+LoopUnroller::DefinitionMap* LoopUnroller::FirstIteration(
+    const LoopShape& shape) {
+  DefinitionMap* map = new (zone()) DefinitionMap();
+  for (PhiIterator it(shape.header); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    map->Insert({phi, phi->InputAt(shape.pre_header_index)->definition()});
+  }
+  return map;
+}
+
+LoopUnroller::DefinitionMap* LoopUnroller::NextIteration(
+    const LoopShape& shape,
+    const DefinitionMap& map) {
+  DefinitionMap* next = new (zone()) DefinitionMap();
+  for (PhiIterator it(shape.header); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    Definition* input = phi->InputAt(shape.back_edge_index)->definition();
+    next->Insert({phi, InstructionCopier::Lookup(map, input)});
+  }
+  return next;
+}
+
+Instruction* LoopUnroller::CopyBlock(BlockEntryInstr* block,
+                                     DefinitionMap* map,
+                                     Instruction* last) {
+  for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (instr->IsCheckStackOverflow() || instr->IsBranch() ||
+        instr->IsGoto()) {
+      continue;
+    }
+    last = last->AppendInstruction(copier_.CopyInstruction(instr, map));
+  }
+  return last;
+}
+
+TargetEntryInstr* LoopUnroller::NewTarget(BlockEntryInstr* from,
+                                          const DefinitionMap& map) {
+  TargetEntryInstr* target = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), from->try_index(), DeoptId::kNone);
+  target->InheritDeoptTarget(zone(), from);
+  copier_.RenameEnvironment(target, map);
+  return target;
+}
+
+}  // namespace dart
@@ -0,0 +1,115 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/instruction_copier.h"
+#include "vm/compiler/backend/loops.h"
+
+namespace dart {
+
+// Unrolls small innermost counted loops whose body is a single basic block:
+//
+//   pre_header: ... goto header
+//   header:     phis, ..., branch (test) body / exit
+//   body:       ..., goto header
+//
+// Loops with a constant trip count (see LoopInfo::HasConstantTripCount) are
+// fully unrolled into straight-line code at the end of the pre-header.
+//
+// Other counted loops are unrolled by --loop-unrolling-factor. Instead of
+// computing how many iterations are left and running a remainder loop, each
+// copy of the body is followed by a copy of the exit test, so the unrolled
+// loop stays correct for any trip count (including ones that wrap around in
+// int64 arithmetic) while still saving a back edge and a stack overflow check
+// for every unrolled iteration.
+//
+// Only instructions that can be re-created faithfully are unrolled (see
+// InstructionCopier::IsCopyable). Copies keep the deopt id of the original
+// instruction and get environments that refer to the values of their own
+// iteration, so deoptimizing in the middle of an unrolled loop resumes
+// unoptimized code in the right iteration.
+class LoopUnroller : public ValueObject {
+ public:
+  explicit LoopUnroller(FlowGraph* flow_graph);
+
+  // Unrolls all suitable loops. Returns true if the flow graph has changed.
+  bool Optimize();
+
+ private:
+  // Maps definitions of the loop to their copies in one unrolled iteration.
+  // Definitions that are not in the map are defined outside of the loop (or
+  // are the originals of the iteration that the map describes).
+  typedef InstructionCopier::DefinitionMap DefinitionMap;
+
+  struct LoopShape {
+    LoopInfo* loop;
+    JoinEntryInstr* header;
+    BlockEntryInstr* pre_header;
+    TargetEntryInstr* body;
+    TargetEntryInstr* exit;
+    BranchInstr* branch;
+    // Index of the phi inputs coming from the pre-header and the body.
+    intptr_t pre_header_index;
+    intptr_t back_edge_index;
+    // Number of instructions copied for every unrolled iteration.
+    intptr_t size;
+  };
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  // Maximum number of instructions unrolling a single loop may add.
+  static intptr_t SizeBudget();
+
+  bool UnrollOneLoop();
+  bool TryUnroll(LoopInfo* loop);
+  bool MatchLoop(LoopInfo* loop, LoopShape* shape);
+
+  // Collects header definitions which are used after the loop.
+  // Returns false if one of them cannot be merged by a phi.
+  bool CollectLiveOut(const LoopShape& shape,
+                      GrowableArray<Definition*>* live_out);
+
+  void FullyUnroll(const LoopShape& shape, intptr_t trip_count);
+  void PartiallyUnroll(const LoopShape& shape,
+                       intptr_t factor,
+                       const GrowableArray<Definition*>& live_out);
+
+  // Returns the map of the first iteration, where header phis take the
+  // values coming from the pre-header.
+  DefinitionMap* FirstIteration(const LoopShape& shape);
+
+  // Returns the map of the iteration following the one described by [map],
+  // where header phis take the values of their back edge inputs.
+  DefinitionMap* NextIteration(const LoopShape& shape,
+                               const DefinitionMap& map);
+
+  // Copies instructions of [block] for the iteration described by [map] and
+  // appends them after [last]. Skips the stack overflow check and the exit
+  // test of the header. Returns the last instruction appended.
+  Instruction* CopyBlock(BlockEntryInstr* block,
+                         DefinitionMap* map,
+                         Instruction* last);
+
+  // Returns a new block entry inheriting the deoptimization target of [from]
+  // with its environment renamed by [map].
+  TargetEntryInstr* NewTarget(BlockEntryInstr* from, const DefinitionMap& map);
+
+  FlowGraph* const flow_graph_;
+  InstructionCopier copier_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopUnroller);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLING_H_
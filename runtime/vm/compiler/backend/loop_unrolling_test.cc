@@ -0,0 +1,164 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests specific to loop unrolling.
+
+#include "vm/compiler/backend/loop_unrolling.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_unrolling);
+DECLARE_FLAG(int, loop_unrolling_factor);
+
+// Helper method to count number of indexed stores.
+static intptr_t CountStores(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (it.Current()->IsStoreIndexed()) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+struct UnrollResult {
+  bool changed;
+  intptr_t loops;
+  intptr_t stores;
+};
+
+// Helper method to build CFG, run loop unrolling on function foo, and
+// report the number of loops and indexed stores after unrolling.
+static UnrollResult ApplyUnrolling(const char* script_chars) {
+  // Load the script and exercise the code once
+  // while exercising the given compiler passes.
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  std::initializer_list<CompilerPass::Id> passes = {
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+  };
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  EXPECT_EQ(1, flow_graph->GetLoopHierarchy().num_loops());
+  EXPECT_EQ(1, CountStores(flow_graph));
+
+  LoopUnroller unroller(flow_graph);
+  UnrollResult result;
+  result.changed = unroller.Optimize();
+  result.loops = flow_graph->GetLoopHierarchy().num_loops();
+  result.stores = CountStores(flow_graph);
+  return result;
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_ConstantTripCount) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a) {
+        for (int i = 0; i < 4; i++) {
+          a[i] = i;
+        }
+      }
+      main() {
+        final a = Uint8List(4);
+        for (int i = 0; i < 100; i++) {
+          foo(a);
+        }
+      }
+    )";
+  UnrollResult result = ApplyUnrolling(kScriptChars);
+  EXPECT(result.changed);
+  EXPECT_EQ(0, result.loops);
+  EXPECT_EQ(4, result.stores);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_ConstantTripCountDown) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a) {
+        for (int i = 3; i > 0; i--) {
+          a[i] = i;
+        }
+      }
+      main() {
+        final a = Uint8List(4);
+        for (int i = 0; i < 100; i++) {
+          foo(a);
+        }
+      }
+    )";
+  UnrollResult result = ApplyUnrolling(kScriptChars);
+  EXPECT(result.changed);
+  EXPECT_EQ(0, result.loops);
+  EXPECT_EQ(3, result.stores);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_VariableTripCount) {
+  SetFlagScope<int> sfs(&FLAG_loop_unrolling_factor, 2);
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List a, int n) {
+        for (int i = 0; i < n; i++) {
+          a[i] = a[i] * 2.0;
+        }
+      }
+      main() {
+        final a = Float64List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a, i);
+        }
+      }
+    )";
+  UnrollResult result = ApplyUnrolling(kScriptChars);
+  EXPECT(result.changed);
+  // The loop stays, but every iteration of it runs two copies of the body.
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(2, result.stores);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopUnrolling_Disabled) {
+  SetFlagScope<bool> sfs(&FLAG_loop_unrolling, false);
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a) {
+        for (int i = 0; i < 4; i++) {
+          a[i] = i;
+        }
+      }
+      main() {
+        final a = Uint8List(4);
+        for (int i = 0; i < 100; i++) {
+          foo(a);
+        }
+      }
+    )";
+  UnrollResult result = ApplyUnrolling(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(1, result.stores);
+}
+
+}  // namespace dart
@@ -0,0 +1,882 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorization.h"
+
+#include <cmath>
+#include <utility>
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            true,
+            "Vectorize loops over typed data using SIMD operations.");
+DEFINE_FLAG(bool,
+            trace_loop_vectorization,
+            false,
+            "Trace loop vectorization.");
+
+DECLARE_FLAG(int, optimization_level);
+
+LoopVectorizer::LoopVectorizer(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph) {}
+
+bool LoopVectorizer::IsSupported() {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  // The vector loop duplicates the loop, which is not wanted when optimizing
+  // for size.
+  if (CompilerState::Current().is_aot() && FLAG_optimization_level == 1) {
+    return false;
+  }
+  return FlowGraphCompiler::SupportsUnboxedSimd128();
+#else
+  // Vector loads and stores use unboxed 64-bit indices.
+  return false;
+#endif
+}
+
+bool LoopVectorizer::Optimize() {
+  if (!FLAG_loop_vectorization || !IsSupported()) {
+    return false;
+  }
+  bool changed = false;
+  // Vectorization changes the flow graph, so the loop hierarchy is recomputed
+  // after every vectorized loop.
+  while (VectorizeOneLoop()) {
+    changed = true;
+  }
+  return changed;
+}
+
+bool LoopVectorizer::VectorizeOneLoop() {
+  const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+  for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+    // The original loop stays as the scalar epilogue of the vector loop.
+    if (vectorized_.Contains(header)) {
+      continue;
+    }
+    VectorLoop vl;
+    if (!MatchLoop(header->loop_info(), &vl)) {
+      continue;
+    }
+    if (FLAG_trace_loop_vectorization && flow_graph_->should_print()) {
+      THR_Print("Vectorizing loop B%" Pd " (%" Pd " lanes)\n",
+                header->block_id(), vl.lanes);
+    }
+    Vectorize(vl);
+    vectorized_.Add(header);
+    return true;
+  }
+  return false;
+}
+
+bool LoopVectorizer::MatchLoop(LoopInfo* loop, VectorLoop* vl) {
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if (header == nullptr || loop->inner() != nullptr ||
+      loop->back_edges().length() != 1 || header->PredecessorCount() != 2 ||
+      header->try_index() != kInvalidTryIndex || header->env() == nullptr) {
+    return false;
+  }
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    return false;
+  }
+  TargetEntryInstr* body = branch->true_successor();
+  TargetEntryInstr* exit = branch->false_successor();
+  if (!loop->Contains(body)) {
+    std::swap(body, exit);
+  }
+  if (body != loop->back_edges()[0] || loop->Contains(exit) ||
+      !body->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  vl->loop = loop;
+  vl->header = header;
+  vl->body = body;
+  vl->back_edge_index = header->IndexOfPredecessor(body);
+  vl->pre_header_index = 1 - vl->back_edge_index;
+  vl->pre_header = header->PredecessorAt(vl->pre_header_index);
+  if (vl->pre_header->try_index() != kInvalidTryIndex ||
+      !vl->pre_header->last_instruction()->IsGoto()) {
+    return false;
+  }
+  return MatchHeader(vl) && MatchBody(vl);
+}
+
+bool LoopVectorizer::MatchHeader(VectorLoop* vl) {
+  JoinEntryInstr* header = vl->header;
+
+  // The induction variable must be the only phi, so that the vector loop
+  // does not need to compute any other values carried between iterations.
+  for (PhiIterator it(header); !it.Done(); it.Advance()) {
+    if (vl->induction != nullptr) {
+      return false;
+    }
+    vl->induction = it.Current();
+  }
+  PhiInstr* phi = vl->induction;
+  if (phi == nullptr ||
+      !phi->InputAt(vl->pre_header_index)->Type()->IsInt()) {
+    return false;
+  }
+
+  // The induction variable is incremented by 1 at the end of the body.
+  vl->increment = phi->InputAt(vl->back_edge_index)->definition();
+  BinaryIntegerOpInstr* add = vl->increment->AsBinaryIntegerOp();
+  if (add == nullptr || add->op_kind() != Token::kADD ||
+      add->GetBlock() != vl->body ||
+      !add->HasOnlyInputUse(phi->InputAt(vl->back_edge_index))) {
+    return false;
+  }
+  Value* step = nullptr;
+  if (add->left()->definition() == phi) {
+    step = add->right();
+  } else if (add->right()->definition() == phi) {
+    step = add->left();
+  } else {
+    return false;
+  }
+  if (!step->BindsToSmiConstant() || step->BoundSmiConstant() != 1) {
+    return false;
+  }
+
+  for (ForwardInstructionIterator it(header); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (instr->IsBranch()) {
+      continue;
+    }
+    if (auto check = instr->AsCheckStackOverflow()) {
+      // The environment of the check is copied into the vector loop, so it
+      // must not refer to other definitions of the header.
+      if (vl->stack_check != nullptr || !vl->header_loads.is_empty()) {
+        return false;
+      }
+      vl->stack_check = check;
+      continue;
+    }
+    if (auto load = instr->AsLoadField()) {
+      if (load->slot().is_immutable() && !load->calls_initializer() &&
+          IsInvariant(*vl, load->instance()->definition())) {
+        vl->header_loads.Add(load);
+        continue;
+      }
+    }
+    return false;
+  }
+
+  // Normalize the loop test to (induction < bound) or (induction <= bound).
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  RelationalOpInstr* compare = branch->comparison()->AsRelationalOp();
+  if (compare == nullptr || (compare->operation_cid() != kSmiCid &&
+                             compare->operation_cid() != kMintCid)) {
+    return false;
+  }
+  Token::Kind kind = compare->kind();
+  if (branch->true_successor() != vl->body) {
+    kind = Token::NegateComparison(kind);
+  }
+  if (compare->left()->definition() == phi) {
+    vl->bound = compare->right()->definition();
+  } else if (compare->right()->definition() == phi) {
+    vl->bound = compare->left()->definition();
+    kind = Token::FlipComparison(kind);
+  } else {
+    return false;
+  }
+  if (kind != Token::kLT && kind != Token::kLTE) {
+    return false;
+  }
+  vl->test_kind = kind;
+  if (!vl->bound->Type()->IsInt()) {
+    return false;
+  }
+  if (auto load = vl->bound->AsLoadField()) {
+    return IsInvariant(*vl, load) || vl->header_loads.Contains(load);
+  }
+  return IsInvariant(*vl, vl->bound);
+}
+
+bool LoopVectorizer::MatchBody(VectorLoop* vl) {
+  // Match element-wise computations of all stored values first, which
+  // determines the arrays accessed by the loop.
+  for (ForwardInstructionIterator it(vl->body); !it.Done(); it.Advance()) {
+    StoreIndexedInstr* store = it.Current()->AsStoreIndexed();
+    if (store == nullptr) {
+      continue;
+    }
+    if (!IsInductionIndex(*vl, store->index()) ||
+        store->index_scale() != TypedDataBase::ElementSizeFor(
+                                    store->class_id()) ||
+        !AddArray(vl, store->array(), store->class_id())) {
+      return false;
+    }
+    Definition* value = store->value()->definition();
+    switch (vl->kind) {
+      case ElementKind::kFloat64:
+        if (!MatchFloat64(vl, value)) return false;
+        break;
+      case ElementKind::kFloat32:
+        // Values are converted to float when stored.
+        if (!value->IsDoubleToFloat() || !AddNode(vl, value) ||
+            !MatchFloat32(vl, value->InputAt(0)->definition())) {
+          return false;
+        }
+        break;
+      case ElementKind::kInteger:
+        if (!MatchInteger(vl, value)) return false;
+        break;
+    }
+    vl->stores.Add(store);
+  }
+  if (vl->stores.is_empty()) {
+    return false;
+  }
+
+  // All other instructions of the body must be checks which are known to
+  // pass for the iterations run by the vector loop.
+  for (ForwardInstructionIterator it(vl->body); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (instr->IsGoto() || instr == vl->increment || instr->IsStoreIndexed()) {
+      continue;
+    }
+    if (Definition* def = instr->AsDefinition()) {
+      if (vl->nodes.Contains(def)) {
+        continue;
+      }
+    }
+    if (auto check = instr->AsCheckBoundBase()) {
+      if (IsInductionIndex(*vl, check->index()) &&
+          AddLength(vl, check->length()->definition())) {
+        continue;
+      }
+    } else if (auto check = instr->AsCheckClass()) {
+      const intptr_t cid = ArrayClassId(*vl, check->value());
+      if (cid != kIllegalCid && check->cids().HasClassId(cid)) continue;
+    } else if (auto check = instr->AsCheckClassId()) {
+      const intptr_t cid = ArrayClassId(*vl, check->value());
+      if (cid != kIllegalCid && check->cids().Contains(cid)) continue;
+    } else if (auto check = instr->AsCheckNull()) {
+      if (IsGuardedArray(*vl, check->value())) continue;
+    } else if (auto check = instr->AsCheckWritable()) {
+      // Internal typed data is always writable.
+      if (IsGuardedArray(*vl, check->value())) continue;
+    } else if (auto check = instr->AsCheckSmi()) {
+      // Checks of stored values only guard speculative integer operations,
+      // whose results are truncated when stored anyway.
+      Definition* value = check->value()->definition();
+      if (IsInductionIndex(*vl, check->value()) || vl->nodes.Contains(value)) {
+        continue;
+      }
+    } else if (auto load = instr->AsLoadField()) {
+      // Lengths of arrays are recomputed in front of the vector loop.
+      if (load->slot().is_immutable() && !load->calls_initializer() &&
+          IsGuardedArray(*vl, load->instance())) {
+        continue;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+bool LoopVectorizer::IsInvariant(const VectorLoop& vl, Definition* def) {
+  return !vl.loop->Contains(def->GetBlock());
+}
+
+bool LoopVectorizer::IsInductionIndex(const VectorLoop& vl, Value* value) {
+  Definition* def = value->definition();
+  while (auto check = def->AsCheckBoundBase()) {
+    def = check->index()->definition();
+  }
+  return def == vl.induction;
+}
+
+bool LoopVectorizer::AddArray(VectorLoop* vl,
+                              Value* array,
+                              intptr_t class_id) {
+  // Views and external typed data may overlap with other arrays, so only
+  // internal typed data is accessed by the vector loop.
+  if (!IsTypedDataClassId(class_id) || !SetElementKind(vl, class_id)) {
+    return false;
+  }
+  Definition* def = array->definition()->OriginalDefinition();
+  if (!IsInvariant(*vl, def) || def->representation() != kTagged) {
+    return false;
+  }
+  const intptr_t array_cid = ArrayClassId(*vl, array);
+  if (array_cid != kIllegalCid) {
+    return array_cid == class_id;
+  }
+  vl->arrays.Add(def);
+  vl->array_cids.Add(class_id);
+  return true;
+}
+
+intptr_t LoopVectorizer::ArrayClassId(const VectorLoop& vl, Value* value) {
+  Definition* def = value->definition()->OriginalDefinition();
+  for (intptr_t i = 0; i < vl.arrays.length(); ++i) {
+    if (vl.arrays[i] == def) {
+      return vl.array_cids[i];
+    }
+  }
+  return kIllegalCid;
+}
+
+bool LoopVectorizer::IsGuardedArray(const VectorLoop& vl, Value* value) {
+  return ArrayClassId(vl, value) != kIllegalCid;
+}
+
+bool LoopVectorizer::AddLength(VectorLoop* vl, Definition* length) {
+  // The vector loop checks lengths of all arrays it accesses.
+  if (auto load = length->AsLoadField()) {
+    if (load->slot().IsIdentical(Slot::TypedDataBase_length()) &&
+        IsGuardedArray(*vl, load->instance())) {
+      return true;
+    }
+  }
+  if (!IsInvariant(*vl, length) || !length->Type()->IsInt()) {
+    return false;
+  }
+  if (!vl->lengths.Contains(length)) {
+    vl->lengths.Add(length);
+  }
+  return true;
+}
+
+bool LoopVectorizer::SetElementKind(VectorLoop* vl, intptr_t class_id) {
+  ElementKind kind;
+  switch (class_id) {
+    case kTypedDataFloat64ArrayCid:
+      kind = ElementKind::kFloat64;
+      break;
+    case kTypedDataFloat32ArrayCid:
+      kind = ElementKind::kFloat32;
+      break;
+    case kTypedDataInt8ArrayCid:
+    case kTypedDataUint8ArrayCid:
+    case kTypedDataInt16ArrayCid:
+    case kTypedDataUint16ArrayCid:
+    case kTypedDataInt32ArrayCid:
+    case kTypedDataUint32ArrayCid:
+    case kTypedDataInt64ArrayCid:
+    case kTypedDataUint64ArrayCid:
+      kind = ElementKind::kInteger;
+      break;
+    default:
+      return false;
+  }
+  const intptr_t element_size = TypedDataBase::ElementSizeFor(class_id);
+  if (vl->lanes == 0) {
+    vl->kind = kind;
+    vl->element_size = element_size;
+    vl->lanes = kSimd128Size / element_size;
+    return true;
+  }
+  return vl->kind == kind && vl->element_size == element_size;
+}
+
+bool LoopVectorizer::MatchFloat64(VectorLoop* vl, Definition* def) {
+  if (IsInvariant(*vl, def)) {
+    return def->Type()->IsDouble();
+  }
+  if (def->IsLoadIndexed()) {
+    return MatchLoad(vl, def);
+  }
+  if (auto op = def->AsBinaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kMUL:
+      case Token::kDIV:
+        return MatchFloat64(vl, op->left()->definition()) &&
+               MatchFloat64(vl, op->right()->definition()) &&
+               AddNode(vl, def);
+      default:
+        return false;
+    }
+  }
+  if (auto op = def->AsUnaryDoubleOp()) {
+    return op->op_kind() == Token::kNEGATE &&
+           MatchFloat64(vl, op->value()->definition()) && AddNode(vl, def);
+  }
+  return false;
+}
+
+// Float32 elements are processed in double precision. The result of a
+// single operation on floats computed in double precision and rounded to
+// float is the same as the result of the operation in float precision, but
+// this does not hold for longer computations, so at most one operation is
+// allowed between loads and stores.
+bool LoopVectorizer::MatchFloat32(VectorLoop* vl, Definition* def) {
+  if (IsInvariant(*vl, def)) {
+    // Filling an array with a value.
+    return def->Type()->IsDouble();
+  }
+  if (auto op = def->AsBinaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kMUL:
+      case Token::kDIV:
+        return MatchFloat32Operand(vl, op->left()->definition()) &&
+               MatchFloat32Operand(vl, op->right()->definition()) &&
+               AddNode(vl, def);
+      default:
+        return false;
+    }
+  }
+  return MatchFloat32Operand(vl, def);
+}
+
+bool LoopVectorizer::MatchFloat32Operand(VectorLoop* vl, Definition* def) {
+  if (auto constant = def->AsConstant()) {
+    if (!constant->value().IsDouble()) {
+      return false;
+    }
+    const double value = Double::Cast(constant->value()).value();
+    return !std::isnan(value) &&
+           static_cast<double>(static_cast<float>(value)) == value;
+  }
+  if (auto conversion = def->AsFloatToDouble()) {
+    return MatchLoad(vl, conversion->value()->definition()) &&
+           AddNode(vl, def);
+  }
+  return false;
+}
+
+// Integer elements are processed 128 bits at a time. Bitwise operations
+// are the same for any lane size, and additions and subtractions wrap
+// around in 32-bit lanes exactly as they do when their results are truncated
+// to 32-bit elements.
+bool LoopVectorizer::MatchInteger(VectorLoop* vl, Definition* def) {
+  if (IsInvariant(*vl, def)) {
+    auto constant = def->AsConstant();
+    return constant != nullptr && constant->value().IsInteger();
+  }
+  if (def->IsLoadIndexed()) {
+    return MatchLoad(vl, def);
+  }
+  if (def->IsBox()) {
+    return MatchInteger(vl, def->InputAt(0)->definition()) && AddNode(vl, def);
+  }
+  // Conversions are only allowed if they do not truncate elements.
+  const size_t element_size = static_cast<size_t>(vl->element_size);
+  if (auto unbox = def->AsUnboxInteger()) {
+    return RepresentationUtils::ValueSize(unbox->representation()) >=
+               element_size &&
+           MatchInteger(vl, unbox->value()->definition()) && AddNode(vl, def);
+  }
+  if (auto conversion = def->AsIntConverter()) {
+    return RepresentationUtils::ValueSize(conversion->to()) >= element_size &&
+           MatchInteger(vl, conversion->value()->definition()) &&
+           AddNode(vl, def);
+  }
+  if (auto op = def->AsBinaryIntegerOp()) {
+    switch (op->op_kind()) {
+      case Token::kBIT_AND:
+      case Token::kBIT_OR:
+      case Token::kBIT_XOR:
+        break;
+      case Token::kADD:
+      case Token::kSUB:
+        if (vl->element_size != kInt32Size) return false;
+        break;
+      default:
+        return false;
+    }
+    return MatchInteger(vl, op->left()->definition()) &&
+           MatchInteger(vl, op->right()->definition()) && AddNode(vl, def);
+  }
+  return false;
+}
+
+bool LoopVectorizer::MatchLoad(VectorLoop* vl, Definition* def) {
+  LoadIndexedInstr* load = def->AsLoadIndexed();
+  return load != nullptr && load->GetBlock() == vl->body &&
+         IsInductionIndex(*vl, load->index()) &&
+         load->index_scale() == TypedDataBase::ElementSizeFor(
+                                    load->class_id()) &&
+         AddArray(vl, load->array(), load->class_id()) && AddNode(vl, def);
+}
+
+bool LoopVectorizer::AddNode(VectorLoop* vl, Definition* def) {
+  if (def->GetBlock() != vl->body) {
+    return false;
+  }
+  if (!vl->nodes.Contains(def)) {
+    vl->nodes.Add(def);
+  }
+  return true;
+}
+
+void LoopVectorizer::Vectorize(const VectorLoop& vl) {
+  JoinEntryInstr* header = vl.header;
+  PhiInstr* induction = vl.induction;
+  Definition* initial = induction->InputAt(vl.pre_header_index)->definition();
+  const intptr_t lanes = vl.lanes;
+
+  exits_.Clear();
+  exit_values_.Clear();
+  vector_values_ = new (zone()) DefinitionMap();
+  scalar_entry_ = new (zone()) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), header->try_index(), DeoptId::kNone);
+
+  // Replace the goto at the end of the pre-header with the guards of the
+  // vector loop.
+  GotoInstr* goto_header = vl.pre_header->last_instruction()->AsGoto();
+  goto_header->UnuseAllInputs();
+  block_ = vl.pre_header;
+  cursor_ = goto_header->previous();
+  index_ = initial;
+
+  // The vector loop counts up from the initial value, so it must not be
+  // negative for all indices to be in bounds.
+  EmitGuard(vl, new (zone()) RelationalOpInstr(
+                    InstructionSource(), Token::kGTE,
+                    new (zone()) Value(initial), Constant(0), kMintCid,
+                    DeoptId::kNone, Instruction::kNotSpeculative));
+  for (intptr_t i = 0; i < vl.arrays.length(); ++i) {
+    Definition* cid = Emit(
+        new (zone()) LoadClassIdInstr(new (zone()) Value(vl.arrays[i])));
+    EmitGuard(vl, new (zone()) StrictCompareInstr(
+                      InstructionSource(), Token::kEQ_STRICT,
+                      new (zone()) Value(cid), Constant(vl.array_cids[i]),
+                      /*needs_number_check=*/false, DeoptId::kNone));
+  }
+
+  // Compute the largest valid index of a vector for every length, and the
+  // bound of the loop test.
+  DefinitionMap header_copies;
+  for (LoadFieldInstr* load : vl.header_loads) {
+    Definition* copy = Emit(new (zone()) LoadFieldInstr(
+        new (zone()) Value(load->instance()->definition()), load->slot(),
+        load->loads_inner_pointer(), load->source()));
+    header_copies.Insert({load, copy});
+  }
+  GrowableArray<Definition*> limits;
+  GrowableArray<Definition*> lengths;
+  for (Definition* array : vl.arrays) {
+    lengths.Add(Emit(new (zone()) LoadFieldInstr(
+        new (zone()) Value(array), Slot::TypedDataBase_length(),
+        InstructionSource())));
+  }
+  lengths.AddArray(vl.lengths);
+  for (Definition* length : lengths) {
+    limits.Add(Emit(new (zone()) BinaryInt64OpInstr(
+        Token::kSUB, new (zone()) Value(length), Constant(lanes - 1),
+        DeoptId::kNone, Instruction::kNotSpeculative)));
+  }
+  Definition* bound = header_copies.LookupValue(vl.bound);
+  if (bound == nullptr) {
+    bound = vl.bound;
+  }
+
+  JoinEntryInstr* vector_header = new (zone()) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), header->try_index(), DeoptId::kNone);
+  BlockEntryInstr* guard_block = block_;
+  guard_goto_ = new (zone()) GotoInstr(vector_header, DeoptId::kNone);
+  guard_goto_->InheritDeoptTarget(zone(), header);
+  RenameEnvironment(guard_goto_, induction, initial);
+  cursor_->AppendInstruction(guard_goto_);
+  guard_block->set_last_instruction(guard_goto_);
+
+  // Header of the vector loop.
+  PhiInstr* vector_index = new (zone()) PhiInstr(vector_header, 2);
+  flow_graph_->AllocateSSAIndex(vector_index);
+  vector_index->mark_alive();
+  vector_header->InsertPhi(vector_index);
+  vector_header->InheritDeoptTarget(zone(), header);
+  RenameEnvironment(vector_header, induction, vector_index);
+  block_ = vector_header;
+  cursor_ = vector_header;
+  index_ = vector_index;
+  if (CheckStackOverflowInstr* check = vl.stack_check) {
+    auto check_copy = new (zone()) CheckStackOverflowInstr(
+        check->source(), check->stack_depth(), check->loop_depth(),
+        DeoptId::kNone, check->kind());
+    check_copy->InheritDeoptTarget(zone(), check);
+    RenameEnvironment(check_copy, induction, vector_index);
+    EmitEffect(check_copy);
+  }
+  for (Definition* limit : limits) {
+    EmitGuard(vl, new (zone()) RelationalOpInstr(
+                      InstructionSource(), Token::kLT,
+                      new (zone()) Value(vector_index),
+                      new (zone()) Value(limit), kMintCid, DeoptId::kNone,
+                      Instruction::kNotSpeculative));
+  }
+  Definition* last = Emit(new (zone()) BinaryInt64OpInstr(
+      Token::kADD, new (zone()) Value(vector_index), Constant(lanes - 1),
+      DeoptId::kNone, Instruction::kNotSpeculative));
+  EmitGuard(vl, new (zone()) RelationalOpInstr(
+                    InstructionSource(), vl.test_kind, new (zone()) Value(last),
+                    new (zone()) Value(bound), kMintCid, DeoptId::kNone,
+                    Instruction::kNotSpeculative));
+
+  // Body of the vector loop. Vector instructions are emitted in the order of
+  // the scalar ones, so loads and stores of the same elements stay ordered.
+  BlockEntryInstr* vector_body = block_;
+  for (ForwardInstructionIterator it(vl.body); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (auto store = instr->AsStoreIndexed()) {
+      EmitVectorStore(vl, store);
+    } else if (Definition* def = instr->AsDefinition()) {
+      if (vl.nodes.Contains(def)) {
+        EmitVectorNode(vl, def);
+      }
+    }
+  }
+  Definition* next_index = Emit(new (zone()) BinaryInt64OpInstr(
+      Token::kADD, new (zone()) Value(vector_index), Constant(lanes),
+      DeoptId::kNone, Instruction::kNotSpeculative));
+  GotoInstr* back_edge = new (zone()) GotoInstr(vector_header, DeoptId::kNone);
+  back_edge->InheritDeoptTarget(zone(), header);
+  RenameEnvironment(back_edge, induction, next_index);
+  cursor_->AppendInstruction(back_edge);
+  vector_body->set_last_instruction(back_edge);
+
+  // Entry of the scalar loop, which runs the remaining iterations.
+  PhiInstr* scalar_index =
+      new (zone()) PhiInstr(scalar_entry_, exits_.length());
+  flow_graph_->AllocateSSAIndex(scalar_index);
+  scalar_index->mark_alive();
+  scalar_entry_->InsertPhi(scalar_index);
+  scalar_entry_->InheritDeoptTarget(zone(), header);
+  RenameEnvironment(scalar_entry_, induction, scalar_index);
+  GotoInstr* goto_scalar = new (zone()) GotoInstr(header, DeoptId::kNone);
+  goto_scalar->InheritDeoptTarget(zone(), header);
+  RenameEnvironment(goto_scalar, induction, scalar_index);
+  scalar_entry_->LinkTo(goto_scalar);
+  scalar_entry_->set_last_instruction(goto_scalar);
+  induction->InputAt(vl.pre_header_index)->BindTo(scalar_index);
+
+  flow_graph_->DiscoverBlocks();
+
+  // Set phi inputs in the order of predecessors found by DiscoverBlocks.
+  auto set_input = [&](PhiInstr* phi, intptr_t i, Definition* def) {
+    Value* input = new (zone()) Value(def);
+    phi->SetInputAt(i, input);
+    def->AddInputUse(input);
+  };
+  for (intptr_t i = 0; i < exits_.length(); ++i) {
+    set_input(scalar_index, scalar_entry_->IndexOfPredecessor(exits_[i]),
+              exit_values_[i]);
+  }
+  set_input(vector_index, vector_header->IndexOfPredecessor(guard_block),
+            initial);
+  set_input(vector_index, vector_header->IndexOfPredecessor(vector_body),
+            next_index);
+  if (header->IndexOfPredecessor(scalar_entry_) != vl.pre_header_index) {
+    Value* first = induction->InputAt(0);
+    Value* second = induction->InputAt(1);
+    induction->SetInputAt(0, second);
+    induction->SetInputAt(1, first);
+  }
+
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph_->ComputeDominators(&dominance_frontier);
+}
+
+Definition* LoopVectorizer::VectorValue(const VectorLoop& vl,
+                                       Definition* def) {
+  Definition* vector = vector_values_->LookupValue(def);
+  if (vector == nullptr) {
+    ASSERT(IsInvariant(vl, def));
+    vector = Splat(vl, def);
+    vector_values_->Insert({def, vector});
+  }
+  return vector;
+}
+
+Definition* LoopVectorizer::Splat(const VectorLoop& vl, Definition* def) {
+  SimdOpInstr* splat = nullptr;
+  switch (vl.kind) {
+    case ElementKind::kFloat64:
+      splat = SimdOpInstr::Create(SimdOpInstr::kFloat64x2Splat,
+                                  new (zone()) Value(def), DeoptId::kNone);
+      break;
+    case ElementKind::kFloat32:
+      splat = SimdOpInstr::Create(SimdOpInstr::kFloat32x4Splat,
+                                  new (zone()) Value(def), DeoptId::kNone);
+      break;
+    case ElementKind::kInteger: {
+      // Replicate the truncated constant into 32-bit lanes.
+      const int64_t value =
+          Integer::Cast(def->AsConstant()->value()).Value();
+      uint32_t lane[4];
+      switch (vl.element_size) {
+        case 1:
+          lane[0] = static_cast<uint32_t>(value & 0xFF) * 0x01010101;
+          break;
+        case 2:
+          lane[0] = static_cast<uint32_t>(value & 0xFFFF) * 0x00010001;
+          break;
+        default:
+          lane[0] = static_cast<uint32_t>(value);
+          break;
+      }
+      lane[1] = (vl.element_size == kInt64Size)
+                    ? static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32)
+                    : lane[0];
+      lane[2] = lane[0];
+      lane[3] = lane[1];
+      Value* inputs[4];
+      for (intptr_t i = 0; i < 4; ++i) {
+        inputs[i] = new (zone()) Value(flow_graph_->GetConstant(
+            Integer::ZoneHandle(zone(), Integer::NewCanonical(
+                                            static_cast<int32_t>(lane[i]))),
+            kUnboxedInt32));
+      }
+      splat = SimdOpInstr::Create(SimdOpInstr::kInt32x4FromInts, inputs[0],
+                                  inputs[1], inputs[2], inputs[3],
+                                  DeoptId::kNone);
+      break;
+    }
+  }
+  flow_graph_->InsertBefore(guard_goto_, splat, nullptr, FlowGraph::kValue);
+  return splat;
+}
+
+void LoopVectorizer::EmitVectorNode(const VectorLoop& vl, Definition* def) {
+  Definition* vector = nullptr;
+  if (auto load = def->AsLoadIndexed()) {
+    vector = Emit(new (zone()) LoadIndexedInstr(
+        new (zone()) Value(load->array()->definition()->OriginalDefinition()),
+        new (zone()) Value(index_), /*index_unboxed=*/true,
+        load->index_scale(), SimdArrayClassId(vl), kUnalignedAccess,
+        DeoptId::kNone, load->source()));
+  } else if (auto op = def->AsBinaryDoubleOp()) {
+    vector = Emit(SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(SimdClassId(vl), op->op_kind()),
+        new (zone()) Value(VectorValue(vl, op->left()->definition())),
+        new (zone()) Value(VectorValue(vl, op->right()->definition())),
+        DeoptId::kNone));
+  } else if (auto op = def->AsUnaryDoubleOp()) {
+    ASSERT(op->op_kind() == Token::kNEGATE);
+    vector = Emit(SimdOpInstr::Create(
+        SimdOpInstr::kFloat64x2Negate,
+        new (zone()) Value(VectorValue(vl, op->value()->definition())),
+        DeoptId::kNone));
+  } else if (auto op = def->AsBinaryIntegerOp()) {
+    vector = Emit(SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(kInt32x4Cid, op->op_kind()),
+        new (zone()) Value(VectorValue(vl, op->left()->definition())),
+        new (zone()) Value(VectorValue(vl, op->right()->definition())),
+        DeoptId::kNone));
+  } else {
+    // Boxing and conversions between representations of elements.
+    ASSERT(def->IsBox() || def->IsUnboxInteger() || def->IsIntConverter() ||
+           def->IsFloatToDouble() || def->IsDoubleToFloat());
+    vector = VectorValue(vl, def->InputAt(0)->definition());
+  }
+  vector_values_->Insert({def, vector});
+}
+
+void LoopVectorizer::EmitVectorStore(const VectorLoop& vl,
+                                     StoreIndexedInstr* store) {
+  EmitEffect(new (zone()) StoreIndexedInstr(
+      new (zone()) Value(store->array()->definition()->OriginalDefinition()),
+      new (zone()) Value(index_),
+      new (zone()) Value(VectorValue(vl, store->value()->definition())),
+      kNoStoreBarrier, /*index_unboxed=*/true, store->index_scale(),
+      SimdArrayClassId(vl), kUnalignedAccess, DeoptId::kNone, store->source(),
+      Instruction::kNotSpeculative));
+}
+
+intptr_t LoopVectorizer::SimdClassId(const VectorLoop& vl) {
+  switch (vl.kind) {
+    case ElementKind::kFloat64:
+      return kFloat64x2Cid;
+    case ElementKind::kFloat32:
+      return kFloat32x4Cid;
+    case ElementKind::kInteger:
+      return kInt32x4Cid;
+  }
+  UNREACHABLE();
+  return kIllegalCid;
+}
+
+intptr_t LoopVectorizer::SimdArrayClassId(const VectorLoop& vl) {
+  switch (vl.kind) {
+    case ElementKind::kFloat64:
+      return kTypedDataFloat64x2ArrayCid;
+    case ElementKind::kFloat32:
+      return kTypedDataFloat32x4ArrayCid;
+    case ElementKind::kInteger:
+      return kTypedDataInt32x4ArrayCid;
+  }
+  UNREACHABLE();
+  return kIllegalCid;
+}
+
+TargetEntryInstr* LoopVectorizer::NewTarget(const VectorLoop& vl,
+                                            Definition* index) {
+  TargetEntryInstr* target = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), vl.header->try_index(),
+      DeoptId::kNone);
+  target->InheritDeoptTarget(zone(), vl.header);
+  RenameEnvironment(target, vl.induction, index);
+  return target;
+}
+
+Definition* LoopVectorizer::Emit(Definition* def) {
+  cursor_ = flow_graph_->AppendTo(cursor_, def, nullptr, FlowGraph::kValue);
+  return def;
+}
+
+void LoopVectorizer::EmitEffect(Instruction* instr) {
+  cursor_ = cursor_->AppendInstruction(instr);
+}
+
+void LoopVectorizer::EmitGuard(const VectorLoop& vl,
+                               ComparisonInstr* comparison) {
+  BranchInstr* branch = new (zone()) BranchInstr(comparison, DeoptId::kNone);
+  cursor_->AppendInstruction(branch);
+  block_->set_last_instruction(branch);
+
+  // Leave to the scalar loop with the current index if the guard fails.
+  TargetEntryInstr* exit = NewTarget(vl, index_);
+  GotoInstr* goto_scalar =
+      new (zone()) GotoInstr(scalar_entry_, DeoptId::kNone);
+  goto_scalar->InheritDeoptTarget(zone(), exit);
+  exit->LinkTo(goto_scalar);
+  exit->set_last_instruction(goto_scalar);
+  exits_.Add(exit);
+  exit_values_.Add(index_);
+
+  TargetEntryInstr* next = NewTarget(vl, index_);
+  *branch->true_successor_address() = next;
+  *branch->false_successor_address() = exit;
+  block_ = next;
+  cursor_ = next;
+}
+
+Value* LoopVectorizer::Constant(int64_t value) {
+  return new (zone()) Value(flow_graph_->GetConstant(
+      Integer::ZoneHandle(zone(), Integer::NewCanonical(value))));
+}
+
+void LoopVectorizer::RenameEnvironment(Instruction* instr,
+                                       Definition* from,
+                                       Definition* to) {
+  if (instr->env() == nullptr) {
+    return;
+  }
+  for (Environment::DeepIterator it(instr->env()); !it.Done(); it.Advance()) {
+    Value* value = it.CurrentValue();
+    if (value->definition() == from) {
+      value->BindToEnvironment(to);
+      value->SetReachingType(nullptr);
+    }
+  }
+}
+
+}  // namespace dart
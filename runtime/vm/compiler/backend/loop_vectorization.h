@@ -0,0 +1,201 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZATION_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZATION_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+// Vectorizes innermost counted loops with a single-block body which access
+// typed data element-wise, e.g.
+//
+//   for (int i = 0; i < n; i++) {
+//     y[i] = a * x[i] + y[i];  // Float64List
+//   }
+//
+// All accesses must use the basic induction variable of the loop as index.
+// Supported element-wise kernels are:
+//
+//   * Float64List: +, -, *, / and negation of elements and loop invariant
+//     doubles, evaluated with Float64x2 operations.
+//   * Float32List: copies, fills and a single +, -, * or / of elements and
+//     constants which are exactly representable as float, evaluated with
+//     Float32x4 operations (rounding the exact double result of a single
+//     operation to float gives the same result as the float operation).
+//   * Integer lists (other than clamped ones): copies and &, |, ^ of elements
+//     and constants, and + and - for 32-bit elements, evaluated on 128 bits
+//     at a time with Int32x4 operations.
+//
+// Reductions are not vectorized since reassociating floating point
+// additions changes the result, and there are no 64-bit integer lanes.
+//
+// The vector loop is inserted in front of the original loop, which becomes
+// the scalar epilogue:
+//
+//   pre_header: ..., branch (i0 >= 0) C / X
+//   C:          branch (cid(array) == expected) ... / X    (for each array)
+//   G:          lengths, splats of invariants, goto VH
+//   VH:         vi = phi(i0, vi + lanes), stack overflow check,
+//               branch (vi < length - (lanes - 1)) ... / X (for each length)
+//   T:          branch (vi + (lanes - 1) < n) VB / X       (loop test)
+//   VB:         vector loads, operations and stores, goto VH
+//   X:          xi = phi(i0, ..., vi, ...), goto header    (scalar loop)
+//
+// The guards make sure the vector body can neither go out of bounds nor
+// access views or external typed data (which could alias with other arrays
+// at different indices). Whenever a guard fails, the remaining iterations
+// run in the original loop, which keeps all of its checks, so exceptions
+// and deoptimization happen exactly as before.
+class LoopVectorizer : public ValueObject {
+ public:
+  explicit LoopVectorizer(FlowGraph* flow_graph);
+
+  // Vectorizes all suitable loops. Returns true if the flow graph has changed.
+  bool Optimize();
+
+ private:
+  // Maps scalar definitions of the loop body (and loop invariants) to their
+  // vector counterparts.
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+  typedef ZoneDirectChainedHashMap<DefinitionKV> DefinitionMap;
+
+  // The kind of elements processed by a vector loop.
+  enum class ElementKind {
+    kFloat64,
+    kFloat32,
+    kInteger,
+  };
+
+  struct VectorLoop {
+    LoopInfo* loop = nullptr;
+    JoinEntryInstr* header = nullptr;
+    BlockEntryInstr* pre_header = nullptr;
+    TargetEntryInstr* body = nullptr;
+    CheckStackOverflowInstr* stack_check = nullptr;
+    // Index of the phi inputs coming from the pre-header and the body.
+    intptr_t pre_header_index = -1;
+    intptr_t back_edge_index = -1;
+
+    // The loop runs while (induction test_kind bound) holds, where test_kind
+    // is either < or <=, and adds 1 to the induction variable every
+    // iteration.
+    PhiInstr* induction = nullptr;
+    Definition* increment = nullptr;
+    Definition* bound = nullptr;
+    Token::Kind test_kind = Token::kILLEGAL;
+
+    ElementKind kind = ElementKind::kFloat64;
+    intptr_t element_size = 0;
+    intptr_t lanes = 0;
+
+    // Typed data arrays accessed in the loop, with their class ids.
+    GrowableArray<Definition*> arrays;
+    GrowableArray<intptr_t> array_cids;
+    // Loop invariant lengths used by bounds checks in the loop (other than
+    // lengths of the arrays above).
+    GrowableArray<Definition*> lengths;
+    // Loads of immutable fields in the header, which are recomputed for the
+    // vector loop.
+    GrowableArray<LoadFieldInstr*> header_loads;
+    // Body instructions which compute values of stored elements.
+    GrowableArray<Definition*> nodes;
+    GrowableArray<StoreIndexedInstr*> stores;
+  };
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  // Returns true if vector operations can be used on the target.
+  static bool IsSupported();
+
+  bool VectorizeOneLoop();
+  bool MatchLoop(LoopInfo* loop, VectorLoop* vl);
+  bool MatchHeader(VectorLoop* vl);
+  bool MatchBody(VectorLoop* vl);
+
+  bool IsInvariant(const VectorLoop& vl, Definition* def);
+
+  // Returns true if [value] is the induction variable or a redefinition of
+  // it by a bounds check.
+  bool IsInductionIndex(const VectorLoop& vl, Value* value);
+
+  // Records the typed data array accessed with [class_id] and returns true
+  // if it can be accessed by the vector loop.
+  bool AddArray(VectorLoop* vl, Value* array, intptr_t class_id);
+  bool IsGuardedArray(const VectorLoop& vl, Value* value);
+  // Returns the class id of the guarded array [value], or kIllegalCid.
+  intptr_t ArrayClassId(const VectorLoop& vl, Value* value);
+
+  // Records a length used by a bounds check and returns true if it can be
+  // checked before entering the vector loop.
+  bool AddLength(VectorLoop* vl, Definition* length);
+
+  // Sets the element kind of the loop from the class id of an access.
+  static bool SetElementKind(VectorLoop* vl, intptr_t class_id);
+
+  // Check that [def] can be computed element-wise by vector operations and
+  // record the instructions of the loop body it depends on.
+  bool MatchFloat64(VectorLoop* vl, Definition* def);
+  bool MatchFloat32(VectorLoop* vl, Definition* def);
+  bool MatchFloat32Operand(VectorLoop* vl, Definition* def);
+  bool MatchInteger(VectorLoop* vl, Definition* def);
+  bool MatchLoad(VectorLoop* vl, Definition* def);
+  bool AddNode(VectorLoop* vl, Definition* def);
+
+  void Vectorize(const VectorLoop& vl);
+
+  // Returns the vector counterpart of [def], splatting loop invariants into
+  // all lanes at the end of the block in front of the vector loop.
+  Definition* VectorValue(const VectorLoop& vl, Definition* def);
+  Definition* Splat(const VectorLoop& vl, Definition* def);
+  void EmitVectorNode(const VectorLoop& vl, Definition* def);
+  void EmitVectorStore(const VectorLoop& vl, StoreIndexedInstr* store);
+
+  // Class id of the SIMD values (and of the arrays of them) processed by the
+  // vector loop.
+  static intptr_t SimdClassId(const VectorLoop& vl);
+  static intptr_t SimdArrayClassId(const VectorLoop& vl);
+
+  // Helpers to build the control flow of the vector loop.
+  TargetEntryInstr* NewTarget(const VectorLoop& vl, Definition* index);
+  Definition* Emit(Definition* def);
+  void EmitEffect(Instruction* instr);
+  // Ends the current block with a branch on [comparison], continuing in a
+  // new block if it is true and running the remaining iterations in the
+  // scalar loop otherwise.
+  void EmitGuard(const VectorLoop& vl, ComparisonInstr* comparison);
+  Value* Constant(int64_t value);
+  void RenameEnvironment(Instruction* instr,
+                         Definition* from,
+                         Definition* to);
+
+  FlowGraph* const flow_graph_;
+  // Headers of loops which have already been vectorized.
+  GrowableArray<BlockEntryInstr*> vectorized_;
+
+  // State of the vector loop under construction.
+  BlockEntryInstr* block_ = nullptr;
+  Instruction* cursor_ = nullptr;
+  Definition* index_ = nullptr;
+  GotoInstr* guard_goto_ = nullptr;
+  JoinEntryInstr* scalar_entry_ = nullptr;
+  GrowableArray<TargetEntryInstr*> exits_;
+  GrowableArray<Definition*> exit_values_;
+  DefinitionMap* vector_values_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVectorizer);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZATION_H_
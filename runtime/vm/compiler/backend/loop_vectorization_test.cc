@@ -0,0 +1,227 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests specific to loop vectorization.
+
+#include "vm/compiler/backend/loop_vectorization.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_vectorization);
+
+struct VectorizeResult {
+  bool changed;
+  intptr_t loops;
+  // Number of indexed stores of vectors.
+  intptr_t vector_stores;
+  // Number of SIMD operations (including splats of loop invariants).
+  intptr_t simd_ops;
+};
+
+// Helper method to build CFG, run loop vectorization on function foo, and
+// report the number of loops and vector instructions after vectorization.
+static VectorizeResult ApplyVectorization(const char* script_chars) {
+  // Load the script and exercise the code once
+  // while exercising the given compiler passes.
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+  std::initializer_list<CompilerPass::Id> passes = {
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+  };
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses(passes);
+  EXPECT_EQ(1, flow_graph->GetLoopHierarchy().num_loops());
+
+  LoopVectorizer vectorizer(flow_graph);
+  VectorizeResult result;
+  result.changed = vectorizer.Optimize();
+  result.loops = flow_graph->GetLoopHierarchy().num_loops();
+  result.vector_stores = 0;
+  result.simd_ops = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      if (auto store = instr->AsStoreIndexed()) {
+        if (IsTypedDataClassId(store->class_id()) &&
+            TypedDataBase::ElementSizeFor(store->class_id()) ==
+                kSimd128Size) {
+          result.vector_stores++;
+        }
+      } else if (instr->IsSimdOp()) {
+        result.simd_ops++;
+      }
+    }
+  }
+  return result;
+}
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float64) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List x, Float64List y, double a) {
+        for (int i = 0; i < y.length; i++) {
+          y[i] = a * x[i] + y[i];
+        }
+      }
+      main() {
+        final x = Float64List(100);
+        final y = Float64List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(x, y, 2.0);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(result.changed);
+  // The vector loop is followed by the original loop.
+  EXPECT_EQ(2, result.loops);
+  EXPECT_EQ(1, result.vector_stores);
+  // Splat of a, multiplication and addition.
+  EXPECT_EQ(3, result.simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float32) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float32List x, Float32List y, int n) {
+        for (int i = 0; i < n; i++) {
+          y[i] = x[i] * 0.5;
+        }
+      }
+      main() {
+        final x = Float32List(100);
+        final y = Float32List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(x, y, i);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(result.changed);
+  EXPECT_EQ(2, result.loops);
+  EXPECT_EQ(1, result.vector_stores);
+  EXPECT_EQ(2, result.simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Uint8) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List a, Uint8List b) {
+        for (int i = 0; i < a.length; i++) {
+          a[i] = b[i] ^ 0x5A;
+        }
+      }
+      main() {
+        final a = Uint8List(100);
+        final b = Uint8List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a, b);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(result.changed);
+  EXPECT_EQ(2, result.loops);
+  EXPECT_EQ(1, result.vector_stores);
+  // Replicated constant and exclusive or.
+  EXPECT_EQ(2, result.simd_ops);
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Reduction) {
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List a) {
+        double sum = 0.0;
+        for (int i = 0; i < a.length; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+      main() {
+        final a = Float64List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(a);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(0, result.simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Float32Expression) {
+  // Rounding after every operation cannot be done with double operations.
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float32List x, Float32List y) {
+        for (int i = 0; i < y.length; i++) {
+          y[i] = x[i] * 0.5 + y[i];
+        }
+      }
+      main() {
+        final x = Float32List(100);
+        final y = Float32List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(x, y);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(0, result.vector_stores);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorization_Disabled) {
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, false);
+  const char* kScriptChars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List x, Float64List y) {
+        for (int i = 0; i < y.length; i++) {
+          y[i] = x[i] + y[i];
+        }
+      }
+      main() {
+        final x = Float64List(100);
+        final y = Float64List(100);
+        for (int i = 0; i < 100; i++) {
+          foo(x, y);
+        }
+      }
+    )";
+  VectorizeResult result = ApplyVectorization(kScriptChars);
+  EXPECT(!result.changed);
+  EXPECT_EQ(1, result.loops);
+  EXPECT_EQ(0, result.vector_stores);
+}
+
+}  // namespace dart
@@ -0,0 +1,691 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_versioning.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/branch_optimizer.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_versioning,
+            true,
+            "Hoist bounds checks out of loops by versioning them.");
+DEFINE_FLAG(int,
+            loop_versioning_size_threshold,
+            100,
+            "Maximum number of instructions in a loop which is versioned.");
+DEFINE_FLAG(bool, trace_loop_versioning, false, "Trace loop versioning.");
+
+DECLARE_FLAG(int, optimization_level);
+
+// Constant offsets of guards are limited, so computing the length minus an
+// offset cannot wrap around.
+static constexpr int64_t kMaxGuardOffset = kMaxInt32;
+
+static bool IsSmallOffset(int64_t offset) {
+  return -kMaxGuardOffset <= offset && offset <= kMaxGuardOffset;
+}
+
+LoopVersioner::LoopVersioner(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph), copier_(flow_graph) {}
+
+bool LoopVersioner::Optimize() {
+  // Versioning duplicates loops, which is not wanted when optimizing for
+  // size.
+  if (!FLAG_loop_versioning || (CompilerState::Current().is_aot() &&
+                                FLAG_optimization_level == 1)) {
+    return false;
+  }
+  bool changed = false;
+  // Versioning changes the flow graph, so the loop hierarchy is recomputed
+  // after every versioned loop.
+  while (VersionOneLoop()) {
+    changed = true;
+  }
+  return changed;
+}
+
+bool LoopVersioner::VersionOneLoop() {
+  const LoopHierarchy& loop_hierarchy = flow_graph_->GetLoopHierarchy();
+  loop_hierarchy.ComputeInduction();
+  for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+    LoopShape shape;
+    if (MatchLoop(header->loop_info(), &shape)) {
+      if (FLAG_trace_loop_versioning && flow_graph_->should_print()) {
+        THR_Print("Versioning loop B%" Pd " (%" Pd " bounds checks, %" Pd
+                  " guards)\n",
+                  header->block_id(), shape.checks.length(),
+                  shape.guards.length());
+      }
+      Version(&shape);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LoopVersioner::MatchLoop(LoopInfo* loop, LoopShape* shape) {
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if (header == nullptr || loop->inner() != nullptr ||
+      loop->control() == nullptr || header->env() == nullptr ||
+      versioned_.Contains(header)) {
+    return false;
+  }
+  BlockEntryInstr* pre_header = nullptr;
+  for (intptr_t i = 0; i < header->PredecessorCount(); ++i) {
+    BlockEntryInstr* pred = header->PredecessorAt(i);
+    if (!loop->IsBackEdge(pred)) {
+      if (pre_header != nullptr) {
+        return false;
+      }
+      pre_header = pred;
+    }
+  }
+  if (pre_header == nullptr || pre_header->try_index() != kInvalidTryIndex ||
+      !pre_header->last_instruction()->IsGoto() ||
+      pre_header->last_instruction()->env() == nullptr) {
+    return false;
+  }
+  shape->loop = loop;
+  shape->header = header;
+  shape->pre_header = pre_header;
+
+  intptr_t size = 0;
+  for (BlockEntryInstr* block : flow_graph_->reverse_postorder()) {
+    if (!loop->Contains(block)) {
+      continue;
+    }
+    if (block->try_index() != kInvalidTryIndex || block->env() == nullptr ||
+        !(block->IsJoinEntry() || block->IsTargetEntry())) {
+      return false;
+    }
+    shape->blocks.Add(block);
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* instr = it.Current();
+      if (auto branch = instr->AsBranch()) {
+        // Targets of branches leaving the loop become the exits which are
+        // shared by both versions of the loop.
+        for (TargetEntryInstr* target :
+             {branch->true_successor(), branch->false_successor()}) {
+          if (!loop->Contains(target)) {
+            if (target->env() == nullptr) {
+              return false;
+            }
+            shape->exits.Add(target);
+          }
+        }
+        continue;
+      }
+      if (auto goto_instr = instr->AsGoto()) {
+        if (!loop->Contains(goto_instr->successor()) ||
+            goto_instr->env() == nullptr) {
+          return false;
+        }
+        continue;
+      }
+      if (!InstructionCopier::IsCopyable(instr)) {
+        return false;
+      }
+      if (auto check = instr->AsCheckBoundBase()) {
+        AnalyzeCheck(shape, check);
+      }
+      size++;
+    }
+  }
+  if (shape->checks.is_empty() ||
+      size > FLAG_loop_versioning_size_threshold) {
+    return false;
+  }
+  return CollectLiveOut(shape);
+}
+
+bool LoopVersioner::AnalyzeCheck(LoopShape* shape,
+                                 CheckBoundBaseInstr* check) {
+  LoopInfo* loop = shape->loop;
+  // Checks which are redundant in all iterations are left to range
+  // analysis.
+  if (loop->IsInRange(check, check->index(), check->length())) {
+    return false;
+  }
+  Definition* length = check->length()->definition();
+  if (loop->Contains(length->GetBlock()) || !IsInt64(length)) {
+    return false;
+  }
+
+  // Find the bound of the control induction i which holds at the check:
+  //   i < U (i++), so i is in [initial, U - 1], or
+  //   i > L (i--), so i is in [L + 1, initial].
+  InductionVar* control = loop->control();
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(control, &stride)) {
+    return false;
+  }
+  InductionVar* limit = nullptr;
+  for (auto bound : control->bounds()) {
+    if (check->IsDominatedBy(bound.branch_)) {
+      limit = bound.limit_;
+      break;
+    }
+  }
+  if (limit == nullptr) {
+    return false;
+  }
+  // The index is i + diff.
+  Definition* index = check->index()->definition();
+  InductionVar* induc = loop->LookupInduction(
+      index->OriginalDefinitionIgnoreBoxingAndConstraints());
+  int64_t diff = 0;
+  if (induc == nullptr || !control->CanComputeDifferenceWith(induc, &diff) ||
+      !IsSmallOffset(diff)) {
+    return false;
+  }
+
+  const intptr_t num_guards = shape->guards.length();
+  bool success = false;
+  if (stride == 1) {
+    success = AddGuard(shape, control->initial(), diff, length,
+                       /*is_lower=*/true) &&
+              AddGuard(shape, limit, diff - 1, length, /*is_lower=*/false);
+  } else {
+    ASSERT(stride == -1);
+    success = AddGuard(shape, limit, diff + 1, length, /*is_lower=*/true) &&
+              AddGuard(shape, control->initial(), diff, length,
+                       /*is_lower=*/false);
+  }
+  if (!success) {
+    shape->guards.TruncateTo(num_guards);
+    return false;
+  }
+  shape->checks.Add(check);
+  return true;
+}
+
+bool LoopVersioner::AddGuard(LoopShape* shape,
+                             InductionVar* bound,
+                             int64_t adjust,
+                             Definition* length,
+                             bool is_lower) {
+  if (!InductionVar::IsInvariant(bound) || !IsSmallOffset(bound->offset())) {
+    return false;
+  }
+  // The bound of the index is value + c.
+  const int64_t c = bound->offset() + adjust;
+  Definition* value = nullptr;
+  if (bound->mult() == 1) {
+    value = bound->def();
+    if (shape->loop->Contains(value->GetBlock()) || !IsInt64(value)) {
+      return false;
+    }
+  } else if (bound->mult() != 0) {
+    return false;
+  }
+
+  Guard guard;
+  if (is_lower) {
+    // value + c >= 0.
+    if (value == nullptr) {
+      return c >= 0;
+    }
+    guard = {value, nullptr, -c};
+  } else if (value == nullptr) {
+    // c < length always holds for negative c.
+    if (c < 0) {
+      return true;
+    }
+    guard = {nullptr, length, c};
+  } else {
+    // value + c < length.
+    guard = {value, length, c};
+  }
+  for (const Guard& other : shape->guards) {
+    if (other.Equals(guard)) {
+      return true;
+    }
+  }
+  shape->guards.Add(guard);
+  return true;
+}
+
+// Returns the block in which [use] takes place. Inputs of phis are used at
+// the end of the corresponding predecessor.
+static BlockEntryInstr* UseBlock(Value* use) {
+  Instruction* instr = use->instruction();
+  if (auto phi = instr->AsPhi()) {
+    return phi->block()->PredecessorAt(use->use_index());
+  }
+  return instr->GetBlock();
+}
+
+bool LoopVersioner::CollectLiveOut(LoopShape* shape) {
+  LoopInfo* loop = shape->loop;
+  for (intptr_t i = 0; i <= flow_graph_->max_block_id(); ++i) {
+    shape->exit_index.Add(-1);
+  }
+  for (BlockEntryInstr* block : flow_graph_->postorder()) {
+    if (loop->Contains(block)) {
+      continue;
+    }
+    for (intptr_t k = 0; k < shape->exits.length(); ++k) {
+      if (shape->exits[k]->Dominates(block)) {
+        shape->exit_index[block->block_id()] = k;
+        break;
+      }
+    }
+  }
+
+  // Uses after the loop must be dominated by one of the exits, where the
+  // values of both versions of the loop are merged.
+  auto collect = [&](Definition* def) {
+    bool is_used_outside = false;
+    for (Value* uses : {def->input_use_list(), def->env_use_list()}) {
+      for (Value::Iterator it(uses); !it.Done(); it.Advance()) {
+        BlockEntryInstr* block = UseBlock(it.Current());
+        if (loop->Contains(block)) continue;
+        if (shape->exit_index[block->block_id()] < 0) return false;
+        is_used_outside = true;
+      }
+    }
+    if (is_used_outside) {
+      // Untagged values cannot flow into phis.
+      if (def->representation() == kUntagged) return false;
+      shape->live_out.Add(def);
+    }
+    return true;
+  };
+
+  for (BlockEntryInstr* block : shape->blocks) {
+    if (auto join = block->AsJoinEntry()) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        if (!collect(it.Current())) return false;
+      }
+    }
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Definition* def = it.Current()->AsDefinition();
+      if (def != nullptr && !collect(def)) return false;
+    }
+  }
+  return true;
+}
+
+// Turns the loop into a fast and a slow version:
+//
+//   pre_header: ..., guards       (failing guards go to slow_entry)
+//   fast_entry: goto header       (loop without the bounds checks)
+//   slow_entry: goto header'      (copy of the loop)
+//   exit_k:     values = phi(values of loop, values of copy), ...
+//
+// Each exit is reached from the original branch through fast_exit_k and
+// from its copy through slow_exit_k.
+void LoopVersioner::Version(LoopShape* shape) {
+  JoinEntryInstr* header = shape->header;
+  BlockEntryInstr* pre_header = shape->pre_header;
+  GotoInstr* goto_header = pre_header->last_instruction()->AsGoto();
+  ASSERT(goto_header != nullptr);
+  // Predecessors of the header change, so remember the order of the inputs
+  // of its phis.
+  GrowableArray<BlockEntryInstr*> header_preds;
+  for (intptr_t i = 0; i < header->PredecessorCount(); ++i) {
+    header_preds.Add(header->PredecessorAt(i));
+  }
+
+  // Copy the loop. All phis are created first, as they can be used by
+  // instructions of blocks which precede them in reverse postorder.
+  BlockMap copies;
+  BlockMap originals;
+  DefinitionMap* map = new (zone()) DefinitionMap();
+  for (BlockEntryInstr* block : shape->blocks) {
+    BlockEntryInstr* copy = nullptr;
+    if (block->IsJoinEntry()) {
+      copy = new (zone()) JoinEntryInstr(flow_graph_->allocate_block_id(),
+                                         block->try_index(), DeoptId::kNone);
+    } else {
+      copy = new (zone()) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                           block->try_index(), DeoptId::kNone);
+    }
+    copies.Insert({block, copy});
+    originals.Insert({copy, block});
+    if (auto join = block->AsJoinEntry()) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        PhiInstr* phi = it.Current();
+        PhiInstr* phi_copy =
+            new (zone()) PhiInstr(copy->AsJoinEntry(), phi->InputCount());
+        phi_copy->set_representation(phi->representation());
+        flow_graph_->AllocateSSAIndex(phi_copy);
+        phi_copy->mark_alive();
+        if (phi->HasType()) {
+          phi_copy->UpdateType(*phi->Type());
+        }
+        copy->AsJoinEntry()->InsertPhi(phi_copy);
+        map->Insert({phi, phi_copy});
+      }
+    }
+  }
+  for (BlockEntryInstr* block : shape->blocks) {
+    CopyBlock(block, copies.LookupValue(block), copies, map);
+  }
+  JoinEntryInstr* header_copy = copies.LookupValue(header)->AsJoinEntry();
+
+  // Test the guards at the end of the pre-header.
+  JoinEntryInstr* slow_entry = new (zone()) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), pre_header->try_index(),
+      DeoptId::kNone);
+  slow_entry->InheritDeoptTarget(zone(), goto_header);
+  LinkTo(slow_entry, header_copy, goto_header);
+  block_ = pre_header;
+  cursor_ = goto_header->previous();
+  for (const Guard& guard : shape->guards) {
+    EmitGuard(guard, goto_header, slow_entry);
+  }
+  BlockEntryInstr* fast_entry = block_;
+  GotoInstr* goto_fast = new (zone()) GotoInstr(header, DeoptId::kNone);
+  goto_fast->InheritDeoptTarget(zone(), goto_header);
+  cursor_->AppendInstruction(goto_fast);
+  fast_entry->set_last_instruction(goto_fast);
+  goto_header->UnuseAllInputs();
+
+  // Route the exits of both versions through new blocks into the old exit
+  // blocks, which become joins.
+  GrowableArray<JoinEntryInstr*> joins;
+  GrowableArray<TargetEntryInstr*> fast_exits;
+  for (TargetEntryInstr* exit : shape->exits) {
+    BlockEntryInstr* from = exit->PredecessorAt(0);
+    BranchInstr* branch = from->last_instruction()->AsBranch();
+    BranchInstr* branch_copy =
+        copies.LookupValue(from)->last_instruction()->AsBranch();
+    JoinEntryInstr* join = BranchSimplifier::ToJoinEntry(zone(), exit);
+    TargetEntryInstr* fast_exit = NewTarget(join, join);
+    LinkTo(fast_exit, join, join);
+    TargetEntryInstr* slow_exit = NewTarget(join, join);
+    copier_.RenameEnvironment(slow_exit, *map);
+    GotoInstr* goto_join = LinkTo(slow_exit, join, join);
+    copier_.RenameEnvironment(goto_join, *map);
+    for (BranchInstr* b : {branch, branch_copy}) {
+      TargetEntryInstr* target = (b == branch) ? fast_exit : slow_exit;
+      if (b->true_successor() == exit) {
+        *b->true_successor_address() = target;
+      } else {
+        ASSERT(b->false_successor() == exit);
+        *b->false_successor_address() = target;
+      }
+    }
+    joins.Add(join);
+    fast_exits.Add(fast_exit);
+  }
+
+  // Merge values of the loop used after it. The exit blocks keep their ids
+  // as joins, so the exit dominating a use can still be found by block id.
+  GrowableArray<PhiInstr*> exit_phis;
+  GrowableArray<Definition*> exit_defs;
+  GrowableArray<intptr_t> exit_phi_index;
+  for (Definition* def : shape->live_out) {
+    GrowableArray<PhiInstr*> phis;
+    for (intptr_t k = 0; k < joins.length(); ++k) {
+      phis.Add(nullptr);
+    }
+    auto phi_for = [&](Value* use) -> PhiInstr* {
+      const intptr_t block_id = UseBlock(use)->block_id();
+      if (block_id >= shape->exit_index.length()) {
+        // New blocks are either copies of the loop or exits of the fast
+        // loop, which keep using the original values.
+        return nullptr;
+      }
+      const intptr_t k = shape->exit_index[block_id];
+      if (k < 0) {
+        return nullptr;
+      }
+      if (phis[k] == nullptr) {
+        PhiInstr* phi = new (zone()) PhiInstr(joins[k], 2);
+        phi->set_representation(def->representation());
+        flow_graph_->AllocateSSAIndex(phi);
+        phi->mark_alive();
+        joins[k]->InsertPhi(phi);
+        phis[k] = phi;
+        exit_phis.Add(phi);
+        exit_defs.Add(def);
+        exit_phi_index.Add(k);
+      }
+      return phis[k];
+    };
+    for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+      if (PhiInstr* phi = phi_for(it.Current())) {
+        it.Current()->BindTo(phi);
+      }
+    }
+    for (Value::Iterator it(def->env_use_list()); !it.Done(); it.Advance()) {
+      if (PhiInstr* phi = phi_for(it.Current())) {
+        it.Current()->BindToEnvironment(phi);
+      }
+    }
+  }
+
+  flow_graph_->DiscoverBlocks();
+
+  // Set phi inputs in the order of predecessors found by DiscoverBlocks.
+  auto set_input = [&](PhiInstr* phi, intptr_t i, Definition* def) {
+    Value* input = new (zone()) Value(def);
+    phi->SetInputAt(i, input);
+    def->AddInputUse(input);
+  };
+  // Returns the index of the input of a phi in the original [block] which
+  // came from [pred] before versioning.
+  auto old_index = [&](JoinEntryInstr* block, BlockEntryInstr* pred) {
+    if (block != header) {
+      return block->IndexOfPredecessor(pred);
+    }
+    for (intptr_t i = 0; i < header_preds.length(); ++i) {
+      if (header_preds[i] == pred) {
+        return i;
+      }
+    }
+    UNREACHABLE();
+    return intptr_t{-1};
+  };
+  for (BlockEntryInstr* block : shape->blocks) {
+    JoinEntryInstr* join = block->AsJoinEntry();
+    if (join == nullptr) {
+      continue;
+    }
+    JoinEntryInstr* copy = copies.LookupValue(block)->AsJoinEntry();
+    PhiIterator copy_it(copy);
+    for (PhiIterator it(join); !it.Done(); it.Advance(), copy_it.Advance()) {
+      PhiInstr* phi = it.Current();
+      for (intptr_t i = 0; i < copy->PredecessorCount(); ++i) {
+        BlockEntryInstr* pred = copy->PredecessorAt(i);
+        BlockEntryInstr* original =
+            (pred == slow_entry) ? pre_header : originals.LookupValue(pred);
+        Definition* input =
+            phi->InputAt(old_index(join, original))->definition();
+        set_input(copy_it.Current(), i, InstructionCopier::Lookup(*map, input));
+      }
+    }
+  }
+  // The fast loop is now entered from fast_entry instead of the pre-header.
+  for (PhiIterator it(header); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    GrowableArray<Value*> inputs;
+    for (intptr_t i = 0; i < phi->InputCount(); ++i) {
+      inputs.Add(phi->InputAt(i));
+    }
+    for (intptr_t i = 0; i < header->PredecessorCount(); ++i) {
+      BlockEntryInstr* pred = header->PredecessorAt(i);
+      phi->SetInputAt(
+          i, inputs[old_index(header, pred == fast_entry ? pre_header : pred)]);
+    }
+  }
+  for (intptr_t i = 0; i < exit_phis.length(); ++i) {
+    PhiInstr* phi = exit_phis[i];
+    JoinEntryInstr* join = joins[exit_phi_index[i]];
+    for (intptr_t j = 0; j < join->PredecessorCount(); ++j) {
+      Definition* def = exit_defs[i];
+      if (join->PredecessorAt(j) != fast_exits[exit_phi_index[i]]) {
+        def = InstructionCopier::Lookup(*map, def);
+      }
+      set_input(phi, j, def);
+    }
+  }
+
+  // The guards make the checks of the fast loop redundant.
+  for (CheckBoundBaseInstr* check : shape->checks) {
+    check->ReplaceUsesWith(check->index()->definition());
+    check->RemoveFromGraph();
+  }
+
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph_->ComputeDominators(&dominance_frontier);
+
+  versioned_.Add(header);
+  versioned_.Add(header_copy);
+}
+
+void LoopVersioner::CopyBlock(BlockEntryInstr* block,
+                              BlockEntryInstr* copy,
+                              const BlockMap& copies,
+                              DefinitionMap* map) {
+  copy->InheritDeoptTarget(zone(), block);
+  copier_.RenameEnvironment(copy, *map);
+  Instruction* last = copy;
+  for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    Instruction* instr_copy = nullptr;
+    if (auto branch = instr->AsBranch()) {
+      // Exits are redirected once the whole loop has been copied.
+      BranchInstr* branch_copy = copier_.CopyBranch(branch, *map);
+      BlockEntryInstr* true_copy =
+          copies.LookupValue(branch->true_successor());
+      BlockEntryInstr* false_copy =
+          copies.LookupValue(branch->false_successor());
+      *branch_copy->true_successor_address() =
+          (true_copy != nullptr) ? true_copy->AsTargetEntry()
+                                 : branch->true_successor();
+      *branch_copy->false_successor_address() =
+          (false_copy != nullptr) ? false_copy->AsTargetEntry()
+                                  : branch->false_successor();
+      instr_copy = branch_copy;
+    } else if (auto goto_instr = instr->AsGoto()) {
+      GotoInstr* goto_copy = new (zone()) GotoInstr(
+          copies.LookupValue(goto_instr->successor())->AsJoinEntry(),
+          DeoptId::kNone);
+      goto_copy->InheritDeoptTarget(zone(), goto_instr);
+      copier_.RenameEnvironment(goto_copy, *map);
+      instr_copy = goto_copy;
+    } else {
+      instr_copy = copier_.CopyInstruction(instr, map);
+    }
+    last = last->AppendInstruction(instr_copy);
+  }
+  copy->set_last_instruction(last);
+}
+
+void LoopVersioner::EmitGuard(const Guard& guard,
+                              GotoInstr* goto_header,
+                              JoinEntryInstr* slow_entry) {
+  ComparisonInstr* comparison = nullptr;
+  if (guard.length == nullptr) {
+    comparison = new (zone()) RelationalOpInstr(
+        InstructionSource(), Token::kGTE,
+        new (zone()) Value(EmitInt64(guard.value)),
+        new (zone()) Value(Constant(guard.offset)), kMintCid, DeoptId::kNone,
+        Instruction::kNotSpeculative);
+  } else if (guard.value == nullptr) {
+    comparison = new (zone()) RelationalOpInstr(
+        InstructionSource(), Token::kGT,
+        new (zone()) Value(EmitInt64(guard.length)),
+        new (zone()) Value(Constant(guard.offset)), kMintCid, DeoptId::kNone,
+        Instruction::kNotSpeculative);
+  } else {
+    Definition* limit = EmitInt64(guard.length);
+    if (guard.offset != 0) {
+      limit = Emit(new (zone()) BinaryInt64OpInstr(
+          Token::kSUB, new (zone()) Value(limit),
+          new (zone()) Value(Constant(guard.offset)), DeoptId::kNone,
+          Instruction::kNotSpeculative));
+    }
+    comparison = new (zone()) RelationalOpInstr(
+        InstructionSource(), Token::kLT,
+        new (zone()) Value(EmitInt64(guard.value)), new (zone()) Value(limit),
+        kMintCid, DeoptId::kNone, Instruction::kNotSpeculative);
+  }
+  BranchInstr* branch = new (zone()) BranchInstr(comparison, DeoptId::kNone);
+  cursor_->AppendInstruction(branch);
+  block_->set_last_instruction(branch);
+
+  TargetEntryInstr* fail = NewTarget(block_, goto_header);
+  LinkTo(fail, slow_entry, goto_header);
+  TargetEntryInstr* next = NewTarget(block_, goto_header);
+  *branch->true_successor_address() = next;
+  *branch->false_successor_address() = fail;
+  block_ = next;
+  cursor_ = next;
+}
+
+Definition* LoopVersioner::Emit(Definition* def) {
+  cursor_ = flow_graph_->AppendTo(cursor_, def, nullptr, FlowGraph::kValue);
+  return def;
+}
+
+bool LoopVersioner::IsInt64(Definition* def) {
+  if (auto constant = def->AsConstant()) {
+    return constant->value().IsInteger();
+  }
+  switch (def->representation()) {
+    case kUnboxedInt64:
+    case kUnboxedInt32:
+    case kUnboxedUint32:
+      return true;
+    case kTagged:
+      return def->Type()->IsInt();
+    default:
+      return false;
+  }
+}
+
+Definition* LoopVersioner::EmitInt64(Definition* def) {
+  ASSERT(IsInt64(def));
+  if (auto constant = def->AsConstant()) {
+    return Constant(Integer::Cast(constant->value()).Value());
+  }
+  switch (def->representation()) {
+    case kUnboxedInt64:
+      return def;
+    case kUnboxedInt32:
+    case kUnboxedUint32:
+      return Emit(new (zone()) IntConverterInstr(
+          def->representation(), kUnboxedInt64, new (zone()) Value(def),
+          DeoptId::kNone));
+    default:
+      return Emit(UnboxInstr::Create(kUnboxedInt64, new (zone()) Value(def),
+                                     DeoptId::kNone,
+                                     Instruction::kNotSpeculative));
+  }
+}
+
+Definition* LoopVersioner::Constant(int64_t value) {
+  return flow_graph_->GetConstant(
+      Integer::ZoneHandle(zone(), Integer::NewCanonical(value)),
+      kUnboxedInt64);
+}
+
+TargetEntryInstr* LoopVersioner::NewTarget(BlockEntryInstr* block,
+                                           Instruction* from) {
+  TargetEntryInstr* target = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), block->try_index(), DeoptId::kNone);
+  target->InheritDeoptTarget(zone(), from);
+  return target;
+}
+
+GotoInstr* LoopVersioner::LinkTo(BlockEntryInstr* block,
+                                 JoinEntryInstr* successor,
+                                 Instruction* from) {
+  GotoInstr* goto_successor = new (zone()) GotoInstr(successor, DeoptId::kNone);
+  goto_successor->InheritDeoptTarget(zone(), from);
+  block->LinkTo(goto_successor);
+  block->set_last_instruction(goto_successor);
+  return goto_successor;
+}
+
+}  // namespace dart
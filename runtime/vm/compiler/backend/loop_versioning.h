@@ -0,0 +1,148 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VERSIONING_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VERSIONING_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/instruction_copier.h"
+#include "vm/compiler/backend/loops.h"
+
+namespace dart {
+
+// Hoists bounds checks out of innermost counted loops by versioning them.
+//
+// Range analysis removes bounds checks which are redundant for all values
+// the loop may see, e.g. a[i] in "for (i = 0; i < a.length; i++)". When the
+// bounds of the induction variable are unrelated to the length of the
+// array, e.g. in "for (i = start; i < end; i++) a[i]", the check can only be
+// removed if the range of the index is tested before entering the loop:
+//
+//   pre_header: ..., branch (start >= 0) G / S
+//   G:          branch (end < a.length + 1) F / S    (for each guard)
+//   F:          goto header                          (loop without checks)
+//   S:          goto header'                         (original loop)
+//
+// The fast loop is the original one with the bounds checks which are
+// implied by the guards removed. The slow loop is a copy which keeps all of
+// its checks, so exceptions and deoptimization happen exactly as before
+// whenever a guard fails.
+//
+// Guards only compare loop invariant values against the lengths in a way
+// which cannot wrap around: lengths are non-negative Smis and the constant
+// offsets involved are small.
+//
+// Each exit of the loop is reached from both versions, so values defined in
+// the loop and used after it are merged by phis in the exit blocks.
+class LoopVersioner : public ValueObject {
+ public:
+  explicit LoopVersioner(FlowGraph* flow_graph);
+
+  // Versions all suitable loops. Returns true if the flow graph has changed.
+  bool Optimize();
+
+ private:
+  typedef InstructionCopier::DefinitionMap DefinitionMap;
+  typedef RawPointerKeyValueTrait<BlockEntryInstr, BlockEntryInstr*> BlockKV;
+  typedef ZoneDirectChainedHashMap<BlockKV> BlockMap;
+
+  // A condition checked before entering the fast loop, one of
+  //
+  //   value >= offset               (length == nullptr)
+  //   length > offset               (value == nullptr)
+  //   value < length - offset
+  struct Guard {
+    Definition* value;
+    Definition* length;
+    int64_t offset;
+
+    bool Equals(const Guard& other) const {
+      return value == other.value && length == other.length &&
+             offset == other.offset;
+    }
+  };
+
+  struct LoopShape {
+    LoopInfo* loop = nullptr;
+    JoinEntryInstr* header = nullptr;
+    BlockEntryInstr* pre_header = nullptr;
+    // Blocks of the loop in reverse postorder.
+    GrowableArray<BlockEntryInstr*> blocks;
+    // Targets of branches leaving the loop.
+    GrowableArray<TargetEntryInstr*> exits;
+    // Bounds checks removed from the fast loop and the guards implying them.
+    GrowableArray<CheckBoundBaseInstr*> checks;
+    GrowableArray<Guard> guards;
+    // Definitions of the loop which are used after it.
+    GrowableArray<Definition*> live_out;
+    // Index of the exit dominating a block after the loop (by block id).
+    GrowableArray<intptr_t> exit_index;
+  };
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  bool VersionOneLoop();
+  bool MatchLoop(LoopInfo* loop, LoopShape* shape);
+
+  // Records the guards which make [check] redundant in the fast loop.
+  // Returns false if the check cannot be removed this way.
+  bool AnalyzeCheck(LoopShape* shape, CheckBoundBaseInstr* check);
+  bool AddGuard(LoopShape* shape,
+                InductionVar* bound,
+                int64_t adjust,
+                Definition* length,
+                bool is_lower);
+
+  // Collects definitions of the loop which are used after it. Returns false
+  // if one of the uses is not dominated by an exit of the loop or the value
+  // cannot be merged by a phi.
+  bool CollectLiveOut(LoopShape* shape);
+
+  void Version(LoopShape* shape);
+
+  // Copies the instructions of [block] into [copy], renaming inputs and
+  // environments by [map] and successors by [copies].
+  void CopyBlock(BlockEntryInstr* block,
+                 BlockEntryInstr* copy,
+                 const BlockMap& copies,
+                 DefinitionMap* map);
+
+  // Helpers to build the guards in front of the loop.
+  void EmitGuard(const Guard& guard,
+                 GotoInstr* goto_header,
+                 JoinEntryInstr* slow_entry);
+  Definition* Emit(Definition* def);
+  // Returns true if [def] is an integer which can be converted to an
+  // unboxed int64 without checks.
+  static bool IsInt64(Definition* def);
+  Definition* EmitInt64(Definition* def);
+  Definition* Constant(int64_t value);
+  TargetEntryInstr* NewTarget(BlockEntryInstr* block, Instruction* from);
+  // Ends [block] with a goto to [successor], inheriting the deoptimization
+  // target of [from].
+  GotoInstr* LinkTo(BlockEntryInstr* block,
+                    JoinEntryInstr* successor,
+                    Instruction* from);
+
+  FlowGraph* const flow_graph_;
+  InstructionCopier copier_;
+  // Headers of loops which have already been versioned.
+  GrowableArray<BlockEntryInstr*> versioned_;
+
+  // State of the guards under construction.
+  BlockEntryInstr* block_ = nullptr;
+  Instruction* cursor_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopVersioner);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VERSIONING_H_
@@ -1019,28 +1019,44 @@ bool LoopInfo::IsAlwaysTaken(BlockEntryInstr* block) const {
   }
   // If the loop has a control induction, make sure the condition is such
   // that the loop body is entered at least once from the header.
-  if (control_ != nullptr) {
-    InductionVar* limit = nullptr;
-    for (auto bound : control_->bounds()) {
-      if (bound.branch_ == header_->last_instruction()) {
-        limit = bound.limit_;
-        break;
-      }
-    }
-    // Control iterates at least once?
-    if (limit != nullptr) {
-      int64_t stride = 0;
-      int64_t begin = 0;
-      int64_t end = 0;
-      if (InductionVar::IsLinear(control_, &stride) &&
-          InductionVar::IsConstant(control_->initial(), &begin) &&
-          InductionVar::IsConstant(limit, &end) &&
-          ((stride == 1 && begin < end) || (stride == -1 && begin > end))) {
-        return true;
-      }
+  int64_t trip_count = 0;
+  return HasConstantTripCount(&trip_count) && trip_count > 0;
+}
+
+bool LoopInfo::HasConstantTripCount(int64_t* trip_count) const {
+  if (control_ == nullptr) {
+    return false;
+  }
+  InductionVar* limit = nullptr;
+  for (auto bound : control_->bounds()) {
+    if (bound.branch_ == header_->last_instruction()) {
+      limit = bound.limit_;
+      break;
     }
   }
-  return false;
+  int64_t stride = 0;
+  int64_t begin = 0;
+  int64_t end = 0;
+  if (limit == nullptr || !InductionVar::IsLinear(control_, &stride) ||
+      !InductionVar::IsConstant(control_->initial(), &begin) ||
+      !InductionVar::IsConstant(limit, &end) ||
+      (stride != 1 && stride != -1)) {
+    return false;
+  }
+  // The bound is strict and the stride is unit, so the header test
+  // succeeds exactly once for every value in [begin,end) or (end,begin].
+  // The unsigned difference is exact, but may not fit a trip count.
+  uint64_t count = 0;
+  if (stride == 1 && begin < end) {
+    count = static_cast<uint64_t>(end) - static_cast<uint64_t>(begin);
+  } else if (stride == -1 && begin > end) {
+    count = static_cast<uint64_t>(begin) - static_cast<uint64_t>(end);
+  }
+  if (count > static_cast<uint64_t>(kMaxInt64)) {
+    return false;
+  }
+  *trip_count = static_cast<int64_t>(count);
+  return true;
 }
 
 bool LoopInfo::IsHeaderPhi(Definition* def) const {
@@ -223,6 +223,10 @@ class LoopInfo : public ZoneAllocated {
   // Returns true if given block is alway taken in this loop.
   bool IsAlwaysTaken(BlockEntryInstr* block) const;
 
+  // Returns true if the control induction of this loop has constant bounds.
+  // Sets the number of times the loop body is entered from the header.
+  bool HasConstantTripCount(int64_t* trip_count) const;
+
   // Returns true if given definition is a header phi for this loop.
   bool IsHeaderPhi(Definition* def) const;
 
@@ -84,6 +84,14 @@ static uword RegMaskBit(Register reg) {
 ParallelMoveResolver::ParallelMoveResolver() : moves_(32) {}
 
 void ParallelMoveResolver::Resolve(ParallelMoveInstr* parallel_move) {
+  ScheduleMoves(parallel_move);
+
+  // Schedule is ready. Update parallel move itself.
+  parallel_move->set_move_schedule(MoveSchedule::From(scheduled_ops_));
+  scheduled_ops_.Clear();
+}
+
+void ParallelMoveResolver::ScheduleMoves(ParallelMoveInstr* parallel_move) {
   ASSERT(moves_.is_empty());
 
   // Build up a worklist of moves.
@@ -110,9 +118,39 @@ void ParallelMoveResolver::Resolve(ParallelMoveInstr* parallel_move) {
   }
   moves_.Clear();
 
-  // Schedule is ready. Update parallel move itself.
-  parallel_move->set_move_schedule(MoveSchedule::From(scheduled_ops_));
-  scheduled_ops_.Clear();
+  CoalesceMoves();
+}
+
+void ParallelMoveResolver::CoalesceMoves() {
+  // Returns true if performing [op] overwrites [loc].
+  auto overwrites = [](const Op& op, Location loc) {
+    return op.operands.dest().Equals(loc) ||
+           ((op.kind == OpKind::kSwap) && op.operands.src().Equals(loc));
+  };
+
+  for (intptr_t i = 0; i < scheduled_ops_.length(); i++) {
+    const auto& op = scheduled_ops_[i];
+    if (op.kind != OpKind::kMove) continue;
+    const Location src = op.operands.src();
+    const Location reg = op.operands.dest();
+    if (!(src.HasStackIndex() || src.IsConstant()) ||
+        !reg.IsMachineRegister()) {
+      continue;
+    }
+    for (intptr_t j = i + 1; j < scheduled_ops_.length(); j++) {
+      auto& other = scheduled_ops_[j];
+      if ((other.kind == OpKind::kMove) && other.operands.src().Equals(src)) {
+        // Only copy the register into a location of the same kind, or
+        // into the kind of stack slot the value was loaded from.
+        const Location dest = other.operands.dest();
+        if ((dest.kind() == reg.kind()) ||
+            (src.HasStackIndex() && (dest.kind() == src.kind()))) {
+          other.operands.set_src(reg);
+        }
+      }
+      if (overwrites(other, src) || overwrites(other, reg)) break;
+    }
+  }
 }
 
 void ParallelMoveResolver::BuildInitialMoveList(
@@ -248,6 +286,7 @@ void ParallelMoveEmitter::EmitMove(const MoveOperands& move) {
   src = compiler_->RebaseIfImprovesAddressing(src);
 #endif
   ParallelMoveEmitter::TemporaryAllocator temp(this, /*blocked=*/kNoRegister);
+  compiler_->StatsRecordMove(move);
   compiler_->EmitMove(dst, src, &temp);
 #if defined(DEBUG)
   // Allocating a scratch register here may cause stack spilling. Neither the
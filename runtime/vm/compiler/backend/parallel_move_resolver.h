@@ -27,6 +27,10 @@ class ParallelMoveResolver : public ValueObject {
   void Resolve(ParallelMoveInstr* parallel_move);
 
  private:
+  // Schedule moves specified by the given parallel move into
+  // [scheduled_ops_].
+  void ScheduleMoves(ParallelMoveInstr* parallel_move);
+
   // Build the initial list of moves.
   void BuildInitialMoveList(ParallelMoveInstr* parallel_move);
 
@@ -41,6 +45,15 @@ class ParallelMoveResolver : public ValueObject {
   // source to destination is removed from the move graph.
   void AddSwapToSchedule(int index);
 
+  // Replaces loads of a value which an earlier scheduled move has already
+  // placed into a register with copies of that register, e.g.
+  //
+  //   r1 <- S; r2 <- S   becomes   r1 <- S; r2 <- r1
+  //
+  // as register to register moves are cheaper than reloading a stack slot
+  // or materializing a constant again.
+  void CoalesceMoves();
+
   FlowGraphCompiler* compiler_;
 
   // List of moves not yet resolved.
@@ -62,6 +75,7 @@ class ParallelMoveResolver : public ValueObject {
   friend class MoveSchedule;
   friend class ParallelMoveEmitter;
   friend class FlowGraphDeserializer;
+  friend class ParallelMoveResolverTestHelper;
 };
 
 class ParallelMoveEmitter : public ValueObject {
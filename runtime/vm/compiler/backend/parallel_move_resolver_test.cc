@@ -0,0 +1,99 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/parallel_move_resolver.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+class ParallelMoveResolverTestHelper : public AllStatic {
+ public:
+  // Returns the moves scheduled for [parallel_move], expecting no swaps.
+  static GrowableArray<MoveOperands> Schedule(
+      ParallelMoveInstr* parallel_move) {
+    ParallelMoveResolver resolver;
+    resolver.ScheduleMoves(parallel_move);
+    GrowableArray<MoveOperands> moves;
+    for (const auto& op : resolver.scheduled_ops_) {
+      if (op.kind == ParallelMoveResolver::OpKind::kNop) continue;
+      EXPECT(op.kind == ParallelMoveResolver::OpKind::kMove);
+      moves.Add(op.operands);
+    }
+    return moves;
+  }
+};
+
+static Location Reg(intptr_t i) {
+  return Location::RegisterLocation(static_cast<Register>(i));
+}
+
+static Location Slot(intptr_t i) {
+  return Location::StackSlot(i, FPREG);
+}
+
+// Returns the index of the scheduled move into [dest].
+static intptr_t IndexOf(const GrowableArray<MoveOperands>& moves,
+                        Location dest) {
+  for (intptr_t i = 0; i < moves.length(); i++) {
+    if (moves[i].dest().Equals(dest)) return i;
+  }
+  return -1;
+}
+
+ISOLATE_UNIT_TEST_CASE(ParallelMoveResolver_CoalesceStackSlotLoads) {
+  auto parallel_move = new ParallelMoveInstr();
+  parallel_move->AddMove(Reg(0), Slot(1));
+  parallel_move->AddMove(Reg(1), Slot(1));
+  parallel_move->AddMove(Slot(2), Slot(1));
+  parallel_move->AddMove(Reg(2), Slot(3));
+
+  const auto moves = ParallelMoveResolverTestHelper::Schedule(parallel_move);
+  EXPECT_EQ(4, moves.length());
+  // The first load of the stack slot is kept, the others copy its register.
+  const intptr_t first = IndexOf(moves, Reg(0));
+  EXPECT_EQ(0, first);
+  EXPECT(moves[first].src().Equals(Slot(1)));
+  EXPECT(moves[IndexOf(moves, Reg(1))].src().Equals(Reg(0)));
+  EXPECT(moves[IndexOf(moves, Slot(2))].src().Equals(Reg(0)));
+  EXPECT(moves[IndexOf(moves, Reg(2))].src().Equals(Slot(3)));
+}
+
+ISOLATE_UNIT_TEST_CASE(ParallelMoveResolver_CoalesceConstantLoads) {
+  auto constant = new ConstantInstr(Smi::ZoneHandle(Smi::New(42)));
+  auto parallel_move = new ParallelMoveInstr();
+  parallel_move->AddMove(Reg(0), Location::Constant(constant));
+  parallel_move->AddMove(Reg(1), Location::Constant(constant));
+  parallel_move->AddMove(Reg(2), Reg(3));
+
+  const auto moves = ParallelMoveResolverTestHelper::Schedule(parallel_move);
+  EXPECT_EQ(3, moves.length());
+  const intptr_t first = IndexOf(moves, Reg(0));
+  EXPECT(moves[first].src().Equals(Location::Constant(constant)));
+  EXPECT(IndexOf(moves, Reg(1)) > first);
+  EXPECT(moves[IndexOf(moves, Reg(1))].src().Equals(Reg(0)));
+  EXPECT(moves[IndexOf(moves, Reg(2))].src().Equals(Reg(3)));
+}
+
+// The value must still be read from the stack slot before the slot itself is
+// overwritten by the parallel move.
+ISOLATE_UNIT_TEST_CASE(ParallelMoveResolver_CoalesceOverwrittenSlot) {
+  auto parallel_move = new ParallelMoveInstr();
+  parallel_move->AddMove(Reg(0), Slot(1));
+  parallel_move->AddMove(Slot(1), Reg(1));
+  parallel_move->AddMove(Reg(2), Slot(1));
+
+  const auto moves = ParallelMoveResolverTestHelper::Schedule(parallel_move);
+  EXPECT_EQ(3, moves.length());
+  const intptr_t load = IndexOf(moves, Reg(0));
+  const intptr_t store = IndexOf(moves, Slot(1));
+  EXPECT(moves[load].src().Equals(Slot(1)));
+  EXPECT(load < store);
+  EXPECT(moves[store].src().Equals(Reg(1)));
+  EXPECT(IndexOf(moves, Reg(2)) < store);
+  EXPECT(moves[IndexOf(moves, Reg(2))].src().Equals(Reg(0)));
+}
+
+}  // namespace dart
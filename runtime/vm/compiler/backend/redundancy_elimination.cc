@@ -23,6 +23,10 @@ DEFINE_FLAG(bool,
             optimize_lazy_initializer_calls,
             true,
             "Eliminate redundant lazy initializer calls.");
+DEFINE_FLAG(bool,
+            partial_escape_analysis,
+            true,
+            "Sink allocations which escape only on some paths.");
 DEFINE_FLAG(bool,
             trace_load_optimization,
             false,
@@ -3672,6 +3676,11 @@ void AllocationSinking::DiscoverFailedCandidates() {
         if (use->instruction()->IsLoadField() ||
             use->instruction()->IsLoadIndexed()) {
           Definition* load = use->instruction()->AsDefinition();
+          // Loads initializing escaped copies are kept: the allocation is
+          // not eliminated, so they load the right values.
+          if (escaped_copy_loads_.Contains(load)) {
+            continue;
+          }
           load->ReplaceUsesWith(flow_graph_->constant_null());
           load->RemoveFromGraph();
         } else {
@@ -3718,8 +3727,16 @@ void AllocationSinking::Optimize() {
     return;
   }
 
+  // Copies created at escapes are allocated without a deoptimization
+  // environment, so partial escape analysis is only done in AOT mode.
+  if (FLAG_partial_escape_analysis && CompilerState::Current().is_aot()) {
+    MaterializeAtEscapes();
+  }
+
   CollectCandidates();
 
+  InitializeEscapedCopies();
+
   // Insert MaterializeObject instructions that will describe the state of the
   // object at all deoptimization points. Each inserted materialization looks
   // like this (where v_0 is allocation that we are going to eliminate):
@@ -4080,6 +4097,308 @@ void AllocationSinking::InsertMaterializations(Definition* alloc) {
   }
 }
 
+// Partial escape analysis.
+//
+// An allocation which escapes only on some paths, e.g. when it is passed to
+// an error reporting call on a rare branch, is not an allocation sinking
+// candidate because IsSafeUse rejects its escaping uses. Instead of giving up
+// on such an allocation it is re-created in every block where it escapes:
+//
+//   v0 <- AllocateObject(...)          v0 <- AllocateObject(...)
+//   StoreField(v0 . x = v1)            StoreField(v0 . x = v1)
+//   Branch if ... goto B1 / B2    =>   Branch if ... goto B1 / B2
+//   B1: StaticCall(report, v0)         B1: v2 <- LoadField(v0 . x)
+//                                          v3 <- AllocateObject(...)
+//                                          StoreField(v3 . x = v2)
+//                                          StaticCall(report, v3)
+//
+// After that the original allocation is only used by stores into its own
+// fields, so it becomes a candidate and is eliminated. The loads which
+// initialize the copy are forwarded by load optimization together with the
+// loads inserted for materializations, so the object is only allocated on
+// the paths where it escapes.
+//
+// The copy is created in front of the first instruction of the block which
+// mentions the allocation and replaces the allocation in all instructions
+// dominated by that point. To preserve the identity of the object no other
+// mention of the allocation may be reachable from this block, unless the
+// allocation itself is executed again on the way.
+
+// Returns true if the given instruction is an allocation which can be
+// re-created by CopyAllocation.
+static bool IsPartialEscapeCandidate(Instruction* instr) {
+  return instr->IsAllocateObject() || instr->IsAllocateClosure() ||
+         instr->IsAllocateContext() || instr->IsAllocateRecord() ||
+         instr->IsAllocateSmallRecord();
+}
+
+// Returns true if the given use is a store of another value into a field of
+// the used allocation.
+static bool IsStoreIntoAllocation(Value* use) {
+  auto* const store = use->instruction()->AsStoreField();
+  return (store != nullptr) && (use == store->instance()) &&
+         (store->value()->definition() != use->definition());
+}
+
+// Returns a new allocation of the same object as the given one, with the
+// same inputs.
+static AllocationInstr* CopyAllocation(Zone* zone, AllocationInstr* alloc) {
+  auto input = [&](intptr_t i) {
+    return new (zone) Value(alloc->InputAt(i)->definition());
+  };
+  if (auto* const instr = alloc->AsAllocateObject()) {
+    return new (zone) AllocateObjectInstr(
+        instr->source(), instr->cls(), DeoptId::kNone,
+        instr->type_arguments() != nullptr
+            ? input(AllocateObjectInstr::kTypeArgumentsPos)
+            : nullptr);
+  }
+  if (auto* const instr = alloc->AsAllocateClosure()) {
+    return new (zone) AllocateClosureInstr(
+        instr->source(), input(AllocateClosureInstr::kFunctionPos),
+        input(AllocateClosureInstr::kContextPos),
+        instr->has_instantiator_type_args()
+            ? input(AllocateClosureInstr::kInstantiatorTypeArgsPos)
+            : nullptr,
+        instr->is_generic(), instr->is_tear_off(), DeoptId::kNone);
+  }
+  if (auto* const instr = alloc->AsAllocateContext()) {
+    return new (zone) AllocateContextInstr(
+        instr->source(), instr->context_slots(), DeoptId::kNone);
+  }
+  if (auto* const instr = alloc->AsAllocateRecord()) {
+    return new (zone)
+        AllocateRecordInstr(instr->source(), instr->shape(), DeoptId::kNone);
+  }
+  if (auto* const instr = alloc->AsAllocateSmallRecord()) {
+    return new (zone) AllocateSmallRecordInstr(
+        instr->source(), instr->shape(), input(0), input(1),
+        instr->num_fields() > 2 ? input(2) : nullptr, DeoptId::kNone);
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+// Marks all blocks reachable from the end of the given block. Blocks in
+// [barriers] are marked when reached, but paths through them are not
+// followed.
+static void MarkReachableBlocks(BlockEntryInstr* from,
+                                const GrowableArray<BlockEntryInstr*>& barriers,
+                                BitVector* reachable) {
+  GrowableArray<BlockEntryInstr*> worklist;
+  worklist.Add(from);
+  while (!worklist.is_empty()) {
+    Instruction* const last = worklist.RemoveLast()->last_instruction();
+    for (intptr_t i = 0; i < last->SuccessorCount(); i++) {
+      BlockEntryInstr* const succ = last->SuccessorAt(i);
+      if (!reachable->Contains(succ->preorder_number())) {
+        reachable->Add(succ->preorder_number());
+        if (!barriers.Contains(succ)) {
+          worklist.Add(succ);
+        }
+      }
+    }
+  }
+}
+
+void AllocationSinking::MaterializeAtEscapes() {
+  GrowableArray<AllocationInstr*> allocations;
+  for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (IsPartialEscapeCandidate(it.Current())) {
+        allocations.Add(it.Current()->AsAllocation());
+      }
+    }
+  }
+
+  for (auto* const alloc : allocations) {
+    if (!IsAllocationSinkingCandidate(alloc, kOptimisticCheck) &&
+        TryMaterializeAtEscapes(alloc)) {
+      if (FLAG_trace_optimization && flow_graph_->should_print()) {
+        THR_Print("materializing allocation v%" Pd " where it escapes\n",
+                  alloc->ssa_temp_index());
+      }
+    }
+  }
+}
+
+bool AllocationSinking::TryMaterializeAtEscapes(AllocationInstr* alloc) {
+  BlockEntryInstr* const block = alloc->GetBlock();
+
+  // Collect all instructions which mention the allocation and the blocks
+  // where it escapes.
+  GrowableArray<Instruction*> mentions;
+  GrowableArray<BlockEntryInstr*> escapes;
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    Instruction* const instr = use->instruction();
+    if (instr->IsPhi()) {
+      return false;
+    }
+    AddInstruction(&mentions, instr);
+    if (IsStoreIntoAllocation(use)) {
+      if (instr->AsStoreField()->slot().representation() == kUntagged) {
+        return false;
+      }
+      continue;
+    }
+    BlockEntryInstr* const use_block = instr->GetBlock();
+    if (use_block == block) {
+      return false;
+    }
+    AddInstruction(&escapes, use_block);
+  }
+  if (escapes.is_empty()) {
+    return false;
+  }
+  for (Value* use = alloc->env_use_list(); use != nullptr;
+       use = use->next_use()) {
+    AddInstruction(&mentions, use->instruction());
+  }
+
+  // A copy created in a block also replaces the allocation in the blocks
+  // it dominates, so only the outermost escaping blocks get copies.
+  GrowableArray<BlockEntryInstr*> roots;
+  for (auto* const escape : escapes) {
+    bool is_nested = false;
+    for (auto* const other : escapes) {
+      if (other != escape && other->Dominates(escape)) {
+        is_nested = true;
+        break;
+      }
+    }
+    if (!is_nested) {
+      roots.Add(escape);
+    }
+  }
+
+  // Find the instruction in front of which each copy is created and assign
+  // mentions to the copies replacing the allocation in them (-1 for mentions
+  // which keep the allocation).
+  GrowableArray<Instruction*> first_mentions(roots.length());
+  GrowableArray<intptr_t> copy_index(mentions.length());
+  for (intptr_t i = 0; i < mentions.length(); i++) {
+    copy_index.Add(-1);
+  }
+  for (intptr_t r = 0; r < roots.length(); r++) {
+    Instruction* first = nullptr;
+    for (ForwardInstructionIterator it(roots[r]); !it.Done(); it.Advance()) {
+      for (intptr_t i = 0; i < mentions.length(); i++) {
+        if (mentions[i] == it.Current()) {
+          if (first == nullptr) {
+            first = it.Current();
+          }
+          copy_index[i] = r;
+        }
+      }
+    }
+    ASSERT(first != nullptr);
+    first_mentions.Add(first);
+    for (intptr_t i = 0; i < mentions.length(); i++) {
+      BlockEntryInstr* const mention_block = mentions[i]->GetBlock();
+      if (mention_block != roots[r] && roots[r]->Dominates(mention_block)) {
+        copy_index[i] = r;
+      }
+    }
+  }
+
+  // Check that the object does not escape on every path and that the
+  // mentions of a copy cannot be followed by other mentions of the same
+  // object.
+  BitVector* reachable =
+      new (Z) BitVector(Z, flow_graph_->preorder().length());
+  MarkReachableBlocks(block, roots, reachable);
+  bool escapes_on_all_paths = true;
+  for (auto* const reached : flow_graph_->preorder()) {
+    if (reachable->Contains(reached->preorder_number()) &&
+        !roots.Contains(reached) &&
+        (reached == block ||
+         reached->last_instruction()->SuccessorCount() == 0)) {
+      escapes_on_all_paths = false;
+      break;
+    }
+  }
+  if (escapes_on_all_paths) {
+    return false;
+  }
+
+  GrowableArray<BlockEntryInstr*> barriers;
+  barriers.Add(block);
+  for (intptr_t r = 0; r < roots.length(); r++) {
+    reachable->Clear();
+    MarkReachableBlocks(roots[r], barriers, reachable);
+    if (reachable->Contains(roots[r]->preorder_number())) {
+      return false;
+    }
+    for (intptr_t i = 0; i < mentions.length(); i++) {
+      BlockEntryInstr* const mention_block = mentions[i]->GetBlock();
+      if (copy_index[i] != r && mention_block != block &&
+          reachable->Contains(mention_block->preorder_number())) {
+        return false;
+      }
+    }
+  }
+
+  GrowableArray<AllocationInstr*> copies(roots.length());
+  for (intptr_t r = 0; r < roots.length(); r++) {
+    AllocationInstr* const copy = CopyAllocation(Z, alloc);
+    flow_graph_->InsertBefore(first_mentions[r], copy, nullptr,
+                              FlowGraph::kValue);
+    copies.Add(copy);
+    escaped_copies_.Add({alloc, copy});
+  }
+  for (intptr_t i = 0; i < mentions.length(); i++) {
+    if (copy_index[i] < 0) {
+      continue;
+    }
+    Instruction* const instr = mentions[i];
+    AllocationInstr* const copy = copies[copy_index[i]];
+    for (intptr_t j = 0; j < instr->InputCount(); j++) {
+      if (instr->InputAt(j)->definition() == alloc) {
+        instr->InputAt(j)->BindTo(copy);
+      }
+    }
+    if (instr->env() != nullptr) {
+      instr->ReplaceInEnvironment(alloc, copy);
+    }
+  }
+  return true;
+}
+
+// Initializes the fields of copies created by MaterializeAtEscapes with the
+// state of the original allocation in front of the copy. The inserted loads
+// are forwarded by load optimization if the allocation is eliminated.
+void AllocationSinking::InitializeEscapedCopies() {
+  for (const auto& escaped : escaped_copies_) {
+    Definition* const alloc = escaped.alloc;
+    AllocationInstr* const copy = escaped.copy;
+
+    auto slots = new (Z) ZoneGrowableArray<const Slot*>(5);
+    for (Value* use = alloc->input_use_list(); use != nullptr;
+         use = use->next_use()) {
+      if (IsStoreIntoAllocation(use)) {
+        AddSlot(slots, use->instruction()->AsStoreField()->slot());
+      }
+    }
+
+    Instruction* cursor = copy;
+    for (auto* const slot : *slots) {
+      auto* const load = new (Z) LoadFieldInstr(
+          new (Z) Value(alloc), *slot, InnerPointerAccess::kNotUntagged,
+          alloc->source());
+      flow_graph_->InsertBefore(copy, load, nullptr, FlowGraph::kValue);
+      escaped_copy_loads_.Add(load);
+      auto* const store = new (Z) StoreFieldInstr(
+          *slot, new (Z) Value(copy), new (Z) Value(load), kEmitStoreBarrier,
+          copy->source(), StoreFieldInstr::Kind::kInitializing);
+      flow_graph_->InsertAfter(cursor, store, nullptr, FlowGraph::kEffect);
+      cursor = store;
+    }
+  }
+}
+
 // TryCatchAnalyzer tries to reduce the state that needs to be synchronized
 // on entry to the catch by discovering Parameter-s which are never used
 // or which are always constant.
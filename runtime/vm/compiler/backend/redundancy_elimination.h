@@ -74,6 +74,12 @@ class AllocationSinking : public ZoneAllocated {
 
   void EliminateAllocation(Definition* alloc);
 
+  // Partial escape analysis: re-creates allocations which escape only on some
+  // paths in the blocks where they escape (see MaterializeAtEscapes).
+  void MaterializeAtEscapes();
+  bool TryMaterializeAtEscapes(AllocationInstr* alloc);
+  void InitializeEscapedCopies();
+
   enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
 
   bool IsAllocationSinkingCandidate(Definition* alloc, SafeUseCheck check_type);
@@ -88,6 +94,15 @@ class AllocationSinking : public ZoneAllocated {
   GrowableArray<MaterializeObjectInstr*> materializations_;
 
   ExitsCollector exits_collector_;
+
+  // Copies of allocations created by MaterializeAtEscapes.
+  struct EscapedCopy {
+    Definition* alloc;
+    AllocationInstr* copy;
+  };
+  GrowableArray<EscapedCopy> escaped_copies_;
+  // Loads which initialize the fields of escaped copies.
+  GrowableArray<Definition*> escaped_copy_loads_;
 };
 
 // A simple common subexpression elimination based
@@ -26,6 +26,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, partial_escape_analysis);
+
 static void NoopNative(Dart_NativeArguments args) {}
 
 static Dart_NativeFunction NoopNativeLookup(Dart_Handle name,
@@ -1565,6 +1567,118 @@ ISOLATE_UNIT_TEST_CASE(DelayAllocations_DontDelayIntoLoop) {
   EXPECT(call->Receiver()->definition() == allocate);
 }
 
+// Compiles function test in AOT mode and collects the allocations and the
+// calls to function report left in its flow graph.
+static FlowGraph* CompileForPartialEscape(
+    const char* script,
+    GrowableArray<AllocateObjectInstr*>* allocations,
+    GrowableArray<StaticCallInstr*>* calls) {
+  const auto& root_library = Library::Handle(LoadTestScript(script));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto* const alloc = it.Current()->AsAllocateObject()) {
+        allocations->Add(alloc);
+      } else if (auto* const call = it.Current()->AsStaticCall()) {
+        if (strcmp(call->function().UserVisibleNameCString(), "report") ==
+            0) {
+          calls->Add(call);
+        }
+      }
+    }
+  }
+  return flow_graph;
+}
+
+static const char* kPartialEscapeScript = R"(
+    class Point {
+      int x, y;
+      Point(this.x, this.y);
+    }
+
+    @pragma("vm:never-inline")
+    void report(Object o) {
+      print(o);
+    }
+
+    int test(int a, int b) {
+      final p = Point(a, b);
+      p.x += b;
+      if (a < 0) {
+        report(p);
+        return 0;
+      }
+      return p.x + p.y;
+    }
+  )";
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscape) {
+  GrowableArray<AllocateObjectInstr*> allocations;
+  GrowableArray<StaticCallInstr*> calls;
+  FlowGraph* flow_graph =
+      CompileForPartialEscape(kPartialEscapeScript, &allocations, &calls);
+
+  // The point is only allocated on the branch where it escapes.
+  EXPECT_EQ(1, allocations.length());
+  EXPECT_EQ(1, calls.length());
+  EXPECT(allocations[0]->GetBlock() !=
+         flow_graph->graph_entry()->normal_entry());
+  EXPECT(allocations[0]->GetBlock() == calls[0]->GetBlock());
+  EXPECT(calls[0]->ArgumentAt(0) == allocations[0]);
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscapeOnAllPaths) {
+  const char* kScript = R"(
+    class Point {
+      int x, y;
+      Point(this.x, this.y);
+    }
+
+    @pragma("vm:never-inline")
+    void report(Object o) {
+      print(o);
+    }
+
+    int test(int a, int b) {
+      final p = Point(a, b);
+      p.x += b;
+      if (a < 0) {
+        report(p);
+        return 0;
+      }
+      report(p);
+      return p.y;
+    }
+  )";
+
+  GrowableArray<AllocateObjectInstr*> allocations;
+  GrowableArray<StaticCallInstr*> calls;
+  FlowGraph* flow_graph =
+      CompileForPartialEscape(kScript, &allocations, &calls);
+
+  EXPECT_EQ(1, allocations.length());
+  EXPECT_EQ(2, calls.length());
+  EXPECT(allocations[0]->GetBlock() ==
+         flow_graph->graph_entry()->normal_entry());
+}
+
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscapeDisabled) {
+  SetFlagScope<bool> sfs(&FLAG_partial_escape_analysis, false);
+  GrowableArray<AllocateObjectInstr*> allocations;
+  GrowableArray<StaticCallInstr*> calls;
+  FlowGraph* flow_graph =
+      CompileForPartialEscape(kPartialEscapeScript, &allocations, &calls);
+
+  EXPECT_EQ(1, allocations.length());
+  EXPECT(allocations[0]->GetBlock() ==
+         flow_graph->graph_entry()->normal_entry());
+}
+
 ISOLATE_UNIT_TEST_CASE(CheckStackOverflowElimination_NoInterruptsPragma) {
   const char* kScript = R"(
     @pragma('vm:prefer-inline')
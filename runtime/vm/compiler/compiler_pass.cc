@@ -12,6 +12,9 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_unrolling.h"
+#include "vm/compiler/backend/loop_vectorization.h"
+#include "vm/compiler/backend/loop_versioning.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
@@ -330,10 +333,13 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   // unreachable code.
   INVOKE_PASS_AOT(ApplyICData);
   INVOKE_PASS_AOT(OptimizeTypedDataAccesses);
+  INVOKE_PASS(LoopVectorization);
+  INVOKE_PASS(LoopUnrolling);
   INVOKE_PASS(SelectRepresentations);
   INVOKE_PASS(CSE);
   INVOKE_PASS(Canonicalize);
   INVOKE_PASS(LICM);
+  INVOKE_PASS(LoopVersioning);
   INVOKE_PASS(TryOptimizePatterns);
   INVOKE_PASS(DSE);
   INVOKE_PASS(TypePropagation);
@@ -466,6 +472,39 @@ COMPILER_PASS(LICM, {
   flow_graph->RemoveRedefinitions(/*keep_checks*/ true);
 });
 
+COMPILER_PASS(LoopUnrolling, {
+  if (flow_graph->is_huge_method()) {
+    return false;
+  }
+
+  LoopUnroller unroller(flow_graph);
+  if (unroller.Optimize()) {
+    FlowGraphTypePropagator::Propagate(flow_graph);
+  }
+});
+
+COMPILER_PASS(LoopVectorization, {
+  if (flow_graph->is_huge_method()) {
+    return false;
+  }
+
+  LoopVectorizer vectorizer(flow_graph);
+  if (vectorizer.Optimize()) {
+    FlowGraphTypePropagator::Propagate(flow_graph);
+  }
+});
+
+COMPILER_PASS(LoopVersioning, {
+  if (flow_graph->is_huge_method()) {
+    return false;
+  }
+
+  LoopVersioner versioner(flow_graph);
+  if (versioner.Optimize()) {
+    FlowGraphTypePropagator::Propagate(flow_graph);
+  }
+});
+
 COMPILER_PASS(DSE, { DeadStoreElimination::Optimize(flow_graph); });
 
 COMPILER_PASS(RangeAnalysis, {
@@ -554,7 +593,13 @@ COMPILER_PASS(FinalizeGraph, {
                                      /*constants_count*/ 0,
                                      /*force*/ true, &instruction_count,
                                      &call_site_count);
-  flow_graph->function().set_inlining_depth(state->inlining_depth);
+  DeferredInliningInfo* deferred =
+      CompilerState::Current().deferred_inlining_info();
+  if (deferred != nullptr) {
+    deferred->SetInliningDepth(flow_graph->function(), state->inlining_depth);
+  } else {
+    flow_graph->function().set_inlining_depth(state->inlining_depth);
+  }
   // Remove redefinitions for the rest of the pipeline.
   flow_graph->RemoveRedefinitions();
 });
@@ -40,6 +40,9 @@ namespace dart {
   V(IfConvert)                                                                 \
   V(Inlining)                                                                  \
   V(LICM)                                                                      \
+  V(LoopUnrolling)                                                             \
+  V(LoopVectorization)                                                         \
+  V(LoopVersioning)                                                            \
   V(OptimisticallySpecializeSmiPhis)                                           \
   V(OptimizeBranches)                                                          \
   V(OptimizeTypedDataAccesses)                                                 \
@@ -19,6 +19,7 @@ namespace dart {
 
 class CompilerPass;
 struct CompilerPassState;
+class DeferredInliningInfo;
 class Function;
 class LocalScope;
 class LocalVariable;
@@ -72,6 +73,15 @@ class CompilerState : public ThreadStackResource {
   SlotCache* slot_cache() const { return slot_cache_; }
   void set_slot_cache(SlotCache* cache) { slot_cache_ = cache; }
 
+  // If set, updates of the inlining heuristics cached in functions are
+  // recorded there instead of being applied (see DeferredInliningInfo).
+  DeferredInliningInfo* deferred_inlining_info() const {
+    return deferred_inlining_info_;
+  }
+  void set_deferred_inlining_info(DeferredInliningInfo* info) {
+    deferred_inlining_info_ = info;
+  }
+
   bool is_aot() const { return is_aot_; }
 
   bool is_optimizing() const { return is_optimizing_; }
@@ -137,6 +147,8 @@ class CompilerState : public ThreadStackResource {
   // Cache for Slot objects created during compilation (see slot.h).
   SlotCache* slot_cache_ = nullptr;
 
+  DeferredInliningInfo* deferred_inlining_info_ = nullptr;
+
   // Caches for dummy LocalVariables and context Slots.
   ZoneGrowableArray<ZoneGrowableArray<const Slot*>*>* dummy_slots_ = nullptr;
   ZoneGrowableArray<LocalVariable*>* dummy_captured_vars_ = nullptr;
@@ -90,6 +90,25 @@ void CompilerTimings::PrintTimers(
   }
 }
 
+void CompilerTimings::AddTimers(std::unique_ptr<Timers>* to,
+                                const Timers& from) {
+  if (*to == nullptr) {
+    *to = std::make_unique<Timers>();
+  }
+  for (intptr_t i = 0; i < kNumTimers; i++) {
+    (*to)->timers_[i].AddTotal(from.timers_[i]);
+    if (from.nested_[i] != nullptr) {
+      AddTimers(&(*to)->nested_[i], *from.nested_[i]);
+    }
+  }
+}
+
+void CompilerTimings::MergeNested(const CompilerTimings& other) {
+  AddTimers(nested_, *other.root_);
+  try_inlining_success_.AddTotal(other.try_inlining_success_);
+  try_inlining_failure_.AddTotal(other.try_inlining_failure_);
+}
+
 void CompilerTimings::Print() {
   Zone* zone = Thread::Current()->zone();
 
@@ -125,9 +125,16 @@ class CompilerTimings : public MallocAllocated {
     }
   }
 
+  // Adds the timers of [other], which measured compilation on another
+  // thread, to the timers nested under the currently running timer. Threads
+  // run concurrently, so nested timers may add up to more than their parent.
+  void MergeNested(const CompilerTimings& other);
+
   void Print();
 
  private:
+  static void AddTimers(std::unique_ptr<Timers>* to, const Timers& from);
+
   void PrintTimers(Zone* zone,
                    const std::unique_ptr<CompilerTimings::Timers>& timers,
                    const Timer& total,
@@ -0,0 +1,21 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/function_key.h"
+
+#include "vm/object.h"
+#include "vm/os.h"
+
+namespace dart {
+
+const char* FunctionKey(Zone* zone, const Function& function) {
+  const auto& script = Script::Handle(zone, function.script());
+  const char* url =
+      script.IsNull() ? "" : String::Handle(zone, script.url()).ToCString();
+  return OS::SCreate(zone, "%s\t%" Pd32 "\t%s", url,
+                     function.token_pos().Serialize(),
+                     function.QualifiedScrubbedNameCString());
+}
+
+}  // namespace dart
@@ -0,0 +1,26 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_FUNCTION_KEY_H_
+#define RUNTIME_VM_COMPILER_FUNCTION_KEY_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+namespace dart {
+
+class Function;
+class Zone;
+
+// Returns a string identifying [function] across runs of the same program:
+// the url of its script, its token position and its qualified name.
+//
+// Used to match functions recorded by one run (see AotProfile and
+// JitWarmupCache) with the functions of a later run.
+const char* FunctionKey(Zone* zone, const Function& function);
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_FUNCTION_KEY_H_
@@ -26,6 +26,7 @@
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
 #include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/compiler/jit/jit_warmup_cache.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
@@ -67,6 +68,15 @@ DEFINE_FLAG(bool,
             false,
             "Print the deopt-id to ICData map in optimizing compiler.");
 DEFINE_FLAG(bool, print_code_source_map, false, "Print code source map.");
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Number of threads compiling optimized code in the background.");
+DEFINE_FLAG(int,
+            background_compilation_aging,
+            1000,
+            "Usage count credited per millisecond a function waits in the "
+            "background compilation queue.");
 DEFINE_FLAG(bool,
             stress_test_background_compilation,
             false,
@@ -474,6 +484,10 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
       // to INT32_MIN. Reset counter so that function can be optimized further.
       function.SetUsageCounter(0);
     }
+    JitWarmupCache* cache = thread()->isolate_group()->jit_warmup_cache();
+    if (cache != nullptr) {
+      cache->OnUnoptimizedCode(thread(), function);
+    }
   }
 
   if (function.IsFfiCallbackTrampoline()) {
@@ -992,7 +1006,9 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 class QueueElement {
  public:
   explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
+      : next_(nullptr),
+        function_(function.ptr()),
+        enqueue_micros_(OS::GetCurrentMonotonicMicros()) {}
 
   virtual ~QueueElement() {
     next_ = nullptr;
@@ -1009,18 +1025,23 @@ class QueueElement {
     return reinterpret_cast<ObjectPtr*>(&function_);
   }
 
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
  private:
   QueueElement* next_;
   FunctionPtr function_;
+  int64_t enqueue_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, and
+// RemoveHottest to pick the function which is most likely to benefit from
+// being optimized next.
 class BackgroundCompilationQueue {
  public:
-  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
+  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr), length_(0) {}
   virtual ~BackgroundCompilationQueue() { Clear(); }
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
@@ -1033,6 +1054,7 @@ class BackgroundCompilationQueue {
   }
 
   bool IsEmpty() const { return first_ == nullptr; }
+  intptr_t Length() const { return length_; }
 
   void Add(QueueElement* value) {
     ASSERT(value != nullptr);
@@ -1045,6 +1067,7 @@ class BackgroundCompilationQueue {
       last_->set_next(value);
     }
     last_ = value;
+    length_++;
     ASSERT(first_ != nullptr && last_ != nullptr);
   }
 
@@ -1066,9 +1089,58 @@ class BackgroundCompilationQueue {
     if (first_ == nullptr) {
       last_ = nullptr;
     }
+    result->set_next(nullptr);
+    length_--;
     return result;
   }
 
+  // Removes [value] from anywhere in the queue.
+  void Remove(QueueElement* value) {
+    QueueElement* prev = nullptr;
+    QueueElement* p = first_;
+    while (p != value) {
+      ASSERT(p != nullptr);
+      prev = p;
+      p = p->next();
+    }
+    if (prev == nullptr) {
+      first_ = value->next();
+    } else {
+      prev->set_next(value->next());
+    }
+    if (last_ == value) {
+      last_ = prev;
+    }
+    value->set_next(nullptr);
+    length_--;
+  }
+
+  // Removes the element whose function has been used the most since it was
+  // enqueued, crediting each element with --background-compilation-aging
+  // uses per millisecond spent waiting so that no function starves.
+  //
+  // Functions have their usage counter set to INT32_MIN when they are
+  // enqueued, so it counts invocations and loop iterations from there.
+  QueueElement* RemoveHottest(Function* function) {
+    ASSERT(first_ != nullptr);
+    const int64_t now = OS::GetCurrentMonotonicMicros();
+    QueueElement* hottest = nullptr;
+    int64_t hottest_score = kMinInt64;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      *function ^= p->function();
+      const int64_t usage_counter = function->usage_counter();
+      int64_t score = (usage_counter < 0) ? usage_counter - kMinInt32 : 0;
+      score += (now - p->enqueue_micros()) * FLAG_background_compilation_aging /
+               kMicrosecondsPerMillisecond;
+      if (score > hottest_score) {
+        hottest = p;
+        hottest_score = score;
+      }
+    }
+    Remove(hottest);
+    return hottest;
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != nullptr) {
@@ -1091,6 +1163,7 @@ class BackgroundCompilationQueue {
  private:
   QueueElement* first_;
   QueueElement* last_;
+  intptr_t length_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
@@ -1113,15 +1186,32 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
     : isolate_group_(isolate_group),
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
+      compiling_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
+      task_count_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete function_queue_;
+  delete compiling_;
 }
 
+#if !defined(PRODUCT)
+static void ReportQueueWait(intptr_t queue_length, int64_t wait_micros) {
+  TimelineStream* stream = Timeline::GetCompilerStream();
+  ASSERT(stream != nullptr);
+  TimelineEvent* event = stream->StartEvent();
+  if (event != nullptr) {
+    event->Counter("BackgroundCompilationQueue");
+    event->SetNumArguments(2);
+    event->FormatArgument(0, "length", "%" Pd, queue_length);
+    event->FormatArgument(1, "wait_micros", "%" Pd64, wait_micros);
+    event->Complete();
+  }
+}
+#endif  // !defined(PRODUCT)
+
 void BackgroundCompiler::Run() {
   bool result = Thread::EnterIsolateGroupAsHelper(
       isolate_group_, Thread::kCompilerTask, /*bypass_safepoint=*/false);
@@ -1133,28 +1223,39 @@ void BackgroundCompiler::Run() {
     HANDLESCOPE(thread);
     Function& function = Function::Handle(zone);
     QueueElement* element = nullptr;
+    intptr_t queue_length = 0;
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
+        element = function_queue()->RemoveHottest(&function);
         function ^= element->function();
+        // Other tasks must not compile the function at the same time.
+        compiling_->Add(element);
+        queue_length = function_queue()->Length();
       }
     }
     if (element != nullptr) {
-      delete element;
+#if !defined(PRODUCT)
+      ReportQueueWait(queue_length,
+                      OS::GetCurrentMonotonicMicros() -
+                          element->enqueue_micros());
+#endif  // !defined(PRODUCT)
       Compiler::CompileOptimizedFunction(thread, function,
                                          Compiler::kNoOSRDeoptId);
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
-      if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
-          FLAG_stress_test_background_compilation) {
-        if (Compiler::CanOptimizeFunction(thread, function)) {
-          SafepointMonitorLocker ml(&monitor_);
-          if (running_) {
-            QueueElement* repeat_qelem = new QueueElement(function);
-            function_queue()->Add(repeat_qelem);
-          }
+      const bool retry =
+          ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
+           FLAG_stress_test_background_compilation) &&
+          Compiler::CanOptimizeFunction(thread, function);
+      SafepointMonitorLocker ml(&monitor_);
+      if (running_) {
+        compiling_->Remove(element);
+        delete element;
+        if (retry) {
+          QueueElement* repeat_qelem = new QueueElement(function);
+          function_queue()->Add(repeat_qelem);
         }
       }
     }
@@ -1165,12 +1266,11 @@ void BackgroundCompiler::Run() {
     if (running_ && !function_queue()->IsEmpty() &&
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
-    } else {
+    } else if (--task_count_ == 0) {
       // Background compiler done. This notification must happen after the
       // thread leaves to group to avoid a shutdown race with the thread
       // registry.
       running_ = false;
-      done_ = true;
       ml.NotifyAll();
     }
   }
@@ -1183,24 +1283,30 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && (task_count_ == 0)) {
     running_ = true;
-    done_ = false;
-    // If we ever wanted to run the BG compiler on the
-    // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
-    // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
-    // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
-      running_ = false;
-      done_ = true;
-      return false;
-    }
   }
 
   ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
+  if (function_queue()->ContainsObj(function) ||
+      compiling_->ContainsObj(function)) {
     return true;
   }
+  // Start another task unless there are enough of them for all queued
+  // functions.
+  // If we ever wanted to run the BG compiler on the
+  // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
+  // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
+  // notification would not work anymore.
+  if ((task_count_ < FLAG_background_compiler_threads) &&
+      (task_count_ <= function_queue()->Length())) {
+    if (Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+      task_count_++;
+    } else if (task_count_ == 0) {
+      running_ = false;
+      return false;
+    }
+  }
   QueueElement* elem = new QueueElement(function);
   function_queue()->Add(elem);
   ml.NotifyAll();
@@ -1209,6 +1315,7 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  compiling_->VisitObjectPointers(visitor);
 }
 
 void BackgroundCompiler::Stop() {
@@ -1224,9 +1331,10 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (task_count_ > 0) {
     locker->Wait();
   }
+  compiling_->Clear();
 }
 
 void BackgroundCompiler::Enable() {
@@ -1248,7 +1356,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (task_count_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -113,9 +113,10 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background-compiler-threads tasks per
+// isolate group, compiling the hottest queued functions first. The tasks
+// die with the owning isolate group.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -145,14 +146,16 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return task_count_ > 0; }
 
   IsolateGroup* isolate_group_;
 
-  Monitor monitor_;  // Controls access to the queue and running state.
+  Monitor monitor_;  // Controls access to the queues and running state.
   BackgroundCompilationQueue* function_queue_;
-  bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  // Functions which are being compiled by one of the tasks.
+  BackgroundCompilationQueue* compiling_;
+  bool running_;         // While true, will try to read queue and compile.
+  intptr_t task_count_;  // Number of tasks which are not done.
   int16_t disabled_depth_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
@@ -0,0 +1,244 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/jit/jit_warmup_cache.h"
+
+#include <stdlib.h>
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/function_key.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/program_visitor.h"
+#include "vm/version.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            jit_warmup_cache,
+            nullptr,
+            "Remember the functions optimized by the JIT in the given file and "
+            "optimize them early in subsequent runs of the same program.");
+DEFINE_FLAG(int,
+            jit_warmup_cache_threshold,
+            100,
+            "Usage count after which functions found in the JIT warmup cache "
+            "are optimized.");
+
+AcqRelAtomic<bool> JitWarmupCache::file_claimed_ = {false};
+
+JitWarmupCache* JitWarmupCache::New(IsolateGroup* isolate_group) {
+  if ((FLAG_jit_warmup_cache == nullptr) ||
+      IsolateGroup::IsSystemIsolateGroup(isolate_group)) {
+    return nullptr;
+  }
+  bool expected = false;
+  if (!file_claimed_.compare_exchange_strong(expected, true)) {
+    return nullptr;
+  }
+  return new JitWarmupCache(isolate_group);
+}
+
+JitWarmupCache::~JitWarmupCache() {
+  for (const auto& entry : entries_) {
+    free(entry.key);
+  }
+  free(program_key_);
+  file_claimed_.store(false);
+}
+
+void JitWarmupCache::OnUnoptimizedCode(Thread* thread,
+                                       const Function& function) {
+  if (!function.IsOptimizable()) {
+    return;
+  }
+  {
+    MutexLocker ml(&mutex_);
+    EnsureLoadedLocked();
+    if (entries_.is_empty()) {
+      return;
+    }
+    const char* key = FunctionKey(thread->zone(), function);
+    const intptr_t index = index_.LookupValue(key);
+    if (index == CStringIntMapKeyValueTrait::kNoValue) {
+      return;
+    }
+    entries_[index].used = true;
+  }
+  const intptr_t usage_counter = Utils::Maximum<intptr_t>(
+      0, isolate_group_->optimization_counter_threshold() -
+             FLAG_jit_warmup_cache_threshold);
+  if (function.usage_counter() < usage_counter) {
+    function.SetUsageCounter(usage_counter);
+  }
+}
+
+void JitWarmupCache::EnsureLoadedLocked() {
+  if (loaded_) {
+    return;
+  }
+  // The program may not be loaded yet when the first function is compiled.
+  IsolateGroupSource* source = isolate_group_->source();
+  const uint8_t* kernel = source->script_kernel_buffer;
+  intptr_t kernel_size = source->script_kernel_size;
+  if (kernel == nullptr) {
+    kernel = source->kernel_buffer;
+    kernel_size = source->kernel_buffer_size;
+  }
+  if (kernel == nullptr) {
+    return;
+  }
+  loaded_ = true;
+  program_key_ = Utils::SCreate("%08" Px32 "\t%" Pd,
+                                HashBytes(kernel, kernel_size), kernel_size);
+
+  if ((Dart::file_read_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    return;
+  }
+  void* file = Dart::file_open_callback()(FLAG_jit_warmup_cache,
+                                          /*write=*/false);
+  if (file == nullptr) {
+    // No cache yet.
+    return;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = 0;
+  Dart::file_read_callback()(&data, &length, file);
+  Dart::file_close_callback()(file);
+  if ((data == nullptr) || (length < 0)) {
+    return;
+  }
+  char* text = reinterpret_cast<char*>(realloc(data, length + 1));
+  if (text == nullptr) {
+    free(data);
+    return;
+  }
+  text[length] = '\0';
+  if (!Parse(text)) {
+    for (const auto& entry : entries_) {
+      free(entry.key);
+    }
+    entries_.Clear();
+    index_.Clear();
+  }
+  free(text);
+}
+
+bool JitWarmupCache::Parse(char* data) {
+  bool version_matches = false;
+  bool program_matches = false;
+  char* next = data;
+  while (next != nullptr) {
+    char* line = next;
+    next = strchr(line, '\n');
+    if (next != nullptr) {
+      *next++ = '\0';
+    }
+    if ((line[0] == '\0') || (line[0] == '#')) {
+      continue;
+    }
+
+    char* record = line;
+    char* rest = strchr(line, '\t');
+    if (rest == nullptr) {
+      return false;
+    }
+    *rest++ = '\0';
+    if (strcmp(record, "version") == 0) {
+      version_matches = strcmp(rest, Version::SnapshotString()) == 0;
+    } else if (strcmp(record, "program") == 0) {
+      program_matches = strcmp(rest, program_key_) == 0;
+    } else if (strcmp(record, "optimized") == 0) {
+      if (!version_matches || !program_matches) {
+        return false;
+      }
+      if (index_.HasKey(rest)) {
+        continue;
+      }
+      char* key = Utils::StrDup(rest);
+      index_.Insert({key, entries_.length()});
+      entries_.Add({key, false});
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+class JitWarmupCacheWriterVisitor : public FunctionVisitor {
+ public:
+  JitWarmupCacheWriterVisitor(Zone* zone,
+                              BaseTextBuffer* buffer,
+                              ZoneCStringSet* written)
+      : zone_(zone), buffer_(buffer), written_(written) {}
+
+  void VisitFunction(const Function& function) {
+    if (!function.HasOptimizedCode()) {
+      return;
+    }
+    const char* key = FunctionKey(zone_, function);
+    if (written_->HasKey(key)) {
+      return;
+    }
+    written_->Insert(key);
+    buffer_->Printf("optimized\t%s\n", key);
+  }
+
+ private:
+  Zone* const zone_;
+  BaseTextBuffer* const buffer_;
+  ZoneCStringSet* const written_;
+};
+
+void JitWarmupCache::Write(Thread* thread) {
+  if ((Dart::file_write_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return;
+  }
+
+  // Collect the optimized functions without holding the lock as walking the
+  // program may reach a safepoint.
+  Zone* zone = thread->zone();
+  TextBuffer buffer(16 * KB);
+  ZoneCStringSet written(zone);
+  JitWarmupCacheWriterVisitor visitor(zone, &buffer, &written);
+  ProgramVisitor::WalkProgram(zone, isolate_group_, &visitor);
+
+  // Hold the lock until the file is closed so that writes of isolates
+  // shutting down concurrently do not interleave.
+  MutexLocker ml(&mutex_);
+  EnsureLoadedLocked();
+  if (program_key_ == nullptr) {
+    return;
+  }
+  TextBuffer header(256);
+  header.AddString("# Dart JIT warmup cache\n");
+  header.Printf("version\t%s\n", Version::SnapshotString());
+  header.Printf("program\t%s\n", program_key_);
+  for (const auto& entry : entries_) {
+    if (!entry.used && !written.HasKey(entry.key)) {
+      buffer.Printf("optimized\t%s\n", entry.key);
+    }
+  }
+
+  void* file = Dart::file_open_callback()(FLAG_jit_warmup_cache,
+                                          /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write JIT warmup cache: %s\n",
+                 FLAG_jit_warmup_cache);
+    return;
+  }
+  Dart::file_write_callback()(header.buffer(), header.length(), file);
+  Dart::file_write_callback()(buffer.buffer(), buffer.length(), file);
+  Dart::file_close_callback()(file);
+}
+
+}  // namespace dart
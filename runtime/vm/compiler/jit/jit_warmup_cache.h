@@ -0,0 +1,99 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_JIT_JIT_WARMUP_CACHE_H_
+#define RUNTIME_VM_COMPILER_JIT_JIT_WARMUP_CACHE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Function;
+class IsolateGroup;
+class Thread;
+
+// Remembers across runs of the same program which functions the JIT ended
+// up optimizing, so that later runs optimize them soon after startup
+// instead of waiting for their usage counters to reach the threshold.
+//
+// With --jit-warmup-cache=<file> the set of functions which have optimized
+// code when an isolate shuts down is written to the file. In the next run
+// every such function gets its usage counter raised to
+// --jit-warmup-cache-threshold below the optimization threshold when its
+// unoptimized code is installed. It still runs unoptimized for a short while
+// to collect type feedback, and is then optimized the usual way, in the
+// background, with CHA and field guard dependencies registered for the new
+// code.
+//
+// The cache stores no code: the optimized code of a run depends on the
+// state of the heap (field guards, loaded classes, type feedback) which may
+// differ in the next run. Functions whose optimized code was discarded
+// because one of its guards failed are not written back. Entries for
+// functions which were not compiled at all are kept.
+//
+// The cache is keyed by the VM version and a hash of the kernel program and
+// ignored if either one changed. Only the first isolate group of the process
+// which runs user code uses the cache: groups created by Isolate.spawnUri
+// run other programs and would replace its entries.
+//
+// The file has one tab separated record per line:
+//
+//   version <snapshot hash>
+//   program <kernel hash> <kernel size>
+//   optimized <script url> <token pos> <qualified name>
+class JitWarmupCache {
+ public:
+  // Returns nullptr unless --jit-warmup-cache is given and [isolate_group]
+  // runs user code.
+  static JitWarmupCache* New(IsolateGroup* isolate_group);
+
+  ~JitWarmupCache();
+
+  // Called when the unoptimized code of [function] has been installed.
+  void OnUnoptimizedCode(Thread* thread, const Function& function);
+
+  // Writes the functions which currently have optimized code together with
+  // the entries of the previous run which were not used. Isolates of the
+  // group shutting down at the same time write the file one after another.
+  void Write(Thread* thread);
+
+ private:
+  struct Entry {
+    char* key;
+    bool used;
+  };
+
+  explicit JitWarmupCache(IsolateGroup* isolate_group)
+      : isolate_group_(isolate_group) {}
+
+  // Reads the cache file once the program is known. Requires mutex_.
+  void EnsureLoadedLocked();
+  bool Parse(char* data);
+
+  // Whether an isolate group of this process owns the cache file.
+  static AcqRelAtomic<bool> file_claimed_;
+
+  IsolateGroup* const isolate_group_;
+  Mutex mutex_;
+  bool loaded_ = false;
+  // Identifies the kernel program, set when loaded.
+  char* program_key_ = nullptr;
+  MallocGrowableArray<Entry> entries_;
+  // Maps function keys to indices in entries_.
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> index_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitWarmupCache);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_JIT_JIT_WARMUP_CACHE_H_
@@ -16,6 +16,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -100,6 +102,69 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnSeveralHelperThreads) {
+  const intptr_t kNumFunctions = 8;
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo0() { return 0; }\n"
+      "  static foo1() { return 1; }\n"
+      "  static foo2() { return 2; }\n"
+      "  static foo3() { return 3; }\n"
+      "  static foo4() { return 4; }\n"
+      "  static foo5() { return 5; }\n"
+      "  static foo6() { return 6; }\n"
+      "  static foo7() { return 7; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const Array& functions = Array::Handle(Array::New(kNumFunctions));
+  Function& func = Function::Handle();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    func = cls.LookupStaticFunction(
+        String::Handle(String::NewFormatted("foo%" Pd, i)));
+    EXPECT(!func.IsNull());
+    CompilerTest::TestCompileFunction(func);
+    EXPECT(func.HasCode());
+    EXPECT(!func.HasOptimizedCode());
+    functions.SetAt(i, func);
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  SetFlagScope<int> sfs(&FLAG_background_compiler_threads, 4);
+  auto isolate_group = thread->isolate_group();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    func ^= functions.At(i);
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(func));
+    // Enqueuing a function which is already queued or being compiled is a
+    // no-op.
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(func));
+  }
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      func ^= functions.At(i);
+      while (!func.HasOptimizedCode()) {
+        ml.Wait(1);
+      }
+    }
+  }
+  delete m;
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
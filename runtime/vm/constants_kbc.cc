@@ -34,6 +34,11 @@ const intptr_t KernelBytecode::kInstructionSize[] = {
 #undef SIZE
 };
 
+static_assert(KernelBytecode::kNumOpcodes <= 256,
+              "Opcode should fit into a byte");
+static_assert((KernelBytecode::kVMInternal_StoreFieldTOSBoxed & 1) == 0,
+              "Narrow bytecodes with wide variants must have even opcodes");
+
 #define DECLARE_INSTRUCTIONS(name, fmt, kind, fmta, fmtb, fmtc)                \
   static const KBCInstr k##name##Instructions[] = {                            \
       KernelBytecode::k##name,                                                 \
@@ -659,9 +659,24 @@ namespace dart {
   V(VMInternal_ImplicitInstanceClosure,    0, ORDN, ___, ___, ___)             \
   V(VMInternal_ImplicitConstructorClosure, 0, ORDN, ___, ___, ___)             \
 
+  // These bytecodes are never generated. The interpreter rewrites ordinary
+  // bytecodes into them in place once they have been executed (quickening).
+  // A quickened bytecode has the same operands and size as the original one.
+  // Narrow bytecodes with wide variants must have even opcodes.
+#define QUICKENED_KERNEL_BYTECODES_LIST(V)                                     \
+  V(VMInternal_Unused00,                   0, RESV, ___, ___, ___)             \
+  V(VMInternal_StoreFieldTOSBoxed,         D, ORDN, lit, ___, ___)             \
+  V(VMInternal_StoreFieldTOSBoxed_Wide,    D, WIDE, lit, ___, ___)             \
+  V(VMInternal_CompareIntEqJumpIfFalse,    0, ORDN, ___, ___, ___)             \
+  V(VMInternal_CompareIntGtJumpIfFalse,    0, ORDN, ___, ___, ___)             \
+  V(VMInternal_CompareIntLtJumpIfFalse,    0, ORDN, ___, ___, ___)             \
+  V(VMInternal_CompareIntGeJumpIfFalse,    0, ORDN, ___, ___, ___)             \
+  V(VMInternal_CompareIntLeJumpIfFalse,    0, ORDN, ___, ___, ___)             \
+
 #define KERNEL_BYTECODES_LIST(V)                                               \
   PUBLIC_KERNEL_BYTECODES_LIST(V)                                              \
-  INTERNAL_KERNEL_BYTECODES_LIST(V)
+  INTERNAL_KERNEL_BYTECODES_LIST(V)                                            \
+  QUICKENED_KERNEL_BYTECODES_LIST(V)
 
 // clang-format on
 
@@ -690,6 +705,11 @@ class KernelBytecode {
     return names[op];
   }
 
+  static const intptr_t kNumOpcodes =
+#define COUNT(name, encoding, kind, op1, op2, op3) +1
+      0 KERNEL_BYTECODES_LIST(COUNT);
+#undef COUNT
+
   static const intptr_t kInstructionSize[];
 
   enum SpecialIndex {
@@ -931,6 +951,12 @@ class KernelBytecode {
       case KernelBytecode::kCompareIntLt:
       case KernelBytecode::kCompareIntGe:
       case KernelBytecode::kCompareIntLe:
+      // Quickened compare bytecodes.
+      case KernelBytecode::kVMInternal_CompareIntEqJumpIfFalse:
+      case KernelBytecode::kVMInternal_CompareIntGtJumpIfFalse:
+      case KernelBytecode::kVMInternal_CompareIntLtJumpIfFalse:
+      case KernelBytecode::kVMInternal_CompareIntGeJumpIfFalse:
+      case KernelBytecode::kVMInternal_CompareIntLeJumpIfFalse:
       case KernelBytecode::kAddDouble:
       case KernelBytecode::kSubDouble:
       case KernelBytecode::kMulDouble:
@@ -334,6 +334,7 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   TimelineBeginEndScope tbes(Timeline::GetVMStream(), "Dart::Init");
 #endif
   IsolateGroup::Init();
+  FullSnapshotReader::Init();
   Isolate::InitVM();
   UserTags::Init();
   PortMap::Init();
@@ -747,6 +748,7 @@ char* Dart::Cleanup() {
   Service::Cleanup();
   PortMap::Cleanup();
   UserTags::Cleanup();
+  FullSnapshotReader::Cleanup();
   IsolateGroup::Cleanup();
   ICData::Cleanup();
   ArgumentsDescriptor::Cleanup();
@@ -1856,6 +1856,11 @@ Dart_SetPerformanceMode(Dart_PerformanceMode mode) {
 DART_EXPORT void Dart_ExitIsolate() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
+  if (T->isolate()->has_message_batch()) {
+    TransitionNativeToVM transition(T);
+    StackZone zone(T);
+    T->isolate()->FlushMessageBatch();
+  }
   // The Thread structure is disassociated from the isolate, we do the
   // safepoint transition explicitly here instead of using the TransitionXXX
   // scope objects as the original transition happened outside this scope in
@@ -4205,11 +4210,31 @@ static ObjectPtr ResolveConstructor(const char* current_func,
   return constructor.ptr();
 }
 
+// Posts the messages that Dart code run on behalf of the embedder coalesced
+// into a batch (see --port-message-batch-size) before control goes back to
+// the embedder. Unlike for message handlers, nothing else would flush them.
+class FlushMessageBatchOnReturn : public ValueObject {
+ public:
+  explicit FlushMessageBatchOnReturn(Thread* thread) : thread_(thread) {}
+  ~FlushMessageBatchOnReturn() {
+    // Calls made from natives leave this to the outermost Dart frame.
+    if (thread_->top_exit_frame_info() == 0) {
+      thread_->isolate()->FlushMessageBatch();
+    }
+  }
+
+ private:
+  Thread* const thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(FlushMessageBatchOnReturn);
+};
+
 DART_EXPORT Dart_Handle Dart_New(Dart_Handle type,
                                  Dart_Handle constructor_name,
                                  int number_of_arguments,
                                  Dart_Handle* arguments) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   CHECK_CALLBACK_STATE(T);
   Object& result = Object::Handle(Z);
 
@@ -4461,6 +4486,7 @@ DART_EXPORT Dart_Handle Dart_InvokeConstructor(Dart_Handle object,
                                                int number_of_arguments,
                                                Dart_Handle* arguments) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   API_TIMELINE_DURATION(T);
   CHECK_CALLBACK_STATE(T);
 
@@ -4543,6 +4569,7 @@ DART_EXPORT Dart_Handle Dart_Invoke(Dart_Handle target,
                                     int number_of_arguments,
                                     Dart_Handle* arguments) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   API_TIMELINE_DURATION(T);
   CHECK_CALLBACK_STATE(T);
 
@@ -4637,6 +4664,7 @@ DART_EXPORT Dart_Handle Dart_InvokeClosure(Dart_Handle closure,
                                            int number_of_arguments,
                                            Dart_Handle* arguments) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   API_TIMELINE_DURATION(T);
   CHECK_CALLBACK_STATE(T);
   const Instance& closure_obj = Api::UnwrapInstanceHandle(Z, closure);
@@ -4666,6 +4694,7 @@ DART_EXPORT Dart_Handle Dart_InvokeClosure(Dart_Handle closure,
 
 DART_EXPORT Dart_Handle Dart_GetField(Dart_Handle container, Dart_Handle name) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   API_TIMELINE_DURATION(T);
   CHECK_CALLBACK_STATE(T);
 
@@ -4731,6 +4760,7 @@ DART_EXPORT Dart_Handle Dart_SetField(Dart_Handle container,
                                       Dart_Handle name,
                                       Dart_Handle value) {
   DARTSCOPE(Thread::Current());
+  FlushMessageBatchOnReturn flush_message_batch(T);
   API_TIMELINE_DURATION(T);
   CHECK_CALLBACK_STATE(T);
 
@@ -6,6 +6,7 @@
 
 #include "../../third_party/double-conversion/src/double-conversion.h"
 
+#include "vm/double_parser.h"
 #include "vm/exceptions.h"
 #include "vm/globals.h"
 #include "vm/object.h"
@@ -157,6 +158,10 @@ bool CStringToDouble(const char* str, intptr_t length, double* result) {
     return false;
   }
 
+  if (TryParseDecimalDouble(str, length, result)) {
+    return true;
+  }
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kInfinitySymbol, kNaNSymbol);
@@ -0,0 +1,27 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_DOUBLE_PARSER_H_
+#define RUNTIME_VM_DOUBLE_PARSER_H_
+
+#include "vm/globals.h"
+
+namespace dart {
+
+// Fast path for parsing decimal numerals of the form
+//
+//   [+-]?[0-9]+(\.[0-9]+)?([eE][+-]?[0-9]+)?
+//
+// with at most 19 significant digits, using the Eisel-Lemire algorithm.
+//
+// Returns true and sets |result| to the correctly rounded value if the
+// numeral could be parsed this way. Returns false for anything else,
+// including numerals that are valid but need the slow path (more digits,
+// halfway cases, subnormal or overflowing results), in which case the caller
+// should fall back to double_conversion::StringToDoubleConverter.
+bool TryParseDecimalDouble(const char* str, intptr_t length, double* result);
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_DOUBLE_PARSER_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_parser.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/double_conversion.h"
+#include "vm/random.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static bool ParseFast(const char* str, double* result) {
+  return TryParseDecimalDouble(str, strlen(str), result);
+}
+
+static uint64_t Bits(double d) {
+  return bit_cast<uint64_t>(d);
+}
+
+VM_UNIT_TEST_CASE(DoubleParser_Simple) {
+  double d = 0.0;
+  EXPECT(ParseFast("0", &d));
+  EXPECT_EQ(Bits(0.0), Bits(d));
+  EXPECT(ParseFast("-0.0", &d));
+  EXPECT_EQ(Bits(-0.0), Bits(d));
+  EXPECT(ParseFast("+1", &d));
+  EXPECT_EQ(1.0, d);
+  EXPECT(ParseFast("1.5", &d));
+  EXPECT_EQ(1.5, d);
+  EXPECT(ParseFast("0.1", &d));
+  EXPECT_EQ(0.1, d);
+  EXPECT(ParseFast("-1.5e10", &d));
+  EXPECT_EQ(-1.5e10, d);
+  EXPECT(ParseFast("1E-5", &d));
+  EXPECT_EQ(1e-5, d);
+  EXPECT(ParseFast("00012.34000", &d));
+  EXPECT_EQ(12.34, d);
+  EXPECT(ParseFast("0.000000000000000000000000000000001234", &d));
+  EXPECT_EQ(1.234e-33, d);
+  EXPECT(ParseFast("1234567890123456789", &d));
+  EXPECT_EQ(1234567890123456789.0, d);
+  EXPECT(ParseFast("1.7976931348623157e308", &d));
+  EXPECT_EQ(1.7976931348623157e308, d);
+  EXPECT(ParseFast("2.2250738585072014e-308", &d));
+  EXPECT_EQ(2.2250738585072014e-308, d);
+}
+
+VM_UNIT_TEST_CASE(DoubleParser_Fallback) {
+  double d = 0.0;
+  // Not in the accepted grammar.
+  EXPECT(!ParseFast("", &d));
+  EXPECT(!ParseFast("-", &d));
+  EXPECT(!ParseFast("1.", &d));
+  EXPECT(!ParseFast(".5", &d));
+  EXPECT(!ParseFast("1e", &d));
+  EXPECT(!ParseFast("1e+", &d));
+  EXPECT(!ParseFast("--1", &d));
+  EXPECT(!ParseFast("1x", &d));
+  EXPECT(!ParseFast("Infinity", &d));
+  EXPECT(!ParseFast("NaN", &d));
+  // Too many significant digits.
+  EXPECT(!ParseFast("12345678901234567890", &d));
+  // Halfway between two doubles.
+  EXPECT(!ParseFast("9007199254740993", &d));
+  // Subnormal, overflowing or underflowing results.
+  EXPECT(!ParseFast("4.9e-324", &d));
+  EXPECT(!ParseFast("1.7976931348623159e308", &d));
+  EXPECT(!ParseFast("1e400", &d));
+  EXPECT(!ParseFast("1e-400", &d));
+
+  // The slow path still parses all of them.
+  EXPECT(CStringToDouble("12345678901234567890", 20, &d));
+  EXPECT_EQ(12345678901234567890.0, d);
+  EXPECT(CStringToDouble("9007199254740993", 16, &d));
+  EXPECT_EQ(9007199254740992.0, d);
+  EXPECT(CStringToDouble("4.9e-324", 8, &d));
+  EXPECT_EQ(Bits(4.9e-324), Bits(d));
+  EXPECT(CStringToDouble("1e400", 5, &d));
+  EXPECT(isinf(d));
+  EXPECT(CStringToDouble("-1e-400", 7, &d));
+  EXPECT_EQ(Bits(-0.0), Bits(d));
+}
+
+VM_UNIT_TEST_CASE(DoubleParser_RoundTrip) {
+  Random random(42);
+  char buffer[64];
+  for (intptr_t i = 0; i < 100000; i++) {
+    const double value = bit_cast<double>(random.NextUInt64());
+    if (isnan(value) || isinf(value)) continue;
+    const int precision = 1 + static_cast<int>(random.NextUInt32() % 17);
+    Utils::SNPrint(buffer, sizeof(buffer), "%.*g", precision, value);
+    double fast;
+    if (ParseFast(buffer, &fast)) {
+      EXPECT_EQ(Bits(strtod(buffer, nullptr)), Bits(fast));
+    }
+  }
+}
+
+}  // namespace dart
@@ -122,6 +122,11 @@ constexpr bool FLAG_support_il_printer = false;
   P(idle_duration_micros, int, kMaxInt32,                                      \
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, false, "Use irregexp bytecode interpreter")      \
+  P(isolate_pool_size, int, 0,                                                 \
+    "Number of pre-initialized idle isolates each isolate group keeps ready "  \
+    "for Isolate.spawn (0 disables the pool).")                                \
+  P(isolate_pool_idle_timeout_ms, int, 30 * kMillisecondsPerSecond,            \
+    "Shut down pooled isolates that stayed idle for longer than this.")        \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   R(log_marker_tasks, false, bool, false,                                      \
     "Log debugging information for old gen GC marking tasks.")                 \
@@ -159,6 +164,14 @@ constexpr bool FLAG_support_il_printer = false;
     "Pause isolates on unhandled exceptions.")                                 \
   P(polymorphic_with_deopt, bool, true,                                        \
     "Polymorphic calls with deoptimization / megamorphic call")                \
+  P(port_message_batch_size, int, 0,                                           \
+    "Coalesce up to this many consecutive messages sent to the same port "     \
+    "within an isolate group into one message (0 or 1 disables batching).")    \
+  P(port_message_batch_window_us, int, 1000,                                   \
+    "Start a new batch when a message is added more than this long after "     \
+    "the first message of the pending batch. The window is only checked "      \
+    "when sending; a pending batch is otherwise posted once the sender "       \
+    "finishes handling its current message.")                                  \
   P(precompiled_mode, bool, false, "Precompilation compiler mode")             \
   P(print_snapshot_sizes, bool, false, "Print sizes of generated snapshots.")  \
   P(print_snapshot_sizes_verbose, bool, false,                                 \
@@ -172,6 +185,9 @@ constexpr bool FLAG_support_il_printer = false;
   R(profiler, false, bool, false, "Enable the profiler.")                      \
   R(profiler_native_memory, false, bool, false,                                \
     "Enable native memory statistic collection.")                              \
+  P(regexp_tier_up_executions, int, 10,                                        \
+    "Interpret regexps this many times before compiling them, unless "         \
+    "--interpret-irregexp (0 compiles them right away).")                      \
   P(reorder_basic_blocks, bool, true, "Reorder basic blocks")                  \
   C(stress_async_stacks, false, false, bool, false,                            \
     "Stress test async stack traces")                                          \
@@ -40,6 +40,17 @@ DEFINE_FLAG(uint64_t,
             interpreter_trace_file_max_bytes,
             100 * MB,
             "Maximum size in bytes of the interpreter trace file");
+DEFINE_FLAG(bool,
+            interpreter_quickening,
+            true,
+            "Rewrite executed bytecodes into specialized forms.");
+#if defined(DEBUG)
+DEFINE_FLAG(bool,
+            interpreter_dispatch_profile,
+            false,
+            "Count dispatched bytecodes and pairs of consecutively dispatched "
+            "bytecodes and print them when the interpreter is destroyed.");
+#endif  // defined(DEBUG)
 
 // InterpreterSetjmpBuffer are linked together, and the last created one
 // is referenced by the Interpreter. When an exception is thrown, the exception
@@ -219,6 +230,27 @@ class InterpreterHelpers {
     return Class::ClassFinalizedBits::decode(cls->untag()->state_bits_) ==
            UntaggedClass::kAllocateFinalized;
   }
+
+  // Replaces the opcode of the instruction at [pc], which must keep its
+  // operands and size. Other threads running the same bytecode may execute
+  // either form, so both must be valid at this point.
+  DART_FORCE_INLINE static void RewriteOpcode(const KBCInstr* pc,
+                                              uint32_t opcode) {
+    ASSERT(KernelBytecode::kInstructionSize[KernelBytecode::DecodeOpcode(
+               pc)] == KernelBytecode::kInstructionSize[opcode]);
+    *const_cast<KBCInstr*>(pc) = static_cast<KBCInstr>(opcode);
+  }
+
+  // Returns true if the compare bytecode before [next] can be fused with the
+  // JumpIfFalse at [next].
+  DART_FORCE_INLINE static bool CanFuseCompareWithJump(const KBCInstr* next) {
+    if (!FLAG_interpreter_quickening) {
+      return false;
+    }
+    const KernelBytecode::Opcode opcode = KernelBytecode::DecodeOpcode(next);
+    return (opcode == KernelBytecode::kJumpIfFalse) ||
+           (opcode == KernelBytecode::kJumpIfFalse_Wide);
+  }
 };
 
 DART_FORCE_INLINE static const KBCInstr* SavedCallerPC(ObjectPtr* FP) {
@@ -337,12 +369,39 @@ void LookupCache::Insert(intptr_t receiver_cid,
   entries_[probe1].target = target;
 }
 
+void CallSiteCache::Clear() {
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    entries_[i].site = nullptr;
+  }
+}
+
+void CallSiteCache::Insert(ObjectPtr* site,
+                           intptr_t receiver_cid,
+                           FunctionPtr target) {
+  ASSERT(target->IsOldObject());
+
+  Entry& entry = entries_[IndexOf(site)];
+  if (entry.site != site) {
+    entry.site = site;
+    entry.num_checks = 0;
+  } else if (entry.num_checks == kMegamorphic) {
+    return;
+  } else if (entry.num_checks == kMaxChecks) {
+    entry.num_checks = kMegamorphic;
+    return;
+  }
+  entry.cids[entry.num_checks] = receiver_cid;
+  entry.targets[entry.num_checks] = target;
+  entry.num_checks++;
+}
+
 Interpreter::Interpreter()
     : stack_(nullptr),
       fp_(nullptr),
       pp_(nullptr),
       argdesc_(nullptr),
-      lookup_cache_() {
+      lookup_cache_(),
+      call_site_cache_() {
   // Setup interpreter support first. Some of this information is needed to
   // setup the architecture state.
   // We allocate the stack here, the size is computed as the sum of
@@ -366,6 +425,14 @@ Interpreter::Interpreter()
   DEBUG_ONLY(icount_ = 1);  // So that tracing after 0 traces first bytecode.
 
 #if defined(DEBUG)
+  dispatch_counts_ = nullptr;
+  dispatch_pair_counts_ = nullptr;
+  last_dispatched_op_ = KernelBytecode::kTrap;
+  if (FLAG_interpreter_dispatch_profile) {
+    const intptr_t num_opcodes = KernelBytecode::kNumOpcodes;
+    dispatch_counts_ = new uint64_t[num_opcodes]();
+    dispatch_pair_counts_ = new uint64_t[num_opcodes * num_opcodes]();
+  }
   trace_file_bytes_written_ = 0;
   trace_file_ = nullptr;
   if (FLAG_interpreter_trace_file != nullptr) {
@@ -384,6 +451,11 @@ Interpreter::~Interpreter() {
   pp_ = nullptr;
   argdesc_ = nullptr;
 #if defined(DEBUG)
+  if (dispatch_counts_ != nullptr) {
+    PrintDispatchProfile();
+    delete[] dispatch_counts_;
+    delete[] dispatch_pair_counts_;
+  }
   if (trace_file_ != nullptr) {
     FlushTraceBuffer();
     // Close the file.
@@ -468,6 +540,74 @@ DART_NOINLINE void Interpreter::WriteInstructionToTrace(const KBCInstr* pc) {
   }
 }
 
+DART_FORCE_INLINE void Interpreter::RecordDispatch(uint32_t op) {
+  dispatch_counts_[op]++;
+  dispatch_pair_counts_[last_dispatched_op_ * KernelBytecode::kNumOpcodes +
+                        op]++;
+  last_dispatched_op_ = op;
+}
+
+struct DispatchCount {
+  uint64_t count;
+  intptr_t index;
+};
+
+static int CompareDispatchCounts(const DispatchCount* a,
+                                 const DispatchCount* b) {
+  // Most frequent first.
+  if (a->count != b->count) {
+    return (a->count > b->count) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : 1;
+}
+
+static void SortDispatchCounts(const uint64_t* counts,
+                               intptr_t length,
+                               MallocGrowableArray<DispatchCount>* result) {
+  for (intptr_t i = 0; i < length; i++) {
+    if (counts[i] != 0) {
+      result->Add({counts[i], i});
+    }
+  }
+  result->Sort(CompareDispatchCounts);
+}
+
+void Interpreter::PrintDispatchProfile() const {
+  static const intptr_t kMaxPairs = 50;
+  const intptr_t num_opcodes = KernelBytecode::kNumOpcodes;
+  uint64_t total = 0;
+  for (intptr_t i = 0; i < num_opcodes; i++) {
+    total += dispatch_counts_[i];
+  }
+  if (total == 0) {
+    return;
+  }
+
+  MallocGrowableArray<DispatchCount> ops;
+  SortDispatchCounts(dispatch_counts_, num_opcodes, &ops);
+  OS::PrintErr("Interpreter dispatch profile: %" Pu64 " bytecodes\n", total);
+  for (const auto& entry : ops) {
+    OS::PrintErr("  %12" Pu64 " %5.1f%% %s\n", entry.count,
+                 100.0 * entry.count / total,
+                 KernelBytecode::NameOf(
+                     static_cast<KernelBytecode::Opcode>(entry.index)));
+  }
+
+  MallocGrowableArray<DispatchCount> pairs;
+  SortDispatchCounts(dispatch_pair_counts_, num_opcodes * num_opcodes,
+                     &pairs);
+  OS::PrintErr("Most frequent bytecode pairs:\n");
+  for (intptr_t i = 0; i < Utils::Minimum(pairs.length(), kMaxPairs); i++) {
+    const auto& entry = pairs[i];
+    OS::PrintErr("  %12" Pu64 " %5.1f%% %s %s\n", entry.count,
+                 100.0 * entry.count / total,
+                 KernelBytecode::NameOf(static_cast<KernelBytecode::Opcode>(
+                     entry.index / num_opcodes)),
+                 KernelBytecode::NameOf(static_cast<KernelBytecode::Opcode>(
+                     entry.index % num_opcodes)));
+  }
+}
+
 #endif  // defined(DEBUG)
 
 // Calls into the Dart runtime are based on this interface.
@@ -563,6 +703,23 @@ DART_NOINLINE bool Interpreter::InvokeCompiled(Thread* thread,
                                                ObjectPtr** SP) {
   ASSERT(Function::HasCode(function));
   ASSERT(function->untag()->code() != StubCode::LazyCompile().ptr());
+#if defined(DART_PRECOMPILED_RUNTIME)
+  const uword entry_point = function->untag()->entry_point_;
+#else
+  const uword entry_point = static_cast<uword>(function->untag()->code());
+#endif
+  return InvokeCompiled(thread, function, entry_point, call_base, call_top, pc,
+                        FP, SP);
+}
+
+DART_NOINLINE bool Interpreter::InvokeCompiled(Thread* thread,
+                                               FunctionPtr function,
+                                               uword entry_point,
+                                               ObjectPtr* call_base,
+                                               ObjectPtr* call_top,
+                                               const KBCInstr** pc,
+                                               ObjectPtr** FP,
+                                               ObjectPtr** SP) {
   // TODO(regis): Once we share the same stack, try to invoke directly.
 #if defined(DEBUG)
   if (IsTracingExecution()) {
@@ -587,22 +744,12 @@ DART_NOINLINE bool Interpreter::InvokeCompiled(Thread* thread,
       }
       result = bit_copy<ObjectPtr, int64_t>(Simulator::Current()->Call(
           reinterpret_cast<intptr_t>(entrypoint),
-#if defined(DART_PRECOMPILED_RUNTIME)
-          static_cast<intptr_t>(function->untag()->entry_point_),
-#else
-          static_cast<intptr_t>(function->untag()->code()),
-#endif
-          static_cast<intptr_t>(argdesc_),
+          static_cast<intptr_t>(entry_point), static_cast<intptr_t>(argdesc_),
           reinterpret_cast<intptr_t>(call_base),
           reinterpret_cast<intptr_t>(thread)));
 #else
       result = static_cast<ObjectPtr>(entrypoint(
-#if defined(DART_PRECOMPILED_RUNTIME)
-          function->untag()->entry_point_,
-#else
-          static_cast<uword>(function->untag()->code()),
-#endif
-          static_cast<uword>(argdesc_), call_base, thread));
+          entry_point, static_cast<uword>(argdesc_), call_base, thread));
 #endif
       ASSERT(thread->vm_tag() == VMTag::kDartInterpretedTagId);
       ASSERT(thread->execution_state() == Thread::kThreadInGenerated);
@@ -712,6 +859,7 @@ DART_FORCE_INLINE bool Interpreter::Invoke(Thread* thread,
 }
 
 DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
+                                                 uint32_t kidx,
                                                  StringPtr target_name,
                                                  ObjectPtr* call_base,
                                                  ObjectPtr* top,
@@ -725,7 +873,14 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 
   intptr_t receiver_cid = call_base[receiver_idx]->GetClassId();
 
+  // The pool entry of the selector identifies the call site.
+  ObjectPtr* site = &pp_->untag()->data()[kidx].raw_obj_;
   FunctionPtr target;
+  if (LIKELY(call_site_cache_.Lookup(site, receiver_cid, &target))) {
+    top[0] = target;
+    return Invoke(thread, call_base, top, pc, FP, SP);
+  }
+
   if (UNLIKELY(!lookup_cache_.Lookup(receiver_cid, target_name, argdesc_,
                                      &target))) {
     // Table lookup miss.
@@ -750,6 +905,10 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 
   if (target != Function::null()) {
     lookup_cache_.Insert(receiver_cid, target_name, argdesc_, target);
+    // Reload the site as the miss handler may have triggered a GC which
+    // moved the pool.
+    site = &pp_->untag()->data()[kidx].raw_obj_;
+    call_site_cache_.Insert(site, receiver_cid, target);
     top[0] = target;
     return Invoke(thread, call_base, top, pc, FP, SP);
   }
@@ -806,6 +965,72 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
   return true;
 }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+DART_FORCE_INLINE bool Interpreter::DispatchTableCall(Thread* thread,
+                                                      ArrayPtr target,
+                                                      ObjectPtr* call_base,
+                                                      ObjectPtr* top,
+                                                      const KBCInstr** pc,
+                                                      ObjectPtr** FP,
+                                                      ObjectPtr** SP,
+                                                      bool* handled) {
+  *handled = false;
+  const intptr_t type_args_len =
+      InterpreterHelpers::ArgDescTypeArgsLen(argdesc_);
+  const intptr_t receiver_idx = type_args_len > 0 ? 1 : 0;
+  const intptr_t receiver_cid = call_base[receiver_idx]->GetClassId();
+  const intptr_t num_cids = Smi::Value(Smi::RawCast(
+      target->untag()->element(kDispatchTableTargetNumCids)));
+  // A null receiver is left to the lookup, which throws the appropriate
+  // error, as are receivers of classes loaded from dynamic modules.
+  if ((receiver_cid == kNullCid) || (receiver_cid >= num_cids)) {
+    return false;
+  }
+  IsolateGroup* isolate_group = thread->isolate_group();
+  const intptr_t offset = Smi::Value(
+      Smi::RawCast(target->untag()->element(kDispatchTableTargetOffset)));
+  const uword* table = isolate_group->dispatch_table()->ArrayOrigin() -
+                       DispatchTable::kOriginElement;
+  const uword entry_point = table[offset + receiver_cid];
+  // Implementations which were not compiled have no entry.
+  CodePtr null_error_stub =
+      isolate_group->object_store()->dispatch_table_null_error_stub();
+  if (entry_point == Code::EntryPointOf(null_error_stub)) {
+    return false;
+  }
+  *handled = true;
+  FunctionPtr function = Function::RawCast(
+      target->untag()->element(kDispatchTableTargetFunction));
+  top[0] = function;
+  return InvokeCompiled(thread, function, entry_point, call_base, top, pc, FP,
+                        SP);
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+DART_FORCE_INLINE bool Interpreter::InterfaceCall(Thread* thread,
+                                                  uint32_t kidx,
+                                                  ObjectPtr* call_base,
+                                                  ObjectPtr* top,
+                                                  const KBCInstr** pc,
+                                                  ObjectPtr** FP,
+                                                  ObjectPtr** SP) {
+  ObjectPtr target = pp_->untag()->data()[kidx].raw_obj_;
+#if defined(DART_PRECOMPILED_RUNTIME)
+  if (target->IsArray()) {
+    bool handled;
+    const bool result = DispatchTableCall(thread, Array::RawCast(target),
+                                          call_base, top, pc, FP, SP, &handled);
+    if (handled) {
+      return result;
+    }
+    target = Array::RawCast(target)->untag()->element(
+        kDispatchTableTargetFunction);
+  }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+  return InstanceCall(thread, kidx, Function::RawCast(target)->untag()->name(),
+                      call_base, top, pc, FP, SP);
+}
+
 // Note:
 // All macro helpers are intended to be used only inside Interpreter::Call.
 
@@ -818,6 +1043,9 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
   if (IsWritingTraceFile()) {                                                  \
     WriteInstructionToTrace(pc);                                               \
   }                                                                            \
+  if (dispatch_counts_ != nullptr) {                                           \
+    RecordDispatch(op);                                                        \
+  }                                                                            \
   icount_++;
 #else
 #define TRACE_INSTRUCTION
@@ -1879,11 +2107,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InterfaceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -1901,11 +2126,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InterfaceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -1951,11 +2173,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InterfaceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -1976,8 +2195,8 @@ SwitchDispatch:
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
       StringPtr target_name = String::RawCast(LOAD_CONSTANT(kidx));
       argdesc_ = Array::RawCast(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InstanceCall(thread, kidx, target_name, call_base, call_top, &pc,
+                        &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2213,12 +2432,39 @@ SwitchDispatch:
       }
     } else {
       InterpreterHelpers::SetField(instance, offset_in_words, value, thread);
+      if (FLAG_interpreter_quickening &&
+          (field->untag()->guarded_cid_ == kDynamicCid)) {
+        // The field has no guards left to update.
+        InterpreterHelpers::RewriteOpcode(
+            pc - KernelBytecode::kInstructionSize[op],
+            KernelBytecode::kVMInternal_StoreFieldTOSBoxed +
+                (op - KernelBytecode::kStoreFieldTOS));
+      }
     }
 
     SP -= 2;  // Drop instance and value.
     DISPATCH();
   }
 
+  {
+    BYTECODE(VMInternal_StoreFieldTOSBoxed, D);
+    FieldPtr field = Field::RawCast(LOAD_CONSTANT(rD + 1));
+    if (UNLIKELY(field->untag()->guarded_cid_ != kDynamicCid)) {
+      // The field guards were reset, go back to StoreFieldTOS.
+      pc -= KernelBytecode::kInstructionSize[op];
+      InterpreterHelpers::RewriteOpcode(
+          pc, KernelBytecode::kStoreFieldTOS +
+                  (op - KernelBytecode::kVMInternal_StoreFieldTOSBoxed));
+      DISPATCH();
+    }
+    InstancePtr instance = Instance::RawCast(SP[-1]);
+    const intptr_t offset_in_words =
+        Smi::Value(field->untag()->host_offset_or_field_id());
+    InterpreterHelpers::SetField(instance, offset_in_words, SP[0], thread);
+    SP -= 2;  // Drop instance and value.
+    DISPATCH();
+  }
+
   {
     BYTECODE(StoreContextParent, 0);
     ContextPtr instance = static_cast<ContextPtr>(SP[-1]);
@@ -2746,6 +2992,34 @@ SwitchDispatch:
       int64_t b = Integer::Value(Integer::RawCast(SP[1]));
       SP[0] = (a == b) ? true_value : false_value;
     }
+    if (InterpreterHelpers::CanFuseCompareWithJump(pc)) {
+      InterpreterHelpers::RewriteOpcode(
+          pc - 1, KernelBytecode::kVMInternal_CompareIntEqJumpIfFalse);
+    }
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntEqJumpIfFalse, 0);
+
+    SP -= 2;
+    bool equal;
+    if (SP[1] == SP[2]) {
+      equal = true;
+    } else if (!SP[1]->IsHeapObject() || !SP[2]->IsHeapObject() ||
+               (SP[1] == null_value) || (SP[2] == null_value)) {
+      equal = false;
+    } else {
+      int64_t a = Integer::Value(Integer::RawCast(SP[1]));
+      int64_t b = Integer::Value(Integer::RawCast(SP[2]));
+      equal = (a == b);
+    }
+    // The fused JumpIfFalse follows.
+    if (equal) {
+      pc = KernelBytecode::Next(pc);
+    } else {
+      pc += KernelBytecode::DecodeT(pc);
+    }
     DISPATCH();
   }
 
@@ -2756,6 +3030,26 @@ SwitchDispatch:
     UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
     SP[0] = (a > b) ? true_value : false_value;
+    if (InterpreterHelpers::CanFuseCompareWithJump(pc)) {
+      InterpreterHelpers::RewriteOpcode(
+          pc - 1, KernelBytecode::kVMInternal_CompareIntGtJumpIfFalse);
+    }
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntGtJumpIfFalse, 0);
+
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
+    UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
+    SP -= 1;
+    // The fused JumpIfFalse follows.
+    if (a > b) {
+      pc = KernelBytecode::Next(pc);
+    } else {
+      pc += KernelBytecode::DecodeT(pc);
+    }
     DISPATCH();
   }
 
@@ -2766,6 +3060,26 @@ SwitchDispatch:
     UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
     SP[0] = (a < b) ? true_value : false_value;
+    if (InterpreterHelpers::CanFuseCompareWithJump(pc)) {
+      InterpreterHelpers::RewriteOpcode(
+          pc - 1, KernelBytecode::kVMInternal_CompareIntLtJumpIfFalse);
+    }
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntLtJumpIfFalse, 0);
+
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
+    UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
+    SP -= 1;
+    // The fused JumpIfFalse follows.
+    if (a < b) {
+      pc = KernelBytecode::Next(pc);
+    } else {
+      pc += KernelBytecode::DecodeT(pc);
+    }
     DISPATCH();
   }
 
@@ -2776,6 +3090,26 @@ SwitchDispatch:
     UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
     SP[0] = (a >= b) ? true_value : false_value;
+    if (InterpreterHelpers::CanFuseCompareWithJump(pc)) {
+      InterpreterHelpers::RewriteOpcode(
+          pc - 1, KernelBytecode::kVMInternal_CompareIntGeJumpIfFalse);
+    }
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntGeJumpIfFalse, 0);
+
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
+    UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
+    SP -= 1;
+    // The fused JumpIfFalse follows.
+    if (a >= b) {
+      pc = KernelBytecode::Next(pc);
+    } else {
+      pc += KernelBytecode::DecodeT(pc);
+    }
     DISPATCH();
   }
 
@@ -2786,6 +3120,26 @@ SwitchDispatch:
     UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
     SP[0] = (a <= b) ? true_value : false_value;
+    if (InterpreterHelpers::CanFuseCompareWithJump(pc)) {
+      InterpreterHelpers::RewriteOpcode(
+          pc - 1, KernelBytecode::kVMInternal_CompareIntLeJumpIfFalse);
+    }
+    DISPATCH();
+  }
+
+  {
+    BYTECODE(VMInternal_CompareIntLeJumpIfFalse, 0);
+
+    SP -= 1;
+    UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
+    UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
+    SP -= 1;
+    // The fused JumpIfFalse follows.
+    if (a <= b) {
+      pc = KernelBytecode::Next(pc);
+    } else {
+      pc += KernelBytecode::DecodeT(pc);
+    }
     DISPATCH();
   }
 
@@ -53,12 +53,83 @@ class LookupCache : public ValueObject {
   Entry entries_[kNumEntries];
 };
 
+// Inline caches of the instance calls made by interpreted code.
+//
+// A call site is identified by the address of the object pool entry holding
+// its selector, which also determines the name and arguments descriptor of
+// the call, so only the receiver class id has to be compared on a hit. Each
+// site remembers up to kMaxChecks receiver classes and then becomes
+// megamorphic, leaving further lookups to the LookupCache. Sites are mapped
+// directly to entries by their address and evict each other on collision.
+//
+// Like the LookupCache, the table is cleared before the GC marks and may
+// move objects.
+class CallSiteCache : public ValueObject {
+ public:
+  CallSiteCache() { Clear(); }
+
+  void Clear();
+
+  // Returns true and sets [target] if [site] has seen [receiver_cid].
+  DART_FORCE_INLINE bool Lookup(ObjectPtr* site,
+                                intptr_t receiver_cid,
+                                FunctionPtr* target) const {
+    const Entry& entry = entries_[IndexOf(site)];
+    if (entry.site != site) {
+      return false;
+    }
+    for (intptr_t i = 0; i < entry.num_checks; i++) {
+      if (entry.cids[i] == receiver_cid) {
+        *target = entry.targets[i];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Insert(ObjectPtr* site, intptr_t receiver_cid, FunctionPtr target);
+
+ private:
+  static constexpr intptr_t kNumEntries = 512;
+  static constexpr intptr_t kMaxChecks = 4;
+  static constexpr intptr_t kMegamorphic = -1;
+
+  struct Entry {
+    ObjectPtr* site;
+    // Number of valid checks, or kMegamorphic.
+    intptr_t num_checks;
+    intptr_t cids[kMaxChecks];
+    FunctionPtr targets[kMaxChecks];
+  };
+
+  static intptr_t IndexOf(ObjectPtr* site) {
+    return (reinterpret_cast<uword>(site) / kWordSize) & (kNumEntries - 1);
+  }
+
+  Entry entries_[kNumEntries];
+
+  friend class InterpreterTestHelper;
+};
+
 class Interpreter {
  public:
   static const uword kInterpreterStackUnderflowSize = 0x80;
   // The entry frame pc marker must be non-zero (a valid exception handler pc).
   static const word kEntryFramePcMarker = -1;
 
+  // In the AOT runtime, the object pool entry of an interface call whose
+  // target has a selector in the dispatch table of the AOT program holds a
+  // dispatch table target instead of the interface target. It is an Array
+  // with the following elements. See DispatchTableCall.
+  enum {
+    kDispatchTableTargetFunction,
+    kDispatchTableTargetOffset,
+    // The number of class ids covered by the table. Classes of dynamic
+    // modules get higher class ids.
+    kDispatchTableTargetNumCids,
+    kDispatchTableTargetLength,
+  };
+
   Interpreter();
   ~Interpreter();
 
@@ -106,7 +177,10 @@ class Interpreter {
   void Unexit(Thread* thread);
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
-  void ClearLookupCache() { lookup_cache_.Clear(); }
+  void ClearLookupCache() {
+    lookup_cache_.Clear();
+    call_site_cache_.Clear();
+  }
 
 #ifndef PRODUCT
   void set_is_debugging(bool value) { is_debugging_ = value; }
@@ -131,6 +205,7 @@ class Interpreter {
   ObjectPtr special_[KernelBytecode::kSpecialIndexCount];
 
   LookupCache lookup_cache_;
+  CallSiteCache call_site_cache_;
 
   void Exit(Thread* thread,
             ObjectPtr* base,
@@ -152,6 +227,17 @@ class Interpreter {
                       ObjectPtr** FP,
                       ObjectPtr** SP);
 
+  // Calls [entry_point], which is the code of [function] or, for calls
+  // through the dispatch table, of an implementation of [function].
+  bool InvokeCompiled(Thread* thread,
+                      FunctionPtr function,
+                      uword entry_point,
+                      ObjectPtr* call_base,
+                      ObjectPtr* call_top,
+                      const KBCInstr** pc,
+                      ObjectPtr** FP,
+                      ObjectPtr** SP);
+
   bool InvokeBytecode(Thread* thread,
                       FunctionPtr function,
                       ObjectPtr* call_base,
@@ -161,6 +247,7 @@ class Interpreter {
                       ObjectPtr** SP);
 
   bool InstanceCall(Thread* thread,
+                    uint32_t kidx,
                     StringPtr target_name,
                     ObjectPtr* call_base,
                     ObjectPtr* call_top,
@@ -168,6 +255,29 @@ class Interpreter {
                     ObjectPtr** FP,
                     ObjectPtr** SP);
 
+  // Makes the interface call whose target is at [kidx] in the object pool.
+  bool InterfaceCall(Thread* thread,
+                     uint32_t kidx,
+                     ObjectPtr* call_base,
+                     ObjectPtr* call_top,
+                     const KBCInstr** pc,
+                     ObjectPtr** FP,
+                     ObjectPtr** SP);
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // Calls the implementation of a dispatch table target for the receiver
+  // through the dispatch table of the AOT program. Sets [handled] to false
+  // without calling anything if the receiver's class is not in the table.
+  bool DispatchTableCall(Thread* thread,
+                         ArrayPtr target,
+                         ObjectPtr* call_base,
+                         ObjectPtr* call_top,
+                         const KBCInstr** pc,
+                         ObjectPtr** FP,
+                         ObjectPtr** SP,
+                         bool* handled);
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
   bool CopyParameters(Thread* thread,
                       const KBCInstr** pc,
                       ObjectPtr** FP,
@@ -247,6 +357,15 @@ class Interpreter {
       kTraceBufferSizeInBytes / sizeof(KBCInstr);
   KBCInstr* trace_buffer_;
   intptr_t trace_buffer_idx_;
+
+  void RecordDispatch(uint32_t op);
+  void PrintDispatchProfile() const;
+
+  // Counts of dispatched bytecodes and of pairs of consecutively dispatched
+  // bytecodes, if --interpreter-dispatch-profile is given.
+  uint64_t* dispatch_counts_;
+  uint64_t* dispatch_pair_counts_;
+  uint32_t last_dispatched_op_;
 #endif  // defined(DEBUG)
 
   // Longjmp support for exceptions.
@@ -0,0 +1,261 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(DART_DYNAMIC_MODULES)
+
+#include "vm/interpreter.h"
+
+#include "vm/bytecode_reader.h"
+#include "vm/dart_entry.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, interpreter_quickening);
+
+class InterpreterTestHelper : public AllStatic {
+ public:
+  static constexpr intptr_t kCallSiteCacheEntries = CallSiteCache::kNumEntries;
+  static constexpr intptr_t kCallSiteCacheChecks = CallSiteCache::kMaxChecks;
+};
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_CallSiteCache) {
+  const intptr_t kNumEntries = InterpreterTestHelper::kCallSiteCacheEntries;
+  const intptr_t kMaxChecks = InterpreterTestHelper::kCallSiteCacheChecks;
+
+  // Any old space functions will do as targets.
+  const auto& object_class =
+      Class::Handle(IsolateGroup::Current()->object_store()->object_class());
+  const auto& functions = Array::Handle(object_class.current_functions());
+  EXPECT(functions.Length() > kMaxChecks);
+  auto& target = Function::Handle();
+
+  // Sites which are kNumEntries words apart map to the same entry.
+  ObjectPtr sites[kNumEntries + 1];
+  ObjectPtr* site = &sites[0];
+  ObjectPtr* colliding_site = &sites[kNumEntries];
+
+  CallSiteCache cache;
+  FunctionPtr result = Function::null();
+  EXPECT(!cache.Lookup(site, kSmiCid, &result));
+
+  for (intptr_t i = 0; i < kMaxChecks; i++) {
+    target ^= functions.At(i);
+    cache.Insert(site, kSmiCid + i, target.ptr());
+  }
+  for (intptr_t i = 0; i < kMaxChecks; i++) {
+    target ^= functions.At(i);
+    EXPECT(cache.Lookup(site, kSmiCid + i, &result));
+    EXPECT(result == target.ptr());
+  }
+  EXPECT(!cache.Lookup(site, kSmiCid + kMaxChecks, &result));
+  EXPECT(!cache.Lookup(&sites[1], kSmiCid, &result));
+
+  // One receiver class too many makes the site megamorphic.
+  target ^= functions.At(kMaxChecks);
+  cache.Insert(site, kSmiCid + kMaxChecks, target.ptr());
+  EXPECT(!cache.Lookup(site, kSmiCid, &result));
+  EXPECT(!cache.Lookup(site, kSmiCid + kMaxChecks, &result));
+  cache.Insert(site, kSmiCid, target.ptr());
+  EXPECT(!cache.Lookup(site, kSmiCid, &result));
+
+  // A colliding site evicts the megamorphic one and starts over.
+  target ^= functions.At(0);
+  cache.Insert(colliding_site, kSmiCid, target.ptr());
+  EXPECT(cache.Lookup(colliding_site, kSmiCid, &result));
+  EXPECT(result == target.ptr());
+  EXPECT(!cache.Lookup(site, kSmiCid, &result));
+  cache.Insert(site, kMintCid, target.ptr());
+  EXPECT(cache.Lookup(site, kMintCid, &result));
+  EXPECT(!cache.Lookup(colliding_site, kSmiCid, &result));
+
+  cache.Clear();
+  EXPECT(!cache.Lookup(site, kMintCid, &result));
+}
+
+// Returns a static function running the given [instructions] in place.
+static FunctionPtr CreateBytecodeFunction(Thread* thread,
+                                          KBCInstr* instructions,
+                                          intptr_t size) {
+  Zone* zone = thread->zone();
+  const auto& owner_name = String::Handle(zone, Symbols::New(thread, "Owner"));
+  const auto& owner = Class::Handle(
+      zone, Class::New(Library::Handle(zone), owner_name, Script::Handle(zone),
+                       TokenPosition::kNoSource));
+  const auto& name =
+      String::Handle(zone, Symbols::New(thread, "bytecodeFunction"));
+  const auto& signature = FunctionType::Handle(zone, FunctionType::New());
+  const auto& function = Function::Handle(
+      zone, Function::New(signature, name,
+                          UntaggedFunction::kRegularFunction,
+                          /*is_static=*/true, /*is_const=*/false,
+                          /*is_abstract=*/false, /*is_external=*/false,
+                          /*is_native=*/false, owner,
+                          TokenPosition::kNoSource));
+  const auto& binary = ExternalTypedData::Handle(
+      zone, ExternalTypedData::New(kExternalTypedDataUint8ArrayCid,
+                                   instructions, size, Heap::kOld));
+  const auto& bytecode = Bytecode::Handle(
+      zone, Bytecode::New(reinterpret_cast<uword>(instructions), size,
+                          /*instructions_offset=*/0, binary,
+                          Object::empty_object_pool()));
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  function.AttachBytecode(bytecode);
+  return function.ptr();
+}
+
+static intptr_t InvokeWithSmis(const Function& function, intptr_t a,
+                               intptr_t b) {
+  const auto& args = Array::Handle(Array::New(2));
+  args.SetAt(0, Smi::Handle(Smi::New(a)));
+  args.SetAt(1, Smi::Handle(Smi::New(b)));
+  const auto& result =
+      Object::Handle(DartEntry::InvokeFunction(function, args));
+  EXPECT(result.IsSmi());
+  return result.IsSmi() ? Smi::Cast(result).Value() : -1;
+}
+
+// Bytecode of (a, b) => (a < b) ? 1 : 2.
+static constexpr intptr_t kCompareOffset = 6;
+#define LESS_THAN_BYTECODE                                                     \
+  {                                                                            \
+    KernelBytecode::kEntry, 0,                                                 \
+    KernelBytecode::kPush, static_cast<KBCInstr>(-6),                          \
+    KernelBytecode::kPush, static_cast<KBCInstr>(-5),                          \
+    KernelBytecode::kCompareIntLt,                                             \
+    KernelBytecode::kJumpIfFalse, 5,                                           \
+    KernelBytecode::kPushInt, 1,                                               \
+    KernelBytecode::kReturnTOS,                                                \
+    KernelBytecode::kPushInt, 2,                                               \
+    KernelBytecode::kReturnTOS,                                                \
+  }
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_FuseCompareWithJump) {
+  SetFlagScope<bool> sfs(&FLAG_interpreter_quickening, true);
+  KBCInstr instructions[] = LESS_THAN_BYTECODE;
+  const auto& function = Function::Handle(CreateBytecodeFunction(
+      thread, instructions, ARRAY_SIZE(instructions)));
+
+  // The first execution rewrites the compare into the fused form, which
+  // takes both branches like the original bytecodes.
+  EXPECT_EQ(1, InvokeWithSmis(function, 1, 2));
+  EXPECT_EQ(KernelBytecode::kVMInternal_CompareIntLtJumpIfFalse,
+            instructions[kCompareOffset]);
+  EXPECT_EQ(1, InvokeWithSmis(function, 1, 2));
+  EXPECT_EQ(2, InvokeWithSmis(function, 2, 1));
+  EXPECT_EQ(2, InvokeWithSmis(function, 2, 2));
+  EXPECT_EQ(1, InvokeWithSmis(function, -3, kSmiMax));
+
+  // The fused form keeps the size of the compare, so the JumpIfFalse is left
+  // in place.
+  EXPECT_EQ(
+      KernelBytecode::kInstructionSize[KernelBytecode::kCompareIntLt],
+      KernelBytecode::kInstructionSize
+          [KernelBytecode::kVMInternal_CompareIntLtJumpIfFalse]);
+  EXPECT_EQ(KernelBytecode::kJumpIfFalse, instructions[kCompareOffset + 1]);
+  EXPECT(KernelBytecode::IsDebugCheckedOpcode(&instructions[kCompareOffset]));
+}
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_NoQuickening) {
+  SetFlagScope<bool> sfs(&FLAG_interpreter_quickening, false);
+  KBCInstr instructions[] = LESS_THAN_BYTECODE;
+  const auto& function = Function::Handle(CreateBytecodeFunction(
+      thread, instructions, ARRAY_SIZE(instructions)));
+
+  EXPECT_EQ(1, InvokeWithSmis(function, 1, 2));
+  EXPECT_EQ(2, InvokeWithSmis(function, 2, 1));
+  EXPECT_EQ(KernelBytecode::kCompareIntLt, instructions[kCompareOffset]);
+}
+
+#undef LESS_THAN_BYTECODE
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_QuickenedBytecodes) {
+  // Quickened bytecodes keep the operands and size of the original ones.
+  EXPECT_EQ(KernelBytecode::kInstructionSize[KernelBytecode::kStoreFieldTOS],
+            KernelBytecode::kInstructionSize
+                [KernelBytecode::kVMInternal_StoreFieldTOSBoxed]);
+  EXPECT_EQ(
+      KernelBytecode::kInstructionSize[KernelBytecode::kStoreFieldTOS_Wide],
+      KernelBytecode::kInstructionSize
+          [KernelBytecode::kVMInternal_StoreFieldTOSBoxed_Wide]);
+  // The wide variant is rewritten by offset from the narrow one.
+  EXPECT_EQ(0, KernelBytecode::kVMInternal_StoreFieldTOSBoxed % 2);
+  EXPECT_EQ(
+      KernelBytecode::kStoreFieldTOS_Wide - KernelBytecode::kStoreFieldTOS,
+      KernelBytecode::kVMInternal_StoreFieldTOSBoxed_Wide -
+          KernelBytecode::kVMInternal_StoreFieldTOSBoxed);
+}
+
+static ObjectPtr LookupDispatchTableTarget(Thread* thread,
+                                           const Function& target) {
+  return bytecode::BytecodeReaderHelper::LookupDispatchTableTarget(thread,
+                                                                   target);
+}
+
+// Interface calls from bytecode to functions listed in the dispatch table
+// selectors of the AOT program get dispatch table targets.
+ISOLATE_UNIT_TEST_CASE(Interpreter_DispatchTableTargets) {
+  ObjectStore* object_store = thread->isolate_group()->object_store();
+  const auto& saved_selectors =
+      Array::Handle(object_store->dispatch_table_interface_selectors());
+  const auto& saved_map =
+      Array::Handle(object_store->dispatch_table_interface_selector_map());
+
+  const auto& object_class = Class::Handle(object_store->object_class());
+  const auto& functions = Array::Handle(object_class.current_functions());
+  EXPECT(functions.Length() >= 3);
+  const auto& first = Function::Handle(Function::RawCast(functions.At(0)));
+  const auto& second = Function::Handle(Function::RawCast(functions.At(1)));
+  const auto& unlisted = Function::Handle(Function::RawCast(functions.At(2)));
+
+  // The number of class ids, then pairs of function and selector offset.
+  const intptr_t kNumCids = 100;
+  const auto& selectors = Array::Handle(Array::New(5));
+  selectors.SetAt(0, Smi::Handle(Smi::New(kNumCids)));
+  selectors.SetAt(1, first);
+  selectors.SetAt(2, Smi::Handle(Smi::New(7)));
+  selectors.SetAt(3, second);
+  selectors.SetAt(4, Smi::Handle(Smi::New(42)));
+  object_store->set_dispatch_table_interface_selectors(selectors);
+  object_store->set_dispatch_table_interface_selector_map(Object::null_array());
+
+  auto& entry = Object::Handle(LookupDispatchTableTarget(thread, second));
+  EXPECT(entry.IsArray());
+  EXPECT_EQ(Interpreter::kDispatchTableTargetLength,
+            Array::Cast(entry).Length());
+  EXPECT(Array::Cast(entry).At(Interpreter::kDispatchTableTargetFunction) ==
+         second.ptr());
+  EXPECT(Array::Cast(entry).At(Interpreter::kDispatchTableTargetOffset) ==
+         Smi::New(42));
+  EXPECT(Array::Cast(entry).At(Interpreter::kDispatchTableTargetNumCids) ==
+         Smi::New(kNumCids));
+  // The map is built once and kept.
+  EXPECT(object_store->dispatch_table_interface_selector_map() !=
+         Array::null());
+
+  entry = LookupDispatchTableTarget(thread, first);
+  EXPECT(entry.IsArray());
+  EXPECT(Array::Cast(entry).At(Interpreter::kDispatchTableTargetOffset) ==
+         Smi::New(7));
+
+  entry = LookupDispatchTableTarget(thread, unlisted);
+  EXPECT(entry.IsNull());
+
+  // Without selectors there are no dispatch table targets.
+  object_store->set_dispatch_table_interface_selectors(Object::null_array());
+  object_store->set_dispatch_table_interface_selector_map(Object::null_array());
+  entry = LookupDispatchTableTarget(thread, second);
+  EXPECT(entry.IsNull());
+
+  object_store->set_dispatch_table_interface_selectors(saved_selectors);
+  object_store->set_dispatch_table_interface_selector_map(saved_map);
+}
+
+}  // namespace dart
+
+#endif  // defined(DART_DYNAMIC_MODULES)
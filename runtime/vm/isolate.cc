@@ -29,6 +29,7 @@
 #include "vm/heap/safepoint.h"
 #include "vm/heap/verifier.h"
 #include "vm/image_snapshot.h"
+#include "vm/isolate_pool.h"
 #include "vm/isolate_reload.h"
 #include "vm/kernel_isolate.h"
 #include "vm/lockers.h"
@@ -36,11 +37,13 @@
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object.h"
+#include "vm/object_graph_copy.h"
 #include "vm/object_id_ring.h"
 #include "vm/object_store.h"
 #include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_export.h"
 #include "vm/reusable_handles.h"
 #include "vm/reverse_pc_lookup_cache.h"
 #include "vm/service.h"
@@ -58,7 +61,9 @@
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
+#include "vm/compiler/jit/jit_warmup_cache.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
 
@@ -357,6 +362,8 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       shared_field_table_(new FieldTable(/*isolate=*/nullptr, this)),
 #if !defined(DART_PRECOMPILED_RUNTIME)
       background_compiler_(new BackgroundCompiler(this)),
+      jit_warmup_cache_(JitWarmupCache::New(this)),
+      aot_profile_writer_(AotProfileWriter::New(this)),
 #endif
       symbols_mutex_(),
       type_canonicalization_mutex_(),
@@ -385,6 +392,9 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
         new MutatorThreadPool(this, FLAG_disable_thread_pool_limit
                                         ? 0
                                         : Scavenger::MaxMutatorThreadCount()));
+    if (FLAG_isolate_pool_size > 0 && !is_system_isolate_group_) {
+      isolate_pool_.reset(new IsolatePool(this));
+    }
   }
   {
     WriteRwLocker wl(ThreadState::Current(), isolate_groups_rwlock_);
@@ -451,7 +461,17 @@ bool IsolateGroup::ContainsOnlyOneIsolate() {
   // We do allow 0 here as well, because the background compiler might call
   // this method while the mutator thread is in shutdown procedure and
   // unregistered itself already.
-  return isolate_count_ == 0 || isolate_count_ == 1;
+  const intptr_t live_isolates = isolate_count_ - pooled_isolate_count_;
+  return live_isolates == 0 || live_isolates == 1;
+}
+
+void IsolateGroup::SetIsolatePooled(Isolate* isolate, bool pooled) {
+  ASSERT(isolate == Isolate::Current());
+  SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
+  if (isolate->UpdateIsolateFlagsBit<Isolate::IsPooledBit>(pooled) != pooled) {
+    pooled_isolate_count_ += pooled ? 1 : -1;
+  }
+  ASSERT(pooled_isolate_count_ >= 0 && pooled_isolate_count_ <= isolate_count_);
 }
 
 void IsolateGroup::RunWithLockedGroup(std::function<void()> fun) {
@@ -464,9 +484,16 @@ void IsolateGroup::UnregisterIsolate(Isolate* isolate) {
   isolates_.Remove(isolate);
 }
 
-bool IsolateGroup::UnregisterIsolateDecrementCount() {
+bool IsolateGroup::UnregisterIsolateDecrementCount(
+    MallocGrowableArray<Isolate*>* released_pooled_isolates) {
   SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
   isolate_count_--;
+  if (isolate_pool_ != nullptr) {
+    // Must happen under the lock: once the count reflects only pooled
+    // isolates no other thread is guaranteed to keep the group alive.
+    isolate_pool_->ReleaseIfOnlyPooledIsolatesRemain(isolate_count_,
+                                                     released_pooled_isolates);
+  }
   return isolate_count_ == 0;
 }
 
@@ -651,6 +678,7 @@ void IsolateGroup::PrintToJSONObject(JSONObject* jsobj, bool ref) {
     JSONArray isolate_array(jsobj, "isolates");
     for (auto it = isolates_.Begin(); it != isolates_.End(); ++it) {
       Isolate* isolate = *it;
+      if (isolate->is_pooled()) continue;
       isolate_array.AddValue(isolate, /*ref=*/true);
     }
   }
@@ -1447,6 +1475,20 @@ MessageHandler::MessageStatus IsolateMessageHandler::HandleMessage(
         }
       }
     }
+  } else if (message->IsPersistentHandleBatch()) {
+    // Deliver coalesced messages as individual events in a single pass. If
+    // one of them terminates the isolate the rest is dropped.
+    const Array& batch = Array::Handle(zone, Array::RawCast(msg.ptr()));
+    Instance& element = Instance::Handle(zone);
+    Object& msg_handler = Object::Handle(zone);
+    for (intptr_t i = 0; i < batch.Length() && status == kOK; i++) {
+      element ^= batch.At(i);
+      msg_handler =
+          DartLibraryCalls::HandleMessage(message->dest_port(), element);
+      if (msg_handler.IsError()) {
+        status = ProcessUnhandledException(Error::Cast(msg_handler));
+      }
+    }
   } else {
     const Object& msg_handler = Object::Handle(
         zone, DartLibraryCalls::HandleMessage(message->dest_port(), msg));
@@ -1459,6 +1501,9 @@ MessageHandler::MessageStatus IsolateMessageHandler::HandleMessage(
       // The handler closure which was used to successfully handle the message.
     }
   }
+  // Messages coalesced while handling this message must not wait for the
+  // next one.
+  I->FlushMessageBatch();
   return status;
 }
 
@@ -1753,6 +1798,7 @@ Isolate::Isolate(IsolateGroup* isolate_group,
       mutex_(),
       tag_table_(GrowableObjectArray::null()),
       sticky_error_(Error::null()),
+      message_batch_(GrowableObjectArray::null()),
       spawn_count_monitor_(),
       handler_info_cache_(),
       catch_entry_moves_cache_(),
@@ -1778,6 +1824,8 @@ Isolate::~Isolate() {
 #if !defined(PRODUCT)
   delete debugger_;
   debugger_ = nullptr;
+  delete profile_exporter_;
+  profile_exporter_ = nullptr;
   if (service_id_zones_ != nullptr) {
     for (intptr_t i = 0; i < service_id_zones_->length(); ++i) {
       delete service_id_zones_->At(i);
@@ -1995,6 +2043,60 @@ void Isolate::set_origin_id(Dart_Port id) {
   origin_id_ = id;
 }
 
+void Isolate::AddToMessageBatch(Dart_Port dest_port, const Object& obj) {
+  ASSERT(FLAG_port_message_batch_size > 1);
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+
+  // Copy eagerly, the sender may mutate [obj] before the batch is posted.
+  const auto& copy = Object::Handle(zone, CopyMutableObjectGraph(obj));
+
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  if (message_batch_port_ != dest_port ||
+      now - message_batch_start_micros_ > FLAG_port_message_batch_window_us) {
+    FlushMessageBatch();
+  }
+  auto& batch = GrowableObjectArray::Handle(zone, message_batch_);
+  if (batch.IsNull()) {
+    batch = GrowableObjectArray::New(FLAG_port_message_batch_size);
+    message_batch_ = batch.ptr();
+  }
+  if (batch.Length() == 0) {
+    message_batch_port_ = dest_port;
+    message_batch_start_micros_ = now;
+  }
+  batch.Add(copy);
+  if (batch.Length() >= FLAG_port_message_batch_size) {
+    FlushMessageBatch();
+  }
+}
+
+void Isolate::FlushMessageBatch() {
+  if (message_batch_port_ == ILLEGAL_PORT) {
+    return;
+  }
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const auto& batch = GrowableObjectArray::Handle(zone, message_batch_);
+  const Dart_Port dest_port = message_batch_port_;
+  message_batch_port_ = ILLEGAL_PORT;
+  ASSERT(batch.Length() > 0);
+
+  auto handle = group()->api_state()->AllocatePersistentHandle();
+  if (batch.Length() == 1) {
+    handle->set_ptr(batch.At(0));
+    batch.SetLength(0);
+    PortMap::PostMessage(
+        Message::New(dest_port, handle, Message::kNormalPriority));
+    return;
+  }
+  // Hands the backing store over to the message and leaves [batch] empty for
+  // reuse.
+  handle->set_ptr(Array::MakeFixedLength(batch));
+  PortMap::PostMessage(Message::New(dest_port, handle, Message::kNormalPriority,
+                                    /*is_batch=*/true));
+}
+
 void Isolate::set_finalizers(const GrowableObjectArray& value) {
   finalizers_ = value.ptr();
 }
@@ -2578,6 +2680,19 @@ void Isolate::Shutdown() {
   }
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (is_runnable() && !Isolate::IsSystemIsolate(this)) {
+    StackZone zone(thread);
+    HandleScope handle_scope(thread);
+    if (group()->aot_profile_writer() != nullptr) {
+      group()->aot_profile_writer()->Write(thread);
+    }
+    if (group()->jit_warmup_cache() != nullptr) {
+      group()->jit_warmup_cache()->Write(thread);
+    }
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   // Then, proceed with low-level teardown.
   Isolate::UnMarkIsolateReady(this);
 
@@ -2586,6 +2701,13 @@ void Isolate::Shutdown() {
   // run any Dart code anymore _and_ will not run any native finalizers anymore.
   RunAndCleanupFinalizersOnShutdown();
 
+  // Post coalesced messages before the bequest and the onExit message.
+  {
+    StackZone zone(thread);
+    HandleScope handle_scope(thread);
+    FlushMessageBatch();
+  }
+
   // Post message before LowLevelShutdown that sends onExit message.
   // This ensures that exit message comes last.
   if (bequest_ != nullptr) {
@@ -2639,7 +2761,9 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
     }
   }
 
-  const bool shutdown_group = isolate_group->UnregisterIsolateDecrementCount();
+  MallocGrowableArray<Isolate*> released_pooled_isolates;
+  const bool shutdown_group = isolate_group->UnregisterIsolateDecrementCount(
+      &released_pooled_isolates);
   if (shutdown_group) {
     KernelIsolate::NotifyAboutIsolateGroupShutdown(isolate_group);
 
@@ -2683,6 +2807,10 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
       }
       Dart::thread_pool()->Run<ShutdownGroupTask>(isolate_group);
     }
+  } else if (!released_pooled_isolates.is_empty()) {
+    // Only idle pooled isolates are left. Shutting down the last of them will
+    // shut down the group, so [isolate_group] must not be used afterwards.
+    IsolatePool::ShutdownIsolates(released_pooled_isolates);
   } else {
     // TODO(dartbug.com/36097): An isolate just died. A significant amount of
     // memory might have become unreachable. We should evaluate how to best
@@ -2730,6 +2858,7 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   visitor->VisitPointer(reinterpret_cast<ObjectPtr*>(&tag_table_));
   visitor->VisitPointer(reinterpret_cast<ObjectPtr*>(&sticky_error_));
   visitor->VisitPointer(reinterpret_cast<ObjectPtr*>(&finalizers_));
+  visitor->VisitPointer(reinterpret_cast<ObjectPtr*>(&message_batch_));
 #if !defined(PRODUCT)
   visitor->VisitPointer(
       reinterpret_cast<ObjectPtr*>(&pending_service_extension_calls_));
@@ -42,6 +42,7 @@
 namespace dart {
 
 // Forward declarations.
+class AotProfileWriter;
 class ApiState;
 class BackgroundCompiler;
 class Become;
@@ -57,8 +58,10 @@ class Heap;
 class ICData;
 class IsolateGroupReloadContext;
 class IsolateMessageHandler;
+class IsolatePool;
 class IsolateObjectStore;
 class IsolateProfilerData;
+class JitWarmupCache;
 class Log;
 class Message;
 class MessageHandler;
@@ -69,6 +72,7 @@ class ObjectIdRing;
 class ObjectPointerVisitor;
 class ObjectStore;
 class PersistentHandle;
+class ProfileExporter;
 class ProgramReloadContext;
 class RwLock;
 class SafepointHandler;
@@ -304,6 +308,11 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 #endif
   }
 #if !defined(DART_PRECOMPILED_RUNTIME)
+  JitWarmupCache* jit_warmup_cache() const { return jit_warmup_cache_.get(); }
+  AotProfileWriter* aot_profile_writer() const {
+    return aot_profile_writer_.get();
+  }
+
   intptr_t optimization_counter_threshold() const {
     if (IsSystemIsolateGroup(this)) {
       return kDefaultOptimizationCounterThreshold;
@@ -323,10 +332,19 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   void UnregisterIsolate(Isolate* isolate);
   // Returns `true` if this was the last isolate and the caller is responsible
   // for deleting the isolate group.
-  bool UnregisterIsolateDecrementCount();
+  // Returns true if this was the last isolate of the group. Pooled isolates
+  // that are left as the only members of the group are moved into
+  // [released_pooled_isolates] and have to be shut down by the caller.
+  bool UnregisterIsolateDecrementCount(
+      MallocGrowableArray<Isolate*>* released_pooled_isolates);
 
+  // Idle pooled isolates are not counted.
   bool ContainsOnlyOneIsolate();
 
+  // Marks [isolate], which must be entered on the current thread, as parked
+  // in or taken out of the group's [IsolatePool].
+  void SetIsolatePooled(Isolate* isolate, bool pooled);
+
   void RunWithLockedGroup(std::function<void()> fun);
 
   void ScheduleInterrupts(uword interrupt_bits);
@@ -769,6 +787,10 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   MutatorThreadPool* thread_pool() { return thread_pool_.get(); }
 
+  // The pool of pre-initialized isolates, or nullptr if --isolate-pool-size
+  // is 0 or this is a system isolate group.
+  IsolatePool* isolate_pool() const { return isolate_pool_.get(); }
+
   void RegisterClass(const Class& cls);
   void RegisterSharedStaticField(const Field& field,
                                  const Object& initial_value);
@@ -837,6 +859,9 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   std::unique_ptr<SafepointRwLock> isolates_lock_;
   IntrusiveDList<Isolate> isolates_;
   intptr_t isolate_count_ = 0;
+  // Number of registered isolates that are idle in [isolate_pool_].
+  intptr_t pooled_isolate_count_ = 0;
+  std::unique_ptr<IsolatePool> isolate_pool_;
   bool initial_spawn_successful_ = false;
   Dart_LibraryTagHandler library_tag_handler_ = nullptr;
   Dart_DeferredLoadHandler deferred_load_handler_ = nullptr;
@@ -891,6 +916,8 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   uint32_t isolate_group_flags_ = 0;
 
   NOT_IN_PRECOMPILED(std::unique_ptr<BackgroundCompiler> background_compiler_);
+  NOT_IN_PRECOMPILED(std::unique_ptr<JitWarmupCache> jit_warmup_cache_);
+  NOT_IN_PRECOMPILED(std::unique_ptr<AotProfileWriter> aot_profile_writer_);
 
   Mutex symbols_mutex_;
   Mutex type_canonicalization_mutex_;
@@ -1034,6 +1061,17 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
     bequest_ = std::move(bequest);
   }
 
+  // Coalesces a same-group message to [dest_port] with the pending batch (see
+  // --port-message-batch-size). The message object graph is copied right
+  // away, the batch is posted by [FlushMessageBatch].
+  void AddToMessageBatch(Dart_Port dest_port, const Object& obj);
+  // Posts the pending batch, if any. Has to be called before sending any
+  // message that is not coalesced to preserve message ordering.
+  void FlushMessageBatch();
+  bool has_message_batch() const {
+    return message_batch_port_ != ILLEGAL_PORT;
+  }
+
   IsolateGroupSource* source() const { return isolate_group_->source(); }
   IsolateGroup* group() const { return isolate_group_; }
 
@@ -1123,6 +1161,12 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
     current_allocation_sample_block_ = block;
   }
 
+  // State of the continuous CPU profile export, see ProfileExporter.
+  ProfileExporter* profile_exporter() const { return profile_exporter_; }
+  void set_profile_exporter(ProfileExporter* exporter) {
+    profile_exporter_ = exporter;
+  }
+
   bool TakeHasCompletedBlocks() {
     return has_completed_blocks_.exchange(0) != 0;
   }
@@ -1393,6 +1437,10 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
     UpdateIsolateFlagsBit<IsServiceRegisteredBit>(value);
   }
 
+  // Whether this isolate is parked in its group's [IsolatePool]. Only
+  // changed via [IsolateGroup::SetIsolatePooled].
+  bool is_pooled() const { return LoadIsolateFlagsBit<IsPooledBit>(); }
+
   // Isolate-specific flag handling.
   static void FlagsInitialize(Dart_IsolateFlags* api_flags);
   void FlagsCopyTo(Dart_IsolateFlags* api_flags) const;
@@ -1580,7 +1628,8 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   V(HasAttemptedStepping)                                                      \
   V(ShouldPausePostServiceRequest)                                             \
   V(IsSystemIsolate)                                                           \
-  V(IsServiceRegistered)
+  V(IsServiceRegistered)                                                       \
+  V(IsPooled)
 
   // Isolate specific flags.
   enum FlagBits {
@@ -1620,6 +1669,8 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
 
   RelaxedAtomic<uword> has_completed_blocks_ = {0};
 
+  ProfileExporter* profile_exporter_ = nullptr;
+
   int64_t last_resume_timestamp_;
 
   VMTagCounters vm_tag_counters_;
@@ -1683,6 +1734,11 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
 
   ErrorPtr sticky_error_;
 
+  // Copied message graphs waiting to be posted to [message_batch_port_].
+  GrowableObjectArrayPtr message_batch_;
+  Dart_Port message_batch_port_ = ILLEGAL_PORT;
+  int64_t message_batch_start_micros_ = 0;
+
   std::unique_ptr<Bequest> bequest_;
   Dart_Port beneficiary_ = 0;
 
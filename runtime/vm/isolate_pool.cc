@@ -0,0 +1,142 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/isolate_pool.h"
+
+#include "include/dart_api.h"
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/os.h"
+
+namespace dart {
+
+static const char* const kPooledIsolateName = "pooled-isolate";
+
+IsolatePool::IsolatePool(IsolateGroup* isolate_group)
+    : isolate_group_(isolate_group) {}
+
+IsolatePool::~IsolatePool() {
+  // The group cannot shut down before all pooled isolates were released.
+  ASSERT(idle_isolates_.is_empty());
+  ASSERT(pending_ == 0);
+}
+
+Isolate* IsolatePool::TryTake(const char* name) {
+  ASSERT(Isolate::Current() == nullptr);
+
+  MallocGrowableArray<Isolate*> expired;
+  Isolate* isolate = nullptr;
+  {
+    MutexLocker ml(&mutex_);
+    const int64_t expiry_micros =
+        OS::GetCurrentMonotonicMicros() -
+        FLAG_isolate_pool_idle_timeout_ms * kMicrosecondsPerMillisecond;
+    // Isolates are appended when parked, so the oldest ones come first.
+    while (!idle_isolates_.is_empty() &&
+           idle_isolates_[0].idle_since_micros < expiry_micros) {
+      expired.Add(idle_isolates_[0].isolate);
+      idle_isolates_.EraseAt(0);
+    }
+    if (!idle_isolates_.is_empty()) {
+      isolate = idle_isolates_.RemoveLast().isolate;
+    }
+  }
+
+  ShutdownIsolates(expired);
+
+  if (isolate != nullptr) {
+    Dart_EnterIsolate(Api::CastIsolate(isolate));
+    isolate_group_->SetIsolatePooled(isolate, false);
+    isolate->set_name(name);
+    if (FLAG_trace_isolates) {
+      OS::PrintErr("[+] Taking isolate from pool: %s\n", name);
+    }
+  }
+  return isolate;
+}
+
+void IsolatePool::Refill() {
+  ASSERT(Isolate::Current() == nullptr);
+
+  while (true) {
+    {
+      MutexLocker ml(&mutex_);
+      if (released_ ||
+          idle_isolates_.length() + pending_ >= FLAG_isolate_pool_size) {
+        return;
+      }
+      pending_++;
+    }
+
+    Isolate* isolate = CreateIdleIsolate();
+
+    MutexLocker ml(&mutex_);
+    pending_--;
+    if (isolate == nullptr) {
+      return;
+    }
+    // The spawner keeps the group alive, so the pool cannot have been
+    // released while this isolate was being created.
+    ASSERT(!released_);
+    idle_isolates_.Add({isolate, OS::GetCurrentMonotonicMicros()});
+  }
+}
+
+Isolate* IsolatePool::CreateIdleIsolate() {
+  auto initialize_callback = Isolate::InitializeCallback();
+  if (initialize_callback == nullptr) {
+    return nullptr;
+  }
+
+  char* error = nullptr;
+  Isolate* isolate = CreateWithinExistingIsolateGroup(
+      isolate_group_, kPooledIsolateName, &error);
+  if (isolate == nullptr) {
+    free(error);
+    return nullptr;
+  }
+
+  void* child_isolate_data = nullptr;
+  if (!initialize_callback(&child_isolate_data, &error)) {
+    Dart_ShutdownIsolate();
+    free(error);
+    return nullptr;
+  }
+  isolate->set_init_callback_data(child_isolate_data);
+
+  // Park the isolate: it stays registered with the group, but no thread has
+  // it entered until it is taken out of the pool again. Parked isolates don't
+  // count as live for [IsolateGroup::ContainsOnlyOneIsolate] and aren't
+  // listed by the service protocol.
+  isolate_group_->SetIsolatePooled(isolate, true);
+  Dart_ExitIsolate();
+  return isolate;
+}
+
+void IsolatePool::ReleaseIfOnlyPooledIsolatesRemain(
+    intptr_t isolate_count,
+    MallocGrowableArray<Isolate*>* released) {
+  MutexLocker ml(&mutex_);
+  if (released_ || pending_ > 0 || isolate_count == 0 ||
+      isolate_count != idle_isolates_.length()) {
+    return;
+  }
+  released_ = true;
+  for (const auto& idle : idle_isolates_) {
+    released->Add(idle.isolate);
+  }
+  idle_isolates_.Clear();
+}
+
+void IsolatePool::ShutdownIsolates(
+    const MallocGrowableArray<Isolate*>& isolates) {
+  for (Isolate* isolate : isolates) {
+    Dart_EnterIsolate(Api::CastIsolate(isolate));
+    isolate->group()->SetIsolatePooled(isolate, false);
+    Dart_ShutdownIsolate();
+  }
+}
+
+}  // namespace dart
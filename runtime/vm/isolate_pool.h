@@ -0,0 +1,93 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_ISOLATE_POOL_H_
+#define RUNTIME_VM_ISOLATE_POOL_H_
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Isolate;
+class IsolateGroup;
+
+// A per-isolate-group cache of pre-initialized isolates (see
+// --isolate-pool-size).
+//
+// Creating an isolate inside an existing group still runs
+// [Isolate::InitIsolate], sets up its field table and message handler and
+// calls the embedder's initialize callback. Pooled isolates have gone through
+// all of that already: they are registered with the group but not runnable
+// and not entered by any thread. A lightweight `Isolate.spawn` takes one,
+// renames it and starts its message loop.
+//
+// Isolates are never returned to the pool after having run their entrypoint,
+// so no state can leak between spawns. Instead the spawner tops the pool up
+// with fresh isolates once the child is running (see [Refill]).
+//
+// The pool starts out empty: the first spawn of a group creates its child the
+// regular way and only then fills the pool, so programs that never spawn don't
+// pay for idle isolates.
+//
+// Pooled isolates must not keep their group alive on their own: once the last
+// other isolate of the group exits they are released via
+// [ReleaseIfOnlyPooledIsolatesRemain] and shut down.
+class IsolatePool {
+ public:
+  explicit IsolatePool(IsolateGroup* isolate_group);
+  ~IsolatePool();
+
+  // Returns an idle isolate renamed to [name] and entered on the current
+  // thread, or nullptr if the pool is empty. Isolates that have been idle for
+  // longer than --isolate-pool-idle-timeout-ms are shut down on the way.
+  //
+  // Must be called without a current isolate while another isolate of the
+  // group (e.g. the spawner) keeps the group alive.
+  Isolate* TryTake(const char* name);
+
+  // Creates new isolates until the pool holds --isolate-pool-size of them.
+  //
+  // Must be called without a current isolate while another isolate of the
+  // group (e.g. the spawner) keeps the group alive.
+  void Refill();
+
+  // Called with the group's isolates lock held after an isolate was
+  // unregistered and [isolate_count] isolates remain in the group.
+  //
+  // If all of them are idle pooled isolates, the pool stops accepting new
+  // isolates and moves them into [released], which the caller has to shut
+  // down via [ShutdownIsolates] after dropping the lock.
+  void ReleaseIfOnlyPooledIsolatesRemain(intptr_t isolate_count,
+                                         MallocGrowableArray<Isolate*>* released);
+
+  // Shuts down pooled [isolates] on the current thread, which must not have
+  // an isolate entered.
+  //
+  // The group may be destroyed by the time this returns.
+  static void ShutdownIsolates(const MallocGrowableArray<Isolate*>& isolates);
+
+ private:
+  struct IdleIsolate {
+    Isolate* isolate;
+    int64_t idle_since_micros;
+  };
+
+  Isolate* CreateIdleIsolate();
+
+  IsolateGroup* const isolate_group_;
+
+  Mutex mutex_;
+  MallocGrowableArray<IdleIsolate> idle_isolates_;
+  // Isolates currently being created by [Refill].
+  intptr_t pending_ = 0;
+  bool released_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(IsolatePool);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_ISOLATE_POOL_H_
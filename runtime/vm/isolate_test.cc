@@ -8,6 +8,8 @@
 
 #include "vm/globals.h"
 #include "vm/isolate.h"
+#include "vm/isolate_pool.h"
+#include "vm/json_stream.h"
 #include "vm/lockers.h"
 #include "vm/port.h"
 #include "vm/thread_barrier.h"
@@ -144,6 +146,85 @@ class InterruptChecker : public ThreadPool::Task {
   ThreadBarrier* barrier_;
 };
 
+static bool InitializePooledIsolate(void** child_isolate_data, char** error) {
+  *child_isolate_data = nullptr;
+  return true;
+}
+
+VM_UNIT_TEST_CASE(IsolatePool_PooledIsolatesAreNotLive) {
+  SetFlagScope<int> sfs(&FLAG_isolate_pool_size, 2);
+  auto saved_initialize_callback = Isolate::InitializeCallback();
+  Isolate::SetInitializeCallback_(InitializePooledIsolate);
+
+  Dart_Isolate main_isolate = TestCase::CreateTestIsolate();
+  Isolate* isolate = reinterpret_cast<Isolate*>(main_isolate);
+  IsolateGroup* group = isolate->group();
+  IsolatePool* pool = group->isolate_pool();
+  EXPECT(pool != nullptr);
+
+  Dart_ExitIsolate();
+  pool->Refill();
+  Dart_EnterIsolate(main_isolate);
+
+  // The idle isolates don't disable the single-isolate fast paths and don't
+  // show up in the service protocol.
+  EXPECT(group->ContainsOnlyOneIsolate());
+#if !defined(PRODUCT)
+  {
+    JSONStream js;
+    group->PrintJSON(&js, /*ref=*/false);
+    EXPECT_NOTSUBSTRING("pooled-isolate", js.ToCString());
+  }
+#endif  // !defined(PRODUCT)
+
+  // A taken isolate is live again.
+  Dart_ExitIsolate();
+  Isolate* child = pool->TryTake("child");
+  EXPECT(child != nullptr);
+  EXPECT(!child->is_pooled());
+  EXPECT(!group->ContainsOnlyOneIsolate());
+  Dart_ShutdownIsolate();
+
+  // Shutting down the last live isolate releases the remaining pooled one.
+  Dart_EnterIsolate(main_isolate);
+  EXPECT(group->ContainsOnlyOneIsolate());
+  Dart_ShutdownIsolate();
+
+  Isolate::SetInitializeCallback_(saved_initialize_callback);
+}
+
+TEST_CASE(Isolate_MessageBatchFlushedOnReturnToEmbedder) {
+  SetFlagScope<int> sfs(&FLAG_port_message_batch_size, 4);
+  const char* kScript = R"(
+    import 'dart:isolate';
+
+    int received = 0;
+    final port = RawReceivePort((_) {
+      received++;
+    });
+
+    void send() {
+      port.sendPort.send(1);
+    }
+
+    int getReceived() => received;
+  )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+
+  // The single message must not wait in the batch for three more once
+  // control is back in the embedder.
+  EXPECT_VALID(Dart_Invoke(lib, NewString("send"), 0, nullptr));
+  EXPECT(!Isolate::Current()->has_message_batch());
+  EXPECT_VALID(Dart_HandleMessage());
+
+  Dart_Handle result = Dart_Invoke(lib, NewString("getReceived"), 0, nullptr);
+  EXPECT_VALID(result);
+  int64_t received = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &received));
+  EXPECT_EQ(1, received);
+}
+
 // Test and document usage of Isolate::HasInterruptsScheduled.
 //
 // Go through a number of rounds of scheduling interrupts and waiting until all
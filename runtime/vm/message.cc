@@ -45,6 +45,18 @@ Message::Message(Dart_Port dest_port,
   ASSERT(IsPersistentHandle());
 }
 
+Message::Message(Dart_Port dest_port,
+                 PersistentHandle* handle,
+                 Priority priority,
+                 bool is_batch)
+    : dest_port_(dest_port),
+      payload_(handle),
+      snapshot_length_(is_batch ? kPersistentHandleBatchSnapshotLen
+                                : kPersistentHandleSnapshotLen),
+      priority_(priority) {
+  ASSERT(IsPersistentHandle() || IsPersistentHandleBatch());
+}
+
 Message::Message(PersistentHandle* handle, Priority priority)
     : dest_port_(ILLEGAL_PORT),
       payload_(handle),
@@ -58,7 +70,8 @@ Message::~Message() {
     free(payload_.snapshot_);
   }
   delete finalizable_data_;
-  if (IsPersistentHandle() || IsFinalizerInvocationRequest()) {
+  if (IsPersistentHandle() || IsPersistentHandleBatch() ||
+      IsFinalizerInvocationRequest()) {
     auto isolate_group = IsolateGroup::Current();
     isolate_group->api_state()->FreePersistentHandle(
         payload_.persistent_handle_);
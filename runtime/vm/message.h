@@ -63,6 +63,14 @@ class Message {
   // receiver are in the same isolate group.
   Message(Dart_Port dest_port, PersistentHandle* handle, Priority priority);
 
+  // A batch of messages sent from SendPort.send to the same port where sender
+  // and receiver are in the same isolate group (see --port-message-batch-size).
+  // The handle refers to an Array of copied message object graphs.
+  Message(Dart_Port dest_port,
+          PersistentHandle* handle,
+          Priority priority,
+          bool is_batch);
+
   // A message sent from GC to run a finalizer.
   Message(PersistentHandle* handle, Priority priority);
 
@@ -96,7 +104,8 @@ class Message {
     return payload_.raw_obj_;
   }
   PersistentHandle* persistent_handle() const {
-    ASSERT(IsPersistentHandle() || IsFinalizerInvocationRequest());
+    ASSERT(IsPersistentHandle() || IsPersistentHandleBatch() ||
+           IsFinalizerInvocationRequest());
     return payload_.persistent_handle_;
   }
   Priority priority() const { return priority_; }
@@ -106,7 +115,8 @@ class Message {
   // vm-service requests.
   bool IsOOB() const { return priority_ == Message::kOOBPriority; }
   bool IsSnapshot() const {
-    return !IsRaw() && !IsPersistentHandle() && !IsFinalizerInvocationRequest();
+    return !IsRaw() && !IsPersistentHandle() && !IsPersistentHandleBatch() &&
+           !IsFinalizerInvocationRequest();
   }
   // A message whose object is an immortal object from the vm-isolate's heap.
   bool IsRaw() const { return snapshot_length_ == 0; }
@@ -115,6 +125,11 @@ class Message {
   bool IsPersistentHandle() const {
     return snapshot_length_ == kPersistentHandleSnapshotLen;
   }
+  // A batch of messages coalesced by the sender, to be delivered to the
+  // destination port one by one.
+  bool IsPersistentHandleBatch() const {
+    return snapshot_length_ == kPersistentHandleBatchSnapshotLen;
+  }
   // A message sent from GC to run a finalizer.
   bool IsFinalizerInvocationRequest() const {
     return snapshot_length_ == kFinalizerSnapshotLen;
@@ -133,6 +148,7 @@ class Message {
  private:
   static intptr_t const kPersistentHandleSnapshotLen = -1;
   static intptr_t const kFinalizerSnapshotLen = -2;
+  static intptr_t const kPersistentHandleBatchSnapshotLen = -3;
 
   friend class MessageQueue;
 
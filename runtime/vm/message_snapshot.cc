@@ -3439,6 +3439,12 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
 }
 
 ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, PersistentHandle* handle) {
+  const auto& msg_array =
+      Array::Handle(thread->zone(), Array::RawCast(handle->ptr()));
+  return ReadObjectGraphCopyMessage(thread, msg_array);
+}
+
+ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, const Array& msg_array) {
   // msg_array = [
   //     <message>,
   //     <collection-lib-objects-to-rehash>,
@@ -3446,7 +3452,6 @@ ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, PersistentHandle* handle) {
   // ]
   Zone* zone = thread->zone();
   Object& msg_obj = Object::Handle(zone);
-  const auto& msg_array = Array::Handle(zone, Array::RawCast(handle->ptr()));
   ASSERT(msg_array.Length() == 3);
   msg_obj = msg_array.At(0);
   if (msg_array.At(1) != Object::null()) {
@@ -3480,6 +3485,23 @@ ObjectPtr ReadMessage(Thread* thread, Message* message) {
     return msg_obj.ptr();
   } else if (message->IsPersistentHandle()) {
     return ReadObjectGraphCopyMessage(thread, message->persistent_handle());
+  } else if (message->IsPersistentHandleBatch()) {
+    // Decode the coalesced messages in place: the batch array is owned by the
+    // message and not visible to the sender anymore.
+    Zone* zone = thread->zone();
+    const auto& batch = Array::Handle(
+        zone, Array::RawCast(message->persistent_handle()->ptr()));
+    auto& msg_array = Array::Handle(zone);
+    auto& msg_obj = Object::Handle(zone);
+    for (intptr_t i = 0; i < batch.Length(); i++) {
+      msg_array ^= batch.At(i);
+      msg_obj = ReadObjectGraphCopyMessage(thread, msg_array);
+      if (msg_obj.IsError()) {
+        return msg_obj.ptr();
+      }
+      batch.SetAt(i, msg_obj);
+    }
+    return batch.ptr();
   } else {
     RELEASE_ASSERT(message->IsSnapshot());
     LongJumpScope jump(thread);
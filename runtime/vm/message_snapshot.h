@@ -24,7 +24,10 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
                                          Message::Priority priority);
 
 ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, PersistentHandle* handle);
+ObjectPtr ReadObjectGraphCopyMessage(Thread* thread, const Array& msg_array);
 
+// For a batch (see Message::IsPersistentHandleBatch) returns an Array of the
+// individual message objects.
 ObjectPtr ReadMessage(Thread* thread, Message* message);
 
 Dart_CObject* ReadApiMessage(Zone* zone, Message* message);
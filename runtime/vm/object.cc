@@ -17994,6 +17994,10 @@ void Code::set_is_discarded(bool value) const {
   set_state_bits(DiscardedBit::update(value, untag()->state_bits_));
 }
 
+void Code::set_is_cold(bool value) const {
+  set_state_bits(ColdBit::update(value, untag()->state_bits_));
+}
+
 void Code::set_compressed_stackmaps(const CompressedStackMaps& maps) const {
   ASSERT(maps.IsOld());
   untag()->set_compressed_stackmaps(maps.ptr());
@@ -18777,6 +18781,32 @@ void Code::ResetActiveInstructions() const {
 #endif
 }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+CodeSourceMapPtr Code::LoadCodeSourceMap() const {
+  // See Serializer::GetLazyCodeSourceMapOffset.
+  const intptr_t offset =
+      Smi::Value(static_cast<SmiPtr>(
+          static_cast<ObjectPtr>(untag()->code_source_map())))
+      << kObjectAlignmentLog2;
+  Thread* thread = Thread::Current();
+  ASSERT(thread->no_safepoint_scope_depth() == 0);
+  const Snapshot* snapshot = Snapshot::SetupFromBuffer(
+      thread->isolate_group()->source()->snapshot_data);
+  const uint8_t* bytes =
+      snapshot->DataImage() + offset + OneByteString::data_offset();
+  const intptr_t length =
+      LoadUnaligned(reinterpret_cast<const uint32_t*>(bytes));
+  const auto& map =
+      CodeSourceMap::Handle(thread->zone(), CodeSourceMap::New(length));
+  {
+    NoSafepointScope no_safepoint;
+    memcpy(map.Data(), bytes + sizeof(uint32_t), length);
+  }
+  set_code_source_map(map);
+  return map.ptr();
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 void Code::GetInlinedFunctionsAtInstruction(
     intptr_t pc_offset,
     GrowableArray<const Function*>* functions,
@@ -23932,7 +23962,6 @@ uword String::HashConcat(const String& str1, const String& str2) {
 }
 
 uword String::Hash(StringPtr raw) {
-  StringHasher hasher;
   uword length = Smi::Value(raw->untag()->length());
   if (raw->IsOneByteString()) {
     const uint8_t* data = static_cast<OneByteStringPtr>(raw)->untag()->data();
@@ -27121,7 +27150,8 @@ RegExpPtr RegExp::New(Zone* zone, Heap::Space space) {
   result.set_num_registers(/*is_one_byte=*/false, -1);
   result.set_num_registers(/*is_one_byte=*/true, -1);
 
-  if (!FLAG_interpret_irregexp) {
+  // With tier-up the functions are created once the pattern is hot.
+  if (!FLAG_interpret_irregexp && (FLAG_regexp_tier_up_executions == 0)) {
     auto thread = Thread::Current();
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
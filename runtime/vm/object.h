@@ -6918,6 +6918,15 @@ class Code : public Object {
   }
   void set_is_discarded(bool value) const;
 
+  // Set by the precompiler if this code is unlikely to run, in which case
+  // its instructions are placed after all other instructions in the
+  // snapshot.
+  bool is_cold() const { return IsCold(ptr()); }
+  static bool IsCold(const CodePtr code) {
+    return ColdBit::decode(code->untag()->state_bits_);
+  }
+  void set_is_cold(bool value) const;
+
   bool HasMonomorphicEntry() const { return HasMonomorphicEntry(ptr()); }
   static bool HasMonomorphicEntry(const CodePtr code) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -7012,7 +7021,17 @@ class Code : public Object {
     untag()->set_pc_descriptors(descriptors.ptr());
   }
 
+  // In the precompiled runtime this may allocate the map (see
+  // LoadCodeSourceMap), so it can reach a safepoint and must not be called
+  // in a NoSafepointScope or while holding raw pointers.
   CodeSourceMapPtr code_source_map() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+    // Snapshots written with --lazy-code-source-maps leave the offset of the
+    // map in the read-only data image here.
+    if (!untag()->code_source_map()->IsHeapObject()) {
+      return LoadCodeSourceMap();
+    }
+#endif
     return untag()->code_source_map();
   }
 
@@ -7158,6 +7177,7 @@ class Code : public Object {
   // which happens for stub code.
   // The pc offset is interpreted as an instruction address (as needed by the
   // disassembler or the top frame of a profiler sample).
+  // Like code_source_map(), this may allocate.
   void GetInlinedFunctionsAtInstruction(
       intptr_t pc_offset,
       GrowableArray<const Function*>* functions,
@@ -7354,6 +7374,12 @@ class Code : public Object {
  private:
   void set_state_bits(intptr_t bits) const;
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // Copies the code source map from the read-only data image of the
+  // snapshot into the heap.
+  CodeSourceMapPtr LoadCodeSourceMap() const;
+#endif
+
   friend class UntaggedObject;  // For UntaggedObject::SizeFromClass().
   friend class UntaggedCode;
   friend struct RelocatorTestHelper;
@@ -7363,7 +7389,8 @@ class Code : public Object {
     kForceOptimizedBit = 1,
     kAliveBit = 2,
     kDiscardedBit = 3,
-    kPtrOffBit = 4,
+    kColdBit = 4,
+    kPtrOffBit = 5,
     kPtrOffSize = kBitsPerInt32 - kPtrOffBit,
   };
 
@@ -7382,6 +7409,8 @@ class Code : public Object {
   // StubCode::UnknownDartCode() during snapshot deserialization.
   class DiscardedBit : public BitField<int32_t, bool, kDiscardedBit, 1> {};
 
+  class ColdBit : public BitField<int32_t, bool, kColdBit, 1> {};
+
   class PtrOffBits
       : public BitField<int32_t, intptr_t, kPtrOffBit, kPtrOffSize> {};
 
@@ -10649,30 +10678,115 @@ class String : public Instance {
   friend class Pass2Visitor;                // Stack "handle"
 };
 
-// Synchronize with implementation in compiler (intrinsifier).
+// Hashes the code units of a string. The result only depends on the code
+// unit values, so one-byte and two-byte strings with the same contents hash
+// alike, and a string may be added in pieces (see String::HashConcat).
+//
+// Code units are consumed in blocks of kBlockSize. Each block is widened to
+// 16-bit code units, packed into two 64-bit words and mixed into two
+// independent lanes, so the bulk loops read 8 (one-byte) or 16 (two-byte)
+// bytes per step instead of one code unit.
 class StringHasher : public ValueObject {
  public:
-  StringHasher() : hash_(0) {}
-  void Add(uint16_t code_unit) { hash_ = CombineHashes(hash_, code_unit); }
+  StringHasher() {}
+
+  void Add(uint16_t code_unit) {
+    const uint64_t shifted = static_cast<uint64_t>(code_unit)
+                             << (16 * (num_pending_ % (kBlockSize / 2)));
+    if (num_pending_ < kBlockSize / 2) {
+      pending_lo_ |= shifted;
+    } else {
+      pending_hi_ |= shifted;
+    }
+    if (++num_pending_ == kBlockSize) {
+      AddBlock(pending_lo_, pending_hi_);
+      pending_lo_ = pending_hi_ = 0;
+      num_pending_ = 0;
+    }
+  }
   void Add(const uint8_t* code_units, intptr_t len) {
-    while (len > 0) {
+    for (; (num_pending_ != 0) && (len > 0); code_units++, len--) {
       Add(*code_units);
-      code_units++;
-      len--;
+    }
+    for (; len >= kBlockSize; code_units += kBlockSize, len -= kBlockSize) {
+      const uint64_t block =
+          LoadUnaligned(reinterpret_cast<const uint64_t*>(code_units));
+      AddBlock(Widen(static_cast<uint32_t>(block)),
+               Widen(static_cast<uint32_t>(block >> 32)));
+    }
+    if (len > 0) {
+      uint64_t block = 0;
+      if (len >= 4) {
+        // The two loads overlap, keep only the bytes past the first one.
+        const uint64_t last = LoadUnaligned(
+            reinterpret_cast<const uint32_t*>(code_units + len - 4));
+        block = LoadUnaligned(reinterpret_cast<const uint32_t*>(code_units)) |
+                ((last >> (8 * (kBlockSize - len))) << 32);
+      } else {
+        for (intptr_t i = 0; i < len; i++) {
+          block |= static_cast<uint64_t>(code_units[i]) << (8 * i);
+        }
+      }
+      pending_lo_ = Widen(static_cast<uint32_t>(block));
+      pending_hi_ = Widen(static_cast<uint32_t>(block >> 32));
+      num_pending_ = len;
     }
   }
   void Add(const uint16_t* code_units, intptr_t len) {
-    while (len > 0) {
+    for (; (num_pending_ != 0) && (len > 0); code_units++, len--) {
+      Add(LoadUnaligned(code_units));
+    }
+    for (; len >= kBlockSize; code_units += kBlockSize, len -= kBlockSize) {
+      AddBlock(LoadUnaligned(reinterpret_cast<const uint64_t*>(code_units)),
+               LoadUnaligned(reinterpret_cast<const uint64_t*>(
+                   code_units + kBlockSize / 2)));
+    }
+    for (; len > 0; code_units++, len--) {
       Add(LoadUnaligned(code_units));
-      code_units++;
-      len--;
     }
   }
   void Add(const String& str, intptr_t begin_index, intptr_t len);
-  intptr_t Finalize() { return FinalizeHash(hash_, String::kHashBits); }
+  intptr_t Finalize() const {
+    // Missing code units of the last block are zero, the length tells such
+    // strings apart from ones that end in actual zeros.
+    const uint64_t length = num_blocks_ * kBlockSize + num_pending_;
+    uint64_t hash =
+        Mix(lo_, pending_lo_) ^ Utils::RotateLeft(hi_ ^ pending_hi_, 32);
+    hash = (hash ^ length) * kMultiplier;
+    hash ^= hash >> 32;
+    return FinalizeHash(static_cast<uint32_t>(hash), String::kHashBits);
+  }
 
  private:
-  uint32_t hash_;
+  static constexpr intptr_t kBlockSize = 8;
+  static constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15;
+
+  static uint64_t Mix(uint64_t lane, uint64_t word) {
+    return (Utils::RotateLeft(lane, 5) ^ word) * kMultiplier;
+  }
+
+  // Spreads four one-byte code units into the 16-bit lanes of a word, the
+  // layout a little-endian load of four two-byte code units has.
+  static uint64_t Widen(uint32_t code_units) {
+    uint64_t word = code_units;
+    word = (word | (word << 16)) & 0x0000ffff0000ffff;
+    word = (word | (word << 8)) & 0x00ff00ff00ff00ff;
+    return word;
+  }
+
+  void AddBlock(uint64_t lo, uint64_t hi) {
+    lo_ = Mix(lo_, lo);
+    hi_ = Mix(hi_, hi);
+    num_blocks_++;
+  }
+
+  uint64_t lo_ = 0;
+  uint64_t hi_ = 0;
+  uint64_t num_blocks_ = 0;
+  // The code units of the current, incomplete block.
+  uint64_t pending_lo_ = 0;
+  uint64_t pending_hi_ = 0;
+  intptr_t num_pending_ = 0;
 };
 
 class OneByteString : public AllStatic {
@@ -10809,6 +10923,7 @@ class OneByteString : public AllStatic {
   friend class StringHasher;
   friend class Symbols;
   friend class Utf8;
+  friend class IrregexpInterpreter;
   friend class OneByteStringMessageSerializationCluster;
   friend class Deserializer;
   friend class JSONWriter;
@@ -10931,6 +11046,7 @@ class TwoByteString : public AllStatic {
   friend class String;
   friend class StringHasher;
   friend class Symbols;
+  friend class IrregexpInterpreter;
   friend class TwoByteStringMessageSerializationCluster;
   friend class JSONWriter;
 };
@@ -12958,16 +13074,22 @@ class RegExp : public Instance {
   }
   ArrayPtr capture_name_map() const { return untag()->capture_name_map(); }
 
+  // Returns null if the pattern has tiered up to compiled code for this kind
+  // of subject.
   TypedDataPtr bytecode(bool is_one_byte, bool sticky) const {
+    ObjectPtr value;
     if (sticky) {
-      return TypedData::RawCast(
-          is_one_byte ? untag()->one_byte_sticky<std::memory_order_acquire>()
-                      : untag()->two_byte_sticky<std::memory_order_acquire>());
+      value = is_one_byte
+                  ? untag()->one_byte_sticky<std::memory_order_acquire>()
+                  : untag()->two_byte_sticky<std::memory_order_acquire>();
     } else {
-      return TypedData::RawCast(
-          is_one_byte ? untag()->one_byte<std::memory_order_acquire>()
-                      : untag()->two_byte<std::memory_order_acquire>());
+      value = is_one_byte ? untag()->one_byte<std::memory_order_acquire>()
+                          : untag()->two_byte<std::memory_order_acquire>();
     }
+    if (value->GetClassId() == kFunctionCid) {
+      return TypedData::null();
+    }
+    return TypedData::RawCast(value);
   }
 
   static intptr_t function_offset(intptr_t cid, bool sticky) {
@@ -13012,6 +13134,20 @@ class RegExp : public Instance {
     return Function::null();
   }
 
+  // Returns true if subjects of class [cid] are matched by compiled code
+  // rather than interpreted bytecode.
+  bool has_function(intptr_t cid, bool sticky) const {
+    return function(cid, sticky)->GetClassId() == kFunctionCid;
+  }
+
+  intptr_t num_executions() const {
+    return untag()->num_executions_.load(std::memory_order_relaxed);
+  }
+  void set_num_executions(intptr_t value) const {
+    ASSERT(Utils::IsUint(16, value));
+    untag()->num_executions_.store(value, std::memory_order_relaxed);
+  }
+
   void set_pattern(const String& pattern) const;
   void set_function(intptr_t cid, bool sticky, const Function& value) const;
   void set_bytecode(bool is_one_byte,
@@ -2720,6 +2720,366 @@ class ObjectGraphCopier : public StackResource {
   intptr_t allocated_bytes_ = 0;
 };
 
+// Builds a deeply immutable version of an object graph (see
+// [DeepFreezeObjectGraph]).
+//
+// Objects are visited in two steps: [Forward] decides what the frozen version
+// of an object is (allocating it if necessary) and queues it, [Fill] then
+// populates it with the frozen versions of the original's references. This
+// keeps the native stack flat for deep graphs and preserves sharing and cycles.
+//
+// The immutability bit is only set once the whole graph was processed, so a
+// failing freeze never leaves partially populated objects shareable. Failures
+// are recorded in [exception_msg] and thrown by the caller once the freezer
+// (which owns malloc()ed and isolate-global state) was destroyed.
+class ObjectGraphFreezer {
+ public:
+  explicit ObjectGraphFreezer(Thread* thread)
+      : thread_(thread),
+        zone_(thread->zone()),
+        map_(thread),
+        from_to_(
+            GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+        worklist_(
+            GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())) {
+    // The identity map uses 0 as an empty marker, so ids have to start at 2.
+    from_to_.Add(Object::null_object());
+    from_to_.Add(Object::null_object());
+  }
+
+  ObjectPtr Freeze(const Object& root) {
+    const auto& result = Object::Handle(zone_, Forward(root));
+
+    auto& from = Object::Handle(zone_);
+    auto& to = Object::Handle(zone_);
+    while (exception_msg_ == nullptr && worklist_.Length() > 0) {
+      to = worklist_.RemoveLast();
+      from = worklist_.RemoveLast();
+      Fill(from, to);
+      thread_->CheckForSafepoint();
+    }
+    if (exception_msg_ != nullptr) {
+      return Object::null();
+    }
+
+    for (intptr_t i = 2; i < from_to_.Length(); i += 2) {
+      to = from_to_.At(i + 1);
+      to.SetImmutable();
+    }
+    return result.ptr();
+  }
+
+  const char* exception_msg() const { return exception_msg_; }
+
+ private:
+  // Returns [Marker] if [from] cannot be frozen.
+  ObjectPtr Forward(const Object& from) {
+    if (!from.ptr()->IsHeapObject() ||
+        CanShareObjectAcrossIsolates(from.ptr())) {
+      return from.ptr();
+    }
+    const ObjectPtr existing =
+        map_.ForwardedObject(from, SlowFromTo(from_to_));
+    if (existing != Marker()) {
+      return existing;
+    }
+
+    const intptr_t cid = from.GetClassId();
+    auto& to = Object::Handle(zone_);
+    switch (cid) {
+      case kArrayCid:
+      case kImmutableArrayCid:
+      case kGrowableObjectArrayCid: {
+        const intptr_t length = cid == kGrowableObjectArrayCid
+                                    ? GrowableObjectArray::Cast(from).Length()
+                                    : Array::Cast(from).Length();
+        const auto& array =
+            Array::Handle(zone_, ImmutableArray::New(length, Heap::kOld));
+        array.SetTypeArguments(TypeArguments::Handle(
+            zone_, ConvertTypeArguments(
+                       Instance::Cast(from),
+                       Class::Handle(zone_, object_store()
+                                                ->immutable_array_class()))));
+        to = array.ptr();
+        break;
+      }
+      case kMapCid: {
+        const auto& map =
+            Map::Handle(zone_, ConstMap::NewUninitialized(Heap::kOld));
+        map.SetTypeArguments(TypeArguments::Handle(
+            zone_, ConvertTypeArguments(
+                       Instance::Cast(from),
+                       Class::Handle(zone_,
+                                     object_store()->const_map_impl_class()))));
+        to = map.ptr();
+        break;
+      }
+      case kSetCid: {
+        const auto& set =
+            Set::Handle(zone_, ConstSet::NewUninitialized(Heap::kOld));
+        set.SetTypeArguments(TypeArguments::Handle(
+            zone_, ConvertTypeArguments(
+                       Instance::Cast(from),
+                       Class::Handle(zone_,
+                                     object_store()->const_set_impl_class()))));
+        to = set.ptr();
+        break;
+      }
+      case kRecordCid:
+        // Records are already immutable, they only need to refer to frozen
+        // objects.
+        to = from.ptr();
+        break;
+      case kClosureCid:
+        return Fail(
+            "Illegal argument in deepFreeze: closures capturing variables "
+            "cannot be frozen");
+      default:
+        if (IsTypedDataBaseClassId(cid) || cid == kByteDataViewCid ||
+            cid == kUnmodifiableByteDataViewCid) {
+          // Typed data has no outgoing references, there is nothing to fill.
+          to = FreezeTypedData(TypedDataBase::Cast(from));
+          map_.Insert(from, to, SlowFromTo(from_to_),
+                      /*check_for_safepoint=*/false);
+          return to.ptr();
+        }
+        if ((cid == kInstanceCid || cid >= kNumPredefinedCids) &&
+            CanFreezeInPlace(Class::Handle(zone_, from.clazz()))) {
+          to = from.ptr();
+          break;
+        }
+        if (exception_msg_ != nullptr) {
+          return Marker();
+        }
+        return Fail(OS::SCreate(
+            zone_,
+            "Illegal argument in deepFreeze: object cannot be frozen - %s",
+            Class::Handle(zone_, from.clazz()).ToCString()));
+    }
+
+    map_.Insert(from, to, SlowFromTo(from_to_),
+                /*check_for_safepoint=*/false);
+    worklist_.Add(from);
+    worklist_.Add(to);
+    return to.ptr();
+  }
+
+  void Fill(const Object& from, const Object& to) {
+    auto& value = Object::Handle(zone_);
+    switch (from.GetClassId()) {
+      case kArrayCid:
+      case kImmutableArrayCid: {
+        const auto& from_array = Array::Cast(from);
+        const auto& to_array = Array::Cast(to);
+        for (intptr_t i = 0; i < from_array.Length(); i++) {
+          value = from_array.At(i);
+          value = Forward(value);
+          if (value.ptr() == Marker()) return;
+          to_array.SetAt(i, value);
+        }
+        break;
+      }
+      case kGrowableObjectArrayCid: {
+        const auto& from_array = GrowableObjectArray::Cast(from);
+        const auto& to_array = Array::Cast(to);
+        for (intptr_t i = 0; i < from_array.Length(); i++) {
+          value = from_array.At(i);
+          value = Forward(value);
+          if (value.ptr() == Marker()) return;
+          to_array.SetAt(i, value);
+        }
+        break;
+      }
+      case kMapCid:
+        FillHashBase(LinkedHashBase::Cast(from), LinkedHashBase::Cast(to),
+                     /*entry_size=*/2);
+        break;
+      case kSetCid:
+        FillHashBase(LinkedHashBase::Cast(from), LinkedHashBase::Cast(to),
+                     /*entry_size=*/1);
+        break;
+      case kRecordCid: {
+        const auto& record = Record::Cast(from);
+        for (intptr_t i = 0; i < record.num_fields(); i++) {
+          value = record.FieldAt(i);
+          if (!IsFrozenInPlace(from, value)) return;
+        }
+        break;
+      }
+      default: {
+        ASSERT(from.ptr() == to.ptr());
+        const auto& instance = Instance::Cast(from);
+        auto& cls = Class::Handle(zone_, from.clazz());
+        auto& fields = Array::Handle(zone_);
+        auto& field = Field::Handle(zone_);
+        while (!cls.IsNull()) {
+          fields = cls.fields();
+          for (intptr_t i = 0; i < fields.Length(); i++) {
+            field ^= fields.At(i);
+            if (field.is_static()) continue;
+            value = instance.GetField(field);
+            if (!IsFrozenInPlace(from, value)) return;
+          }
+          cls = cls.SuperClass();
+        }
+        break;
+      }
+    }
+  }
+
+  // The frozen map/set only retains live entries, so it has no deleted keys.
+  // Its index is built lazily by the Dart code, as for constant maps and sets.
+  void FillHashBase(const LinkedHashBase& from,
+                    const LinkedHashBase& to,
+                    intptr_t entry_size) {
+    const auto& from_data = Array::Handle(zone_, from.data());
+    const intptr_t used_data =
+        from_data.IsNull() ? 0 : Smi::Value(from.used_data());
+
+    intptr_t live_entries = 0;
+    for (intptr_t i = 0; i < used_data; i += entry_size) {
+      // Deleted entries point back to the data array.
+      if (from_data.At(i) != from_data.ptr()) live_entries++;
+    }
+
+    const intptr_t to_used_data = live_entries * entry_size;
+    const auto& to_data =
+        Array::Handle(zone_, Array::New(to_used_data, Heap::kOld));
+    auto& value = Object::Handle(zone_);
+    intptr_t j = 0;
+    for (intptr_t i = 0; i < used_data; i += entry_size) {
+      if (from_data.At(i) == from_data.ptr()) continue;
+      for (intptr_t k = 0; k < entry_size; k++) {
+        value = from_data.At(i + k);
+        value = Forward(value);
+        if (value.ptr() == Marker()) return;
+        to_data.SetAt(j++, value);
+      }
+    }
+    ASSERT(j == to_used_data);
+
+    to.set_data(to_data);
+    to.set_used_data(to_used_data);
+    to.set_deleted_keys(0);
+    to.ComputeAndSetHashMask();
+  }
+
+  // Records and class instances keep their identity when frozen, so whatever
+  // they refer to must not need to be copied.
+  bool IsFrozenInPlace(const Object& holder, const Object& value) {
+    const ObjectPtr frozen = Forward(value);
+    if (frozen == Marker()) return false;
+    if (frozen != value.ptr()) {
+      Fail(OS::SCreate(
+          zone_,
+          "Illegal argument in deepFreeze: %s refers to a mutable %s, freeze "
+          "it first",
+          Class::Handle(zone_, holder.clazz()).ToCString(),
+          Class::Handle(zone_, value.clazz()).ToCString()));
+      return false;
+    }
+    return true;
+  }
+
+  bool CanFreezeInPlace(const Class& cls) {
+    if (cls.num_native_fields() > 0 || cls.is_isolate_unsendable()) {
+      return false;
+    }
+    auto& klass = Class::Handle(zone_, cls.ptr());
+    auto& fields = Array::Handle(zone_);
+    auto& field = Field::Handle(zone_);
+    while (!klass.IsNull()) {
+      fields = klass.fields();
+      for (intptr_t i = 0; i < fields.Length(); i++) {
+        field ^= fields.At(i);
+        if (field.is_static()) continue;
+        if (!field.is_final() || field.is_late()) {
+          Fail(OS::SCreate(
+              zone_,
+              "Illegal argument in deepFreeze: %s has a mutable field '%s'",
+              cls.ToCString(), field.UserVisibleNameCString()));
+          return false;
+        }
+      }
+      klass = klass.SuperClass();
+    }
+    return true;
+  }
+
+  ObjectPtr FreezeTypedData(const TypedDataBase& from) {
+    const intptr_t cid = from.GetClassId();
+    intptr_t data_cid;
+    intptr_t view_cid;
+    if (cid == kByteDataViewCid || cid == kUnmodifiableByteDataViewCid) {
+      data_cid = kTypedDataUint8ArrayCid;
+      view_cid = kUnmodifiableByteDataViewCid;
+    } else {
+      data_cid =
+          cid - ((cid - kFirstTypedDataCid) % kNumTypedDataCidRemainders);
+      view_cid = data_cid + kTypedDataCidRemainderUnmodifiable;
+    }
+
+    const intptr_t length = from.Length();
+    const auto& data =
+        TypedData::Handle(zone_, TypedData::New(data_cid, length, Heap::kOld));
+    {
+      NoSafepointScope no_safepoint;
+      memmove(data.DataAddr(0), from.DataAddr(0), from.LengthInBytes());
+    }
+    data.SetImmutable();
+    return TypedDataView::New(view_cid, data, 0, length, Heap::kOld);
+  }
+
+  TypeArgumentsPtr ConvertTypeArguments(const Instance& from,
+                                        const Class& to_class) {
+    auto& type_args = TypeArguments::Handle(zone_, from.GetTypeArguments());
+    if (type_args.IsNull()) {
+      return TypeArguments::null();
+    }
+    type_args = type_args.FromInstanceTypeArguments(
+        thread_, Class::Handle(zone_, from.clazz()));
+    return to_class.GetInstanceTypeArguments(thread_, type_args);
+  }
+
+  ObjectStore* object_store() const {
+    return thread_->isolate_group()->object_store();
+  }
+
+  ObjectPtr Fail(const char* exception_msg) {
+    exception_msg_ = exception_msg;
+    return Marker();
+  }
+
+  Thread* thread_;
+  Zone* zone_;
+  IdentityMap map_;
+  const GrowableObjectArray& from_to_;
+  const GrowableObjectArray& worklist_;
+  const char* exception_msg_ = nullptr;
+};
+
+ObjectPtr DeepFreezeObjectGraph(const Object& root) {
+  auto thread = Thread::Current();
+  auto zone = thread->zone();
+  TIMELINE_DURATION(thread, Isolate, "DeepFreezeObjectGraph");
+
+  const char* exception_msg = nullptr;
+  auto& result = Object::Handle(zone);
+  {
+    ObjectGraphFreezer freezer(thread);
+    result = freezer.Freeze(root);
+    exception_msg = freezer.exception_msg();
+  }
+  if (exception_msg != nullptr) {
+    const auto& msg_obj = String::Handle(zone, String::New(exception_msg));
+    const auto& args = Array::Handle(zone, Array::New(1));
+    args.SetAt(0, msg_obj);
+    Exceptions::ThrowByType(Exceptions::kArgument, args);
+    UNREACHABLE();
+  }
+  return result.ptr();
+}
+
 ObjectPtr CopyMutableObjectGraph(const Object& object) {
   auto thread = Thread::Current();
   TIMELINE_DURATION(thread, Isolate, "CopyMutableObjectGraph");
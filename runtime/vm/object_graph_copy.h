@@ -31,6 +31,20 @@ bool CanShareObjectAcrossIsolates(ObjectPtr obj);
 // those objects.
 ObjectPtr CopyMutableObjectGraph(const Object& root);
 
+// Returns a deeply immutable version of the object graph referenced by [root]
+// which can be shared by all isolates of the group without copying.
+//
+// Objects that can already be shared are returned as-is. Lists, maps, sets and
+// typed data are copied into their unmodifiable counterparts (lists become
+// `_ImmutableList`, maps and sets become `_ConstMap` and `_ConstSet`, typed
+// data becomes an unmodifiable view on an immutable copy). Records and
+// instances of classes with only final, non-late fields are frozen in place and
+// must only refer to objects that don't need to be copied.
+//
+// Throws an `ArgumentError` if the graph contains objects that cannot be
+// frozen, e.g. closures capturing variables or objects with mutable fields.
+ObjectPtr DeepFreezeObjectGraph(const Object& root);
+
 typedef enum {
   kInternalToIsolateGroup,
   kExternalBetweenIsolateGroups,
@@ -2007,26 +2007,31 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !flags().IgnoreCase());
   jsobj.AddProperty("isMultiLine", flags().IsMultiLine());
 
-  if (!FLAG_interpret_irregexp) {
-    Function& func = Function::Handle();
-    func = function(kOneByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteFunction", func);
-    func = function(kTwoByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteFunction", func);
-    func = function(kOneByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteFunctionSticky", func);
-    func = function(kTwoByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteFunctionSticky", func);
-  } else {
-    TypedData& bc = TypedData::Handle();
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteBytecodeSticky", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteBytecodeSticky", bc);
+  // Each specialization holds either its function, once the pattern has
+  // tiered up, or its bytecode.
+  struct {
+    intptr_t cid;
+    bool sticky;
+    const char* function_name;
+    const char* bytecode_name;
+  } specializations[] = {
+      {kOneByteStringCid, false, "_oneByteFunction", "_oneByteBytecode"},
+      {kTwoByteStringCid, false, "_twoByteFunction", "_twoByteBytecode"},
+      {kOneByteStringCid, true, "_oneByteFunctionSticky",
+       "_oneByteBytecodeSticky"},
+      {kTwoByteStringCid, true, "_twoByteFunctionSticky",
+       "_twoByteBytecodeSticky"},
+  };
+  Function& func = Function::Handle();
+  TypedData& bc = TypedData::Handle();
+  for (const auto& spec : specializations) {
+    if (has_function(spec.cid, spec.sticky)) {
+      func = function(spec.cid, spec.sticky);
+      jsobj.AddProperty(spec.function_name, func);
+    } else {
+      bc = bytecode(spec.cid == kOneByteStringCid, spec.sticky);
+      jsobj.AddProperty(spec.bytecode_name, bc);
+    }
   }
 }
 
@@ -275,6 +275,7 @@ class ObjectPointerVisitor;
   RW(Code, type_parameter_tts_stub)                                            \
   RW(Code, unreachable_tts_stub)                                               \
   RW(Array, ffi_callback_functions)                                            \
+  RW(Array, dispatch_table_interface_selectors)                                \
   RW(Code, slow_tts_stub)                                                      \
   /* Roots for JIT/AOT snapshots are up until here (see to_snapshot() below)*/ \
   RW(Code, await_stub)                                                         \
@@ -292,6 +293,7 @@ class ObjectPointerVisitor;
   RW(Code, suspend_sync_star_at_start_stub)                                    \
   RW(Code, suspend_sync_star_at_yield_stub)                                    \
   RW(Array, dispatch_table_code_entries)                                       \
+  RW(Array, dispatch_table_interface_selector_map)                             \
   RW(GrowableObjectArray, instructions_tables)                                 \
   RW(Array, obfuscation_map)                                                   \
   RW(Array, loading_unit_uris)                                                 \
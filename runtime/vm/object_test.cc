@@ -1383,6 +1383,34 @@ ISOLATE_UNIT_TEST_CASE(StringHashConcat) {
                         String::Handle(String::FromUTF16(clef_utf16 + 1, 1))));
 }
 
+// StringHasher consumes code units in blocks, check that neither the width
+// of the code units nor where a string is split affects the hash.
+ISOLATE_UNIT_TEST_CASE(StringHashBlocks) {
+  const char* chars = "abcdefghijklmnopqrstuvwxyz0123456789";
+  const intptr_t length = strlen(chars);
+  uint16_t wide[64];
+  for (intptr_t i = 0; i < length; i++) {
+    wide[i] = chars[i];
+  }
+  const String& str = String::Handle(String::New(chars));
+  String& prefix = String::Handle();
+  String& suffix = String::Handle();
+  for (intptr_t len = 0; len <= length; len++) {
+    const uword hash = String::Hash(chars, len);
+    EXPECT_EQ(hash, String::Hash(wide, len));
+    EXPECT_EQ(hash, String::Hash(str, 0, len));
+    for (intptr_t split = 0; split <= len; split++) {
+      prefix = String::SubString(str, 0, split);
+      suffix = String::FromUTF16(wide + split, len - split);
+      EXPECT_EQ(hash, String::HashConcat(prefix, suffix));
+    }
+  }
+  // Trailing zeros are not confused with the padding of the last block.
+  const char zeros[] = {'a', 0, 0};
+  EXPECT_NE(String::Hash(zeros, 1), String::Hash(zeros, 2));
+  EXPECT_NE(String::Hash(zeros, 2), String::Hash(zeros, 3));
+}
+
 ISOLATE_UNIT_TEST_CASE(StringSubStringDifferentWidth) {
   // Create 1-byte substring from a 1-byte source string.
   const char* onechars = "\xC3\xB6\xC3\xB1\xC3\xA9";
@@ -211,6 +211,8 @@ class ParsedFunction : public ZoneAllocated {
   Thread* thread() const { return thread_; }
   Isolate* isolate() const { return thread_->isolate(); }
   Zone* zone() const { return thread_->zone(); }
+  // See FlowGraph::set_thread.
+  void set_thread(Thread* thread) { thread_ = thread; }
 
   // Adds only relevant fields: field must be unique and its guarded_cid()
   // relevant.
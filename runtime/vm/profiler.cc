@@ -22,6 +22,7 @@
 #include "vm/native_symbol.h"
 #include "vm/object.h"
 #include "vm/os.h"
+#include "vm/profiler_export.h"
 #include "vm/profiler_service.h"
 #include "vm/reusable_handles.h"
 #include "vm/signal_handler.h"
@@ -591,6 +592,7 @@ void Profiler::Init() {
   ThreadInterrupter::Startup();
   SampleBlockProcessor::Init();
   SampleBlockProcessor::Startup();
+  ProfileExporter::Init();
   initialized_ = true;
 }
 
@@ -1837,8 +1839,21 @@ class StreamableSampleFilter : public SampleFilter {
   const Isolate* isolate_;
 };
 
+// Passes the CPU samples of an isolate regardless of their user tag.
+class ExportableSampleFilter : public SampleFilter {
+ public:
+  ExportableSampleFilter(Dart_Port port, bool take_samples)
+      : SampleFilter(port, kNoTaskFilter, -1, -1, take_samples) {}
+
+  bool FilterSample(Sample* sample) override {
+    return !sample->is_allocation_sample();
+  }
+};
+
 void Profiler::ProcessCompletedBlocks(Isolate* isolate) {
-  if (!Service::profiler_stream.enabled()) return;
+  const bool stream = Service::profiler_stream.enabled();
+  const bool export_profile = ProfileExporter::IsEnabled();
+  if (!stream && !export_profile) return;
   auto thread = Thread::Current();
   if (Isolate::IsSystemIsolate(isolate)) return;
 
@@ -1846,17 +1861,28 @@ void Profiler::ProcessCompletedBlocks(Isolate* isolate) {
   DisableThreadInterruptsScope dtis(thread);
   StackZone zone(thread);
   HandleScope handle_scope(thread);
-  StreamableSampleFilter filter(isolate->main_port(), isolate);
-  Profile profile;
-  profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
-  ServiceEvent event(isolate, ServiceEvent::kCpuSamples);
-  event.set_cpu_profile(&profile);
-  Service::HandleEvent(&event);
+  if (export_profile) {
+    // Leave the blocks for the service stream if it also wants them.
+    ExportableSampleFilter filter(isolate->main_port(),
+                                  /*take_samples=*/!stream);
+    Profile profile;
+    profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+    ProfileExporter::AddProfile(isolate, &profile);
+  }
+  if (stream) {
+    StreamableSampleFilter filter(isolate->main_port(), isolate);
+    Profile profile;
+    profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+    ServiceEvent event(isolate, ServiceEvent::kCpuSamples);
+    event.set_cpu_profile(&profile);
+    Service::HandleEvent(&event);
+  }
 }
 
 void Profiler::IsolateShutdown(Thread* thread) {
   FlushSampleBlocks(thread->isolate());
   ProcessCompletedBlocks(thread->isolate());
+  ProfileExporter::IsolateShutdown(thread->isolate());
 }
 
 void SampleBlockProcessor::ThreadMain(uword parameters) {
@@ -0,0 +1,502 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler_export.h"
+
+#include "platform/text_buffer.h"
+#include "platform/utils.h"
+#include "vm/dart.h"
+#include "vm/datastream.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/profiler.h"
+#include "vm/profiler_service.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+DEFINE_FLAG(charp,
+            profile_export_dir,
+            nullptr,
+            "Continuously write the CPU profile of each isolate to files in "
+            "this directory.");
+DEFINE_FLAG(charp,
+            profile_export_format,
+            "pprof",
+            "Format of the files written to --profile_export_dir: 'pprof' or "
+            "'collapsed'.");
+DEFINE_FLAG(int,
+            profile_export_period,
+            10000,
+            "Milliseconds of CPU samples aggregated into each file written to "
+            "--profile_export_dir.");
+DEFINE_FLAG(int,
+            profile_export_max_stacks,
+            16 * KB,
+            "Maximum number of distinct stacks aggregated in memory before a "
+            "file is written to --profile_export_dir.");
+
+DECLARE_FLAG(int, profile_period);
+
+// Pseudo-frame at the root of samples whose stack walk was cut short.
+static constexpr const char* kTruncatedFunctionName = "[truncated]";
+
+// Minimal encoder for the protobuf wire format used by pprof.
+class ProtobufWriter : public ValueObject {
+ public:
+  ProtobufWriter() : stream_(kInitialSize) {}
+
+  const uint8_t* buffer() const { return stream_.buffer(); }
+  intptr_t length() const { return stream_.bytes_written(); }
+
+  void WriteVarint(intptr_t field, uint64_t value) {
+    WriteTag(field, kVarintWireType);
+    stream_.WriteLEB128(value);
+  }
+
+  // Used for the elements of packed repeated fields.
+  void WriteRawVarint(uint64_t value) { stream_.WriteLEB128(value); }
+
+  void WriteBytes(intptr_t field, const void* bytes, intptr_t length) {
+    WriteTag(field, kLengthDelimitedWireType);
+    stream_.WriteLEB128(static_cast<uint64_t>(length));
+    stream_.WriteBytes(bytes, length);
+  }
+
+  void WriteString(intptr_t field, const char* value) {
+    WriteBytes(field, value, strlen(value));
+  }
+
+  void WriteMessage(intptr_t field, const ProtobufWriter& message) {
+    WriteBytes(field, message.buffer(), message.length());
+  }
+
+  uint8_t* Steal(intptr_t* length) { return stream_.Steal(length); }
+
+ private:
+  static constexpr intptr_t kInitialSize = 64;
+  static constexpr uint64_t kVarintWireType = 0;
+  static constexpr uint64_t kLengthDelimitedWireType = 2;
+
+  void WriteTag(intptr_t field, uint64_t wire_type) {
+    stream_.WriteLEB128((static_cast<uint64_t>(field) << 3) | wire_type);
+  }
+
+  MallocWriteStream stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtobufWriter);
+};
+
+// Field numbers from
+// https://github.com/google/pprof/blob/main/proto/profile.proto.
+enum PprofProfileField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12,
+  kProfileComment = 13,
+};
+
+enum PprofValueTypeField {
+  kValueTypeType = 1,
+  kValueTypeUnit = 2,
+};
+
+enum PprofSampleField {
+  kSampleLocationId = 1,
+  kSampleValue = 2,
+};
+
+enum PprofLocationField {
+  kLocationId = 1,
+  kLocationLine = 4,
+};
+
+enum PprofLineField {
+  kLineFunctionId = 1,
+};
+
+enum PprofFunctionField {
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFilename = 4,
+};
+
+// Fixed prefix of the pprof string table. Function names and script URLs
+// follow it.
+enum PprofString {
+  kEmptyString = 0,
+  kSamplesString,
+  kCountString,
+  kCpuString,
+  kNanosecondsString,
+  kCommentString,
+  kNumFixedStrings,
+};
+
+Mutex* ProfileExporter::mutex_ = nullptr;
+
+void ProfileExporter::Init() {
+  if (mutex_ == nullptr) {
+    mutex_ = new Mutex();
+  }
+}
+
+bool ProfileExporter::IsEnabled() {
+  // The mutex is only created once the profiler is running.
+  return (FLAG_profile_export_dir != nullptr) && (mutex_ != nullptr);
+}
+
+void ProfileExporter::AddProfile(Isolate* isolate, Profile* profile) {
+  ASSERT(IsEnabled());
+  // Only the aggregation happens under the lock, files are written after
+  // releasing it.
+  Output output;
+  {
+    MutexLocker ml(mutex_);
+    ProfileExporter* exporter = isolate->profile_exporter();
+    if (exporter == nullptr) {
+      exporter = new ProfileExporter(isolate->name(), isolate->main_port());
+      isolate->set_profile_exporter(exporter);
+    }
+    exporter->Add(profile);
+    if (exporter->ShouldWrite()) {
+      exporter->TakeOutput(&output);
+    }
+  }
+  WriteOutput(&output);
+}
+
+void ProfileExporter::IsolateShutdown(Isolate* isolate) {
+  if (!IsEnabled()) {
+    return;
+  }
+  Output output;
+  {
+    MutexLocker ml(mutex_);
+    ProfileExporter* exporter = isolate->profile_exporter();
+    if (exporter == nullptr) {
+      return;
+    }
+    isolate->set_profile_exporter(nullptr);
+    exporter->TakeOutput(&output);
+    delete exporter;
+  }
+  WriteOutput(&output);
+}
+
+ProfileExporter::ProfileExporter(const char* isolate_name, Dart_Port port)
+    : isolate_name_(Utils::StrDup(isolate_name)), port_(port) {}
+
+ProfileExporter::~ProfileExporter() {
+  Reset();
+  free(isolate_name_);
+}
+
+uword ProfileExporter::StackTrait::Hash(Key key) {
+  uint32_t hash = 0;
+  for (intptr_t i = 0; i < key->length; i++) {
+    hash = CombineHashes(hash, static_cast<uint32_t>(key->functions[i]));
+  }
+  return FinalizeHash(hash, kBitsPerInt32 - 1);
+}
+
+bool ProfileExporter::StackTrait::IsKeyEqual(Pair kv, Key key) {
+  return (kv->length == key->length) &&
+         (memcmp(kv->functions, key->functions,
+                 key->length * sizeof(intptr_t)) == 0);
+}
+
+uword ProfileExporter::FunctionTrait::Hash(const Key& key) {
+  uint32_t hash = Utils::StringHash(key.name, strlen(key.name));
+  if (key.url != nullptr) {
+    hash = CombineHashes(hash, Utils::StringHash(key.url, strlen(key.url)));
+  }
+  return FinalizeHash(hash, kBitsPerInt32 - 1);
+}
+
+bool ProfileExporter::FunctionTrait::IsKeyEqual(const Pair& kv,
+                                                const Key& key) {
+  if (strcmp(kv.key.name, key.name) != 0) {
+    return false;
+  }
+  if ((kv.key.url == nullptr) || (key.url == nullptr)) {
+    return kv.key.url == key.url;
+  }
+  return strcmp(kv.key.url, key.url) == 0;
+}
+
+intptr_t ProfileExporter::FunctionIndex(const char* name, const char* url) {
+  auto* pair = function_indices_.Lookup({name, url});
+  if (pair != nullptr) {
+    return pair->value;
+  }
+  ExportedFunction function;
+  function.name = Utils::StrDup(name);
+  function.url = (url != nullptr) ? Utils::StrDup(url) : nullptr;
+  const intptr_t index = functions_.length();
+  functions_.Add(function);
+  function_indices_.Insert({{function.name, function.url}, index});
+  return index;
+}
+
+void ProfileExporter::Add(Profile* profile) {
+  // Note that |cache| is zone-allocated, so it does not need to be
+  // deallocated manually.
+  auto* cache = new ProfileCodeInlinedFunctionsCache();
+  GrowableArray<ProfileFunction*> sample_functions;
+  MallocGrowableArray<intptr_t> indices;
+  for (intptr_t i = 0; i < profile->sample_count(); i++) {
+    ProcessedSample* sample = profile->SampleAt(i);
+    sample_functions.Clear();
+    profile->GetSampleFunctions(sample, cache, &sample_functions);
+
+    indices.Clear();
+    if (sample->truncated()) {
+      indices.Add(FunctionIndex(kTruncatedFunctionName, nullptr));
+    }
+    for (intptr_t j = 0; j < sample_functions.length(); j++) {
+      ProfileFunction* function = sample_functions[j];
+      indices.Add(
+          FunctionIndex(function->Name(), function->ResolvedScriptUrl()));
+    }
+    if (indices.is_empty()) {
+      continue;
+    }
+
+    Stack key = {indices.length(), 0, indices.data()};
+    Stack* stack = stack_set_.LookupValue(&key);
+    if (stack == nullptr) {
+      stack = reinterpret_cast<Stack*>(malloc(sizeof(Stack)));
+      stack->length = indices.length();
+      stack->count = 0;
+      stack->functions = reinterpret_cast<intptr_t*>(
+          malloc(indices.length() * sizeof(intptr_t)));
+      memmove(stack->functions, indices.data(),
+              indices.length() * sizeof(intptr_t));
+      stacks_.Add(stack);
+      stack_set_.Insert(stack);
+    }
+    stack->count++;
+
+    const int64_t timestamp = sample->timestamp();
+    if ((start_micros_ < 0) || (timestamp < start_micros_)) {
+      start_micros_ = timestamp;
+    }
+    if (timestamp > end_micros_) {
+      end_micros_ = timestamp;
+    }
+  }
+}
+
+bool ProfileExporter::ShouldWrite() const {
+  if (stacks_.is_empty()) {
+    return false;
+  }
+  if (stacks_.length() >= FLAG_profile_export_max_stacks) {
+    return true;
+  }
+  const int64_t period_micros = static_cast<int64_t>(
+      FLAG_profile_export_period) * kMicrosecondsPerMillisecond;
+  return (end_micros_ - start_micros_) >= period_micros;
+}
+
+void ProfileExporter::TakeOutput(Output* output) {
+  ASSERT(output->path == nullptr);
+  if (stacks_.is_empty()) {
+    return;
+  }
+
+  const bool collapsed = strcmp(FLAG_profile_export_format, "collapsed") == 0;
+  if (!collapsed && (strcmp(FLAG_profile_export_format, "pprof") != 0)) {
+    OS::PrintErr("warning: Unknown --profile_export_format '%s', using "
+                 "'pprof'.\n",
+                 FLAG_profile_export_format);
+  }
+
+  // Isolate names are usually script URIs, so keep only the characters that
+  // are safe in file names.
+  char* name = Utils::StrDup(isolate_name_);
+  for (char* c = name; *c != '\0'; c++) {
+    if (!Utils::IsAlphaNumeric(*c) && (*c != '-') && (*c != '.')) {
+      *c = '_';
+    }
+  }
+  output->path = Utils::SCreate("%s/%s-%" Pd64 "-%" Pd ".%s",
+                                FLAG_profile_export_dir, name, port_,
+                                sequence_number_++,
+                                collapsed ? "collapsed" : "pb");
+  free(name);
+
+  output->data = collapsed ? SerializeCollapsed(&output->length)
+                           : SerializePprof(&output->length);
+  Reset();
+}
+
+void ProfileExporter::WriteOutput(Output* output) {
+  if (output->path == nullptr) {
+    return;
+  }
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+  } else if (void* file = file_open(output->path, /*write=*/true)) {
+    file_write(output->data, output->length, file);
+    file_close(file);
+  } else {
+    OS::PrintErr("warning: Failed to write CPU profile: %s\n",
+                 output->path);
+  }
+  free(output->path);
+  free(output->data);
+  output->path = nullptr;
+  output->data = nullptr;
+  output->length = 0;
+}
+
+uint8_t* ProfileExporter::SerializeCollapsed(intptr_t* length) {
+  TextBuffer buffer(KB);
+  for (intptr_t i = 0; i < stacks_.length(); i++) {
+    const Stack* stack = stacks_[i];
+    for (intptr_t j = 0; j < stack->length; j++) {
+      if (j > 0) {
+        buffer.AddChar(';');
+      }
+      buffer.AddString(functions_[stack->functions[j]].name);
+    }
+    buffer.Printf(" %" Pd "\n", stack->count);
+  }
+  *length = buffer.length();
+  return reinterpret_cast<uint8_t*>(buffer.Steal());
+}
+
+uint8_t* ProfileExporter::SerializePprof(intptr_t* length) {
+  const int64_t period_nanos =
+      static_cast<int64_t>(FLAG_profile_period) * kNanosecondsPerMicrosecond;
+  const intptr_t num_functions = functions_.length();
+  ProtobufWriter profile;
+
+  {
+    ProtobufWriter samples_type;
+    samples_type.WriteVarint(kValueTypeType, kSamplesString);
+    samples_type.WriteVarint(kValueTypeUnit, kCountString);
+    profile.WriteMessage(kProfileSampleType, samples_type);
+    ProtobufWriter cpu_type;
+    cpu_type.WriteVarint(kValueTypeType, kCpuString);
+    cpu_type.WriteVarint(kValueTypeUnit, kNanosecondsString);
+    profile.WriteMessage(kProfileSampleType, cpu_type);
+  }
+
+  for (intptr_t i = 0; i < stacks_.length(); i++) {
+    const Stack* stack = stacks_[i];
+    // pprof expects the leaf first. Location ids are function indices + 1.
+    ProtobufWriter location_ids;
+    for (intptr_t j = stack->length - 1; j >= 0; j--) {
+      location_ids.WriteRawVarint(stack->functions[j] + 1);
+    }
+    ProtobufWriter values;
+    values.WriteRawVarint(stack->count);
+    values.WriteRawVarint(stack->count * period_nanos);
+    ProtobufWriter sample;
+    sample.WriteMessage(kSampleLocationId, location_ids);
+    sample.WriteMessage(kSampleValue, values);
+    profile.WriteMessage(kProfileSample, sample);
+  }
+
+  // Functions are not attributed to lines, so there is exactly one location
+  // per function and both share the same id.
+  for (intptr_t i = 0; i < num_functions; i++) {
+    ProtobufWriter line;
+    line.WriteVarint(kLineFunctionId, i + 1);
+    ProtobufWriter location;
+    location.WriteVarint(kLocationId, i + 1);
+    location.WriteMessage(kLocationLine, line);
+    profile.WriteMessage(kProfileLocation, location);
+  }
+
+  for (intptr_t i = 0; i < num_functions; i++) {
+    const intptr_t name = kNumFixedStrings + i;
+    const intptr_t url = (functions_[i].url != nullptr)
+                             ? kNumFixedStrings + num_functions + i
+                             : kEmptyString;
+    ProtobufWriter function;
+    function.WriteVarint(kFunctionId, i + 1);
+    function.WriteVarint(kFunctionName, name);
+    function.WriteVarint(kFunctionSystemName, name);
+    function.WriteVarint(kFunctionFilename, url);
+    profile.WriteMessage(kProfileFunction, function);
+  }
+
+  char* comment = Utils::SCreate("isolate: %s (port %" Pd64 ")", isolate_name_,
+                                 port_);
+  profile.WriteString(kProfileStringTable, "");
+  profile.WriteString(kProfileStringTable, "samples");
+  profile.WriteString(kProfileStringTable, "count");
+  profile.WriteString(kProfileStringTable, "cpu");
+  profile.WriteString(kProfileStringTable, "nanoseconds");
+  profile.WriteString(kProfileStringTable, comment);
+  free(comment);
+  for (intptr_t i = 0; i < num_functions; i++) {
+    profile.WriteString(kProfileStringTable, functions_[i].name);
+  }
+  for (intptr_t i = 0; i < num_functions; i++) {
+    const char* url = functions_[i].url;
+    profile.WriteString(kProfileStringTable, (url != nullptr) ? url : "");
+  }
+
+  // Sample timestamps are in the monotonic clock, so they are rebased onto
+  // the wall clock for pprof.
+  const int64_t now_micros = OS::GetCurrentTimeMicros();
+  const int64_t start_micros =
+      now_micros - (OS::GetCurrentMonotonicMicros() - start_micros_);
+  profile.WriteVarint(kProfileTimeNanos,
+                      start_micros * kNanosecondsPerMicrosecond);
+  profile.WriteVarint(
+      kProfileDurationNanos,
+      (end_micros_ - start_micros_) * kNanosecondsPerMicrosecond);
+  {
+    ProtobufWriter period_type;
+    period_type.WriteVarint(kValueTypeType, kCpuString);
+    period_type.WriteVarint(kValueTypeUnit, kNanosecondsString);
+    profile.WriteMessage(kProfilePeriodType, period_type);
+  }
+  profile.WriteVarint(kProfilePeriod, period_nanos);
+  profile.WriteVarint(kProfileComment, kCommentString);
+
+  return profile.Steal(length);
+}
+
+void ProfileExporter::Reset() {
+  for (intptr_t i = 0; i < stacks_.length(); i++) {
+    free(stacks_[i]->functions);
+    free(stacks_[i]);
+  }
+  stacks_.Clear();
+  stack_set_.Clear();
+  for (intptr_t i = 0; i < functions_.length(); i++) {
+    free(functions_[i].name);
+    free(functions_[i].url);
+  }
+  functions_.Clear();
+  function_indices_.Clear();
+  start_micros_ = -1;
+  end_micros_ = -1;
+}
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
@@ -0,0 +1,138 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROFILER_EXPORT_H_
+#define RUNTIME_VM_PROFILER_EXPORT_H_
+
+#include "include/dart_api.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+class Isolate;
+class Mutex;
+class Profile;
+
+// Continuously writes the CPU samples of an isolate to files in
+// --profile_export_dir, either as pprof protobufs or as collapsed stacks
+// that flame graph tools accept.
+//
+// Samples are symbolized on the sample block processor thread, so the
+// mutator only pays for taking the samples. Stacks are aggregated in memory
+// and written out when --profile_export_period has elapsed, when
+// --profile_export_max_stacks distinct stacks have been seen, and when the
+// isolate shuts down. Every write starts a new file and resets the
+// aggregation, so memory use does not grow with the lifetime of the isolate.
+// Files are serialized under the exporter lock but written after releasing
+// it, so disk I/O does not hold up the other isolates.
+class ProfileExporter : public MallocAllocated {
+ public:
+  static void Init();
+
+  static bool IsEnabled();
+
+  // Adds the CPU samples in |profile| to the export state of |isolate|.
+  static void AddProfile(Isolate* isolate, Profile* profile);
+
+  // Writes any pending samples of |isolate| and releases its export state.
+  static void IsolateShutdown(Isolate* isolate);
+
+  ~ProfileExporter();
+
+ private:
+  // A distinct stack and the number of samples that hit it.
+  struct Stack {
+    intptr_t length;
+    intptr_t count;
+    intptr_t* functions;  // Indices into functions_, outermost first.
+  };
+
+  struct StackTrait {
+    using Key = const Stack*;
+    using Value = Stack*;
+    using Pair = Stack*;
+
+    static Key KeyOf(Pair kv) { return kv; }
+    static Value ValueOf(Pair kv) { return kv; }
+    static uword Hash(Key key);
+    static bool IsKeyEqual(Pair kv, Key key);
+  };
+
+  struct ExportedFunction {
+    char* name;
+    char* url;  // Can be nullptr.
+  };
+
+  // Maps the name and url of a function to its index in functions_.
+  // Functions with the same name in different libraries are distinct.
+  struct FunctionTrait {
+    struct Key {
+      const char* name;
+      const char* url;  // Can be nullptr.
+    };
+    using Value = intptr_t;
+
+    static constexpr Value kNoValue = -1;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key({nullptr, nullptr}), value(kNoValue) {}
+      Pair(const Key& key, const Value& value) : key(key), value(value) {}
+    };
+
+    static Key KeyOf(const Pair& pair) { return pair.key; }
+    static Value ValueOf(const Pair& pair) { return pair.value; }
+    static uword Hash(const Key& key);
+    static bool IsKeyEqual(const Pair& kv, const Key& key);
+  };
+
+  // A serialized profile waiting to be written to |path|.
+  struct Output {
+    char* path = nullptr;
+    uint8_t* data = nullptr;
+    intptr_t length = 0;
+  };
+
+  ProfileExporter(const char* isolate_name, Dart_Port port);
+
+  void Add(Profile* profile);
+  intptr_t FunctionIndex(const char* name, const char* url);
+  bool ShouldWrite() const;
+  // Serializes the aggregated stacks into |output|, unless there are none,
+  // and resets the aggregation.
+  void TakeOutput(Output* output);
+  uint8_t* SerializeCollapsed(intptr_t* length);
+  uint8_t* SerializePprof(intptr_t* length);
+  void Reset();
+
+  // Writes |output|, if any, and frees it. Must not hold mutex_.
+  static void WriteOutput(Output* output);
+
+  static Mutex* mutex_;
+
+  char* isolate_name_;
+  const Dart_Port port_;
+  intptr_t sequence_number_ = 0;
+  int64_t start_micros_ = -1;
+  int64_t end_micros_ = -1;
+  MallocGrowableArray<ExportedFunction> functions_;
+  MallocDirectChainedHashMap<FunctionTrait> function_indices_;
+  MallocGrowableArray<Stack*> stacks_;
+  MallocDirectChainedHashMap<StackTrait> stack_set_;
+
+  friend class ProfileExporterTestHelper;
+  DISALLOW_COPY_AND_ASSIGN(ProfileExporter);
+};
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROFILER_EXPORT_H_
@@ -1746,6 +1746,48 @@ void Profile::ProcessInlinedFunctionFrameJSON(
   PrintFunctionFrameIndexJSON(stack, function);
 }
 
+void Profile::GetSampleFunctions(ProcessedSample* sample,
+                                 ProfileCodeInlinedFunctionsCache* cache,
+                                 GrowableArray<ProfileFunction*>* functions) {
+  Code& code = Code::Handle();
+  for (intptr_t frame_index = sample->length() - 1; frame_index >= 0;
+       frame_index--) {
+    const uword pc = sample->At(frame_index);
+    ProfileCode* profile_code = GetCodeFromPC(pc, sample->timestamp());
+    ASSERT(profile_code != nullptr);
+    ProfileFunction* function = profile_code->function();
+    ASSERT(function != nullptr);
+
+    // Don't show stubs in stack traces.
+    if (!function->is_visible() ||
+        (function->kind() == ProfileFunction::kStubFunction)) {
+      continue;
+    }
+
+    GrowableArray<const Function*>* inlined_functions = nullptr;
+    GrowableArray<TokenPosition>* inlined_token_positions = nullptr;
+    TokenPosition token_position = TokenPosition::kNoSource;
+    if (profile_code->code().IsCode()) {
+      code ^= profile_code->code().ptr();
+      cache->Get(pc, code, sample, frame_index, &inlined_functions,
+                 &inlined_token_positions, &token_position);
+    }
+
+    if ((inlined_functions == nullptr) || (inlined_functions->length() <= 1)) {
+      functions->Add(function);
+      continue;
+    }
+
+    // Inlined functions are ordered from the outermost to the innermost.
+    for (intptr_t i = 0; i < inlined_functions->length(); i++) {
+      const Function* inlined_function = (*inlined_functions)[i];
+      ASSERT(inlined_function != nullptr);
+      ASSERT(!inlined_function->IsNull());
+      functions->Add(functions_->LookupOrAdd(*inlined_function));
+    }
+  }
+}
+
 void Profile::PrintFunctionFrameIndexJSON(JSONArray* stack,
                                           ProfileFunction* function) {
   stack->AddValue64(function->table_index());
@@ -400,6 +400,13 @@ class Profile : public ValueObject {
 
   ProfileFunction* FindFunction(const Function& function);
 
+  // Appends the functions on the stack of |sample| to |functions|, starting
+  // with the outermost caller. Inlined frames are expanded and stubs are
+  // skipped, matching the stacks printed by PrintProfileJSON.
+  void GetSampleFunctions(ProcessedSample* sample,
+                          ProfileCodeInlinedFunctionsCache* cache,
+                          GrowableArray<ProfileFunction*>* functions);
+
  private:
   void PrintHeaderJSON(JSONObject* obj);
   void ProcessSampleFrameJSON(JSONArray* stack,
@@ -8,6 +8,7 @@
 #include "vm/dart_api_state.h"
 #include "vm/globals.h"
 #include "vm/profiler.h"
+#include "vm/profiler_export.h"
 #include "vm/profiler_service.h"
 #include "vm/source_report.h"
 #include "vm/symbols.h"
@@ -768,6 +769,181 @@ ISOLATE_UNIT_TEST_CASE(Profiler_FunctionTicks) {
   }
 }
 
+class ProfileExporterTestHelper {
+ public:
+  // Returns |profile| as serialized by the exporter of an isolate in
+  // |format|, either "collapsed" or "pprof". The result is malloc-allocated.
+  static uint8_t* Export(Profile* profile,
+                         const char* format,
+                         intptr_t* length) {
+    ProfileExporter exporter("test", ILLEGAL_PORT);
+    exporter.Add(profile);
+    if (strcmp(format, "collapsed") == 0) {
+      return exporter.SerializeCollapsed(length);
+    }
+    return exporter.SerializePprof(length);
+  }
+
+  // Checks that functions are exported once per name and url.
+  static void CheckFunctionIndices() {
+    ProfileExporter exporter("test", ILLEGAL_PORT);
+    const intptr_t a_foo = exporter.FunctionIndex("foo", "a.dart");
+    const intptr_t b_foo = exporter.FunctionIndex("foo", "b.dart");
+    const intptr_t foo = exporter.FunctionIndex("foo", nullptr);
+    EXPECT(a_foo != b_foo);
+    EXPECT(a_foo != foo);
+    EXPECT(b_foo != foo);
+    EXPECT_EQ(a_foo, exporter.FunctionIndex("foo", "a.dart"));
+    EXPECT_EQ(b_foo, exporter.FunctionIndex("foo", "b.dart"));
+    EXPECT_EQ(foo, exporter.FunctionIndex("foo", nullptr));
+    EXPECT_EQ(3, exporter.functions_.length());
+    EXPECT_STREQ("b.dart", exporter.functions_[b_foo].url);
+  }
+};
+
+// Decodes just enough of the protobuf wire format to check pprof output.
+class ProtobufReader : public ValueObject {
+ public:
+  ProtobufReader(const uint8_t* data, intptr_t length)
+      : current_(data), end_(data + length) {}
+
+  bool HasMore() const { return current_ < end_; }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (intptr_t shift = 0; current_ < end_; shift += 7) {
+      const uint8_t byte = *current_++;
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) break;
+    }
+    return value;
+  }
+
+  // Reads a field tag and returns the field number. Sets |bytes| and
+  // |length| for length delimited fields and |value| for varints.
+  intptr_t ReadField(const uint8_t** bytes, intptr_t* length, uint64_t* value) {
+    const uint64_t tag = ReadVarint();
+    *bytes = nullptr;
+    *length = 0;
+    *value = 0;
+    switch (tag & 7) {
+      case 0:
+        *value = ReadVarint();
+        break;
+      case 2:
+        *length = ReadVarint();
+        *bytes = current_;
+        current_ += *length;
+        break;
+      default:
+        FATAL("Unexpected wire type %" Pu64, tag & 7);
+    }
+    return tag >> 3;
+  }
+
+ private:
+  const uint8_t* current_;
+  const uint8_t* const end_;
+};
+
+ISOLATE_UNIT_TEST_CASE(Profiler_Export) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  DisableBackgroundCompilationScope dbcs;
+  const char* kScript =
+      "class A {\n"
+      "  var a;\n"
+      "  var b;\n"
+      "}\n"
+      "class B {\n"
+      "  static boo() {\n"
+      "    return new A();\n"
+      "  }\n"
+      "}\n"
+      "main() {\n"
+      "  return B.boo();\n"
+      "}\n";
+
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+  const Class& class_a = Class::Handle(GetClass(root_library, "A"));
+  EXPECT(!class_a.IsNull());
+  class_a.SetTraceAllocation(true);
+  Invoke(root_library, "main");
+  Invoke(root_library, "main");
+  Invoke(root_library, "main");
+
+  Isolate* isolate = thread->isolate();
+  StackZone zone(thread);
+  Profile profile;
+  AllocationFilter filter(isolate->main_port(), class_a.id());
+  profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+  EXPECT_EQ(3, profile.sample_count());
+
+  // Collapsed stacks list the frames outermost first, without stubs.
+  intptr_t length = 0;
+  char* collapsed = reinterpret_cast<char*>(
+      ProfileExporterTestHelper::Export(&profile, "collapsed", &length));
+  EXPECT_EQ(static_cast<intptr_t>(strlen(collapsed)), length);
+  EXPECT_STREQ("main;B.boo 3\n", collapsed);
+  free(collapsed);
+
+  uint8_t* pprof =
+      ProfileExporterTestHelper::Export(&profile, "pprof", &length);
+  GrowableArray<const char*> strings;
+  intptr_t sample_types = 0;
+  GrowableArray<uint64_t> location_ids;
+  GrowableArray<uint64_t> values;
+  intptr_t samples = 0;
+  const uint8_t* bytes;
+  intptr_t bytes_length;
+  uint64_t value;
+  ProtobufReader reader(pprof, length);
+  while (reader.HasMore()) {
+    switch (reader.ReadField(&bytes, &bytes_length, &value)) {
+      case 1:  // Profile.sample_type
+        sample_types++;
+        break;
+      case 2: {  // Profile.sample
+        samples++;
+        ProtobufReader sample(bytes, bytes_length);
+        while (sample.HasMore()) {
+          const intptr_t field =
+              sample.ReadField(&bytes, &bytes_length, &value);
+          ProtobufReader packed(bytes, bytes_length);
+          while (packed.HasMore()) {
+            (field == 1 ? location_ids : values).Add(packed.ReadVarint());
+          }
+        }
+        break;
+      }
+      case 6:  // Profile.string_table
+        strings.Add(OS::SCreate(zone.GetZone(), "%.*s",
+                                static_cast<int>(bytes_length),
+                                reinterpret_cast<const char*>(bytes)));
+        break;
+    }
+  }
+  free(pprof);
+
+  EXPECT_EQ(2, sample_types);
+  EXPECT_EQ(1, samples);
+  EXPECT_EQ(2, values.length());
+  EXPECT_EQ(3u, values[0]);
+  // Locations are listed leaf first. The names of the functions of location
+  // i follow the 6 fixed strings at index 5 + i.
+  EXPECT_EQ(2, location_ids.length());
+  // Fixed strings, then a name and a URL per function.
+  EXPECT_EQ(10, strings.length());
+  EXPECT_STREQ("", strings[0]);
+  EXPECT_STREQ("samples", strings[1]);
+  EXPECT_STREQ("B.boo", strings[5 + static_cast<intptr_t>(location_ids[0])]);
+  EXPECT_STREQ("main", strings[5 + static_cast<intptr_t>(location_ids[1])]);
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_ExportFunctionIndices) {
+  ProfileExporterTestHelper::CheckFunctionIndices();
+}
+
 ISOLATE_UNIT_TEST_CASE(Profiler_IntrinsicAllocation) {
   EnableProfiler();
   DisableNativeProfileScope dnps;
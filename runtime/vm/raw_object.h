@@ -271,6 +271,9 @@ class UntaggedObject {
   //    `IsShallowlyImmutableCid(intptr_t predefined_cid)`
   //    a. Unmodifiable typed data view (backing store may be mutable).
   //    b. Closures (the context may be modifiable).
+  // 3. Objects of a graph frozen by `deepFreeze` from `dart:concurrent`.
+  //    `DeepFreezeObjectGraph`. Such objects only refer to objects which are
+  //    deeply immutable themselves.
   //
   // The bit is used in `CanShareObject` in object_graph_copy, where special
   // care is taken to look at the shallow immutable instances. Shallow immutable
@@ -3608,6 +3611,11 @@ class UntaggedRegExp : public UntaggedInstance {
   // It is possible multiple compilers race to update the flags concurrently.
   // That should be safe since all updates update to the same values..
   AtomicBitFieldContainer<int8_t> type_flags_;
+
+  // Number of interpreted matches while the pattern has not tiered up to
+  // compiled code, see --regexp-tier-up-executions. Fits in the padding at
+  // the end of the object.
+  std::atomic<uint16_t> num_executions_;
 };
 
 class UntaggedWeakProperty : public UntaggedInstance {
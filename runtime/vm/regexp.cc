@@ -3001,17 +3001,7 @@ void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
       GetSkipTable(min_lookahead, max_lookahead, boolean_skip_table);
   ASSERT(skip_distance != 0);
 
-  BlockLabel cont, again;
-
-  masm->BindBlock(&again);
-  masm->CheckPreemption(/*is_backtrack=*/false);
-  masm->LoadCurrentCharacter(max_lookahead, &cont, true);
-  masm->CheckBitInTable(boolean_skip_table, &cont);
-  masm->AdvanceCurrentPosition(skip_distance);
-  masm->GoTo(&again);
-  masm->BindBlock(&cont);
-
-  return;
+  masm->SkipUntilBitInTable(max_lookahead, boolean_skip_table, skip_distance);
 }
 
 /* Code generation for choice nodes.
@@ -5417,7 +5407,7 @@ RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     bool is_one_byte,
     bool is_sticky,
     Zone* zone) {
-  ASSERT(FLAG_interpret_irregexp);
+  ASSERT(FLAG_interpret_irregexp || (FLAG_regexp_tier_up_executions > 0));
   const String& pattern = String::Handle(zone, regexp.pattern());
 
   ASSERT(!regexp.IsNull());
@@ -5584,7 +5574,8 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
-  if (!FLAG_interpret_irregexp) {
+  // With tier-up the functions are created once the pattern is hot.
+  if (!FLAG_interpret_irregexp && (FLAG_regexp_tier_up_executions == 0)) {
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
         Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
@@ -5600,4 +5591,47 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   return regexp.ptr();
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+bool RegExpEngine::TierUpIfHot(Thread* thread,
+                               const RegExp& regexp,
+                               intptr_t cid,
+                               bool sticky) {
+  ASSERT(!FLAG_interpret_irregexp);
+  if (regexp.has_function(cid, sticky)) {
+    return true;
+  }
+  // The count may miss concurrent matches from other isolates of the group,
+  // which only delays tiering up.
+  const intptr_t threshold =
+      Utils::Minimum<intptr_t>(FLAG_regexp_tier_up_executions, kMaxUint16);
+  const intptr_t executions = regexp.num_executions();
+  if (executions < threshold) {
+    regexp.set_num_executions(executions + 1);
+    return false;
+  }
+  EnsureSpecializedFunction(thread, regexp, cid, sticky);
+  return true;
+}
+
+void RegExpEngine::EnsureSpecializedFunction(Thread* thread,
+                                             const RegExp& regexp,
+                                             intptr_t cid,
+                                             bool sticky) {
+  ASSERT(!FLAG_interpret_irregexp);
+  if (regexp.has_function(cid, sticky)) {
+    return;
+  }
+  // The slot of the function holds the bytecode until then, which other
+  // mutators may be about to install.
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  if (regexp.has_function(cid, sticky)) {
+    return;
+  }
+  Zone* zone = thread->zone();
+  const Library& lib = Library::Handle(zone, Library::CoreLibrary());
+  const Class& owner = Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
+  CreateSpecializedFunction(thread, zone, regexp, cid, sticky, owner);
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 }  // namespace dart
@@ -1515,6 +1515,29 @@ class RegExpEngine : public AllStatic {
                                 const String& pattern,
                                 RegExpFlags flags);
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Returns true if [regexp] should be matched against a subject of class
+  // [cid] by compiled code rather than by the bytecode interpreter.
+  //
+  // Unless --interpret-irregexp is given, patterns are interpreted until they
+  // have been matched --regexp-tier-up-executions times, which spares
+  // patterns that are only used a few times the cost of compiling them. The
+  // specialized function for each kind of subject is then created the first
+  // time the pattern is matched against such a subject, and compiled lazily
+  // when called.
+  static bool TierUpIfHot(Thread* thread,
+                          const RegExp& regexp,
+                          intptr_t cid,
+                          bool sticky);
+
+  // Creates the function matching [regexp] against subjects of class [cid]
+  // unless it exists.
+  static void EnsureSpecializedFunction(Thread* thread,
+                                        const RegExp& regexp,
+                                        intptr_t cid,
+                                        bool sticky);
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
@@ -99,8 +99,9 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(CaseInsensitiveCompareUTF16,
 
 BlockLabel::BlockLabel() {
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
-    // Only needed by the compiled IR backend.
+  // Only needed by the compiled IR backend, which is not used to compile
+  // bytecode for patterns which have not tiered up yet.
+  if (!FLAG_interpret_irregexp && Thread::Current()->HasCompilerState()) {
     block_ =
         new JoinEntryInstr(-1, -1, CompilerState::Current().GetNextDeoptId());
   }
@@ -112,6 +113,19 @@ RegExpMacroAssembler::RegExpMacroAssembler(Zone* zone)
 
 RegExpMacroAssembler::~RegExpMacroAssembler() {}
 
+void RegExpMacroAssembler::SkipUntilBitInTable(intptr_t cp_offset,
+                                               const TypedData& table,
+                                               intptr_t advance_by) {
+  BlockLabel cont, again;
+  BindBlock(&again);
+  CheckPreemption(/*is_backtrack=*/false);
+  LoadCurrentCharacter(cp_offset, &cont, true);
+  CheckBitInTable(table, &cont);
+  AdvanceCurrentPosition(advance_by);
+  GoTo(&again);
+  BindBlock(&cont);
+}
+
 void RegExpMacroAssembler::CheckNotInSurrogatePair(intptr_t cp_offset,
                                                    BlockLabel* on_failure) {
   BlockLabel ok;
@@ -172,6 +172,12 @@ class RegExpMacroAssembler : public ZoneAllocated {
   // array, and if the found byte is non-zero, we jump to the on_bit_set label.
   virtual void CheckBitInTable(const TypedData& table,
                                BlockLabel* on_bit_set) = 0;
+  // Advances the current position by advance_by until the character at
+  // cp_offset from it (modulus the kTableSize) is set in the byte array or
+  // lies past the end of the input. May clobber the current character.
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t advance_by);
 
   // Checks for preemption and serves as an OSR entry.
   virtual void CheckPreemption(bool is_backtrack) {}
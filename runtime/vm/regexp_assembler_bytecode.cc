@@ -11,11 +11,22 @@
 #include "vm/regexp_assembler_bytecode_inl.h"
 #include "vm/regexp_bytecodes.h"
 #include "vm/regexp_interpreter.h"
+#include "vm/regexp_linear.h"
 #include "vm/regexp_parser.h"
 #include "vm/timeline.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            regexp_linear_engine,
+            false,
+            "Match regexps in linear time when their pattern allows it.");
+DEFINE_FLAG(int,
+            regexp_backtracks_before_fallback,
+            0,
+            "Finish matches which backtrack more than this many times in "
+            "linear time when the pattern allows it (0 means never).");
+
 BytecodeRegExpMacroAssembler::BytecodeRegExpMacroAssembler(
     ZoneGrowableArray<uint8_t>* buffer,
     Zone* zone)
@@ -335,6 +346,23 @@ void BytecodeRegExpMacroAssembler::CheckBitInTable(const TypedData& table,
   }
 }
 
+void BytecodeRegExpMacroAssembler::SkipUntilBitInTable(intptr_t cp_offset,
+                                                       const TypedData& table,
+                                                       intptr_t advance_by) {
+  ASSERT(cp_offset >= 0);
+  ASSERT(cp_offset <= kMaxCPOffset);
+  ASSERT(advance_by > 0);
+  Emit(BC_SKIP_UNTIL_BIT_IN_TABLE, cp_offset);
+  Emit32(advance_by);
+  for (int i = 0; i < kTableSize; i += kBitsPerByte) {
+    int byte = 0;
+    for (int j = 0; j < kBitsPerByte; j++) {
+      if (table.GetUint8(i + j) != 0) byte |= 1 << j;
+    }
+    Emit8(byte);
+  }
+}
+
 void BytecodeRegExpMacroAssembler::CheckNotBackReference(
     intptr_t start_reg,
     bool read_backward,
@@ -419,13 +447,20 @@ void BytecodeRegExpMacroAssembler::Expand() {
     buffer_->Add(0);
 }
 
+// Sets [bytecode] to the bytecode of [regexp] for [subject], compiling it if
+// needed, and returns the number of registers it requires.
+//
+// The slot of the bytecode is read only once: once the pattern has tiered up
+// another mutator may replace the bytecode with compiled code at any time.
 static intptr_t Prepare(const RegExp& regexp,
                         const String& subject,
                         bool sticky,
+                        TypedData* bytecode,
                         Zone* zone) {
   bool is_one_byte = subject.IsOneByteString();
 
-  if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
+  *bytecode = regexp.bytecode(is_one_byte, sticky);
+  if (bytecode->IsNull()) {
     const String& pattern = String::Handle(zone, regexp.pattern());
 #if defined(SUPPORT_TIMELINE)
     TimelineBeginEndScope tbes(Thread::Current(), Timeline::GetCompilerStream(),
@@ -455,10 +490,21 @@ static intptr_t Prepare(const RegExp& regexp,
       Exceptions::ThrowUnsupportedError(result.error_message);
     }
     ASSERT(result.bytecode != nullptr);
+    *bytecode = result.bytecode->ptr();
     ASSERT(regexp.num_registers(is_one_byte) == -1 ||
            regexp.num_registers(is_one_byte) == result.num_registers);
     regexp.set_num_registers(is_one_byte, result.num_registers);
-    regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
+    if (FLAG_interpret_irregexp) {
+      regexp.set_bytecode(is_one_byte, sticky, *bytecode);
+    } else {
+      // Don't overwrite compiled code installed in the meantime.
+      Thread* thread = Thread::Current();
+      SafepointWriteRwLocker ml(thread,
+                                thread->isolate_group()->program_lock());
+      if (!regexp.has_function(subject.GetClassId(), sticky)) {
+        regexp.set_bytecode(is_one_byte, sticky, *bytecode);
+      }
+    }
   }
 
   ASSERT(regexp.num_registers(is_one_byte) != -1);
@@ -468,14 +514,14 @@ static intptr_t Prepare(const RegExp& regexp,
 }
 
 static ObjectPtr ExecRaw(const RegExp& regexp,
+                         const TypedData& bytecode,
                          const String& subject,
                          int32_t index,
                          bool sticky,
                          int32_t* output,
                          intptr_t output_size,
+                         intptr_t backtrack_limit,
                          Zone* zone) {
-  bool is_one_byte = subject.IsOneByteString();
-
   // We must have done EnsureCompiledIrregexp, so we can get the number of
   // registers.
   int number_of_capture_registers = (regexp.num_bracket_expressions() + 1) * 2;
@@ -488,11 +534,10 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
     raw_output[i] = -1;
   }
 
-  const TypedData& bytecode =
-      TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
   ASSERT(!bytecode.IsNull());
   const Object& result = Object::Handle(
-      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index));
+      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index,
+                                       backtrack_limit));
 
   if (result.ptr() == Bool::True().ptr()) {
     // Copy capture results to the start of the registers array.
@@ -506,23 +551,67 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
   return result.ptr();
 }
 
+// Returns the result of matching [regexp] in linear time, or the sentinel if
+// its pattern is not supported by the linear engine.
+static ObjectPtr ExecLinear(const RegExp& regexp,
+                            const String& subject,
+                            const Smi& start_index,
+                            bool sticky,
+                            Zone* zone) {
+  RegExpLinearProgram* program =
+      RegExpLinearEngine::Compile(regexp, subject.IsOneByteString(), zone);
+  if (program == nullptr) {
+    return Object::sentinel().ptr();
+  }
+  const Object& result = Object::Handle(
+      zone, RegExpLinearEngine::Match(*program, subject, start_index.Value(),
+                                      sticky, zone));
+  if (result.IsError()) {
+    Exceptions::PropagateError(Error::Cast(result));
+    UNREACHABLE();
+  }
+  return result.ptr();
+}
+
 ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
                                                   const String& subject,
                                                   const Smi& start_index,
                                                   bool sticky,
                                                   Zone* zone) {
-  intptr_t required_registers = Prepare(regexp, subject, sticky, zone);
+  TypedData& bytecode = TypedData::Handle(zone);
+  intptr_t required_registers =
+      Prepare(regexp, subject, sticky, &bytecode, zone);
   if (required_registers < 0) {
     // Compiling failed with an exception.
     UNREACHABLE();
   }
 
+  if (FLAG_regexp_linear_engine) {
+    const Object& result = Object::Handle(
+        zone, ExecLinear(regexp, subject, start_index, sticky, zone));
+    if (result.ptr() != Object::sentinel().ptr()) {
+      return result.ptr();
+    }
+  }
+
   // V8 uses a shared copy on the isolate when smaller than some threshold.
   int32_t* output_registers = zone->Alloc<int32_t>(required_registers);
 
-  const Object& result =
-      Object::Handle(zone, ExecRaw(regexp, subject, start_index.Value(), sticky,
-                                   output_registers, required_registers, zone));
+  Object& result = Object::Handle(
+      zone, ExecRaw(regexp, bytecode, subject, start_index.Value(), sticky,
+                    output_registers, required_registers,
+                    FLAG_regexp_backtracks_before_fallback, zone));
+  if (result.ptr() == Object::sentinel().ptr()) {
+    // The pattern backtracks excessively on this subject. Start over in
+    // linear time if possible, and without a limit otherwise.
+    result = ExecLinear(regexp, subject, start_index, sticky, zone);
+    if (result.ptr() != Object::sentinel().ptr()) {
+      return result.ptr();
+    }
+    result = ExecRaw(regexp, bytecode, subject, start_index.Value(), sticky,
+                     output_registers, required_registers,
+                     /*backtrack_limit=*/0, zone);
+  }
   if (result.ptr() == Bool::True().ptr()) {
     intptr_t capture_count = regexp.num_bracket_expressions();
     intptr_t capture_register_count = (capture_count + 1) * 2;
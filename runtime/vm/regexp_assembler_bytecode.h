@@ -78,6 +78,9 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
                                         uint16_t to,
                                         BlockLabel* on_not_in_range);
   virtual void CheckBitInTable(const TypedData& table, BlockLabel* on_bit_set);
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t advance_by);
   virtual void CheckNotBackReference(intptr_t start_reg,
                                      bool read_backward,
                                      BlockLabel* on_no_match);
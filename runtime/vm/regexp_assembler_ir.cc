@@ -288,6 +288,8 @@ ArrayPtr IRRegExpMacroAssembler::Execute(const RegExp& regexp,
                                          bool sticky,
                                          Zone* zone) {
   const intptr_t cid = input.GetClassId();
+  RegExpEngine::EnsureSpecializedFunction(Thread::Current(), regexp, cid,
+                                          sticky);
   const Function& fun = Function::Handle(regexp.function(cid, sticky));
   ASSERT(!fun.IsNull());
   // Create the argument list.
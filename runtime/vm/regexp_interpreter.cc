@@ -10,6 +10,12 @@
 #include "heap/safepoint.h"
 #include "vm/regexp_interpreter.h"
 
+#if defined(HOST_ARCH_X64) || defined(HOST_ARCH_IA32)
+#include <emmintrin.h>
+#elif defined(HOST_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
 #include "platform/unicode.h"
 #include "vm/object.h"
 #include "vm/regexp_assembler.h"
@@ -133,6 +139,133 @@ static int32_t Load16Aligned(const uint8_t* pc) {
   return *reinterpret_cast<const uint16_t*>(pc);
 }
 
+template <>
+const uint8_t* IrregexpInterpreter::SubjectData<uint8_t>(
+    const String& subject) {
+  return OneByteString::DataStart(subject);
+}
+
+template <>
+const uint16_t* IrregexpInterpreter::SubjectData<uint16_t>(
+    const String& subject) {
+  return TwoByteString::DataStart(subject);
+}
+
+// Whether [c] modulus the table size is set in a table of
+// RegExpMacroAssembler::kTableSize bits.
+static inline bool IsBitInTable(const uint8_t* table, uint32_t c) {
+  c &= RegExpMacroAssembler::kTableMask;
+  return (table[c >> kBitsPerByteLog2] & (1 << (c & (kBitsPerByte - 1)))) != 0;
+}
+
+// Returns the index of the first character of data[from..to) which is set in
+// [table], or [to] if there is none.
+//
+// This scans the subject for the first character of a pattern which is not
+// anchored, so it is the hot loop of matching a pattern which occurs rarely
+// in a long string. Vector instructions compare 16 characters at once: SSE2
+// compares them with each character of a small set, and NEON looks them up
+// in the table split by nibbles.
+static intptr_t FindBitInTable(const uint8_t* data,
+                               intptr_t from,
+                               intptr_t to,
+                               const uint8_t* table) {
+  constexpr intptr_t kVectorSize = 16;
+  intptr_t i = from;
+#if defined(HOST_ARCH_X64) || defined(HOST_ARCH_IA32)
+  constexpr intptr_t kMaxChars = 4;
+  uint8_t chars[kMaxChars];
+  intptr_t num_chars = 0;
+  for (intptr_t c = 0; c < RegExpMacroAssembler::kTableSize; c++) {
+    if (IsBitInTable(table, c)) {
+      if (num_chars == kMaxChars) {
+        num_chars = 0;
+        break;
+      }
+      chars[num_chars++] = c;
+    }
+  }
+  if (num_chars > 0) {
+    const __m128i mask = _mm_set1_epi8(RegExpMacroAssembler::kTableMask);
+    // Repeat the characters of smaller sets to keep the loop branch free.
+    const __m128i c0 = _mm_set1_epi8(chars[0]);
+    const __m128i c1 = _mm_set1_epi8(chars[1 % num_chars]);
+    const __m128i c2 = _mm_set1_epi8(chars[2 % num_chars]);
+    const __m128i c3 = _mm_set1_epi8(chars[3 % num_chars]);
+    for (; i + kVectorSize <= to; i += kVectorSize) {
+      const __m128i v = _mm_and_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), mask);
+      const __m128i hits01 =
+          _mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1));
+      const __m128i hits23 =
+          _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3));
+      const __m128i hits = _mm_or_si128(hits01, hits23);
+      const int bits = _mm_movemask_epi8(hits);
+      if (bits != 0) {
+        return i + Utils::CountTrailingZeros32(bits);
+      }
+    }
+  }
+#elif defined(HOST_ARCH_ARM64)
+  // Character c is in the table if bit (c >> 4) & 7 of low_nibbles[c & 0xf]
+  // is set.
+  uint8_t low_nibbles[kVectorSize] = {};
+  for (intptr_t c = 0; c < RegExpMacroAssembler::kTableSize; c++) {
+    if (IsBitInTable(table, c)) {
+      low_nibbles[c & 0xf] |= 1 << (c >> 4);
+    }
+  }
+  static const uint8_t kHighNibbleBits[kVectorSize] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t low_table = vld1q_u8(low_nibbles);
+  const uint8x16_t high_table = vld1q_u8(kHighNibbleBits);
+  const uint8x16_t low_mask = vdupq_n_u8(0xf);
+  for (; i + kVectorSize <= to; i += kVectorSize) {
+    const uint8x16_t v = vld1q_u8(data + i);
+    const uint8x16_t low = vqtbl1q_u8(low_table, vandq_u8(v, low_mask));
+    const uint8x16_t high = vqtbl1q_u8(high_table, vshrq_n_u8(v, 4));
+    if (vmaxvq_u8(vtstq_u8(low, high)) != 0) {
+      // Found in this block, the loop below locates it.
+      break;
+    }
+  }
+#endif
+  for (; i < to; i++) {
+    if (IsBitInTable(table, data[i])) {
+      return i;
+    }
+  }
+  return to;
+}
+
+// Returns the first position from [current] on, in steps of [advance_by], at
+// which the character [cp_offset] ahead is set in [table] or lies past the
+// end of the subject.
+template <typename Char>
+static int32_t SkipUntilBitInTable(const Char* data,
+                                   intptr_t length,
+                                   int32_t current,
+                                   int32_t cp_offset,
+                                   int32_t advance_by,
+                                   const uint8_t* table) {
+  if ((sizeof(Char) == 1) && (advance_by == 1)) {
+    const intptr_t from = current + cp_offset;
+    if (from >= length) {
+      return current;
+    }
+    return FindBitInTable(reinterpret_cast<const uint8_t*>(data), from, length,
+                          table) -
+           cp_offset;
+  }
+  while (true) {
+    const intptr_t pos = current + cp_offset;
+    if ((pos >= length) || IsBitInTable(table, data[pos])) {
+      return current;
+    }
+    current += advance_by;
+  }
+}
+
 // A simple abstraction over the backtracking stack used by the interpreter.
 // This backtracking stack does not grow automatically, but it ensures that the
 // the memory held by the stack is released or remembered in a cache if the
@@ -177,13 +310,15 @@ class BacktrackStack {
 };
 
 // Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
+// Error if VM error needs to be propagated up the callchain, Sentinel if the
+// backtrack limit was exceeded.
 template <typename Char>
 static ObjectPtr RawMatch(const TypedData& bytecode,
                           const String& subject,
                           int32_t* registers,
                           int32_t current,
-                          uint32_t current_char) {
+                          uint32_t current_char,
+                          intptr_t backtrack_limit) {
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
   // the moment.
@@ -202,6 +337,10 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
 
   intptr_t subject_length = subject.Length();
 
+  // Goes negative on the first backtrack beyond the limit. A limit of zero
+  // means no limit.
+  intptr_t backtracks_left = backtrack_limit > 0 ? backtrack_limit : kIntptrMax;
+
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     OS::PrintErr("Start irregexp bytecode interpreter\n");
@@ -292,6 +431,9 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
         pc += BC_POP_CP_LENGTH;
         break;
         BYTECODE(POP_BT)
+        if (UNLIKELY(--backtracks_left < 0)) {
+          return Object::sentinel().ptr();
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
@@ -679,6 +821,17 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
           pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
           break;
         }
+        BYTECODE(SKIP_UNTIL_BIT_IN_TABLE) {
+          const int32_t cp_offset = insn >> BYTECODE_SHIFT;
+          current = SkipUntilBitInTable(
+              IrregexpInterpreter::SubjectData<Char>(subject), subject_length,
+              current, cp_offset, Load32Aligned(pc + 4), pc + 8);
+          if (current + cp_offset < subject_length) {
+            current_char = subject.CharAt(current + cp_offset);
+          }
+          pc += BC_SKIP_UNTIL_BIT_IN_TABLE_LENGTH;
+          break;
+        }
         default:
           UNREACHABLE();
           break;
@@ -688,11 +841,13 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
 }
 
 // Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
+// Error if VM error needs to be propagated up the callchain, Sentinel if the
+// backtrack limit was exceeded.
 ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
                                      const String& subject,
                                      int32_t* registers,
-                                     int32_t start_position) {
+                                     int32_t start_position,
+                                     intptr_t backtrack_limit) {
   uint16_t previous_char = '\n';
   if (start_position != 0) {
     previous_char = subject.CharAt(start_position - 1);
@@ -700,10 +855,10 @@ ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
 
   if (subject.IsOneByteString()) {
     return RawMatch<uint8_t>(bytecode, subject, registers, start_position,
-                             previous_char);
+                             previous_char, backtrack_limit);
   } else if (subject.IsTwoByteString()) {
     return RawMatch<uint16_t>(bytecode, subject, registers, start_position,
-                              previous_char);
+                              previous_char, backtrack_limit);
   } else {
     UNREACHABLE();
     return Bool::False().ptr();
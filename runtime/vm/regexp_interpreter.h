@@ -17,11 +17,19 @@ class IrregexpInterpreter : public AllStatic {
  public:
   // Returns True in case of a success, False in case of a failure,
   // Null in case of internal exception,
-  // Error in case VM error has to propagated up to the caller.
+  // Error in case VM error has to propagated up to the caller,
+  // Sentinel in case more than [backtrack_limit] backtracks were needed.
+  // A [backtrack_limit] of 0 means no limit.
   static ObjectPtr Match(const TypedData& bytecode,
                          const String& subject,
                          int32_t* captures,
-                         int32_t start_position);
+                         int32_t start_position,
+                         intptr_t backtrack_limit = 0);
+
+  // Returns the code units of [subject], which is a OneByteString if [Char]
+  // is uint8_t and a TwoByteString otherwise. Requires a NoSafepointScope.
+  template <typename Char>
+  static const Char* SubjectData(const String& subject);
 };
 
 }  // namespace dart
@@ -0,0 +1,641 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp_linear.h"
+
+#include "vm/regexp.h"
+#include "vm/regexp_ast.h"
+#include "vm/regexp_parser.h"
+#include "vm/symbols.h"
+#include "vm/thread.h"
+#include "vm/unibrow-inl.h"
+#include "vm/unibrow.h"
+
+namespace dart {
+
+class RegExpLinearProgram : public ZoneAllocated {
+ public:
+  enum Opcode {
+    // Consumes a character in the ranges [x, y) of the program.
+    kConsume,
+    // Continues at x and, with lower priority, at y.
+    kFork,
+    // Continues at x.
+    kJump,
+    // Sets register x to the current position.
+    kSetRegister,
+    // Sets registers [x, y) to -1.
+    kClearRegisters,
+    // Fails unless the current position is past the one in register x.
+    kCheckProgress,
+    // Fails unless the RegExpAssertion::AssertionType x holds.
+    kAssertion,
+    // Reports a match.
+    kAccept,
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    int32_t x;
+    int32_t y;
+  };
+
+  // The program starts with a loop skipping characters in front of the
+  // match, which sticky matches leave out.
+  static constexpr intptr_t kStickyStart = 3;
+
+  explicit RegExpLinearProgram(intptr_t capture_count)
+      : num_capture_registers_((capture_count + 1) * 2),
+        num_registers_(num_capture_registers_) {}
+
+  intptr_t length() const { return instructions_.length(); }
+  const Instruction& InstructionAt(intptr_t pc) const {
+    return instructions_[pc];
+  }
+
+  intptr_t num_capture_registers() const { return num_capture_registers_; }
+  intptr_t num_registers() const { return num_registers_; }
+
+  // Returns true if the kConsume instruction [instr] accepts [c].
+  bool Consumes(const Instruction& instr, int32_t c) const {
+    ASSERT(instr.opcode == kConsume);
+    intptr_t low = instr.x;
+    intptr_t high = instr.y;
+    while (low < high) {
+      const intptr_t mid = low + (high - low) / 2;
+      const CharacterRange& range = ranges_[mid];
+      if (c < range.from()) {
+        high = mid;
+      } else if (c > range.to()) {
+        low = mid + 1;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  GrowableArray<Instruction> instructions_;
+  // Canonical ranges of the kConsume instructions.
+  GrowableArray<CharacterRange> ranges_;
+  const intptr_t num_capture_registers_;
+  // Capture registers followed by the registers of kCheckProgress.
+  intptr_t num_registers_;
+
+  friend class RegExpLinearCompiler;
+
+  DISALLOW_COPY_AND_ASSIGN(RegExpLinearProgram);
+};
+
+class RegExpLinearCompiler : public RegExpVisitor {
+ public:
+  RegExpLinearCompiler(RegExpLinearProgram* program,
+                       bool is_one_byte,
+                       Zone* zone)
+      : program_(program), is_one_byte_(is_one_byte), zone_(zone) {}
+
+  // Returns false if [tree] cannot be matched by an automaton.
+  bool Compile(RegExpTree* tree);
+
+#define DECLARE_VISIT(Name)                                                    \
+  virtual void* Visit##Name(RegExp##Name* that, void* data);
+  FOR_EACH_REG_EXP_TREE_TYPE(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+ private:
+  // Bounds the size of the program, which the matcher keeps per thread.
+  static constexpr intptr_t kMaxInstructions = 16 * KB;
+  static constexpr intptr_t kMaxThreadRegisters = 1 * MB;
+
+  intptr_t Position() const { return program_->instructions_.length(); }
+
+  intptr_t Emit(RegExpLinearProgram::Opcode opcode,
+                intptr_t x = 0,
+                intptr_t y = 0) {
+    if (Position() >= kMaxInstructions) {
+      failed_ = true;
+    }
+    program_->instructions_.Add({opcode, static_cast<int32_t>(x),
+                                 static_cast<int32_t>(y)});
+    return Position() - 1;
+  }
+
+  void PatchFork(intptr_t pc, intptr_t first, intptr_t second) {
+    RegExpLinearProgram::Instruction* instr = &program_->instructions_[pc];
+    ASSERT(instr->opcode == RegExpLinearProgram::kFork);
+    instr->x = first;
+    instr->y = second;
+  }
+
+  void EmitConsume(ZoneGrowableArray<CharacterRange>* ranges);
+  void EmitCharacter(uint16_t c, bool ignore_case);
+  void EmitClearRegisters(Interval registers);
+
+  RegExpLinearProgram* const program_;
+  const bool is_one_byte_;
+  Zone* const zone_;
+  bool failed_ = false;
+  unibrow::Mapping<unibrow::Ecma262UnCanonicalize> uncanonicalize_;
+};
+
+bool RegExpLinearCompiler::Compile(RegExpTree* tree) {
+  // Lazily skip characters in front of the match, with lower priority than
+  // the threads which started earlier.
+  Emit(RegExpLinearProgram::kFork, RegExpLinearProgram::kStickyStart, 1);
+  EmitConsume(CharacterRange::List(zone_, CharacterRange::Everything()));
+  Emit(RegExpLinearProgram::kJump, 0);
+  ASSERT(Position() == RegExpLinearProgram::kStickyStart);
+
+  // Wrap the pattern in capture #0.
+  Emit(RegExpLinearProgram::kSetRegister, RegExpCapture::StartRegister(0));
+  tree->Accept(this, nullptr);
+  Emit(RegExpLinearProgram::kSetRegister, RegExpCapture::EndRegister(0));
+  Emit(RegExpLinearProgram::kAccept);
+  return !failed_ && (Position() * program_->num_registers() <=
+                      kMaxThreadRegisters);
+}
+
+void RegExpLinearCompiler::EmitConsume(
+    ZoneGrowableArray<CharacterRange>* ranges) {
+  CharacterRange::Canonicalize(ranges);
+  const intptr_t start = program_->ranges_.length();
+  for (intptr_t i = 0; i < ranges->length(); i++) {
+    program_->ranges_.Add(ranges->At(i));
+  }
+  Emit(RegExpLinearProgram::kConsume, start, program_->ranges_.length());
+}
+
+void RegExpLinearCompiler::EmitCharacter(uint16_t c, bool ignore_case) {
+  auto ranges = new (zone_) ZoneGrowableArray<CharacterRange>(2);
+  if (!ignore_case) {
+    ranges->Add(CharacterRange::Singleton(c));
+    EmitConsume(ranges);
+    return;
+  }
+  // Same as the letters irregexp compares a character with, see
+  // GetCaseIndependentLetters.
+  if (!is_one_byte_ || c <= Symbols::kMaxOneCharCodeSymbol) {
+    int32_t letters[unibrow::Ecma262UnCanonicalize::kMaxWidth];
+    intptr_t length = uncanonicalize_.get(c, '\0', letters);
+    if (length == 0) {
+      letters[0] = c;
+      length = 1;
+    }
+    for (intptr_t i = 0; i < length; i++) {
+      ranges->Add(CharacterRange::Singleton(letters[i]));
+    }
+  }
+  EmitConsume(ranges);
+}
+
+void RegExpLinearCompiler::EmitClearRegisters(Interval registers) {
+  if (!registers.is_empty()) {
+    Emit(RegExpLinearProgram::kClearRegisters, registers.from(),
+         registers.to() + 1);
+  }
+}
+
+void* RegExpLinearCompiler::VisitDisjunction(RegExpDisjunction* that,
+                                             void* data) {
+  ZoneGrowableArray<RegExpTree*>* alternatives = that->alternatives();
+  GrowableArray<intptr_t> jumps;
+  for (intptr_t i = 0; i < alternatives->length() && !failed_; i++) {
+    if (i == alternatives->length() - 1) {
+      alternatives->At(i)->Accept(this, data);
+      break;
+    }
+    const intptr_t fork = Emit(RegExpLinearProgram::kFork);
+    alternatives->At(i)->Accept(this, data);
+    jumps.Add(Emit(RegExpLinearProgram::kJump));
+    PatchFork(fork, fork + 1, Position());
+  }
+  for (intptr_t i = 0; i < jumps.length(); i++) {
+    program_->instructions_[jumps[i]].x = Position();
+  }
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitAlternative(RegExpAlternative* that,
+                                             void* data) {
+  ZoneGrowableArray<RegExpTree*>* nodes = that->nodes();
+  for (intptr_t i = 0; i < nodes->length() && !failed_; i++) {
+    nodes->At(i)->Accept(this, data);
+  }
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitAssertion(RegExpAssertion* that,
+                                           void* data) {
+  Emit(RegExpLinearProgram::kAssertion, that->assertion_type());
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitCharacterClass(RegExpCharacterClass* that,
+                                                void* data) {
+  ZoneGrowableArray<CharacterRange>* ranges = that->ranges();
+  auto copy =
+      new (zone_) ZoneGrowableArray<CharacterRange>(ranges->length());
+  for (intptr_t i = 0; i < ranges->length(); i++) {
+    copy->Add(ranges->At(i));
+  }
+  // Same as TextNode::MakeCaseIndependent.
+  if (that->flags().IgnoreCase() && !that->is_standard()) {
+    CharacterRange::AddCaseEquivalents(copy, is_one_byte_, zone_);
+  }
+  if (that->is_negated()) {
+    CharacterRange::Canonicalize(copy);
+    auto negated = new (zone_) ZoneGrowableArray<CharacterRange>(
+        copy->length() + 1);
+    CharacterRange::Negate(copy, negated);
+    copy = negated;
+  }
+  EmitConsume(copy);
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitAtom(RegExpAtom* that, void* data) {
+  ZoneGrowableArray<uint16_t>* chars = that->data();
+  for (intptr_t i = 0; i < chars->length() && !failed_; i++) {
+    EmitCharacter(chars->At(i), that->ignore_case());
+  }
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitText(RegExpText* that, void* data) {
+  GrowableArray<TextElement>* elements = that->elements();
+  for (intptr_t i = 0; i < elements->length() && !failed_; i++) {
+    const TextElement& element = elements->At(i);
+    if (element.text_type() == TextElement::ATOM) {
+      VisitAtom(element.atom(), data);
+    } else {
+      VisitCharacterClass(element.char_class(), data);
+    }
+  }
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitQuantifier(RegExpQuantifier* that,
+                                            void* data) {
+  if (that->is_possessive()) {
+    failed_ = true;
+    return nullptr;
+  }
+  RegExpTree* body = that->body();
+  const intptr_t min = that->min();
+  const intptr_t max = that->max();
+  const bool is_greedy = !that->is_non_greedy();
+  // An iteration beyond the minimum may not match the empty string, which
+  // kCheckProgress enforces. Threads are merged by program counter, which
+  // only keeps the right thread at a kCheckProgress that can be reached
+  // from the start of the same iteration, so bodies matching the empty
+  // string are only supported in unbounded loops.
+  const bool can_be_empty = body->min_match() == 0;
+  if (can_be_empty && (max != RegExpTree::kInfinity) && (max > min)) {
+    failed_ = true;
+    return nullptr;
+  }
+  // Captures in the body are reset by each iteration.
+  const Interval captures = that->CaptureRegisters();
+
+  for (intptr_t i = 0; i < min && !failed_; i++) {
+    EmitClearRegisters(captures);
+    body->Accept(this, data);
+  }
+  if (max == RegExpTree::kInfinity) {
+    const intptr_t loop = Emit(RegExpLinearProgram::kFork);
+    const intptr_t progress_register =
+        can_be_empty ? program_->num_registers_++ : -1;
+    EmitClearRegisters(captures);
+    if (can_be_empty) {
+      Emit(RegExpLinearProgram::kSetRegister, progress_register);
+    }
+    body->Accept(this, data);
+    if (can_be_empty) {
+      Emit(RegExpLinearProgram::kCheckProgress, progress_register);
+    }
+    Emit(RegExpLinearProgram::kJump, loop);
+    if (is_greedy) {
+      PatchFork(loop, loop + 1, Position());
+    } else {
+      PatchFork(loop, Position(), loop + 1);
+    }
+    return nullptr;
+  }
+  GrowableArray<intptr_t> forks;
+  for (intptr_t i = min; i < max && !failed_; i++) {
+    forks.Add(Emit(RegExpLinearProgram::kFork));
+    EmitClearRegisters(captures);
+    body->Accept(this, data);
+  }
+  for (intptr_t i = 0; i < forks.length(); i++) {
+    if (is_greedy) {
+      PatchFork(forks[i], forks[i] + 1, Position());
+    } else {
+      PatchFork(forks[i], Position(), forks[i] + 1);
+    }
+  }
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitCapture(RegExpCapture* that, void* data) {
+  Emit(RegExpLinearProgram::kSetRegister,
+       RegExpCapture::StartRegister(that->index()));
+  that->body()->Accept(this, data);
+  Emit(RegExpLinearProgram::kSetRegister,
+       RegExpCapture::EndRegister(that->index()));
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitLookaround(RegExpLookaround* that,
+                                            void* data) {
+  failed_ = true;
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitBackReference(RegExpBackReference* that,
+                                               void* data) {
+  failed_ = true;
+  return nullptr;
+}
+
+void* RegExpLinearCompiler::VisitEmpty(RegExpEmpty* that, void* data) {
+  return nullptr;
+}
+
+// Runs a RegExpLinearProgram over a subject.
+//
+// The threads waiting to consume the character at the current position are
+// kept in a list ordered by priority together with their registers. Each
+// step computes the list for the next position by following the
+// instructions of each thread up to its next kConsume. A program counter
+// reached by two threads is only followed for the first one, which has the
+// higher priority, so a list never holds more threads than there are
+// instructions.
+class RegExpLinearMatcher : public ValueObject {
+ public:
+  RegExpLinearMatcher(const RegExpLinearProgram& program,
+                      const String& subject,
+                      Zone* zone);
+
+  ObjectPtr Match(intptr_t start_index, bool sticky);
+
+ private:
+  struct ThreadList {
+    intptr_t length;
+    intptr_t* pcs;
+    // num_registers() registers per thread.
+    int32_t* registers;
+  };
+
+  // A program counter to follow, or a register to restore once the
+  // instructions after it have been followed if pc is negative.
+  struct Job {
+    intptr_t pc;
+    intptr_t reg;
+    int32_t value;
+  };
+
+  static constexpr intptr_t kInterruptCheckMask = 4 * KB - 1;
+
+  static bool IsLineTerminator(uint16_t c) {
+    return (c == '\n') || (c == '\r') || (c == 0x2028) || (c == 0x2029);
+  }
+
+  static bool IsWordCharacter(uint16_t c) {
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+           ((c >= '0') && (c <= '9')) || (c == '_');
+  }
+
+  intptr_t num_registers() const { return program_.num_registers(); }
+
+  void AddThread(ThreadList* list,
+                 intptr_t pc,
+                 const int32_t* registers,
+                 intptr_t position);
+  bool AssertionHolds(intptr_t type, intptr_t position) const;
+
+  const RegExpLinearProgram& program_;
+  const String& subject_;
+  const intptr_t subject_length_;
+  Zone* const zone_;
+  ThreadList lists_[2];
+  // Registers of the thread being followed.
+  int32_t* scratch_;
+  GrowableArray<Job> jobs_;
+  // The last generation in which each program counter was reached.
+  intptr_t* visited_;
+  intptr_t generation_ = 0;
+};
+
+RegExpLinearMatcher::RegExpLinearMatcher(const RegExpLinearProgram& program,
+                                         const String& subject,
+                                         Zone* zone)
+    : program_(program),
+      subject_(subject),
+      subject_length_(subject.Length()),
+      zone_(zone),
+      jobs_(zone, 16) {
+  const intptr_t length = program.length();
+  for (intptr_t i = 0; i < 2; i++) {
+    lists_[i].length = 0;
+    lists_[i].pcs = zone->Alloc<intptr_t>(length);
+    lists_[i].registers = zone->Alloc<int32_t>(length * num_registers());
+  }
+  scratch_ = zone->Alloc<int32_t>(num_registers());
+  visited_ = zone->Alloc<intptr_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    visited_[i] = -1;
+  }
+}
+
+void RegExpLinearMatcher::AddThread(ThreadList* list,
+                                    intptr_t pc,
+                                    const int32_t* registers,
+                                    intptr_t position) {
+  memmove(scratch_, registers, num_registers() * sizeof(int32_t));
+  ASSERT(jobs_.is_empty());
+  jobs_.Add({pc, 0, 0});
+  while (!jobs_.is_empty()) {
+    const Job job = jobs_.RemoveLast();
+    if (job.pc < 0) {
+      scratch_[job.reg] = job.value;
+      continue;
+    }
+    for (intptr_t next = job.pc; next >= 0;) {
+      pc = next;
+      next = -1;
+      const RegExpLinearProgram::Instruction& instr =
+          program_.InstructionAt(pc);
+      // Whether a kCheckProgress passes depends on the registers of the
+      // thread, and it may only be reached by a thread which started the
+      // iteration at this position before, see VisitQuantifier. Every other
+      // instruction behaves the same for all threads.
+      if (instr.opcode != RegExpLinearProgram::kCheckProgress) {
+        if (visited_[pc] == generation_) {
+          continue;
+        }
+        visited_[pc] = generation_;
+      }
+      switch (instr.opcode) {
+        case RegExpLinearProgram::kConsume:
+        case RegExpLinearProgram::kAccept:
+          list->pcs[list->length] = pc;
+          memmove(&list->registers[list->length * num_registers()], scratch_,
+                  num_registers() * sizeof(int32_t));
+          list->length++;
+          break;
+        case RegExpLinearProgram::kFork:
+          jobs_.Add({instr.y, 0, 0});
+          next = instr.x;
+          break;
+        case RegExpLinearProgram::kJump:
+          next = instr.x;
+          break;
+        case RegExpLinearProgram::kSetRegister:
+          jobs_.Add({-1, instr.x, scratch_[instr.x]});
+          scratch_[instr.x] = position;
+          next = pc + 1;
+          break;
+        case RegExpLinearProgram::kClearRegisters:
+          for (intptr_t reg = instr.x; reg < instr.y; reg++) {
+            jobs_.Add({-1, reg, scratch_[reg]});
+            scratch_[reg] = -1;
+          }
+          next = pc + 1;
+          break;
+        case RegExpLinearProgram::kCheckProgress:
+          if (scratch_[instr.x] != position) {
+            next = pc + 1;
+          }
+          break;
+        case RegExpLinearProgram::kAssertion:
+          if (AssertionHolds(instr.x, position)) {
+            next = pc + 1;
+          }
+          break;
+      }
+    }
+  }
+}
+
+bool RegExpLinearMatcher::AssertionHolds(intptr_t type,
+                                         intptr_t position) const {
+  switch (type) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::START_OF_LINE:
+      return (position == 0) ||
+             IsLineTerminator(subject_.CharAt(position - 1));
+    case RegExpAssertion::END_OF_INPUT:
+      return position == subject_length_;
+    case RegExpAssertion::END_OF_LINE:
+      return (position == subject_length_) ||
+             IsLineTerminator(subject_.CharAt(position));
+    case RegExpAssertion::BOUNDARY:
+    case RegExpAssertion::NON_BOUNDARY: {
+      const bool word_before =
+          (position > 0) && IsWordCharacter(subject_.CharAt(position - 1));
+      const bool word_after = (position < subject_length_) &&
+                              IsWordCharacter(subject_.CharAt(position));
+      return (word_before != word_after) ==
+             (type == RegExpAssertion::BOUNDARY);
+    }
+  }
+  UNREACHABLE();
+  return false;
+}
+
+ObjectPtr RegExpLinearMatcher::Match(intptr_t start_index, bool sticky) {
+  if (start_index > subject_length_) {
+    return Instance::null();
+  }
+  Thread* thread = Thread::Current();
+  int32_t* match = zone_->Alloc<int32_t>(num_registers());
+  for (intptr_t i = 0; i < num_registers(); i++) {
+    match[i] = -1;
+  }
+  ThreadList* current = &lists_[0];
+  ThreadList* next = &lists_[1];
+  AddThread(current, sticky ? RegExpLinearProgram::kStickyStart : 0, match,
+            start_index);
+  bool matched = false;
+  for (intptr_t position = start_index; current->length > 0; position++) {
+    if (((position & kInterruptCheckMask) == 0) &&
+        UNLIKELY(thread->HasScheduledInterrupts())) {
+      const Error& error = Error::Handle(zone_, thread->HandleInterrupts());
+      if (!error.IsNull()) {
+        return error.ptr();
+      }
+    }
+    generation_++;
+    next->length = 0;
+    const int32_t c =
+        position < subject_length_ ? subject_.CharAt(position) : -1;
+    for (intptr_t i = 0; i < current->length; i++) {
+      const intptr_t pc = current->pcs[i];
+      const int32_t* registers = &current->registers[i * num_registers()];
+      const RegExpLinearProgram::Instruction& instr =
+          program_.InstructionAt(pc);
+      if (instr.opcode == RegExpLinearProgram::kAccept) {
+        // Threads with lower priority cannot produce the match.
+        matched = true;
+        memmove(match, registers, num_registers() * sizeof(int32_t));
+        break;
+      }
+      if ((c >= 0) && program_.Consumes(instr, c)) {
+        AddThread(next, pc + 1, registers, position + 1);
+      }
+    }
+    ThreadList* temp = current;
+    current = next;
+    next = temp;
+  }
+  if (!matched) {
+    return Instance::null();
+  }
+
+  const intptr_t num_capture_registers = program_.num_capture_registers();
+  const TypedData& result = TypedData::Handle(
+      zone_, TypedData::New(kTypedDataInt32ArrayCid, num_capture_registers));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(result.DataAddr(0), match,
+            num_capture_registers * sizeof(int32_t));
+  }
+  return result.ptr();
+}
+
+RegExpLinearProgram* RegExpLinearEngine::Compile(const RegExp& regexp,
+                                                 bool is_one_byte,
+                                                 Zone* zone) {
+  // Unicode patterns match surrogate pairs and need full case folding.
+  if (regexp.flags().IsUnicode()) {
+    return nullptr;
+  }
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+  // Parsing failures are handled in the RegExp factory constructor.
+  RegExpParser::ParseRegExp(pattern, regexp.flags(), compile_data);
+
+  RegExpLinearProgram* program =
+      new (zone) RegExpLinearProgram(compile_data->capture_count);
+  RegExpLinearCompiler compiler(program, is_one_byte, zone);
+  if (!compiler.Compile(compile_data->tree)) {
+    return nullptr;
+  }
+  return program;
+}
+
+ObjectPtr RegExpLinearEngine::Match(const RegExpLinearProgram& program,
+                                    const String& subject,
+                                    intptr_t start_index,
+                                    bool sticky,
+                                    Zone* zone) {
+  ASSERT(subject.IsOneByteString() || subject.IsTwoByteString());
+  RegExpLinearMatcher matcher(program, subject, zone);
+  return matcher.Match(start_index, sticky);
+}
+
+}  // namespace dart
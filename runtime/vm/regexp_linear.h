@@ -0,0 +1,51 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class RegExpLinearProgram;
+
+// A regexp engine whose running time is linear in the length of the subject.
+//
+// Irregexp matches by backtracking, which takes time exponential in the
+// length of the subject for patterns such as /(a*)*b/. This engine compiles
+// the parsed pattern to a nondeterministic automaton instead and runs all of
+// its threads in lockstep over the subject (a Pike VM), so a match takes
+// O(n * m) steps for a subject of length n and a pattern of size m. Threads
+// are kept in order of priority, so the match and its captures are the ones
+// a backtracking engine would find.
+//
+// Patterns with backreferences or lookarounds, which are not regular, and
+// unicode patterns are not supported.
+//
+// The bytecode interpreter uses this engine when --regexp-linear-engine is
+// given, and falls back to it once a match has backtracked more than
+// --regexp-backtracks-before-fallback times.
+class RegExpLinearEngine : public AllStatic {
+ public:
+  // Compiles the pattern of [regexp] for subjects of the given width.
+  // Returns nullptr if the pattern is not supported.
+  static RegExpLinearProgram* Compile(const RegExp& regexp,
+                                      bool is_one_byte,
+                                      Zone* zone);
+
+  // Returns the capture registers of the first match of [program] in
+  // [subject] at or after [start_index] as an Int32 TypedData, null if there
+  // is none, or an Error if the match was interrupted.
+  static ObjectPtr Match(const RegExpLinearProgram& program,
+                         const String& subject,
+                         intptr_t start_index,
+                         bool sticky,
+                         Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_LINEAR_H_
@@ -7,11 +7,16 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
+#include "vm/regexp_linear.h"
 #include "vm/unit_test.h"
+#include "vm/zone_text_buffer.h"
 
 namespace dart {
 
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 static ArrayPtr Match(const String& pat, const String& str) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -66,4 +71,189 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+// Returns the capture registers of a match as a string, "unsupported" if
+// the linear engine cannot handle [pattern], or "null" if there is no match.
+static const char* LinearMatch(const char* pattern,
+                               const char* subject,
+                               RegExpFlags flags = RegExpFlags(),
+                               intptr_t start_index = 0,
+                               bool sticky = false) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const String& pat = String::Handle(Symbols::New(thread, pattern));
+  const String& str = String::Handle(String::New(subject));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, flags));
+  RegExpLinearProgram* program =
+      RegExpLinearEngine::Compile(regexp, str.IsOneByteString(), zone);
+  if (program == nullptr) {
+    return "unsupported";
+  }
+  const Object& result = Object::Handle(
+      RegExpLinearEngine::Match(*program, str, start_index, sticky, zone));
+  if (result.IsNull()) {
+    return "null";
+  }
+  const TypedData& registers = TypedData::Cast(result);
+  ZoneTextBuffer buffer(zone);
+  for (intptr_t i = 0; i < registers.Length(); i++) {
+    buffer.Printf("%s%d", i == 0 ? "" : " ",
+                  registers.GetInt32(i * sizeof(int32_t)));
+  }
+  return buffer.buffer();
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearEngine) {
+  RegExpFlags ignore_case;
+  ignore_case.SetIgnoreCase();
+  RegExpFlags multi_line;
+  multi_line.SetMultiLine();
+  RegExpFlags unicode;
+  unicode.SetUnicode();
+
+  EXPECT_STREQ("1 3", LinearMatch("bc", "abcba"));
+  EXPECT_STREQ("null", LinearMatch("bd", "abcba"));
+  EXPECT_STREQ("2 4", LinearMatch("[^a]+", "aabca"));
+  EXPECT_STREQ("1 4", LinearMatch("AB[c-d]", "xabD", ignore_case));
+  EXPECT_STREQ("0 3", LinearMatch("a{2,3}", "aaaa"));
+  EXPECT_STREQ("2 5", LinearMatch("\\bfoo\\b", "a foo b"));
+  EXPECT_STREQ("null", LinearMatch("^b", "a\nb"));
+  EXPECT_STREQ("2 3", LinearMatch("^b", "a\nb", multi_line));
+
+  // Alternatives and quantifiers are tried in the order of a backtracking
+  // engine.
+  EXPECT_STREQ("0 1", LinearMatch("a|ab", "ab"));
+  EXPECT_STREQ("0 4 0 1 1 4", LinearMatch("(a|ab)(c|bcd)", "abcd"));
+  EXPECT_STREQ("0 1", LinearMatch("a+?", "aaa"));
+  EXPECT_STREQ("0 3 1 2", LinearMatch("<(.*?)>", "<a><b>"));
+
+  // Iterations reset the captures of the body and may not be empty.
+  EXPECT_STREQ("0 2 -1 -1", LinearMatch("(?:(a)|b)+", "ab"));
+  EXPECT_STREQ("0 4 0 3", LinearMatch("(a*)*b", "aaab"));
+  EXPECT_STREQ("null", LinearMatch("(a*)*b", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+
+  EXPECT_STREQ("null", LinearMatch("b", "abab", RegExpFlags(), 2, true));
+  EXPECT_STREQ("1 2", LinearMatch("b", "abab", RegExpFlags(), 1, true));
+  EXPECT_STREQ("3 4", LinearMatch("b", "abab", RegExpFlags(), 2, false));
+
+  EXPECT_STREQ("unsupported", LinearMatch("(a)\\1", "aa"));
+  EXPECT_STREQ("unsupported", LinearMatch("a(?=b)", "ab"));
+  EXPECT_STREQ("unsupported", LinearMatch("a", "a", unicode));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_BacktrackFallback) {
+  SetFlagScope<bool> sfs_interpret(&FLAG_interpret_irregexp, true);
+  SetFlagScope<int> sfs_fallback(&FLAG_regexp_backtracks_before_fallback,
+                                 1000);
+  Zone* zone = thread->zone();
+  // Takes exponential time when backtracking.
+  const String& pat = String::Handle(Symbols::New(thread, "(a*)*b"));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+  const String& str = String::Handle(
+      String::New("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+  const Object& result = Object::Handle(BytecodeRegExpMacroAssembler::Interpret(
+      regexp, str, Object::smi_zero(), /*sticky=*/false, zone));
+  EXPECT(result.IsNull());
+}
+
+// Returns the capture registers of the first match of [pattern] in the
+// [length] code units of [subject] found by the bytecode interpreter, or
+// "null" if there is none.
+template <typename Char>
+static const char* InterpretMatch(const char* pattern,
+                                  const Char* subject,
+                                  intptr_t length) {
+  SetFlagScope<bool> sfs_interpret(&FLAG_interpret_irregexp, true);
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const String& pat = String::Handle(Symbols::New(thread, pattern));
+  const String& str = String::Handle(
+      sizeof(Char) == 1
+          ? String::FromLatin1(reinterpret_cast<const uint8_t*>(subject),
+                               length)
+          : String::FromUTF16(reinterpret_cast<const uint16_t*>(subject),
+                              length));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+  const Object& result = Object::Handle(BytecodeRegExpMacroAssembler::Interpret(
+      regexp, str, Object::smi_zero(), /*sticky=*/false, zone));
+  if (result.IsNull()) {
+    return "null";
+  }
+  const TypedData& registers = TypedData::Cast(result);
+  ZoneTextBuffer buffer(zone);
+  for (intptr_t i = 0; i < registers.Length(); i++) {
+    buffer.Printf("%s%d", i == 0 ? "" : " ",
+                  registers.GetInt32(i * sizeof(int32_t)));
+  }
+  return buffer.buffer();
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_SkipUntilBitInTable) {
+  // Long enough for the vectorized scan, with characters whose low 7 bits
+  // match the pattern but which don't.
+  const intptr_t kLength = 1000;
+  uint8_t one_byte[kLength];
+  uint16_t two_byte[kLength];
+  for (intptr_t i = 0; i < kLength; i++) {
+    one_byte[i] = (i % 7 == 0) ? 0x8a : 'a' + (i % 3);
+    two_byte[i] = (i % 7 == 0) ? 0x10a : 'a' + (i % 3);
+  }
+  EXPECT_STREQ("null", InterpretMatch("[\\r\\n]", one_byte, kLength));
+  EXPECT_STREQ("null", InterpretMatch("[\\r\\n]", two_byte, kLength));
+
+  one_byte[987] = '\n';
+  two_byte[987] = '\n';
+  EXPECT_STREQ("987 988", InterpretMatch("[\\r\\n]", one_byte, kLength));
+  EXPECT_STREQ("987 988", InterpretMatch("[\\r\\n]", two_byte, kLength));
+
+  const char* log = "INFO: started\nERR: none\nERROR: failed\nINFO: done";
+  const intptr_t log_length = strlen(log);
+  EXPECT_STREQ("24 37",
+               InterpretMatch("ERROR:.*", reinterpret_cast<const uint8_t*>(log),
+                              log_length));
+  EXPECT_STREQ("null",
+               InterpretMatch("FATAL:.*", reinterpret_cast<const uint8_t*>(log),
+                              log_length));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_TierUp) {
+  SetFlagScope<bool> sfs_interpret(&FLAG_interpret_irregexp, false);
+  SetFlagScope<int> sfs_tier_up(&FLAG_regexp_tier_up_executions, 2);
+  Zone* zone = thread->zone();
+  const String& pat = String::Handle(Symbols::New(thread, "b+"));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+  const String& str = String::Handle(String::New("abba"));
+  EXPECT(!regexp.has_function(kOneByteStringCid, /*sticky=*/false));
+
+  // Cold patterns are interpreted.
+  for (intptr_t i = 0; i < 2; i++) {
+    EXPECT(!RegExpEngine::TierUpIfHot(thread, regexp, kOneByteStringCid,
+                                      /*sticky=*/false));
+    const Object& result = Object::Handle(
+        BytecodeRegExpMacroAssembler::Interpret(
+            regexp, str, Object::smi_zero(), /*sticky=*/false, zone));
+    EXPECT(result.IsTypedData());
+  }
+  EXPECT(regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false) !=
+         TypedData::null());
+
+  // Hot patterns are compiled for each kind of subject on first use.
+  EXPECT(RegExpEngine::TierUpIfHot(thread, regexp, kOneByteStringCid,
+                                   /*sticky=*/false));
+  EXPECT(regexp.has_function(kOneByteStringCid, /*sticky=*/false));
+  EXPECT(regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false) ==
+         TypedData::null());
+  EXPECT(!regexp.has_function(kTwoByteStringCid, /*sticky=*/false));
+  EXPECT(!regexp.has_function(kOneByteStringCid, /*sticky=*/true));
+
+  const Array& result = Array::Handle(IRRegExpMacroAssembler::Execute(
+      regexp, str, Object::smi_zero(), /*sticky=*/false, zone));
+  EXPECT_EQ(2, result.Length());
+  EXPECT_EQ(1, Smi::Value(Smi::RawCast(result.At(0))));
+  EXPECT_EQ(3, Smi::Value(Smi::RawCast(result.At(1))));
+}
+
 }  // namespace dart
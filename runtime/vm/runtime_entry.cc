@@ -246,6 +246,7 @@ static void DoThrowNullError(Isolate* isolate,
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
 
+  // May allocate the map, see Code::code_source_map.
   const CodeSourceMap& map =
       CodeSourceMap::Handle(zone, code.code_source_map());
   String& member_name = String::Handle(zone);
@@ -6,6 +6,7 @@
 
 #include "include/dart_tools_api.h"
 #include "platform/assert.h"
+#include "platform/text_buffer.h"
 #include "platform/unicode.h"
 #include "vm/app_snapshot.h"
 #include "vm/class_finalizer.h"
@@ -17,6 +18,7 @@
 #include "vm/message_snapshot.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
+#include "vm/timeline.h"
 #include "vm/timer.h"
 #include "vm/unit_test.h"
 
@@ -789,6 +791,124 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
   free(isolate_snapshot_data_buffer);
 }
 
+DECLARE_FLAG(int, snapshot_fill_tasks);
+
+// Reads [snapshot] into a new isolate and returns the result of checksum() in
+// its root library.
+static int64_t ChecksumFromSnapshot(uint8_t* snapshot) {
+  TestCase::CreateTestIsolateFromSnapshot(snapshot);
+  Dart_EnterScope();
+  Dart_Handle result =
+      Dart_Invoke(TestCase::lib(), NewString("checksum"), 0, nullptr);
+  EXPECT_VALID(result);
+  int64_t checksum = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &checksum));
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+  return checksum;
+}
+
+// Writes a full snapshot of a program whose checksum() adds up a constant
+// list of [num_points] points, and returns the expected checksum.
+static uint8_t* WritePointsSnapshot(intptr_t num_points, int64_t* expected) {
+  TextBuffer script(64 * KB);
+  script.AddString(
+      "class Point {\n"
+      "  const Point(this.x, this.y);\n"
+      "  final int x;\n"
+      "  final double y;\n"
+      "}\n"
+      "const points = <Point>[\n");
+  for (intptr_t i = 0; i < num_points; i++) {
+    script.Printf("  Point(%" Pd ", %" Pd ".5),\n", i, i);
+  }
+  script.AddString(
+      "];\n"
+      "int checksum() {\n"
+      "  int sum = 0;\n"
+      "  for (final p in points) {\n"
+      "    sum += p.x * 3 + p.y.floor();\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n");
+  *expected = 2 * num_points * (num_points - 1);
+
+  TestIsolateScope __test_isolate__;
+  TestCase::LoadTestScript(script.buffer(), nullptr);
+
+  Thread* thread = Thread::Current();
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HandleScope scope(thread);
+
+  Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+  {
+    TransitionVMToNative to_native(thread);
+    EXPECT_VALID(result);
+  }
+
+  MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+  FullSnapshotWriter writer(
+      Snapshot::kFull, /*vm_snapshot_data=*/nullptr, &isolate_snapshot_data,
+      /*vm_image_writer=*/nullptr, /*iso_image_writer=*/nullptr);
+  writer.WriteFullSnapshot();
+  intptr_t unused;
+  return isolate_snapshot_data.Steal(&unused);
+}
+
+// The core libraries alone have enough objects to fill on helper threads.
+VM_UNIT_TEST_CASE(FullSnapshotFilledConcurrently) {
+  int64_t expected;
+  uint8_t* isolate_snapshot_data_buffer =
+      WritePointsSnapshot(/*num_points=*/5000, &expected);
+
+  {
+    SetFlagScope<int> sfs(&FLAG_snapshot_fill_tasks, 0);
+    const intptr_t fills = FullSnapshotReader::concurrent_fills_for_testing();
+    EXPECT_EQ(expected, ChecksumFromSnapshot(isolate_snapshot_data_buffer));
+    EXPECT_EQ(fills, FullSnapshotReader::concurrent_fills_for_testing());
+  }
+
+  {
+    SetFlagScope<int> sfs(&FLAG_snapshot_fill_tasks, 4);
+    const intptr_t fills = FullSnapshotReader::concurrent_fills_for_testing();
+    EXPECT_EQ(expected, ChecksumFromSnapshot(isolate_snapshot_data_buffer));
+    // Helper threads are only used if there is a processor to spare.
+    if (OS::NumberOfAvailableProcessors() > 1) {
+      EXPECT(FullSnapshotReader::concurrent_fills_for_testing() > fills);
+    }
+  }
+
+  free(isolate_snapshot_data_buffer);
+}
+
+#if defined(SUPPORT_TIMELINE) && !defined(PRODUCT)
+// Loading a snapshot with the isolate stream enabled records the load
+// profile of each cluster on the timeline.
+VM_UNIT_TEST_CASE(FullSnapshotLoadProfileTimeline) {
+  int64_t expected;
+  uint8_t* isolate_snapshot_data_buffer =
+      WritePointsSnapshot(/*num_points=*/10, &expected);
+
+  TimelineStream* stream = Timeline::GetIsolateStream();
+  const bool was_enabled = stream->enabled();
+  stream->set_enabled(true);
+  EXPECT_EQ(expected, ChecksumFromSnapshot(isolate_snapshot_data_buffer));
+  stream->set_enabled(was_enabled);
+  free(isolate_snapshot_data_buffer);
+
+  EXPECT(Timeline::recorder() != nullptr);
+  JSONStream js;
+  TimelineEventFilter filter;
+  Timeline::recorder()->PrintJSON(&js, &filter);
+  const char* json = js.ToCString();
+  EXPECT_SUBSTRING("\"phase\":\"ReadAlloc\"", json);
+  EXPECT_SUBSTRING("\"phase\":\"ReadFill\"", json);
+  EXPECT_SUBSTRING("\"phase\":\"PostLoad\"", json);
+  EXPECT_SUBSTRING("\"canonicalized\":\"", json);
+}
+#endif  // defined(SUPPORT_TIMELINE) && !defined(PRODUCT)
+
 // Helper function to call a top level Dart function and serialize the result.
 static std::unique_ptr<Message> GetSerialized(Dart_Handle lib,
                                               const char* dart_function) {
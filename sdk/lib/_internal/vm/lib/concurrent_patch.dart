@@ -65,3 +65,9 @@ base class _ConditionVariableImpl extends NativeFieldWrapperClass1
   @Native<Void Function(Handle)>(symbol: "ConditionVariable_Notify")
   external void notify();
 }
+
+@patch
+T deepFreeze<T>(T object) => _deepFreeze(object) as T;
+
+@pragma("vm:external-name", "Concurrent_deepFreeze")
+external Object? _deepFreeze(Object? object);
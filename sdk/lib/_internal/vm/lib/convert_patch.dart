@@ -1641,6 +1641,9 @@ class _JsonUtf8Parser extends _JsonParserWithListener
   }
 
   double parseDouble(int start, int end) {
+    // Parse straight from the chunk unless it is not VM typed data.
+    final double? result = _parseDoubleFromBytes(chunk, start, end);
+    if (result != null) return result;
     String string = getString(start, end, 0x7f);
     return _parseDouble(string, 0, string.length);
   }
@@ -1649,6 +1652,9 @@ class _JsonUtf8Parser extends _JsonParserWithListener
 @pragma("vm:external-name", "Double_parse")
 external double _parseDouble(String source, int start, int end);
 
+@pragma("vm:external-name", "Double_parseBytes")
+external double? _parseDoubleFromBytes(Uint8List bytes, int start, int end);
+
 /**
  * Implements the chunked conversion from a UTF-8 encoding of JSON
  * to its corresponding object.
@@ -65,3 +65,29 @@ abstract interface class ConditionVariable {
   /// Wake up at least one thread waiting on this condition variable.
   external void notify();
 }
+
+/// Returns a deeply immutable version of [object] which isolates of the same
+/// isolate group can share without copying.
+///
+/// Sending the result (or any object reachable from it) through a [SendPort]
+/// to an isolate in the same group, e.g. one created by `Isolate.spawn`, passes
+/// it by reference: both isolates observe the identical object.
+///
+/// Objects which are already immutable, such as strings, numbers and constants,
+/// are returned unchanged. Other objects are frozen as follows:
+///
+/// * Lists are copied into unmodifiable lists.
+/// * Maps and sets are copied into unmodifiable maps and sets which keep the
+///   iteration order.
+/// * Typed data is copied into unmodifiable typed data.
+/// * Records and instances of classes whose instance fields are all final and
+///   not late are frozen in place, keeping their identity. Everything they
+///   refer to has to be immutable already, e.g. because it was frozen before.
+///
+/// Elements of copied collections are frozen recursively. Sharing and cycles
+/// within [object] are preserved.
+///
+/// Throws an [ArgumentError] if the object graph contains objects which cannot
+/// be frozen, e.g. closures capturing variables or instances with mutable
+/// fields. Nothing is frozen in that case.
+external T deepFreeze<T>(T object);